@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Base/Config.h"
+#include "Renderer/MaterialRuntime.h"
+#include "Renderer/Software/SoftwareLighting.h"
+#include "Scene/MaterialManager.h"
+#include "Scene/Texture.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace RetroRenderer::Bench {
+
+// Absolute so the suite does not depend on the working directory it is launched from.
+inline std::filesystem::path GetAssetsPath() {
+    return std::filesystem::path(RETRO_BENCH_ASSETS_DIR);
+}
+
+// Every shipped *.rrmatdef.json in a stable order, so new templates are picked up without touching the suite.
+inline std::vector<std::filesystem::path> ListShippedMaterialTemplates() {
+    std::vector<std::filesystem::path> paths;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(GetAssetsPath() / "materials", ec)) {
+        const std::string fileName = entry.path().filename().string();
+        constexpr std::string_view kSuffix = ".rrmatdef.json";
+        if (entry.is_regular_file() && fileName.size() > kSuffix.size() &&
+            fileName.compare(fileName.size() - kSuffix.size(), kSuffix.size(), kSuffix) == 0) {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+inline std::shared_ptr<const Texture> MakeGradientTexture(int size) {
+    std::vector<Pixel> pixels(static_cast<size_t>(size) * static_cast<size_t>(size));
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            pixels[static_cast<size_t>(y) * static_cast<size_t>(size) + static_cast<size_t>(x)] =
+                Pixel{static_cast<uint8_t>(x * 255 / size), static_cast<uint8_t>(y * 255 / size), static_cast<uint8_t>((x ^ y) & 0xFF), 255};
+        }
+    }
+    auto texture = std::make_shared<Texture>();
+    texture->LoadFromPixels(std::move(pixels), size, size);
+    texture->EnsureTiledLayout();
+    texture->EnsureMipChain();
+    return texture;
+}
+
+// Same state SWRenderer builds for a scene material: template defaults for every parameter and the given texture
+// bound to every sampler slot, with the reduced levels the preset asks for.
+inline SoftwareMaterialState MakeMaterialState(std::shared_ptr<const CompiledMaterialTemplate> compiledTemplate,
+                                               const Texture* texture,
+                                               const Config& config) {
+    SoftwareMaterialState state{};
+    state.compiledTemplate = std::move(compiledTemplate);
+    state.pipelineState = state.compiledTemplate->pipelineState;
+    for (const MaterialParameterDesc& parameter : state.compiledTemplate->parameters) {
+        state.parameterValues.push_back(parameter.defaultValue.data);
+    }
+    for (const MaterialSamplerDesc& samplerDesc : state.compiledTemplate->samplers) {
+        ResolvedMaterialSampler sampler{};
+        sampler.texture = texture;
+        sampler.filter = samplerDesc.filter;
+        sampler.wrapU = samplerDesc.wrapU;
+        sampler.wrapV = samplerDesc.wrapV;
+        if (texture != nullptr && config.retro.textureMaxDimension > 0) {
+            sampler.reducedLevel = texture->GetReducedLevel(config.retro.textureMaxDimension);
+            if (config.retro.usePs1ShadingModel && config.retro.usePs1TextureClut) {
+                sampler.reducedIndexedLevel = texture->GetReducedIndexedLevel(config.retro.textureMaxDimension);
+            }
+        }
+        state.samplers.push_back(std::move(sampler));
+    }
+    return state;
+}
+
+} // namespace RetroRenderer::Bench
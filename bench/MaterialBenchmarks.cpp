@@ -0,0 +1,63 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkFixtures.h"
+#include "Renderer/MaterialRuntime.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RetroRenderer {
+namespace {
+constexpr int kGridSize = 128;
+
+// One input per pixel of a kGridSize square, with UVs, normals and colors varying the way a rasterized quad's would.
+std::vector<MaterialFragmentStageInput> MakeFragmentInputs() {
+    std::vector<MaterialFragmentStageInput> inputs;
+    inputs.reserve(static_cast<size_t>(kGridSize) * kGridSize);
+    for (int y = 0; y < kGridSize; y++) {
+        for (int x = 0; x < kGridSize; x++) {
+            const glm::vec2 uv((static_cast<float>(x) + 0.5f) / kGridSize, (static_cast<float>(y) + 0.5f) / kGridSize);
+            MaterialFragmentStageInput input{};
+            input.worldPosition = glm::vec3(uv * 2.0f - 1.0f, 0.0f);
+            input.normalWS = glm::normalize(glm::vec3(uv.x - 0.5f, uv.y - 0.5f, 1.0f));
+            input.uv0 = uv * 3.0f;
+            input.color0 = glm::vec4(uv, 1.0f - uv.x, 1.0f);
+            input.viewDirWS = glm::normalize(glm::vec3(0.0f, 0.0f, 3.0f) - input.worldPosition);
+            input.screenUV = uv;
+            input.uvFootprintLog2 = -7.0f;
+            inputs.push_back(input);
+        }
+    }
+    return inputs;
+}
+} // namespace
+
+TEST_CASE("EvaluateMaterialFragmentStage per shipped material", "[benchmark][material]") {
+    const std::vector<std::filesystem::path> templatePaths = Bench::ListShippedMaterialTemplates();
+    REQUIRE_FALSE(templatePaths.empty());
+
+    MaterialManager materialManager;
+    const std::shared_ptr<const Texture> texture = Bench::MakeGradientTexture(256);
+    const std::vector<MaterialFragmentStageInput> inputs = MakeFragmentInputs();
+    const Config config{};
+    for (const std::filesystem::path& templatePath : templatePaths) {
+        const auto compiledTemplate = materialManager.GetCompiledTemplate(templatePath);
+        REQUIRE(compiledTemplate != nullptr);
+        // The error template has no source hash; benchmarking it would hide a broken asset behind plausible numbers.
+        REQUIRE(compiledTemplate->cacheKey != 0);
+        const SoftwareMaterialState state = Bench::MakeMaterialState(compiledTemplate, texture.get(), config);
+
+        BENCHMARK(templatePath.filename().string() + ", " + std::to_string(inputs.size()) + " fragments") {
+            float checksum = 0.0f;
+            for (const MaterialFragmentStageInput& input : inputs) {
+                checksum += EvaluateMaterialFragmentStage(*state.compiledTemplate, state.parameterValues, state.samplers, input).baseColor.g;
+            }
+            return checksum;
+        };
+    }
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,66 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Scene/ImportedSceneData.h"
+#include "Scene/LightweightObjSceneImporter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace RetroRenderer {
+namespace {
+// Height-field grid with positions, UVs, normals and quad faces: the shape of a typical exported OBJ.
+std::string MakeGridObjText(int cellsPerSide) {
+    std::ostringstream obj;
+    obj.setf(std::ios::fixed);
+    obj.precision(6);
+    obj << "# benchmark grid " << cellsPerSide << "x" << cellsPerSide << "\n";
+    obj << "o Grid\n";
+    const int verticesPerSide = cellsPerSide + 1;
+    for (int y = 0; y < verticesPerSide; y++) {
+        for (int x = 0; x < verticesPerSide; x++) {
+            const float u = static_cast<float>(x) / static_cast<float>(cellsPerSide);
+            const float v = static_cast<float>(y) / static_cast<float>(cellsPerSide);
+            obj << "v " << u * 2.0f - 1.0f << " " << 0.1f * static_cast<float>((x * 7 + y * 13) % 5) << " " << v * 2.0f - 1.0f << "\n";
+            obj << "vt " << u << " " << v << "\n";
+            obj << "vn 0.000000 1.000000 0.000000\n";
+        }
+    }
+    for (int y = 0; y < cellsPerSide; y++) {
+        for (int x = 0; x < cellsPerSide; x++) {
+            const int i0 = y * verticesPerSide + x + 1;
+            const int i1 = i0 + 1;
+            const int i2 = i0 + verticesPerSide + 1;
+            const int i3 = i0 + verticesPerSide;
+            obj << "f " << i0 << "/" << i0 << "/" << i0 << " " << i1 << "/" << i1 << "/" << i1 << " " << i2 << "/" << i2 << "/" << i2
+                << " " << i3 << "/" << i3 << "/" << i3 << "\n";
+        }
+    }
+    return obj.str();
+}
+} // namespace
+
+TEST_CASE("ParseObjText throughput", "[benchmark][importer][obj]") {
+    for (const int cellsPerSide : {32, 256}) {
+        const std::string objText = MakeGridObjText(cellsPerSide);
+        const auto* data = reinterpret_cast<const uint8_t*>(objText.data());
+
+        ImportedSceneData check;
+        LightweightObjSceneImporter checkImporter;
+        REQUIRE(checkImporter.LoadFromMemory(data, objText.size(), check));
+        REQUIRE_FALSE(check.meshes.empty());
+
+        // The byte count is part of the name so trend tooling can turn the mean into MB/s.
+        BENCHMARK(std::to_string(cellsPerSide) + "x" + std::to_string(cellsPerSide) + " grid, " + std::to_string(objText.size()) +
+                  " bytes") {
+            ImportedSceneData sceneData;
+            LightweightObjSceneImporter importer;
+            importer.LoadFromMemory(data, objText.size(), sceneData);
+            return sceneData.meshes.size();
+        };
+    }
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,163 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkFixtures.h"
+#include "Base/Config.h"
+#include "Renderer/Buffer.h"
+#include "Renderer/RetroPalette.h"
+#include "Renderer/Software/DepthClip.h"
+#include "Renderer/Software/Rasterizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RetroRenderer {
+namespace {
+struct PresetCase {
+    const char* name;
+    Config::RenderPreset preset;
+};
+
+constexpr PresetCase kPresets[] = {
+    {"default", Config::RenderPreset::DEFAULT},
+    {"pico8", Config::RenderPreset::PICO8},
+    {"picocad", Config::RenderPreset::PICOCAD},
+    {"ps1", Config::RenderPreset::PS1},
+};
+
+Config MakePresetConfig(Config::RenderPreset preset) {
+    Config config{};
+    Config::ApplyRenderPreset(config, preset);
+    // The benchmark draws single triangles directly, so nothing may be rejected before rasterization.
+    config.cull.backfaceCulling = false;
+    config.cull.depthTest = true;
+    return config;
+}
+
+// Maps a pixel position to the NDC the rasterizer expects, with the framebuffer's y axis pointing down.
+RasterVertex MakePixelVertex(float x, float y, size_t width, size_t height, const glm::vec2& uv) {
+    const float ndcX = x / static_cast<float>(width) * 2.0f - 1.0f;
+    const float ndcY = 1.0f - y / static_cast<float>(height) * 2.0f;
+    RasterVertex vertex{};
+    vertex.position = glm::vec3(ndcX, ndcY, 0.25f);
+    vertex.cullPosition = glm::vec3(ndcX, -ndcY, 0.25f);
+    vertex.worldPosition = glm::vec3(ndcX, ndcY, 0.0f);
+    vertex.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+    vertex.texCoords = uv;
+    vertex.color = glm::vec4(0.8f, 0.6f, 0.4f, 1.0f);
+    vertex.clipW = 1.0f;
+    return vertex;
+}
+
+struct TriangleCase {
+    const char* name;
+    // Corners in units of the framebuffer size, so each shape covers the same share of every preset's resolution.
+    std::array<glm::vec2, 3> corners;
+    // Small triangles are a handful of pixels whatever the resolution; their corners are in pixels instead.
+    bool cornersInPixels = false;
+};
+
+const TriangleCase kTriangles[] = {
+    {"small", {glm::vec2(10.0f, 10.0f), glm::vec2(14.0f, 10.0f), glm::vec2(10.0f, 14.0f)}, true},
+    {"large", {glm::vec2(0.05f, 0.05f), glm::vec2(0.95f, 0.10f), glm::vec2(0.50f, 0.95f)}, false},
+    {"thin", {glm::vec2(0.02f, 0.10f), glm::vec2(0.98f, 0.90f), glm::vec2(0.98f, 0.905f)}, false},
+};
+
+std::array<RasterVertex, 3> MakeTriangle(const TriangleCase& triangle, size_t width, size_t height) {
+    const glm::vec2 scale = triangle.cornersInPixels ? glm::vec2(1.0f) : glm::vec2(static_cast<float>(width), static_cast<float>(height));
+    const std::array<glm::vec2, 3> kUvs = {glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f)};
+    std::array<RasterVertex, 3> vertices{};
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const glm::vec2 pixel = triangle.corners[i] * scale;
+        vertices[i] = MakePixelVertex(pixel.x, pixel.y, width, height, kUvs[i]);
+    }
+    return vertices;
+}
+
+ClipVertex MakeClipVertex(const glm::vec4& clipPosition) {
+    ClipVertex vertex{};
+    vertex.clipPosition = clipPosition;
+    vertex.worldPosition = glm::vec3(clipPosition);
+    vertex.texCoords = glm::vec2(clipPosition.x, clipPosition.y);
+    return vertex;
+}
+
+// Triangles whose depths fall in [minZ, maxZ] relative to w = 1, so the share crossing each plane is controlled.
+std::vector<std::array<ClipVertex, 3>> MakeClipTriangles(size_t count, float minZ, float maxZ) {
+    std::mt19937 rng(0x5EEDu);
+    std::uniform_real_distribution<float> xy(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> z(minZ, maxZ);
+    std::vector<std::array<ClipVertex, 3>> triangles(count);
+    for (auto& triangle : triangles) {
+        for (ClipVertex& vertex : triangle) {
+            vertex = MakeClipVertex(glm::vec4(xy(rng), xy(rng), z(rng), 1.0f));
+        }
+    }
+    return triangles;
+}
+} // namespace
+
+TEST_CASE("Rasterizer DrawTriangle per preset", "[benchmark][rasterizer]") {
+    MaterialManager materialManager;
+    const auto compiledTemplate = materialManager.GetCompiledTemplate(Bench::GetAssetsPath() / kMaterialAssetPhongTextured);
+    REQUIRE(compiledTemplate != nullptr);
+    REQUIRE(compiledTemplate->cacheKey != 0);
+    const std::shared_ptr<const Texture> texture = Bench::MakeGradientTexture(256);
+    const std::vector<LightSnapshot> lights = {LightSnapshot{LightType::POINT, glm::vec3(0.0f, 0.0f, 4.0f), glm::vec3(1.0f), 1.0f}};
+    const glm::vec3 viewPosition(0.0f, 0.0f, 3.0f);
+
+    for (const PresetCase& presetCase : kPresets) {
+        const Config config = MakePresetConfig(presetCase.preset);
+        const size_t width = static_cast<size_t>(std::max(config.renderer.resolution.x, 1));
+        const size_t height = static_cast<size_t>(std::max(config.renderer.resolution.y, 1));
+        const SoftwareMaterialState materialState = Bench::MakeMaterialState(compiledTemplate, texture.get(), config);
+        const RetroPalette::PaletteSnapshot palette = RetroPalette::AcquirePaletteSnapshot(config.retro);
+        texture->EnsureAutoPalette();
+
+        Buffer<Pixel> framebuffer(width, height);
+        Buffer<float> depthBuffer(width, height);
+        for (const TriangleCase& triangleCase : kTriangles) {
+            const std::array<RasterVertex, 3> triangle = MakeTriangle(triangleCase, width, height);
+            BENCHMARK(std::string(presetCase.name) + " " + triangleCase.name + " triangle") {
+                // Clearing depth keeps every iteration shading the same pixels instead of failing the depth test.
+                depthBuffer.Clear(1.0f);
+                std::array<RasterVertex, 3> vertices = triangle;
+                Rasterizer::DrawTriangle(
+                    framebuffer, depthBuffer, vertices, config, lights, materialState, viewPosition, texture.get(), palette.get());
+                return framebuffer.data[0].r;
+            };
+        }
+    }
+}
+
+TEST_CASE("ClipPolygonDepthClipSpace", "[benchmark][rasterizer][clip]") {
+    constexpr size_t kTriangleCount = 4096;
+    const struct {
+        const char* name;
+        float minZ;
+        float maxZ;
+    } kCases[] = {
+        {"inside", -0.9f, 0.9f},
+        {"near plane", -1.6f, 0.4f},
+        {"near and far planes", -1.8f, 1.8f},
+    };
+
+    for (const auto& clipCase : kCases) {
+        const std::vector<std::array<ClipVertex, 3>> triangles = MakeClipTriangles(kTriangleCount, clipCase.minZ, clipCase.maxZ);
+        BENCHMARK(std::string("clip ") + std::to_string(kTriangleCount) + " triangles, " + clipCase.name) {
+            size_t vertexCount = 0;
+            for (const auto& triangle : triangles) {
+                vertexCount += ClipPolygonDepthClipSpace(triangle).count;
+            }
+            return vertexCount;
+        };
+    }
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,114 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "BenchmarkFixtures.h"
+#include "Base/Config.h"
+#include "Renderer/RetroPalette.h"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace RetroRenderer {
+namespace {
+constexpr int kScreenSize = 256;
+
+// Rotated walk over the texture so consecutive samples do not simply stream along a row.
+glm::vec2 RotatedUv(int sx, int sy) {
+    const float u = static_cast<float>(sx) / kScreenSize;
+    const float v = static_cast<float>(sy) / kScreenSize;
+    constexpr float kCos = 0.8660254f;
+    constexpr float kSin = 0.5f;
+    return glm::vec2(u * kCos - v * kSin, u * kSin + v * kCos) * 2.0f;
+}
+} // namespace
+
+TEST_CASE("Texture sampling", "[benchmark][texture]") {
+    for (const int size : {64, 512}) {
+        const std::shared_ptr<const Texture> texture = Bench::MakeGradientTexture(size);
+        const std::string suffix = ", " + std::to_string(size) + "px texture";
+
+        BENCHMARK("nearest repeat" + suffix) {
+            uint32_t checksum = 0;
+            for (int sy = 0; sy < kScreenSize; sy++) {
+                for (int sx = 0; sx < kScreenSize; sx++) {
+                    checksum += texture->SampleNearestRepeat(RotatedUv(sx, sy)).g;
+                }
+            }
+            return checksum;
+        };
+        BENCHMARK("nearest repeat, selected mip" + suffix) {
+            const int mipLevel = texture->SelectMipLevel(std::log2(2.0f / kScreenSize));
+            uint32_t checksum = 0;
+            for (int sy = 0; sy < kScreenSize; sy++) {
+                for (int sx = 0; sx < kScreenSize; sx++) {
+                    checksum += texture->SampleNearestRepeat(RotatedUv(sx, sy), mipLevel).g;
+                }
+            }
+            return checksum;
+        };
+        BENCHMARK("reduced nearest repeat (64px cap)" + suffix) {
+            uint32_t checksum = 0;
+            for (int sy = 0; sy < kScreenSize; sy++) {
+                for (int sx = 0; sx < kScreenSize; sx++) {
+                    checksum += texture->SampleReducedNearestRepeat(RotatedUv(sx, sy), 64).g;
+                }
+            }
+            return checksum;
+        };
+    }
+}
+
+TEST_CASE("RetroPalette lookups", "[benchmark][palette]") {
+    Config::RetroStyleSettings retro{};
+    retro.palette = Config::PaletteType::PICO8;
+    const RetroPalette::PaletteSnapshot palette = RetroPalette::AcquirePaletteSnapshot(retro);
+    REQUIRE(palette != nullptr);
+
+    BENCHMARK("nearest index, full RGB565 sweep") {
+        uint32_t checksum = 0;
+        for (uint32_t value = 0; value < 65536u; value++) {
+            const uint8_t r = static_cast<uint8_t>((value >> 11) << 3);
+            const uint8_t g = static_cast<uint8_t>(((value >> 5) & 0x3Fu) << 2);
+            const uint8_t b = static_cast<uint8_t>((value & 0x1Fu) << 3);
+            checksum += RetroPalette::FindNearestPaletteIndex(r, g, b, *palette);
+        }
+        return checksum;
+    };
+    BENCHMARK("ordered dither, " + std::to_string(kScreenSize) + "x" + std::to_string(kScreenSize)) {
+        uint32_t checksum = 0;
+        for (int sy = 0; sy < kScreenSize; sy++) {
+            for (int sx = 0; sx < kScreenSize; sx++) {
+                const Color color(Color::Uint8Tag{}, static_cast<uint8_t>(sx), static_cast<uint8_t>(sy), 128);
+                checksum += RetroPalette::ApplyOrderedDither4x4(color, glm::ivec2(sx, sy), *palette).g;
+            }
+        }
+        return checksum;
+    };
+    BENCHMARK("ramp pixel, " + std::to_string(kScreenSize) + "x" + std::to_string(kScreenSize)) {
+        uint32_t checksum = 0;
+        for (int sy = 0; sy < kScreenSize; sy++) {
+            for (int sx = 0; sx < kScreenSize; sx++) {
+                const float value = static_cast<float>(sx) / kScreenSize;
+                checksum += RetroPalette::SampleRampPixel(*palette, static_cast<uint8_t>(sy & 0x0F), value).g;
+            }
+        }
+        return checksum;
+    };
+
+    const std::shared_ptr<const Texture> texture = Bench::MakeGradientTexture(128);
+    texture->EnsureAutoPalette();
+    BENCHMARK("texture auto palette nearest index, full RGB565 sweep") {
+        uint32_t checksum = 0;
+        for (uint32_t value = 0; value < 65536u; value++) {
+            const uint8_t r = static_cast<uint8_t>((value >> 11) << 3);
+            const uint8_t g = static_cast<uint8_t>(((value >> 5) & 0x3Fu) << 2);
+            const uint8_t b = static_cast<uint8_t>((value & 0x1Fu) << 3);
+            checksum += texture->FindNearestAutoPaletteIndex(r, g, b);
+        }
+        return checksum;
+    };
+}
+
+} // namespace RetroRenderer
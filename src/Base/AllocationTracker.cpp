@@ -0,0 +1,138 @@
+#include "AllocationTracker.h"
+#include <cstdlib>
+#include <new>
+
+namespace RetroRenderer {
+namespace {
+struct AtomicAllocationCounts {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+// Constant-initialized, so they are usable from operator new before any dynamic initializer has run.
+std::array<AtomicAllocationCounts, kAllocationTagCount> g_CurrentFrame;
+std::array<AtomicAllocationCounts, kAllocationTagCount> g_LastFrame;
+thread_local AllocationTag t_Tag = AllocationTag::UNTAGGED;
+
+constexpr const char* kAllocationTagNames[kAllocationTagCount] = {
+    "untagged",
+    "scene",
+    "render packet",
+    "render system",
+    "software renderer",
+    "ui",
+    "presentation",
+};
+
+void Publish(AtomicAllocationCounts& from, AtomicAllocationCounts& to) {
+    to.allocations.store(from.allocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    to.deallocations.store(from.deallocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    to.bytes.store(from.bytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+}
+} // namespace
+
+const char* GetAllocationTagName(AllocationTag tag) {
+    const size_t index = static_cast<size_t>(tag);
+    return index < kAllocationTagCount ? kAllocationTagNames[index] : "unknown";
+}
+
+AllocationCounts AllocationFrameReport::Total() const {
+    AllocationCounts total{};
+    for (const AllocationCounts& counts : tags) {
+        total.allocations += counts.allocations;
+        total.deallocations += counts.deallocations;
+        total.bytes += counts.bytes;
+    }
+    return total;
+}
+
+void AllocationTracker::SetEnabled(bool enabled) {
+    s_Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void AllocationTracker::EndFrame() {
+    for (size_t tag = 0; tag < kAllocationTagCount; tag++) {
+        Publish(g_CurrentFrame[tag], g_LastFrame[tag]);
+    }
+}
+
+AllocationFrameReport AllocationTracker::GetLastFrame() {
+    AllocationFrameReport report{};
+    for (size_t tag = 0; tag < kAllocationTagCount; tag++) {
+        report.tags[tag].allocations = g_LastFrame[tag].allocations.load(std::memory_order_relaxed);
+        report.tags[tag].deallocations = g_LastFrame[tag].deallocations.load(std::memory_order_relaxed);
+        report.tags[tag].bytes = g_LastFrame[tag].bytes.load(std::memory_order_relaxed);
+    }
+    return report;
+}
+
+AllocationTag AllocationTracker::GetThreadTag() {
+    return t_Tag;
+}
+
+void AllocationTracker::SetThreadTag(AllocationTag tag) {
+    t_Tag = tag;
+}
+
+void AllocationTracker::RecordAllocation(size_t bytes) {
+    if (!IsEnabled()) {
+        return;
+    }
+    AtomicAllocationCounts& counts = g_CurrentFrame[static_cast<size_t>(t_Tag)];
+    counts.allocations.fetch_add(1, std::memory_order_relaxed);
+    counts.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocationTracker::RecordDeallocation() {
+    if (!IsEnabled()) {
+        return;
+    }
+    g_CurrentFrame[static_cast<size_t>(t_Tag)].deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace RetroRenderer
+
+#if RETRO_ALLOCATION_TRACKING
+// Replacing the throwing scalar and array forms is enough: the standard library's nothrow forms forward to them and
+// its sized deletes forward to the unsized ones. Over-aligned forms keep their default implementations.
+void* operator new(std::size_t size) {
+    const std::size_t requested = size != 0 ? size : 1;
+    void* pointer = std::malloc(requested);
+    // As the standard operator new does: give an installed new_handler the chance to free memory and retry.
+    while (pointer == nullptr) {
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+        pointer = std::malloc(requested);
+    }
+    RetroRenderer::AllocationTracker::RecordAllocation(size);
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    RetroRenderer::AllocationTracker::RecordDeallocation();
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    ::operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    ::operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    ::operator delete(pointer);
+}
+#endif
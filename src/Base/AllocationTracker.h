@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Only builds with -DRETRO_ALLOCATION_TRACKING=1 replace the global operator new/delete; everything else keeps the
+// default allocator and compiles every RETRO_ALLOCATION_TAG away.
+#ifndef RETRO_ALLOCATION_TRACKING
+#define RETRO_ALLOCATION_TRACKING 0
+#endif
+
+namespace RetroRenderer {
+
+// Subsystem a heap allocation is charged to; set per thread with RETRO_ALLOCATION_TAG.
+enum class AllocationTag : uint8_t {
+    UNTAGGED,
+    SCENE,
+    RENDER_PACKET,
+    RENDER_SYSTEM,
+    SOFTWARE_RENDERER,
+    UI,
+    PRESENTATION,
+    COUNT,
+};
+
+inline constexpr size_t kAllocationTagCount = static_cast<size_t>(AllocationTag::COUNT);
+
+const char* GetAllocationTagName(AllocationTag tag);
+
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    // Requested bytes of the allocations; frees are not sized.
+    uint64_t bytes = 0;
+};
+
+struct AllocationFrameReport {
+    std::array<AllocationCounts, kAllocationTagCount> tags{};
+
+    [[nodiscard]] AllocationCounts Total() const;
+    [[nodiscard]] const AllocationCounts& operator[](AllocationTag tag) const {
+        return tags[static_cast<size_t>(tag)];
+    }
+};
+
+// Counts C++ heap traffic (global operator new/delete) per frame and tag. Allocations made through malloc directly
+// (SDL, ImGui's allocator) are not seen. While tracking is off each new/delete costs one relaxed atomic load on top
+// of malloc/free.
+class AllocationTracker {
+  public:
+    [[nodiscard]] static bool IsEnabled() {
+        return s_Enabled.load(std::memory_order_relaxed);
+    }
+    static void SetEnabled(bool enabled);
+
+    // Publishes the counts since the previous call as the last frame's report and starts counting a new frame.
+    static void EndFrame();
+    [[nodiscard]] static AllocationFrameReport GetLastFrame();
+
+    [[nodiscard]] static AllocationTag GetThreadTag();
+    static void SetThreadTag(AllocationTag tag);
+
+    // Called from the operator new/delete replacements.
+    static void RecordAllocation(size_t bytes);
+    static void RecordDeallocation();
+
+  private:
+    static inline std::atomic<bool> s_Enabled{false};
+};
+
+class AllocationTagScope {
+  public:
+    explicit AllocationTagScope(AllocationTag tag) : m_PreviousTag(AllocationTracker::GetThreadTag()) {
+        AllocationTracker::SetThreadTag(tag);
+    }
+    ~AllocationTagScope() {
+        AllocationTracker::SetThreadTag(m_PreviousTag);
+    }
+    AllocationTagScope(const AllocationTagScope&) = delete;
+    AllocationTagScope& operator=(const AllocationTagScope&) = delete;
+
+  private:
+    AllocationTag m_PreviousTag;
+};
+
+} // namespace RetroRenderer
+
+#define RETRO_ALLOCATION_TAG_CONCAT_INNER(a, b) a##b
+#define RETRO_ALLOCATION_TAG_CONCAT(a, b) RETRO_ALLOCATION_TAG_CONCAT_INNER(a, b)
+#if RETRO_ALLOCATION_TRACKING
+#define RETRO_ALLOCATION_TAG(tag)                                                                                  \
+    const ::RetroRenderer::AllocationTagScope RETRO_ALLOCATION_TAG_CONCAT(retroAllocationTag_, __LINE__)(          \
+        ::RetroRenderer::AllocationTag::tag)
+#else
+#define RETRO_ALLOCATION_TAG(tag) static_cast<void>(0)
+#endif
@@ -122,6 +122,7 @@ struct Config {
         bool rasterClip = true;
         bool geometricClip = true;
         bool frustumCull = true;
+        bool occlusionCull = true;
     };
 
     // Rasterizer
@@ -155,6 +156,9 @@ struct Config {
         RasterizationLineMode lineMode = RasterizationLineMode::BRESENHAM;
         RasterizationPolygonMode polygonMode = RasterizationPolygonMode::FILL;
         RasterizationFillMode fillMode = RasterizationFillMode::SCANLINE;
+        bool mipmapping = true; // Sample textures from the mip level matching each triangle's UV density
+        bool collectCounters = false; // Count triangles and pixels per frame (Stats::lastSoftwareRaster*)
+        bool overdrawHeatmap = false; // Replace the image with a heatmap of framebuffer writes per pixel
     };
 
     struct GLRasterizerSettings {
@@ -169,6 +173,10 @@ struct Config {
     struct GLSpecifics {
         GLRasterizerSettings rasterizer;
         GLTextureSampling textureSampling = GLTextureSampling::FILTERED_MIPS;
+        // Combined GPU texture + mesh cache budget. While over it, entries unused for residencyIdleFrames frames are
+        // evicted least recently used first and re-uploaded on next use. 0 disables eviction.
+        int residencyBudgetMiB = 512;
+        int residencyIdleFrames = 120;
     };
 
     struct RetroStyleSettings {
@@ -211,6 +219,12 @@ struct Config {
         Color fogColor = Color(Color::Uint8Tag{}, 0x60, 0x70, 0x88);
     };
 
+    struct DiagnosticsSettings {
+        float memorySampleRateHz = 4.0f; // Background process-memory samples per second
+        bool trackAllocations = false;   // Count operator new/delete per frame and subsystem (AllocationTracker)
+        bool capturePackets = false;     // Append each frame's RenderPacket to a replay capture (RenderPacketCapture)
+    };
+
     // Shared between rendering modes
     WindowSettings window;
     EnvironmentSettings environment;
@@ -220,6 +234,7 @@ struct Config {
     SoftwareSpecifics software;
     GLSpecifics gl;
     RetroStyleSettings retro;
+    DiagnosticsSettings diagnostics;
 
     static glm::ivec2 MakeAspectAwareResolution(const glm::ivec2& windowSize, int targetHeight) {
         const int safeWidth = std::max(windowSize.x, 1);
@@ -288,9 +303,11 @@ struct Config {
         config.cull.rasterClip = true;
         config.cull.geometricClip = true;
         config.cull.frustumCull = true;
+        config.cull.occlusionCull = true;
 
         config.software.rasterizer.polygonMode = RasterizationPolygonMode::FILL;
         config.software.rasterizer.fillMode = RasterizationFillMode::SCANLINE;
+        config.software.rasterizer.mipmapping = true;
         config.gl.rasterizer.polygonMode = RasterizationPolygonMode::FILL;
         config.gl.textureSampling = GLTextureSampling::FILTERED_MIPS;
 
@@ -351,6 +368,7 @@ struct Config {
             config.environment.shadowMap = false;
             config.cull.backfaceCulling = true;
             config.software.rasterizer.fillMode = RasterizationFillMode::BARYCENTRIC;
+            config.software.rasterizer.mipmapping = false;
             config.retro.useStableUntexturedBaseColor = true;
             config.retro.untexturedBaseColor = Color(Color::Uint8Tag{}, 0xB8, 0xB4, 0xAC);
             config.retro.textureMaxDimension = 64;
@@ -1,5 +1,6 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <filesystem>
 #include <string>
 #include <utility>
 #include <vector>
@@ -11,6 +12,8 @@ enum class EventType {
     Scene_Load,
     Scene_Reset,
     Texture_Load,
+    Animation_Export,
+    Animation_ExportCancel,
 };
 
 static constexpr const char* EventTypeToString(EventType type) {
@@ -25,6 +28,10 @@ static constexpr const char* EventTypeToString(EventType type) {
         return "Texture_Load";
     case EventType::Scene_Reset:
         return "Scene_Reset";
+    case EventType::Animation_Export:
+        return "Animation_Export";
+    case EventType::Animation_ExportCancel:
+        return "Animation_ExportCancel";
     default:
         return "Unknown";
     }
@@ -90,4 +97,21 @@ struct SceneResetEvent : public Event {
         type = EventType::Scene_Reset;
     }
 };
+
+struct AnimationExportEvent : public Event {
+    std::filesystem::path outputDirectory;
+    bool writePng = true;
+
+    AnimationExportEvent(std::filesystem::path directory, bool png = true) {
+        type = EventType::Animation_Export;
+        outputDirectory = std::move(directory);
+        writePng = png;
+    }
+};
+
+struct AnimationExportCancelEvent : public Event {
+    AnimationExportCancelEvent() {
+        type = EventType::Animation_ExportCancel;
+    }
+};
 } // namespace RetroRenderer
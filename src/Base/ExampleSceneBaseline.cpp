@@ -299,4 +299,40 @@ bool LoadExampleSceneBaselineForScene(const std::filesystem::path& scenePath,
     return foundAnyBaseline;
 }
 
+bool LoadExampleSceneBaselineFile(const std::filesystem::path& baselinePath,
+                                  ExampleSceneBaseline& outBaseline,
+                                  std::vector<std::string>* warnings) {
+    outBaseline = {};
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(baselinePath, ec)) {
+        AddWarning(warnings, baselinePath.generic_string() + ": file not found");
+        return false;
+    }
+
+    std::vector<std::string> parseWarnings;
+    ParseExampleSceneBaselineText(ReadTextFile(baselinePath), outBaseline, &parseWarnings);
+    for (const std::string& warning : parseWarnings) {
+        AddWarning(warnings, baselinePath.generic_string() + ": " + warning);
+    }
+    return true;
+}
+
+void ApplyExampleSceneBaselineToConfig(const ExampleSceneBaseline& baseline, Config& config) {
+    if (baseline.showSkybox.has_value()) {
+        config.environment.showSkybox = *baseline.showSkybox;
+    }
+    if (baseline.backfaceCulling.has_value()) {
+        config.cull.backfaceCulling = *baseline.backfaceCulling;
+    }
+    if (baseline.perspectiveCorrect.has_value()) {
+        config.renderer.enablePerspectiveCorrect = *baseline.perspectiveCorrect;
+    }
+    if (baseline.glTextureSampling.has_value()) {
+        config.gl.textureSampling = *baseline.glTextureSampling;
+    }
+    if (baseline.lightPosition.has_value()) {
+        config.environment.lightPosition = *baseline.lightPosition;
+    }
+}
+
 } // namespace RetroRenderer
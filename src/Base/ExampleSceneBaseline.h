@@ -40,4 +40,12 @@ bool LoadExampleSceneBaselineForScene(const std::filesystem::path& scenePath,
                                       std::vector<std::string>* warnings = nullptr,
                                       std::vector<std::filesystem::path>* matchedFiles = nullptr);
 
+// Reads a single baseline file, without the directory walk of LoadExampleSceneBaselineForScene.
+bool LoadExampleSceneBaselineFile(const std::filesystem::path& baselinePath,
+                                  ExampleSceneBaseline& outBaseline,
+                                  std::vector<std::string>* warnings = nullptr);
+
+// Applies the config-level overrides. Material template and camera type need the scene and are applied by the caller.
+void ApplyExampleSceneBaselineToConfig(const ExampleSceneBaseline& baseline, Config& config);
+
 } // namespace RetroRenderer
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+namespace RetroRenderer {
+
+// Time fed to material stages. Real-time clocks follow the frame deltas the main loop measures; fixed-step clocks
+// advance by a constant step per frame, so offline export, headless and perf runs render the same images on every
+// machine regardless of how long each frame took.
+class FrameClock {
+  public:
+    static FrameClock RealTime() {
+        return FrameClock(0.0);
+    }
+    static FrameClock FixedStep(double stepSeconds) {
+        return FrameClock(stepSeconds > 0.0 ? stepSeconds : 0.0);
+    }
+
+    // Advances by one frame; realDeltaMs is ignored by fixed-step clocks.
+    void Tick(uint32_t realDeltaMs) {
+        m_FrameIndex++;
+        if (!IsFixedStep()) {
+            m_RealTimeMs += realDeltaMs;
+        }
+    }
+    void Reset() {
+        m_FrameIndex = 0;
+        m_RealTimeMs = 0;
+    }
+
+    [[nodiscard]] bool IsFixedStep() const {
+        return m_StepSeconds > 0.0;
+    }
+    [[nodiscard]] uint64_t GetFrameIndex() const {
+        return m_FrameIndex;
+    }
+    [[nodiscard]] float GetSeconds() const {
+        // Derived from the frame index rather than accumulated, so long runs do not drift.
+        return IsFixedStep() ? static_cast<float>(static_cast<double>(m_FrameIndex) * m_StepSeconds)
+                             : static_cast<float>(static_cast<double>(m_RealTimeMs) / 1000.0);
+    }
+
+  private:
+    explicit FrameClock(double stepSeconds) : m_StepSeconds(stepSeconds) {
+    }
+
+    double m_StepSeconds = 0.0;
+    uint64_t m_FrameIndex = 0;
+    uint64_t m_RealTimeMs = 0;
+};
+
+} // namespace RetroRenderer
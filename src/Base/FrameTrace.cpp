@@ -0,0 +1,221 @@
+#include "FrameTrace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RetroRenderer {
+namespace {
+using TimingClock = std::chrono::steady_clock;
+
+// Fields are atomics so the dump can read slots the owning thread is rewriting without a data race; torn slots are
+// detected through the write index and dropped.
+struct TraceEventSlot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> startNs{0};
+    std::atomic<uint64_t> durationNs{0};
+};
+
+struct ThreadTraceBuffer {
+    uint32_t threadId = 0;
+    // Guarded by TraceRegistry::mutex.
+    const char* threadName = nullptr;
+    std::atomic<bool> attached{true};
+    // Only the owning thread writes; readers use acquire loads.
+    std::atomic<uint64_t> writeIndex{0};
+    std::atomic<uint64_t> clearedIndex{0};
+    std::unique_ptr<TraceEventSlot[]> slots = std::make_unique<TraceEventSlot[]>(FrameTrace::kEventsPerThread);
+};
+
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadTraceBuffer>> buffers;
+    uint32_t nextThreadId = 1;
+    const TimingClock::time_point epoch = TimingClock::now();
+};
+
+TraceRegistry& GetRegistry() {
+    static TraceRegistry registry;
+    return registry;
+}
+
+// Releases the buffer for reuse by a later thread when this one exits. Its zones stay in the dump.
+struct ThreadBufferHandle {
+    ThreadTraceBuffer* buffer = nullptr;
+    const char* threadName = nullptr;
+
+    ~ThreadBufferHandle() {
+        if (buffer != nullptr) {
+            buffer->attached.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadBufferHandle t_BufferHandle;
+
+ThreadTraceBuffer& AcquireThreadBuffer() {
+    TraceRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    ThreadTraceBuffer* buffer = nullptr;
+    for (const std::unique_ptr<ThreadTraceBuffer>& candidate : registry.buffers) {
+        if (!candidate->attached.load(std::memory_order_acquire)) {
+            buffer = candidate.get();
+            buffer->attached.store(true, std::memory_order_relaxed);
+            break;
+        }
+    }
+    if (buffer == nullptr) {
+        registry.buffers.push_back(std::make_unique<ThreadTraceBuffer>());
+        buffer = registry.buffers.back().get();
+        buffer->threadId = registry.nextThreadId++;
+    }
+    buffer->threadName = t_BufferHandle.threadName;
+    t_BufferHandle.buffer = buffer;
+    return *buffer;
+}
+
+struct CopiedTraceEvent {
+    const char* name = nullptr;
+    uint64_t startNs = 0;
+    uint64_t durationNs = 0;
+};
+
+void CopyThreadEvents(const ThreadTraceBuffer& buffer, std::vector<CopiedTraceEvent>& outEvents) {
+    constexpr uint64_t capacity = FrameTrace::kEventsPerThread;
+    const uint64_t end = buffer.writeIndex.load(std::memory_order_acquire);
+    const uint64_t begin = std::max(buffer.clearedIndex.load(std::memory_order_relaxed),
+                                    end > capacity ? end - capacity : 0);
+    const size_t firstCopied = outEvents.size();
+    for (uint64_t index = begin; index < end; index++) {
+        const TraceEventSlot& slot = buffer.slots[index % capacity];
+        outEvents.push_back(CopiedTraceEvent{
+            slot.name.load(std::memory_order_relaxed),
+            slot.startNs.load(std::memory_order_relaxed),
+            slot.durationNs.load(std::memory_order_relaxed),
+        });
+    }
+
+    // Anything the owner wrote meanwhile may have overwritten the oldest copied slots, including the slot it is
+    // writing right now, so only indices past after - capacity are trusted.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = buffer.writeIndex.load(std::memory_order_relaxed);
+    const uint64_t trustedBegin = after + 1 > capacity ? after + 1 - capacity : 0;
+    if (trustedBegin > begin) {
+        const size_t dropped = static_cast<size_t>(std::min(trustedBegin - begin, end - begin));
+        outEvents.erase(outEvents.begin() + static_cast<std::ptrdiff_t>(firstCopied),
+                        outEvents.begin() + static_cast<std::ptrdiff_t>(firstCopied + dropped));
+    }
+}
+
+void WriteJsonString(std::ostream& output, const char* text) {
+    output << '"';
+    for (const char* c = text; *c != '\0'; c++) {
+        const unsigned char value = static_cast<unsigned char>(*c);
+        if (value == '"' || value == '\\') {
+            output << '\\' << *c;
+        } else if (value < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", value);
+            output << escaped;
+        } else {
+            output << *c;
+        }
+    }
+    output << '"';
+}
+
+void WriteMicroseconds(std::ostream& output, uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", static_cast<double>(ns) / 1000.0);
+    output << text;
+}
+} // namespace
+
+void FrameTrace::SetEnabled(bool enabled) {
+    s_Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void FrameTrace::Clear() {
+    TraceRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const std::unique_ptr<ThreadTraceBuffer>& buffer : registry.buffers) {
+        buffer->clearedIndex.store(buffer->writeIndex.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void FrameTrace::SetThreadName(const char* name) {
+    t_BufferHandle.threadName = name;
+    if (t_BufferHandle.buffer != nullptr) {
+        TraceRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        t_BufferHandle.buffer->threadName = name;
+    }
+}
+
+uint64_t FrameTrace::NowNanoseconds() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(TimingClock::now() - GetRegistry().epoch).count());
+}
+
+void FrameTrace::RecordZone(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadTraceBuffer& buffer = t_BufferHandle.buffer != nullptr ? *t_BufferHandle.buffer : AcquireThreadBuffer();
+    const uint64_t index = buffer.writeIndex.load(std::memory_order_relaxed);
+    TraceEventSlot& slot = buffer.slots[index % kEventsPerThread];
+    // Pairs with the acquire fence in CopyThreadEvents: a reader that sees any of these stores also sees writeIndex
+    // at `index`, and so knows the slot may be torn.
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(endNs >= startNs ? endNs - startNs : 0, std::memory_order_relaxed);
+    buffer.writeIndex.store(index + 1, std::memory_order_release);
+}
+
+bool FrameTrace::WriteChromeTrace(const std::filesystem::path& path, std::string& outErrorMessage) {
+    std::ofstream output(path, std::ios::trunc);
+    if (!output) {
+        outErrorMessage = "Could not write trace " + path.generic_string() + ".";
+        return false;
+    }
+
+    output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    output << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"RetroRenderer\"}}";
+
+    TraceRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<CopiedTraceEvent> events;
+    for (const std::unique_ptr<ThreadTraceBuffer>& buffer : registry.buffers) {
+        char threadLabel[32];
+        std::snprintf(threadLabel, sizeof(threadLabel), "thread %u", buffer->threadId);
+        output << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+               << ",\"args\":{\"name\":";
+        WriteJsonString(output, buffer->threadName != nullptr ? buffer->threadName : threadLabel);
+        output << "}}";
+
+        events.clear();
+        CopyThreadEvents(*buffer, events);
+        for (const CopiedTraceEvent& event : events) {
+            if (event.name == nullptr) {
+                continue;
+            }
+            output << ",\n{\"name\":";
+            WriteJsonString(output, event.name);
+            output << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+            WriteMicroseconds(output, event.startNs);
+            output << ",\"dur\":";
+            WriteMicroseconds(output, event.durationNs);
+            output << "}";
+        }
+    }
+    output << "\n]}\n";
+
+    if (!output) {
+        outErrorMessage = "Failed while writing trace " + path.generic_string() + ".";
+        return false;
+    }
+    return true;
+}
+
+} // namespace RetroRenderer
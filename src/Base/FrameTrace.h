@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Builds with -DRETRO_TRACE_ZONES=0 compile every RETRO_TRACE_ZONE away.
+#ifndef RETRO_TRACE_ZONES
+#define RETRO_TRACE_ZONES 1
+#endif
+
+namespace RetroRenderer {
+
+// Scoped timing zones for the frame pipeline, dumped as a Chrome trace (chrome://tracing, ui.perfetto.dev). Each
+// thread appends to its own fixed-size ring buffer without locks, so the oldest zones are overwritten once a thread
+// has recorded more than kEventsPerThread of them. While recording is off a zone costs one relaxed atomic load.
+class FrameTrace {
+  public:
+    static constexpr size_t kEventsPerThread = size_t{1} << 15;
+
+    [[nodiscard]] static bool IsEnabled() {
+        return s_Enabled.load(std::memory_order_relaxed);
+    }
+    static void SetEnabled(bool enabled);
+    // Drops every zone recorded so far; threads keep their buffers.
+    static void Clear();
+
+    // `name` must outlive the trace (a string literal); it labels the calling thread's lane in the viewer.
+    static void SetThreadName(const char* name);
+
+    [[nodiscard]] static uint64_t NowNanoseconds();
+    // `name` must be a string literal; only the pointer is stored.
+    static void RecordZone(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Safe to call while other threads are recording; zones overwritten during the copy are skipped.
+    static bool WriteChromeTrace(const std::filesystem::path& path, std::string& outErrorMessage);
+
+  private:
+    static inline std::atomic<bool> s_Enabled{false};
+};
+
+class TraceZone {
+  public:
+    explicit TraceZone(const char* name)
+        : m_Name(FrameTrace::IsEnabled() ? name : nullptr),
+          m_StartNs(m_Name != nullptr ? FrameTrace::NowNanoseconds() : 0) {
+    }
+    ~TraceZone() {
+        if (m_Name != nullptr) {
+            FrameTrace::RecordZone(m_Name, m_StartNs, FrameTrace::NowNanoseconds());
+        }
+    }
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+  private:
+    const char* m_Name;
+    uint64_t m_StartNs;
+};
+
+} // namespace RetroRenderer
+
+#define RETRO_TRACE_CONCAT_INNER(a, b) a##b
+#define RETRO_TRACE_CONCAT(a, b) RETRO_TRACE_CONCAT_INNER(a, b)
+#if RETRO_TRACE_ZONES
+#define RETRO_TRACE_ZONE(name) const ::RetroRenderer::TraceZone RETRO_TRACE_CONCAT(retroTraceZone_, __LINE__)(name)
+#else
+#define RETRO_TRACE_ZONE(name) static_cast<void>(0)
+#endif
@@ -8,12 +8,58 @@
 #include <mach/mach.h>
 #include <sys/resource.h>
 #elif defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 #include <string>
 #endif
 
 namespace RetroRenderer {
+namespace {
+#if defined(__linux__)
+bool ReadStatmResidentBytes(uint64_t& outBytes) {
+    // procfs regenerates the file on every read from offset 0, so one descriptor serves every sample.
+    static const int statmFd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    static const long pageSize = sysconf(_SC_PAGESIZE);
+    if (statmFd < 0 || pageSize <= 0) {
+        return false;
+    }
+    char text[128];
+    const ssize_t length = pread(statmFd, text, sizeof(text) - 1, 0);
+    if (length <= 0) {
+        return false;
+    }
+    text[length] = '\0';
+
+    // "size resident shared text lib data dt", all in pages.
+    char* cursor = text;
+    std::strtoull(cursor, &cursor, 10);
+    char* residentEnd = nullptr;
+    const unsigned long long residentPages = std::strtoull(cursor, &residentEnd, 10);
+    if (residentEnd == cursor) {
+        return false;
+    }
+    outBytes = static_cast<uint64_t>(residentPages) * static_cast<uint64_t>(pageSize);
+    return true;
+}
+#endif
+} // namespace
+
+bool MemoryProfiler::SampleResidentBytes(uint64_t& outResidentBytes) {
+#if defined(__linux__)
+    return ReadStatmResidentBytes(outResidentBytes);
+#else
+    const ProcessMemorySnapshot snapshot = SampleProcessMemory();
+    if (!snapshot.supported || snapshot.residentBytes == 0) {
+        return false;
+    }
+    outResidentBytes = snapshot.residentBytes;
+    return true;
+#endif
+}
+
 ProcessMemorySnapshot MemoryProfiler::SampleProcessMemory() {
     ProcessMemorySnapshot snapshot{};
 
@@ -43,6 +89,10 @@ ProcessMemorySnapshot MemoryProfiler::SampleProcessMemory() {
         snapshot.supported = true;
     }
 #elif defined(__linux__)
+    if (ReadStatmResidentBytes(snapshot.residentBytes)) {
+        snapshot.supported = true;
+    }
+    // The peak (VmHWM) is only reported in the slower, line-oriented status file.
     std::ifstream status("/proc/self/status");
     if (status.is_open()) {
         std::string line;
@@ -66,7 +116,7 @@ ProcessMemorySnapshot MemoryProfiler::SampleProcessMemory() {
             };
 
             uint64_t parsedBytes = 0;
-            if (parseStatusKb("VmRSS:", parsedBytes)) {
+            if (snapshot.residentBytes == 0 && parseStatusKb("VmRSS:", parsedBytes)) {
                 snapshot.residentBytes = parsedBytes;
                 snapshot.supported = true;
                 continue;
@@ -13,6 +13,9 @@ struct ProcessMemorySnapshot {
 class MemoryProfiler {
   public:
     static ProcessMemorySnapshot SampleProcessMemory();
+    // Resident set only. On Linux this is a single pread of /proc/self/statm through a descriptor kept open for the
+    // life of the process, with no allocation; elsewhere it costs the same as SampleProcessMemory.
+    static bool SampleResidentBytes(uint64_t& outResidentBytes);
 };
 
 } // namespace RetroRenderer
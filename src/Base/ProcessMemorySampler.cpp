@@ -0,0 +1,78 @@
+#include "ProcessMemorySampler.h"
+#include "FrameTrace.h"
+#include "MemoryProfiler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace RetroRenderer {
+
+ProcessMemorySampler::~ProcessMemorySampler() {
+    Stop();
+}
+
+void ProcessMemorySampler::Start(std::shared_ptr<Stats> stats, float rateHz) {
+    Stop();
+    p_Stats = std::move(stats);
+    if (!p_Stats) {
+        return;
+    }
+    SetRateHz(rateHz);
+    Sample(true);
+#if !defined(__EMSCRIPTEN__)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_StopRequested = false;
+    }
+    m_Thread = std::thread([this]() { Run(); });
+#endif
+}
+
+void ProcessMemorySampler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_StopRequested = true;
+    }
+    m_Cv.notify_all();
+    if (m_Thread.joinable()) {
+        m_Thread.join();
+    }
+}
+
+void ProcessMemorySampler::SetRateHz(float rateHz) {
+    m_RateHz.store(std::clamp(rateHz, kMinRateHz, kMaxRateHz), std::memory_order_relaxed);
+}
+
+void ProcessMemorySampler::Run() {
+    FrameTrace::SetThreadName("memory sampler");
+    uint64_t tick = 1;
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (true) {
+        const auto interval = std::chrono::duration<float>(1.0f / m_RateHz.load(std::memory_order_relaxed));
+        if (m_Cv.wait_for(lock, interval, [this]() { return m_StopRequested; })) {
+            return;
+        }
+        lock.unlock();
+        Sample(tick % kPeakRefreshTicks == 0);
+        tick++;
+        lock.lock();
+    }
+}
+
+void ProcessMemorySampler::Sample(bool refreshPeak) {
+    RETRO_TRACE_ZONE("ProcessMemorySampler::Sample");
+    if (refreshPeak) {
+        const ProcessMemorySnapshot snapshot = MemoryProfiler::SampleProcessMemory();
+        if (snapshot.supported) {
+            p_Stats->UpdateProcessMemory(snapshot.residentBytes, snapshot.peakResidentBytes);
+            m_SampleCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+    uint64_t residentBytes = 0;
+    if (MemoryProfiler::SampleResidentBytes(residentBytes)) {
+        p_Stats->UpdateProcessMemory(residentBytes, 0);
+        m_SampleCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Stats.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace RetroRenderer {
+
+// Samples process memory on a background thread and publishes it into Stats, keeping /proc reads and their
+// allocations off the frame loop. Each tick takes the cheap resident-set path; the OS peak, which needs the slower
+// full sample, is refreshed every kPeakRefreshTicks ticks. Builds without threads (Emscripten) never start sampling.
+class ProcessMemorySampler {
+  public:
+    static constexpr float kDefaultRateHz = 4.0f;
+    static constexpr float kMinRateHz = 0.1f;
+    static constexpr float kMaxRateHz = 60.0f;
+    static constexpr uint64_t kPeakRefreshTicks = 8;
+
+    ProcessMemorySampler() = default;
+    ~ProcessMemorySampler();
+    ProcessMemorySampler(const ProcessMemorySampler&) = delete;
+    ProcessMemorySampler& operator=(const ProcessMemorySampler&) = delete;
+
+    // Takes one sample before returning, so Stats is populated as soon as Start succeeds.
+    void Start(std::shared_ptr<Stats> stats, float rateHz = kDefaultRateHz);
+    void Stop();
+    // Clamped to [kMinRateHz, kMaxRateHz]; cheap enough to call every frame with the configured rate.
+    void SetRateHz(float rateHz);
+    [[nodiscard]] float GetRateHz() const {
+        return m_RateHz.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] uint64_t GetSampleCount() const {
+        return m_SampleCount.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void Run();
+    void Sample(bool refreshPeak);
+
+    std::shared_ptr<Stats> p_Stats;
+    std::atomic<float> m_RateHz{kDefaultRateHz};
+    std::atomic<uint64_t> m_SampleCount{0};
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    bool m_StopRequested = false;
+    std::thread m_Thread;
+};
+
+} // namespace RetroRenderer
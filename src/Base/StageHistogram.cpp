@@ -0,0 +1,106 @@
+#include "StageHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace RetroRenderer {
+namespace {
+uint64_t PercentileFromBuckets(const std::array<uint32_t, StageHistogram::kBucketCount>& counts,
+                               uint64_t total,
+                               double fraction) {
+    // Nearest rank, as in the perf-regression metrics.
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total))));
+    uint64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < counts.size(); bucket++) {
+        cumulative += counts[bucket];
+        if (cumulative >= rank) {
+            return StageHistogram::BucketUpperBound(bucket);
+        }
+    }
+    return StageHistogram::BucketUpperBound(counts.size() - 1);
+}
+} // namespace
+
+StageHistogram::StageHistogram(size_t windowSize)
+    : m_WindowSize(std::max<size_t>(windowSize, 1)),
+      m_Window(std::make_unique<std::atomic<uint64_t>[]>(m_WindowSize)) {
+}
+
+void StageHistogram::Record(uint64_t ns) {
+    m_LastNs.store(ns, std::memory_order_relaxed);
+    if (ns == 0) {
+        return;
+    }
+
+    // The new sample is counted before it becomes visible in the window, so whoever later evicts it always finds
+    // its bucket already incremented.
+    m_BucketCounts[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    const uint64_t slot = m_NextSlot.fetch_add(1, std::memory_order_relaxed) % m_WindowSize;
+    const uint64_t evicted = m_Window[slot].exchange(ns, std::memory_order_acq_rel);
+    if (evicted != 0) {
+        m_BucketCounts[BucketIndex(evicted)].fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+StageTimingSummary StageHistogram::Summarize(uint64_t budgetNs) const {
+    StageTimingSummary summary{};
+    uint64_t minNs = std::numeric_limits<uint64_t>::max();
+    for (size_t slot = 0; slot < m_WindowSize; slot++) {
+        const uint64_t sample = m_Window[slot].load(std::memory_order_acquire);
+        if (sample == 0) {
+            continue;
+        }
+        summary.sampleCount++;
+        minNs = std::min(minNs, sample);
+        summary.maxNs = std::max(summary.maxNs, sample);
+        if (budgetNs > 0 && sample > budgetNs) {
+            summary.overBudgetCount++;
+        }
+    }
+    if (summary.sampleCount == 0) {
+        return summary;
+    }
+    summary.minNs = minNs;
+
+    std::array<uint32_t, kBucketCount> counts{};
+    uint64_t total = 0;
+    for (size_t bucket = 0; bucket < kBucketCount; bucket++) {
+        // Record counts a sample before it enters the window, so a concurrent call can only over-count briefly.
+        counts[bucket] = m_BucketCounts[bucket].load(std::memory_order_relaxed);
+        total += counts[bucket];
+    }
+    if (total == 0) {
+        return summary;
+    }
+    // Bucket bounds are coarser than the exact extremes, so keep percentiles inside [min, max].
+    const auto clampToRange = [&summary](uint64_t value) {
+        return std::clamp(value, summary.minNs, summary.maxNs);
+    };
+    summary.medianNs = clampToRange(PercentileFromBuckets(counts, total, 0.50));
+    summary.p95Ns = clampToRange(PercentileFromBuckets(counts, total, 0.95));
+    summary.p99Ns = clampToRange(PercentileFromBuckets(counts, total, 0.99));
+    return summary;
+}
+
+size_t StageHistogram::BucketIndex(uint64_t ns) {
+    const uint64_t value = std::min(ns, kMaxTrackableNs);
+    if (value < kSubBucketCount) {
+        return static_cast<size_t>(value);
+    }
+    const uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - 1 - kSubBucketBits;
+    const uint64_t subBucket = (value >> shift) - kSubBucketCount;
+    return kSubBucketCount + static_cast<size_t>(shift) * kSubBucketCount + static_cast<size_t>(subBucket);
+}
+
+uint64_t StageHistogram::BucketUpperBound(size_t bucketIndex) {
+    if (bucketIndex < kSubBucketCount) {
+        return bucketIndex;
+    }
+    const size_t offset = bucketIndex - kSubBucketCount;
+    const uint32_t shift = static_cast<uint32_t>(offset / kSubBucketCount);
+    const uint64_t subBucket = offset % kSubBucketCount;
+    return ((kSubBucketCount + subBucket + 1) << shift) - 1;
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace RetroRenderer {
+
+struct StageTimingSummary {
+    // Samples in the window; every other field is zero when this is.
+    size_t sampleCount = 0;
+    uint64_t minNs = 0;
+    uint64_t medianNs = 0;
+    uint64_t p95Ns = 0;
+    uint64_t p99Ns = 0;
+    uint64_t maxNs = 0;
+    // Samples in the window above the budget passed to Summarize.
+    size_t overBudgetCount = 0;
+};
+
+// Timing of one pipeline stage over a rolling window of its most recent samples. Samples land in log-linear
+// (HDR-style) buckets with 16 sub-buckets per power of two, so percentiles carry at most ~6% error at any magnitude;
+// min, max and the over-budget count are exact. Record is lock-free and may be called from any thread, including
+// several at once; Summarize may run concurrently and sees each sample either fully or not at all.
+class StageHistogram {
+  public:
+    static constexpr size_t kDefaultWindowSize = 512;
+    static constexpr uint32_t kSubBucketBits = 4;
+    static constexpr uint32_t kSubBucketCount = 1u << kSubBucketBits;
+    // Longer samples (~68 s) are clamped into the last bucket.
+    static constexpr uint64_t kMaxTrackableNs = (uint64_t{1} << 36) - 1;
+    static constexpr size_t kBucketCount = kSubBucketCount + (36 - kSubBucketBits) * kSubBucketCount;
+
+    StageHistogram() : StageHistogram(kDefaultWindowSize) {
+    }
+    explicit StageHistogram(size_t windowSize);
+    StageHistogram(const StageHistogram&) = delete;
+    StageHistogram& operator=(const StageHistogram&) = delete;
+
+    // A zero duration marks a stage that did not run this frame: it updates GetLastNs but is not sampled, so idle
+    // stages do not drag the percentiles down.
+    void Record(uint64_t ns);
+
+    [[nodiscard]] uint64_t GetLastNs() const {
+        return m_LastNs.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] size_t GetWindowSize() const {
+        return m_WindowSize;
+    }
+    // budgetNs == 0 leaves overBudgetCount at zero.
+    [[nodiscard]] StageTimingSummary Summarize(uint64_t budgetNs = 0) const;
+
+    [[nodiscard]] static size_t BucketIndex(uint64_t ns);
+    // Largest value that maps to the bucket; percentiles report this so they never understate a tail.
+    [[nodiscard]] static uint64_t BucketUpperBound(size_t bucketIndex);
+
+  private:
+    size_t m_WindowSize;
+    std::atomic<uint64_t> m_LastNs{0};
+    std::atomic<uint64_t> m_NextSlot{0};
+    // Raw samples of the window, 0 for empty slots.
+    std::unique_ptr<std::atomic<uint64_t>[]> m_Window;
+    std::array<std::atomic<uint32_t>, kBucketCount> m_BucketCounts{};
+};
+
+} // namespace RetroRenderer
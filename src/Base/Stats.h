@@ -1,17 +1,25 @@
 #pragma once
+#include "StageHistogram.h"
 #include <atomic>
 #include <cstdint>
 
 namespace RetroRenderer {
+// 60 Hz.
+inline constexpr uint64_t kDefaultFrameBudgetNs = 16'666'667;
+
 struct Stats {
     int renderedTris = 0;
     int renderedVerts = 0;
-    bool processMemorySupported = false;
-    uint64_t processResidentBytes = 0;
-    uint64_t processResidentPeakBytes = 0;
-    uint64_t processResidentPeakOsBytes = 0;
+    // Written by ProcessMemorySampler's thread; see UpdateProcessMemory.
+    std::atomic<bool> processMemorySupported = false;
+    std::atomic<uint64_t> processResidentBytes = 0;
+    std::atomic<uint64_t> processResidentPeakBytes = 0;
+    std::atomic<uint64_t> processResidentPeakOsBytes = 0;
     uint64_t sceneGeometryCpuBytes = 0;
     uint64_t sceneTextureCpuBytes = 0;
+    uint64_t textureRegistryPathHits = 0;
+    uint64_t textureRegistryContentHits = 0;
+    uint64_t textureRegistrySharedBytes = 0;
     uint64_t softwareFramebufferColorBytes = 0;
     uint64_t softwareDepthBufferBytes = 0;
     uint64_t softwareScratchBytes = 0;
@@ -24,6 +32,10 @@ struct Stats {
     uint64_t glRendererTextureCacheBytes = 0;
     uint64_t glRendererSkyboxBytes = 0;
     uint64_t glRendererFallbackTextureBytes = 0;
+    uint64_t glTextureEvictions = 0;
+    uint64_t glTextureReuploads = 0;
+    uint64_t glMeshEvictions = 0;
+    uint64_t glMeshReuploads = 0;
     uint64_t outputPresenterBytes = 0;
     uint64_t previewPresenterBytes = 0;
     uint64_t fontPresenterBytes = 0;
@@ -33,37 +45,60 @@ struct Stats {
     std::atomic<uint64_t> swJobsReplacedPending = 0;
     std::atomic<uint64_t> swFramesPresented = 0;
     std::atomic<uint64_t> swFramesReplacedReady = 0;
+    std::atomic<uint64_t> lastSoftwareClustersTested = 0;
+    std::atomic<uint64_t> lastSoftwareClustersFrustumCulled = 0;
+    std::atomic<uint64_t> lastSoftwareClustersBackfaceCulled = 0;
+    std::atomic<uint64_t> lastSoftwareClustersOcclusionCulled = 0;
+    std::atomic<uint64_t> lastSoftwareItemsTested = 0;
+    std::atomic<uint64_t> lastSoftwareItemsOcclusionCulled = 0;
+    std::atomic<uint64_t> lastSoftwareOcclusionFullBuilds = 0;
+    std::atomic<uint64_t> lastSoftwareOcclusionTilesRescanned = 0;
+    // Published once per software frame from the renderer's RasterCounters; zero while collection is off.
+    std::atomic<uint64_t> lastSoftwareRasterTrianglesSubmitted = 0;
+    std::atomic<uint64_t> lastSoftwareRasterTrianglesCulled = 0;
+    std::atomic<uint64_t> lastSoftwareRasterTrianglesClipped = 0;
+    std::atomic<uint64_t> lastSoftwareRasterTrianglesDeferred = 0;
+    std::atomic<uint64_t> lastSoftwareRasterPixelsCovered = 0;
+    std::atomic<uint64_t> lastSoftwareRasterPixelsShaded = 0;
+    std::atomic<uint64_t> lastSoftwareRasterPixelsDepthRejected = 0;
+    std::atomic<uint64_t> lastSoftwareRasterPixelsAlphaDiscarded = 0;
+    std::atomic<uint64_t> lastSoftwareRasterPixelsWritten = 0;
+    std::atomic<uint64_t> lastSoftwareRasterMaterialInstructions = 0;
     std::atomic<uint64_t> lastSoftwareFramePresentedNs = 0;
-    std::atomic<uint64_t> lastSoftwareFramePresentIntervalNs = 0;
-    std::atomic<uint64_t> lastFrameTotalNs = 0;
-    std::atomic<uint64_t> lastMainUpdateNs = 0;
-    std::atomic<uint64_t> lastDisplayBeforeFrameNs = 0;
-    std::atomic<uint64_t> lastRenderPacketBuildNs = 0;
-    std::atomic<uint64_t> lastRenderSystemNs = 0;
-    std::atomic<uint64_t> lastGlRenderNs = 0;
-    std::atomic<uint64_t> lastSoftwarePacketCopyNs = 0;
-    std::atomic<uint64_t> lastSoftwareWorkerRenderNs = 0;
-    std::atomic<uint64_t> lastSoftwareWorkerCopyNs = 0;
-    std::atomic<uint64_t> lastDisplayDrawNs = 0;
-    std::atomic<uint64_t> lastCpuOutputUploadNs = 0;
-    std::atomic<uint64_t> lastImGuiBuildNs = 0;
-    std::atomic<uint64_t> lastImGuiRenderNs = 0;
-    std::atomic<uint64_t> lastSwapBuffersNs = 0;
+    // Stage timings keep the last value plus a rolling histogram; see StageHistogram.
+    StageHistogram softwareFramePresentIntervalTiming;
+    StageHistogram frameTotalTiming;
+    StageHistogram mainUpdateTiming;
+    StageHistogram displayBeforeFrameTiming;
+    StageHistogram renderPacketBuildTiming;
+    StageHistogram renderSystemTiming;
+    StageHistogram glRenderTiming;
+    StageHistogram softwarePacketCopyTiming;
+    StageHistogram softwareWorkerRenderTiming;
+    StageHistogram softwareWorkerCopyTiming;
+    StageHistogram displayDrawTiming;
+    StageHistogram cpuOutputUploadTiming;
+    StageHistogram imGuiBuildTiming;
+    StageHistogram imGuiRenderTiming;
+    StageHistogram swapBuffersTiming;
+    // Frames whose total time exceeds this count as over budget.
+    std::atomic<uint64_t> frameBudgetNs = kDefaultFrameBudgetNs;
 
     void Reset() {
         renderedTris = 0;
         renderedVerts = 0;
     }
 
+    // Single writer (the memory sampler), any number of readers. osPeakResidentBytes == 0 keeps the previous peak.
     void UpdateProcessMemory(uint64_t residentBytes, uint64_t osPeakResidentBytes) {
-        processMemorySupported = true;
-        processResidentBytes = residentBytes;
-        if (processResidentBytes > processResidentPeakBytes) {
-            processResidentPeakBytes = processResidentBytes;
+        processResidentBytes.store(residentBytes, std::memory_order_relaxed);
+        if (residentBytes > processResidentPeakBytes.load(std::memory_order_relaxed)) {
+            processResidentPeakBytes.store(residentBytes, std::memory_order_relaxed);
         }
-        if (osPeakResidentBytes > processResidentPeakOsBytes) {
-            processResidentPeakOsBytes = osPeakResidentBytes;
+        if (osPeakResidentBytes > processResidentPeakOsBytes.load(std::memory_order_relaxed)) {
+            processResidentPeakOsBytes.store(osPeakResidentBytes, std::memory_order_relaxed);
         }
+        processMemorySupported.store(true, std::memory_order_relaxed);
     }
 
     [[nodiscard]] uint64_t KnownResidentBytes() const {
@@ -1,5 +1,7 @@
 #include "Engine.h"
-#include "Base/MemoryProfiler.h"
+#include "Base/FrameTrace.h"
+#include "Base/AllocationTracker.h"
+#include "Renderer/AnimationSequenceRenderer.h"
 #include "Renderer/InlineRenderExecutor.h"
 #include <KrisLogger/Logger.h>
 #include <algorithm>
@@ -30,6 +32,7 @@ uint64_t ElapsedNanoseconds(TimingClock::time_point start) {
 } // namespace
 
 bool Engine::Init() {
+    FrameTrace::SetThreadName("main");
 #ifndef __EMSCRIPTEN__
     LOGD("Starting RetroRenderer in directory: %s", SDL_GetBasePath());
 #endif
@@ -62,6 +65,7 @@ bool Engine::Init() {
     if (!p_MaterialManager->Init()) {
         return false;
     }
+    m_MemorySampler.Start(p_stats_, p_config_->diagnostics.memorySampleRateHz);
     m_DisplaySystem.BindEditorContext(EditorContext{
         .config = p_config_,
         .stats = p_stats_,
@@ -70,6 +74,7 @@ bool Engine::Init() {
         .dispatchImmediate = [this](const Event& event) { DispatchImmediate(event); },
         .enqueueEvent = [this](std::unique_ptr<Event> event) { EnqueueEvent(std::move(event)); },
         .selectedModelIndex = std::nullopt,
+        .animationExport = &m_AnimationExport,
     });
 
     // Default scene (optional)
@@ -81,6 +86,7 @@ bool Engine::Init() {
 
 void Engine::Run() {
     m_LastFrameTicks = SDL_GetTicks();
+    m_MaterialClock.Reset();
 
     LOGD("Entered main loop");
 #ifdef __EMSCRIPTEN__
@@ -94,82 +100,142 @@ void Engine::Run() {
 }
 
 void Engine::ProcessFrame() {
+    RETRO_TRACE_ZONE("Engine::ProcessFrame");
     const auto frameStart = TimingClock::now();
     const Uint32 now = SDL_GetTicks();
     const Uint32 rawDelta = now - m_LastFrameTicks;
     m_LastFrameTicks = now;
     const Uint32 delta = std::min<Uint32>(rawDelta, 50);
+    m_MaterialClock.Tick(rawDelta);
+    AllocationTracker::SetEnabled(p_config_->diagnostics.trackAllocations);
 
     const auto mainUpdateStart = TimingClock::now();
     ProcessEventQueue();
+    // Before the scene update so the live frame re-culls and re-poses after export packets are built.
+    m_AnimationExport.Tick();
 
     auto inputActions = m_InputSystem.HandleInput();
     if (inputActions & static_cast<InputActionMask>(InputAction::QUIT)) {
         m_Running = false;
-        p_stats_->lastFrameTotalNs.store(ElapsedNanoseconds(frameStart), std::memory_order_relaxed);
+        p_stats_->frameTotalTiming.Record(ElapsedNanoseconds(frameStart));
         return;
     }
     // TODO: handle camera switching
 
-    p_SceneManager->ProcessInput(inputActions, delta);
-    p_SceneManager->Update(delta, p_config_->renderer.resolution);
-    p_SceneManager->NewFrame();
-
-    const ProcessMemorySnapshot memorySnapshot = MemoryProfiler::SampleProcessMemory();
-    if (memorySnapshot.supported) {
-        p_stats_->UpdateProcessMemory(memorySnapshot.residentBytes, memorySnapshot.peakResidentBytes);
+    {
+        RETRO_TRACE_ZONE("SceneManager::Update");
+        RETRO_ALLOCATION_TAG(SCENE);
+        p_SceneManager->ProcessInput(inputActions, delta);
+        p_SceneManager->Update(delta, p_config_->renderer.resolution);
+        p_SceneManager->NewFrame();
     }
-    p_stats_->lastMainUpdateNs.store(ElapsedNanoseconds(mainUpdateStart), std::memory_order_relaxed);
+
+    m_MemorySampler.SetRateHz(p_config_->diagnostics.memorySampleRateHz);
+    p_stats_->mainUpdateTiming.Record(ElapsedNanoseconds(mainUpdateStart));
 
     auto scene = p_SceneManager->GetScene();
     auto camera = p_SceneManager->GetCamera();
     const bool hasScene = scene != nullptr && camera != nullptr;
 
     const auto beforeFrameStart = TimingClock::now();
-    m_DisplaySystem.BeforeFrame();
-    p_stats_->lastDisplayBeforeFrameNs.store(ElapsedNanoseconds(beforeFrameStart), std::memory_order_relaxed);
+    {
+        RETRO_TRACE_ZONE("DisplaySystem::BeforeFrame");
+        RETRO_ALLOCATION_TAG(UI);
+        m_DisplaySystem.BeforeFrame();
+    }
+    p_stats_->displayBeforeFrameTiming.Record(ElapsedNanoseconds(beforeFrameStart));
 
-    p_RenderSystem->BeforeFrame(p_config_->renderer.clearColor);
-    const bool outputAvailable =
-        hasScene && (p_config_->renderer.selectedRenderer == Config::RendererType::GL ||
-                     p_RenderSystem->PollSoftwareFrame());
+    bool outputAvailable = false;
+    {
+        RETRO_ALLOCATION_TAG(RENDER_SYSTEM);
+        p_RenderSystem->BeforeFrame(p_config_->renderer.clearColor);
+        outputAvailable = hasScene && (p_config_->renderer.selectedRenderer == Config::RendererType::GL ||
+                                       p_RenderSystem->PollSoftwareFrame());
+    }
     const auto drawStart = TimingClock::now();
-    if (hasScene) {
-        const RenderOutputOrigin origin = p_config_->renderer.selectedRenderer == Config::RendererType::GL
-                                              ? RenderOutputOrigin::BottomLeft
-                                              : RenderOutputOrigin::TopLeft;
-        m_DisplaySystem.DrawFrame(outputAvailable, origin);
-    } else {
-        p_stats_->Reset();
-        m_DisplaySystem.DrawFrame();
+    {
+        RETRO_TRACE_ZONE("DisplaySystem::DrawFrame");
+        RETRO_ALLOCATION_TAG(UI);
+        if (hasScene) {
+            const RenderOutputOrigin origin = p_config_->renderer.selectedRenderer == Config::RendererType::GL
+                                                  ? RenderOutputOrigin::BottomLeft
+                                                  : RenderOutputOrigin::TopLeft;
+            m_DisplaySystem.DrawFrame(outputAvailable, origin);
+        } else {
+            p_stats_->Reset();
+            m_DisplaySystem.DrawFrame();
+        }
     }
-    p_stats_->lastDisplayDrawNs.store(ElapsedNanoseconds(drawStart), std::memory_order_relaxed);
+    p_stats_->displayDrawTiming.Record(ElapsedNanoseconds(drawStart));
 
     const auto packetStart = TimingClock::now();
-    const std::shared_ptr<const RenderPacket> packet = p_RenderSystem->BuildRenderPacket(scene, camera);
-    p_stats_->lastRenderPacketBuildNs.store(ElapsedNanoseconds(packetStart), std::memory_order_relaxed);
+    std::shared_ptr<const RenderPacket> packet;
+    {
+        RETRO_ALLOCATION_TAG(RENDER_PACKET);
+        packet = p_RenderSystem->BuildRenderPacket(scene, camera, m_MaterialClock.GetSeconds());
+    }
+    p_stats_->renderPacketBuildTiming.Record(ElapsedNanoseconds(packetStart));
+    UpdatePacketCapture(packet);
 
     std::shared_ptr<const CpuFrame> softwareFrame;
     if (hasScene) {
+        RETRO_ALLOCATION_TAG(RENDER_SYSTEM);
         softwareFrame = p_RenderSystem->PrepareFrame(packet);
     } else {
-        p_stats_->lastRenderSystemNs.store(0, std::memory_order_relaxed);
-        p_stats_->lastGlRenderNs.store(0, std::memory_order_relaxed);
-        p_stats_->lastSoftwarePacketCopyNs.store(0, std::memory_order_relaxed);
+        p_stats_->renderSystemTiming.Record(0);
+        p_stats_->glRenderTiming.Record(0);
+        p_stats_->softwarePacketCopyTiming.Record(0);
     }
 
-    FrameSubmission submission{};
-    submission.frameId = ++m_NextFrameId;
-    submission.renderPacket = packet;
-    submission.softwareFrame = std::move(softwareFrame);
-    submission.uiTextures = m_DisplaySystem.TakeUiTextureSnapshots();
-    submission.ui = m_DisplaySystem.TakeUiRenderPacket();
-    submission.enableVsync = p_config_->window.enableVsync;
-    p_RenderExecutor->Execute(std::move(submission));
-    p_stats_->lastFrameTotalNs.store(ElapsedNanoseconds(frameStart), std::memory_order_relaxed);
+    {
+        RETRO_ALLOCATION_TAG(PRESENTATION);
+        FrameSubmission submission{};
+        submission.frameId = ++m_NextFrameId;
+        submission.renderPacket = packet;
+        submission.softwareFrame = std::move(softwareFrame);
+        submission.uiTextures = m_DisplaySystem.TakeUiTextureSnapshots();
+        submission.ui = m_DisplaySystem.TakeUiRenderPacket();
+        submission.enableVsync = p_config_->window.enableVsync;
+        p_RenderExecutor->Execute(std::move(submission));
+    }
+    AllocationTracker::EndFrame();
+    p_stats_->frameTotalTiming.Record(ElapsedNanoseconds(frameStart));
+}
+
+void Engine::UpdatePacketCapture(const std::shared_ptr<const RenderPacket>& packet) {
+    std::string errorMessage;
+    if (!p_config_->diagnostics.capturePackets) {
+        if (m_PacketCapture.IsOpen()) {
+            const size_t packetCount = m_PacketCapture.GetPacketCount();
+            if (m_PacketCapture.Close(errorMessage)) {
+                LOGI("Saved %zu render packets to %s", packetCount, kDefaultPacketCapturePath);
+            } else {
+                LOGE("%s", errorMessage.c_str());
+            }
+        }
+        return;
+    }
+
+    RETRO_TRACE_ZONE("Engine::UpdatePacketCapture");
+    if (!m_PacketCapture.IsOpen() && !m_PacketCapture.Open(kDefaultPacketCapturePath, errorMessage)) {
+        LOGE("%s", errorMessage.c_str());
+        p_config_->diagnostics.capturePackets = false;
+        return;
+    }
+    if (packet != nullptr && packet->hasScene && !m_PacketCapture.WritePacket(*packet, errorMessage)) {
+        LOGE("%s", errorMessage.c_str());
+        p_config_->diagnostics.capturePackets = false;
+        m_PacketCapture.Close(errorMessage);
+    }
 }
 
 void Engine::Destroy() {
+    m_AnimationExport.Cancel();
+    m_MemorySampler.Stop();
+    std::string captureError;
+    if (!m_PacketCapture.Close(captureError)) {
+        LOGE("%s", captureError.c_str());
+    }
     if (p_RenderSystem) {
         p_RenderSystem->Destroy();
         p_RenderSystem.reset();
@@ -228,6 +294,7 @@ void Engine::Dispatch(const Event& event) {
     }
     case EventType::Scene_Load: {
         const SceneLoadEvent& e = static_cast<const SceneLoadEvent&>(event);
+        m_AnimationExport.Cancel();
         if (!e.loadFromMemory) {
             LOGD("Attempting to load scene from path: %s", e.scenePath.c_str());
             p_SceneManager->LoadScene(e.scenePath, e.appendToCurrentScene);
@@ -238,10 +305,26 @@ void Engine::Dispatch(const Event& event) {
         break;
     }
     case EventType::Scene_Reset: {
+        m_AnimationExport.Cancel();
         p_SceneManager->ResetScene();
         p_RenderSystem->OnResetScene();
         break;
     }
+    case EventType::Animation_Export: {
+        const AnimationExportEvent& e = static_cast<const AnimationExportEvent&>(event);
+        AnimationExportSettings settings{};
+        settings.outputDirectory = e.outputDirectory;
+        settings.format = e.writePng ? ImageSequenceFormat::PNG : ImageSequenceFormat::PPM;
+        std::string errorMessage;
+        if (!m_AnimationExport.Start(*p_SceneManager, *p_RenderSystem, settings, errorMessage)) {
+            LOGE("Animation export failed: %s", errorMessage.c_str());
+        }
+        break;
+    }
+    case EventType::Animation_ExportCancel: {
+        m_AnimationExport.Cancel();
+        break;
+    }
     case EventType::Output_Image_Resize: {
         const OutputImageResizeEvent& e = static_cast<const OutputImageResizeEvent&>(event);
         if (e.resolution.x <= 0 || e.resolution.y <= 0) {
@@ -5,7 +5,11 @@
 #include <queue>
 
 #include "Base/Event.h"
+#include "Base/FrameClock.h"
+#include "Base/ProcessMemorySampler.h"
 #include "Base/Stats.h"
+#include "Renderer/AnimationSequenceRenderer.h"
+#include "Renderer/RenderPacketCapture.h"
 #include "Renderer/RenderSystem.h"
 #include "Renderer/IRenderExecutor.h"
 #include "Scene/MaterialManager.h"
@@ -43,6 +47,7 @@ class Engine {
     Engine() = default;
     ~Engine() = default;
     void ProcessEventQueue();
+    void UpdatePacketCapture(const std::shared_ptr<const RenderPacket>& packet);
 
   private:
     std::shared_ptr<Config> p_config_ = std::make_shared<Config>();
@@ -56,8 +61,12 @@ class Engine {
     InputSystem m_InputSystem;
     std::unique_ptr<SceneManager> p_SceneManager;
     std::unique_ptr<MaterialManager> p_MaterialManager;
+    ProcessMemorySampler m_MemorySampler;
+    RenderPacketCaptureWriter m_PacketCapture;
+    AnimationExportJob m_AnimationExport;
 
     Uint32 m_LastFrameTicks = 0;
+    FrameClock m_MaterialClock = FrameClock::RealTime();
     uint64_t m_NextFrameId = 0;
     bool m_Running = true;
 };
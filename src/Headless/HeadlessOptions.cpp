@@ -0,0 +1,286 @@
+#include "HeadlessOptions.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+namespace RetroRenderer {
+namespace {
+std::string ToLowerCopy(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char ch) {
+        return static_cast<char>(std::tolower(ch));
+    });
+    return text;
+}
+
+bool ParseInt(const std::string& text, int minValue, int& outValue) {
+    int value = 0;
+    const char* end = text.data() + text.size();
+    const auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc() || ptr != end || value < minValue) {
+        return false;
+    }
+    outValue = value;
+    return true;
+}
+
+bool ParseResolution(const std::string& text, glm::ivec2& outResolution) {
+    const size_t separator = text.find_first_of("xX");
+    if (separator == std::string::npos) {
+        return false;
+    }
+    glm::ivec2 resolution{};
+    if (!ParseInt(text.substr(0, separator), 1, resolution.x) || !ParseInt(text.substr(separator + 1), 1, resolution.y)) {
+        return false;
+    }
+    outResolution = resolution;
+    return true;
+}
+} // namespace
+
+bool ParseRenderPresetName(const std::string& name, Config::RenderPreset& outPreset) {
+    const std::string lowered = ToLowerCopy(name);
+    if (lowered == "default") {
+        outPreset = Config::RenderPreset::DEFAULT;
+    } else if (lowered == "pico8" || lowered == "pico-8") {
+        outPreset = Config::RenderPreset::PICO8;
+    } else if (lowered == "picocad") {
+        outPreset = Config::RenderPreset::PICOCAD;
+    } else if (lowered == "ps1") {
+        outPreset = Config::RenderPreset::PS1;
+    } else if (lowered == "custom") {
+        outPreset = Config::RenderPreset::CUSTOM;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* GetRenderPresetName(Config::RenderPreset preset) {
+    switch (preset) {
+    case Config::RenderPreset::DEFAULT:
+        return "default";
+    case Config::RenderPreset::PICO8:
+        return "pico8";
+    case Config::RenderPreset::PICOCAD:
+        return "picocad";
+    case Config::RenderPreset::PS1:
+        return "ps1";
+    case Config::RenderPreset::CUSTOM:
+        return "custom";
+    }
+    return "custom";
+}
+
+bool ParseCameraPathName(const std::string& name, HeadlessCameraPath& outPath) {
+    const std::string lowered = ToLowerCopy(name);
+    if (lowered == "static") {
+        outPath = HeadlessCameraPath::STATIC;
+    } else if (lowered == "orbit") {
+        outPath = HeadlessCameraPath::ORBIT;
+    } else if (lowered == "dolly") {
+        outPath = HeadlessCameraPath::DOLLY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* GetCameraPathName(HeadlessCameraPath path) {
+    switch (path) {
+    case HeadlessCameraPath::STATIC:
+        return "static";
+    case HeadlessCameraPath::ORBIT:
+        return "orbit";
+    case HeadlessCameraPath::DOLLY:
+        return "dolly";
+    }
+    return "static";
+}
+
+bool ParseHeadlessArguments(const std::vector<std::string>& arguments,
+                            HeadlessOptions& outOptions,
+                            std::string& outErrorMessage) {
+    outOptions = {};
+    bool framesGiven = false;
+    bool warmupGiven = false;
+    for (size_t i = 0; i < arguments.size(); i++) {
+        const std::string& argument = arguments[i];
+        if (argument == "-h" || argument == "--help") {
+            outOptions.showHelp = true;
+            return true;
+        }
+        if (argument == "--frame-timings") {
+            outOptions.printFrameTimings = true;
+            continue;
+        }
+        if (argument == "--allocations") {
+            outOptions.trackAllocations = true;
+            continue;
+        }
+        if (argument == "--no-scene-baseline") {
+            outOptions.useSceneBaseline = false;
+            continue;
+        }
+        if (argument == "--perf-update") {
+            outOptions.updatePerfBaseline = true;
+            continue;
+        }
+        if (argument.rfind("--", 0) != 0) {
+            if (!outOptions.scenePath.empty()) {
+                outErrorMessage = "Unexpected argument '" + argument + "'; only one scene can be rendered per run.";
+                return false;
+            }
+            outOptions.scenePath = argument;
+            continue;
+        }
+
+        if (i + 1 >= arguments.size()) {
+            outErrorMessage = "Missing value for " + argument + ".";
+            return false;
+        }
+        const std::string& value = arguments[++i];
+        if (argument == "--output") {
+            outOptions.outputDirectory = value;
+        } else if (argument == "--stem") {
+            outOptions.fileStem = value;
+        } else if (argument == "--format") {
+            const std::string lowered = ToLowerCopy(value);
+            if (lowered == "png") {
+                outOptions.format = ImageSequenceFormat::PNG;
+            } else if (lowered == "ppm") {
+                outOptions.format = ImageSequenceFormat::PPM;
+            } else {
+                outErrorMessage = "Unknown image format '" + value + "' (expected png or ppm).";
+                return false;
+            }
+        } else if (argument == "--preset") {
+            Config::RenderPreset preset{};
+            if (!ParseRenderPresetName(value, preset)) {
+                outErrorMessage = "Unknown preset '" + value + "' (expected default, pico8, picocad, ps1 or custom).";
+                return false;
+            }
+            outOptions.preset = preset;
+        } else if (argument == "--baseline") {
+            outOptions.baselinePath = value;
+        } else if (argument == "--resolution") {
+            glm::ivec2 resolution{};
+            if (!ParseResolution(value, resolution)) {
+                outErrorMessage = "Invalid resolution '" + value + "' (expected WIDTHxHEIGHT).";
+                return false;
+            }
+            outOptions.resolution = resolution;
+        } else if (argument == "--frames") {
+            if (!ParseInt(value, 1, outOptions.frameCount)) {
+                outErrorMessage = "Invalid frame count '" + value + "'.";
+                return false;
+            }
+            framesGiven = true;
+        } else if (argument == "--warmup") {
+            if (!ParseInt(value, 0, outOptions.warmupFrames)) {
+                outErrorMessage = "Invalid warmup frame count '" + value + "'.";
+                return false;
+            }
+            warmupGiven = true;
+        } else if (argument == "--camera-path") {
+            if (!ParseCameraPathName(value, outOptions.cameraPath)) {
+                outErrorMessage = "Unknown camera path '" + value + "' (expected static, orbit or dolly).";
+                return false;
+            }
+        } else if (argument == "--trace") {
+            outOptions.tracePath = value;
+        } else if (argument == "--capture") {
+            outOptions.capturePath = value;
+        } else if (argument == "--replay") {
+            outOptions.replayPath = value;
+        } else if (argument == "--perf-baseline") {
+            outOptions.perfBaselinePath = value;
+        } else if (argument == "--perf-tolerance") {
+            int percent = 0;
+            if (!ParseInt(value, 0, percent)) {
+                outErrorMessage = "Invalid perf tolerance '" + value + "' (expected a whole percentage).";
+                return false;
+            }
+            outOptions.perfTolerance = static_cast<double>(percent) / 100.0;
+        } else {
+            outErrorMessage = "Unknown option " + argument + ".";
+            return false;
+        }
+    }
+
+    if (outOptions.perfBaselinePath.has_value()) {
+        if (outOptions.replayPath.has_value()) {
+            outErrorMessage = "--replay and --perf-baseline cannot be combined.";
+            return false;
+        }
+        if (!outOptions.scenePath.empty()) {
+            outErrorMessage = "Perf runs take their scenes from the baseline file; drop '" +
+                              outOptions.scenePath.generic_string() + "'.";
+            return false;
+        }
+        // Enough frames for stable tail percentiles unless the caller asked for something else.
+        if (!framesGiven) {
+            outOptions.frameCount = 120;
+        }
+        if (!warmupGiven) {
+            outOptions.warmupFrames = 10;
+        }
+        return true;
+    }
+    if (outOptions.updatePerfBaseline) {
+        outErrorMessage = "--perf-update requires --perf-baseline.";
+        return false;
+    }
+    if (outOptions.replayPath.has_value()) {
+        if (!outOptions.scenePath.empty()) {
+            outErrorMessage = "Replays take their frames from the capture; drop '" +
+                              outOptions.scenePath.generic_string() + "'.";
+            return false;
+        }
+        if (outOptions.preset.has_value() || outOptions.baselinePath.has_value() ||
+            outOptions.cameraPath != HeadlessCameraPath::STATIC || outOptions.capturePath.has_value()) {
+            outErrorMessage = "--preset, --baseline, --camera-path and --capture do not apply to --replay.";
+            return false;
+        }
+        if (!framesGiven) {
+            outOptions.frameCount = 0;
+        }
+        return true;
+    }
+    if (outOptions.scenePath.empty()) {
+        outErrorMessage = "No scene given.";
+        return false;
+    }
+    return true;
+}
+
+std::string GetHeadlessUsage(const std::string& programName) {
+    return "Usage: " + programName + " <scene> [options]\n"
+           "       " + programName + " --perf-baseline FILE [--perf-update] [options]\n"
+           "       " + programName + " --replay FILE [options]\n"
+           "Renders a scene with the software renderer, without a window or GPU.\n"
+           "\n"
+           "  --output DIR          write frames to DIR (frames are not written otherwise)\n"
+           "  --stem NAME           frame file name prefix (default: frame)\n"
+           "  --format png|ppm      frame image format (default: png)\n"
+           "  --preset NAME         default, pico8, picocad, ps1 or custom\n"
+           "  --baseline FILE       apply this example baseline file instead of the scene's own\n"
+           "  --no-scene-baseline   ignore example-baseline.cfg files next to the scene\n"
+           "  --resolution WxH      render target size (default: preset or 1280x720)\n"
+           "  --frames N            measured frames to render (default: 1)\n"
+           "  --warmup N            unmeasured frames rendered first (default: 0)\n"
+           "  --camera-path NAME    static, orbit or dolly (default: static)\n"
+           "  --frame-timings       print timings for every frame, not only the summary\n"
+           "  --allocations         count heap allocations per frame and tag\n"
+           "  --trace FILE          write pipeline zones as a Chrome trace (chrome://tracing, ui.perfetto.dev)\n"
+           "  --capture FILE        save the render packet of every measured frame to FILE\n"
+           "\n"
+           "Replay (frames default to one pass over the capture):\n"
+           "  --replay FILE         render the packets saved with --capture or from the editor\n"
+           "\n"
+           "Perf regression (frames default to 120 with 10 warmup):\n"
+           "  --perf-baseline FILE  render every case in FILE and compare against its metrics\n"
+           "  --perf-update         record the measured metrics into FILE instead of comparing\n"
+           "  --perf-tolerance PCT  allowed slowdown per metric in percent (default: 15)\n";
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../Base/Config.h"
+#include "../Renderer/AnimationSequenceRenderer.h"
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace RetroRenderer {
+
+// Scripted camera motion over the rendered frames. Paths start from the scene's own camera and keep looking at the
+// center of the scene bounds, so every run of the same scene sees the same views.
+enum class HeadlessCameraPath {
+    STATIC,
+    // One full turn around the vertical axis through the scene center.
+    ORBIT,
+    // Moves halfway toward the scene center and back.
+    DOLLY,
+};
+
+struct HeadlessOptions {
+    std::filesystem::path scenePath;
+    // Frames are only written when an output directory is given, so timing-only runs stay free of disk I/O.
+    std::filesystem::path outputDirectory;
+    std::string fileStem = "frame";
+    ImageSequenceFormat format = ImageSequenceFormat::PNG;
+    std::optional<Config::RenderPreset> preset;
+    // Explicit baseline file; when unset the example-baseline.cfg files next to the scene apply, as in the editor.
+    std::optional<std::filesystem::path> baselinePath;
+    bool useSceneBaseline = true;
+    std::optional<glm::ivec2> resolution;
+    // With --replay and no --frames this is 0, meaning one pass over the captured packets.
+    int frameCount = 1;
+    // Rendered before the measured frames and never written, to settle caches and lazily built texture data.
+    int warmupFrames = 0;
+    HeadlessCameraPath cameraPath = HeadlessCameraPath::STATIC;
+    bool printFrameTimings = false;
+    // Counts heap allocations per measured frame (needs RETRO_ALLOCATION_TRACKING).
+    bool trackAllocations = false;
+    // Records RETRO_TRACE_ZONE zones for the whole run and writes them here as a Chrome trace.
+    std::optional<std::filesystem::path> tracePath;
+    // Writes the RenderPacket of every measured frame here, for --replay.
+    std::optional<std::filesystem::path> capturePath;
+    // Replay mode: renders the packets of this capture instead of loading a scene. The capture carries its own
+    // config, camera and material time, so only --resolution overrides what was recorded.
+    std::optional<std::filesystem::path> replayPath;
+    bool showHelp = false;
+
+    // Perf-regression mode: render every case listed in this baseline file and compare against its recorded metrics.
+    std::optional<std::filesystem::path> perfBaselinePath;
+    // Rewrites the baseline with the measured metrics instead of comparing; with a missing or empty baseline, every
+    // example scene and every scene in the baseline's scenes/ directory is added for each built-in preset.
+    bool updatePerfBaseline = false;
+    // Allowed slowdown before a metric counts as regressed, as a fraction of the baseline value.
+    double perfTolerance = 0.15;
+};
+
+bool ParseHeadlessArguments(const std::vector<std::string>& arguments,
+                            HeadlessOptions& outOptions,
+                            std::string& outErrorMessage);
+bool ParseRenderPresetName(const std::string& name, Config::RenderPreset& outPreset);
+const char* GetRenderPresetName(Config::RenderPreset preset);
+bool ParseCameraPathName(const std::string& name, HeadlessCameraPath& outPath);
+const char* GetCameraPathName(HeadlessCameraPath path);
+std::string GetHeadlessUsage(const std::string& programName);
+
+} // namespace RetroRenderer
@@ -0,0 +1,755 @@
+#include "HeadlessRenderer.h"
+#include "PerfRegression.h"
+#include "../Base/AllocationTracker.h"
+#include "../Base/ExampleSceneBaseline.h"
+#include "../Base/ExampleSceneCatalog.h"
+#include "../Base/FrameClock.h"
+#include "../Base/FrameTrace.h"
+#include "../Base/MemoryProfiler.h"
+#include "../Base/Stats.h"
+#include "../Renderer/RenderPacketCapture.h"
+#include "../Renderer/RenderSystem.h"
+#include "../Scene/MaterialManager.h"
+#include "../Scene/SceneManager.h"
+#include <KrisLogger/Logger.h>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <system_error>
+
+namespace RetroRenderer {
+namespace {
+using TimingClock = std::chrono::steady_clock;
+
+uint64_t ElapsedNanoseconds(TimingClock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(TimingClock::now() - start).count());
+}
+
+double ToMilliseconds(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+std::filesystem::path MakeFramePath(const HeadlessOptions& options, int frame) {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "_%05d", frame);
+    const char* extension = options.format == ImageSequenceFormat::PNG ? ".png" : ".ppm";
+    return options.outputDirectory / (options.fileStem + suffix + extension);
+}
+
+bool ResolveBaseline(const HeadlessOptions& options, ExampleSceneBaseline& outBaseline) {
+    std::vector<std::string> warnings;
+    bool found = false;
+    if (options.baselinePath.has_value()) {
+        found = LoadExampleSceneBaselineFile(*options.baselinePath, outBaseline, &warnings);
+    } else if (options.useSceneBaseline) {
+        found = LoadExampleSceneBaselineForScene(options.scenePath, outBaseline, &warnings);
+    }
+    for (const std::string& warning : warnings) {
+        LOGW("Scene baseline warning: %s", warning.c_str());
+    }
+    return found;
+}
+
+void ApplyBaselineToScene(const ExampleSceneBaseline& baseline,
+                          const MaterialManager& materialManager,
+                          const Config& config,
+                          Scene& scene,
+                          Camera& camera) {
+    std::filesystem::path templatePath;
+    if (baseline.materialAsset.has_value()) {
+        templatePath = *baseline.materialAsset;
+    } else if (baseline.materialType.has_value()) {
+        templatePath = materialManager.ResolveBuiltInTemplatePath(
+            *baseline.materialType == ExampleSceneBaseline::MaterialType::PHONG_VERTEX_COLOR);
+    }
+    if (!templatePath.empty()) {
+        scene.SetAllMaterialTemplates(templatePath);
+    }
+    scene.SetDefaultLightPosition(config.environment.lightPosition);
+    if (baseline.cameraType.has_value()) {
+        camera.m_Type = *baseline.cameraType;
+    }
+}
+
+// Turns allocation tracking on for the run and restores the previous state on every exit path.
+class AllocationTrackingScope {
+  public:
+    explicit AllocationTrackingScope(bool enable) : m_WasEnabled(AllocationTracker::IsEnabled()) {
+        if (enable) {
+            AllocationTracker::SetEnabled(true);
+        }
+    }
+    ~AllocationTrackingScope() {
+        AllocationTracker::SetEnabled(m_WasEnabled);
+    }
+    AllocationTrackingScope(const AllocationTrackingScope&) = delete;
+    AllocationTrackingScope& operator=(const AllocationTrackingScope&) = delete;
+
+  private:
+    bool m_WasEnabled;
+};
+
+void AddAllocations(const AllocationFrameReport& frame, AllocationFrameReport& total) {
+    for (size_t tag = 0; tag < kAllocationTagCount; tag++) {
+        total.tags[tag].allocations += frame.tags[tag].allocations;
+        total.tags[tag].deallocations += frame.tags[tag].deallocations;
+        total.tags[tag].bytes += frame.tags[tag].bytes;
+    }
+}
+
+uint64_t CountSubmittedTriangles(const RenderPacket& packet) {
+    uint64_t triangles = 0;
+    for (const RenderItem& item : packet.items) {
+        if (item.geometry) {
+            triangles += item.geometry->indices.size() / 3;
+        }
+    }
+    return triangles;
+}
+
+// Renders the packet and fills in the render and write stages of timing; shared by scene runs and replays.
+bool RenderHeadlessFrame(const HeadlessOptions& options,
+                         RenderSystem& renderSystem,
+                         const Stats& stats,
+                         const std::shared_ptr<const RenderPacket>& packet,
+                         bool measured,
+                         int outputFrame,
+                         HeadlessFrameTiming& timing,
+                         HeadlessRunResult& outResult) {
+    timing.renderItems = packet->items.size();
+    timing.submittedTriangles = CountSubmittedTriangles(*packet);
+
+    std::shared_ptr<const CpuFrame> frame;
+    {
+        RETRO_ALLOCATION_TAG(RENDER_SYSTEM);
+        frame = renderSystem.RenderFrameBlocking(packet);
+    }
+    if (!frame) {
+        outResult.errorMessage = "Software renderer produced no frame.";
+        return false;
+    }
+    timing.renderSystemNs = stats.renderSystemTiming.GetLastNs();
+    timing.softwareRenderNs = stats.softwareWorkerRenderTiming.GetLastNs();
+    timing.softwareCopyNs = stats.softwareWorkerCopyTiming.GetLastNs();
+    const uint64_t rasterSubmitted = stats.lastSoftwareRasterTrianglesSubmitted.load(std::memory_order_relaxed);
+    const uint64_t rasterCulled = stats.lastSoftwareRasterTrianglesCulled.load(std::memory_order_relaxed);
+    timing.rasterizedTriangles = rasterSubmitted - std::min(rasterCulled, rasterSubmitted);
+    timing.shadedPixels = stats.lastSoftwareRasterPixelsShaded.load(std::memory_order_relaxed);
+    timing.occlusionFullBuilds = stats.lastSoftwareOcclusionFullBuilds.load(std::memory_order_relaxed);
+    timing.occlusionTilesRescanned = stats.lastSoftwareOcclusionTilesRescanned.load(std::memory_order_relaxed);
+    timing.occlusionCulledItems = stats.lastSoftwareItemsOcclusionCulled.load(std::memory_order_relaxed);
+
+    if (measured && !options.outputDirectory.empty()) {
+        RETRO_ALLOCATION_TAG(PRESENTATION);
+        const auto writeStart = TimingClock::now();
+        if (!WriteCpuFrameImage(MakeFramePath(options, outputFrame), *frame, options.format, outResult.errorMessage)) {
+            return false;
+        }
+        timing.writeNs = ElapsedNanoseconds(writeStart);
+        outResult.framesWritten++;
+    }
+    return true;
+}
+
+void RecordFrameAllocations(bool measured, HeadlessFrameTiming& timing, HeadlessRunResult& outResult) {
+    AllocationTracker::EndFrame();
+    const AllocationFrameReport allocations = AllocationTracker::GetLastFrame();
+    const AllocationCounts total = allocations.Total();
+    timing.allocations = total.allocations;
+    timing.allocatedBytes = total.bytes;
+    if (measured) {
+        AddAllocations(allocations, outResult.allocations);
+    }
+}
+
+bool CreateOutputDirectory(const HeadlessOptions& options, HeadlessRunResult& outResult) {
+    if (options.outputDirectory.empty()) {
+        return true;
+    }
+    std::error_code errorCode;
+    std::filesystem::create_directories(options.outputDirectory, errorCode);
+    if (errorCode) {
+        outResult.errorMessage =
+            "Could not create " + options.outputDirectory.generic_string() + ": " + errorCode.message();
+        return false;
+    }
+    return true;
+}
+
+struct CameraPathAnchor {
+    glm::vec3 focus = glm::vec3(0.0f);
+    glm::vec3 startOffset = glm::vec3(0.0f, 0.0f, 3.0f);
+};
+
+// Focus on the center of the scene bounds, starting from wherever the scene (or its baseline) put the camera.
+CameraPathAnchor MakeCameraPathAnchor(Scene& scene, const Camera& camera) {
+    scene.UpdateTransforms();
+    const TransformHierarchy& transforms = scene.GetTransforms();
+    bool hasBounds = false;
+    glm::vec3 sceneMin(0.0f);
+    glm::vec3 sceneMax(0.0f);
+    for (size_t i = 0; i < transforms.GetCount(); i++) {
+        const int index = static_cast<int>(i);
+        if (!transforms.HasLocalBounds(index)) {
+            continue;
+        }
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        transforms.GetWorldBounds(index, boundsMin, boundsMax);
+        sceneMin = hasBounds ? glm::min(sceneMin, boundsMin) : boundsMin;
+        sceneMax = hasBounds ? glm::max(sceneMax, boundsMax) : boundsMax;
+        hasBounds = true;
+    }
+
+    CameraPathAnchor anchor{};
+    anchor.focus = hasBounds ? (sceneMin + sceneMax) * 0.5f : camera.m_Position + camera.m_Direction * 3.0f;
+    anchor.startOffset = camera.m_Position - anchor.focus;
+    if (glm::dot(anchor.startOffset, anchor.startOffset) < 1e-6f) {
+        anchor.startOffset = glm::vec3(0.0f, 0.0f, 3.0f);
+    }
+    return anchor;
+}
+
+// progress runs from 0 at the first rendered frame towards 1 at the last.
+void ApplyCameraPath(HeadlessCameraPath path, const CameraPathAnchor& anchor, float progress, Camera& camera) {
+    glm::vec3 offset = anchor.startOffset;
+    switch (path) {
+    case HeadlessCameraPath::STATIC:
+        return;
+    case HeadlessCameraPath::ORBIT: {
+        const float angle = glm::two_pi<float>() * progress;
+        const float c = std::cos(angle);
+        const float s = std::sin(angle);
+        offset = glm::vec3(offset.x * c + offset.z * s, offset.y, -offset.x * s + offset.z * c);
+        break;
+    }
+    case HeadlessCameraPath::DOLLY:
+        offset *= 1.0f - 0.5f * std::sin(glm::pi<float>() * progress);
+        break;
+    }
+
+    camera.m_Position = anchor.focus + offset;
+    const glm::vec3 direction = glm::normalize(-offset);
+    camera.m_EulerRotation.x = glm::degrees(std::asin(glm::clamp(direction.y, -1.0f, 1.0f)));
+    camera.m_EulerRotation.y = glm::degrees(std::atan2(direction.z, direction.x));
+}
+
+struct StageSummary {
+    StageTimingSummary timing{};
+    uint64_t sumNs = 0;
+};
+
+// Feeds the run through the same histogram the live Stats panel uses, with a window holding every measured frame.
+template <typename TSelector>
+StageSummary Summarize(const std::vector<HeadlessFrameTiming>& frames, TSelector&& selector, uint64_t budgetNs = 0) {
+    StageSummary summary{};
+    StageHistogram histogram(frames.size());
+    for (const HeadlessFrameTiming& frame : frames) {
+        const uint64_t value = selector(frame);
+        histogram.Record(value);
+        summary.sumNs += value;
+    }
+    summary.timing = histogram.Summarize(budgetNs);
+    return summary;
+}
+
+void PrintStage(const char* name, const StageSummary& summary, size_t frameCount) {
+    std::printf("  %-16s avg %9.3f  min %9.3f  p50 %9.3f  p95 %9.3f  p99 %9.3f  max %9.3f ms\n",
+                name,
+                ToMilliseconds(summary.sumNs) / static_cast<double>(std::max<size_t>(frameCount, 1)),
+                ToMilliseconds(summary.timing.minNs),
+                ToMilliseconds(summary.timing.medianNs),
+                ToMilliseconds(summary.timing.p95Ns),
+                ToMilliseconds(summary.timing.p99Ns),
+                ToMilliseconds(summary.timing.maxNs));
+}
+
+constexpr const char* kBundledPerfSceneDirectory = "scenes";
+
+constexpr Config::RenderPreset kDiscoveredPresets[] = {
+    Config::RenderPreset::DEFAULT,
+    Config::RenderPreset::PICO8,
+    Config::RenderPreset::PICOCAD,
+    Config::RenderPreset::PS1,
+};
+
+std::string DescribeCase(const PerfCase& perfCase) {
+    return perfCase.scenePath.generic_string() + " [" + GetRenderPresetName(perfCase.preset) + ", " +
+           GetCameraPathName(perfCase.cameraPath) + "]";
+}
+
+void AppendDiscoveredCases(const std::filesystem::path& scenePath, std::vector<PerfBaselineEntry>& entries) {
+    for (const Config::RenderPreset preset : kDiscoveredPresets) {
+        PerfBaselineEntry entry{};
+        entry.perfCase.scenePath = scenePath;
+        entry.perfCase.preset = preset;
+        entry.perfCase.cameraPath = HeadlessCameraPath::ORBIT;
+        entries.push_back(std::move(entry));
+    }
+}
+
+// Example scenes plus the scenes shipped next to the baseline, so a fresh checkout without downloaded assets can
+// still record one.
+std::vector<PerfBaselineEntry> DiscoverPerfCases(const std::filesystem::path& baselineDirectory) {
+    std::vector<PerfBaselineEntry> entries;
+    ExampleSceneCatalog catalog;
+    if (catalog.Refresh()) {
+        for (const ExampleSceneEntry& scene : catalog.GetScenes()) {
+            AppendDiscoveredCases(scene.relativePath, entries);
+        }
+    }
+
+    const std::filesystem::path bundledDirectory = baselineDirectory / kBundledPerfSceneDirectory;
+    std::error_code errorCode;
+    if (!std::filesystem::is_directory(bundledDirectory, errorCode)) {
+        return entries;
+    }
+    std::vector<std::filesystem::path> bundledScenes;
+    for (const auto& file : std::filesystem::directory_iterator(bundledDirectory, errorCode)) {
+        if (file.is_regular_file() && file.path().extension() == ".obj") {
+            bundledScenes.push_back(std::filesystem::path(kBundledPerfSceneDirectory) / file.path().filename());
+        }
+    }
+    std::sort(bundledScenes.begin(), bundledScenes.end());
+    for (const std::filesystem::path& scenePath : bundledScenes) {
+        AppendDiscoveredCases(scenePath, entries);
+    }
+    return entries;
+}
+
+// Adds every discovered case the baseline does not list yet, so a new example or bundled scene has to be recorded
+// before the suite passes again.
+void AppendUnlistedPerfCases(const std::filesystem::path& baselineDirectory, std::vector<PerfBaselineEntry>& entries) {
+    for (PerfBaselineEntry& discovered : DiscoverPerfCases(baselineDirectory)) {
+        const bool listed = std::any_of(entries.begin(), entries.end(), [&](const PerfBaselineEntry& entry) {
+            return entry.perfCase.scenePath == discovered.perfCase.scenePath &&
+                   entry.perfCase.preset == discovered.perfCase.preset &&
+                   entry.perfCase.cameraPath == discovered.perfCase.cameraPath;
+        });
+        if (!listed) {
+            entries.push_back(std::move(discovered));
+        }
+    }
+}
+
+// Scenes shipped next to the baseline win over example scenes with the same relative path.
+std::filesystem::path ResolvePerfScenePath(const std::filesystem::path& baselineDirectory,
+                                           const ExampleSceneCatalog& catalog,
+                                           const std::filesystem::path& scenePath) {
+    const std::filesystem::path bundledPath = baselineDirectory / scenePath;
+    std::error_code errorCode;
+    if (std::filesystem::is_regular_file(bundledPath, errorCode)) {
+        return bundledPath;
+    }
+    return catalog.GetRootPath() / scenePath;
+}
+
+void PrintMetrics(const PerfMetrics& metrics) {
+    std::printf("    median %8.3f ms  p95 %8.3f ms  p99 %8.3f ms  %10.4g tris/s  %10.4g px/s\n",
+                metrics.medianFrameMs,
+                metrics.p95FrameMs,
+                metrics.p99FrameMs,
+                metrics.trianglesPerSecond,
+                metrics.pixelsPerSecond);
+}
+} // namespace
+
+bool RunHeadless(const HeadlessOptions& options, HeadlessRunResult& outResult) {
+    outResult = {};
+
+    auto config = std::make_shared<Config>();
+    auto stats = std::make_shared<Stats>();
+    if (options.preset.has_value()) {
+        Config::ApplyRenderPreset(*config, *options.preset);
+    }
+    config->renderer.selectedRenderer = Config::RendererType::SOFTWARE;
+    if (options.resolution.has_value()) {
+        config->renderer.resolution = *options.resolution;
+    }
+
+    ExampleSceneBaseline baseline{};
+    const bool hasBaseline = ResolveBaseline(options, baseline);
+    if (hasBaseline) {
+        ApplyExampleSceneBaselineToConfig(baseline, *config);
+    }
+    // Perf throughput is derived from the raster counters, so scene runs always collect them.
+    config->software.rasterizer.collectCounters = true;
+    outResult.resolution = config->renderer.resolution;
+
+    MaterialManager materialManager;
+    RenderSystem renderSystem(config, stats, materialManager);
+    if (!renderSystem.Init()) {
+        outResult.errorMessage = "Failed to initialize the render system.";
+        return false;
+    }
+    SceneManager sceneManager;
+    sceneManager.BindDependencies(config, renderSystem);
+    materialManager.BindRenderServices(renderSystem);
+    materialManager.BindSceneAccessor([&sceneManager]() { return sceneManager.GetScene(); });
+    if (!materialManager.Init()) {
+        outResult.errorMessage = "Failed to initialize the material manager.";
+        return false;
+    }
+
+    const auto loadStart = TimingClock::now();
+    const std::string scenePath = options.scenePath.string();
+    if (!sceneManager.LoadScene(scenePath)) {
+        outResult.errorMessage = "Failed to load scene " + scenePath + ".";
+        return false;
+    }
+    renderSystem.OnLoadScene(SceneLoadEvent{scenePath});
+    outResult.sceneLoadNs = ElapsedNanoseconds(loadStart);
+
+    const std::shared_ptr<Scene> scene = sceneManager.GetScene();
+    Camera* camera = sceneManager.GetCamera();
+    if (!scene || camera == nullptr) {
+        outResult.errorMessage = "Scene loaded without a camera.";
+        return false;
+    }
+    if (hasBaseline) {
+        ApplyBaselineToScene(baseline, materialManager, *config, *scene, *camera);
+        sceneManager.NotifySceneMutated();
+    }
+
+    if (!CreateOutputDirectory(options, outResult)) {
+        return false;
+    }
+    RenderPacketCaptureWriter packetCapture;
+    if (options.capturePath.has_value() && !packetCapture.Open(*options.capturePath, outResult.errorMessage)) {
+        return false;
+    }
+
+    // Animated scenes step one clip frame per rendered frame; material time follows the clip rate either way so
+    // repeated runs render identical images.
+    const SceneAnimationClip& clip = sceneManager.GetAnimationClip();
+    const bool animate = !clip.tracks.empty();
+    const int fps = std::max(clip.fps, 1);
+    const int clipLength = std::max(clip.endFrame - clip.startFrame + 1, 1);
+    const int totalFrames = options.warmupFrames + options.frameCount;
+    FrameClock materialClock = FrameClock::FixedStep(1.0 / static_cast<double>(fps));
+    const CameraPathAnchor cameraAnchor = MakeCameraPathAnchor(*scene, *camera);
+    outResult.frames.reserve(static_cast<size_t>(options.frameCount));
+    const bool trackAllocations = RETRO_ALLOCATION_TRACKING && options.trackAllocations;
+    const AllocationTrackingScope allocationTracking(trackAllocations);
+    for (int frameIndex = 0; frameIndex < totalFrames; frameIndex++) {
+        const bool measured = frameIndex >= options.warmupFrames;
+        const int outputFrame = frameIndex - options.warmupFrames;
+        RETRO_TRACE_ZONE("Headless frame");
+        HeadlessFrameTiming timing{};
+        if (trackAllocations) {
+            // Drops whatever the previous iteration freed after its report was taken.
+            AllocationTracker::EndFrame();
+        }
+        const auto frameStart = TimingClock::now();
+
+        {
+            RETRO_ALLOCATION_TAG(SCENE);
+            const auto updateStart = TimingClock::now();
+            if (animate) {
+                sceneManager.SetAnimationPlayheadFrame(clip.startFrame + frameIndex % clipLength);
+            }
+            ApplyCameraPath(options.cameraPath,
+                            cameraAnchor,
+                            static_cast<float>(frameIndex) / static_cast<float>(totalFrames),
+                            *camera);
+            sceneManager.Update(0, config->renderer.resolution);
+            sceneManager.NewFrame();
+            timing.sceneUpdateNs = ElapsedNanoseconds(updateStart);
+        }
+
+        std::shared_ptr<const RenderPacket> packet;
+        {
+            RETRO_ALLOCATION_TAG(RENDER_PACKET);
+            const auto packetStart = TimingClock::now();
+            packet = renderSystem.BuildRenderPacket(scene, camera, materialClock.GetSeconds());
+            materialClock.Tick(0);
+            timing.packetBuildNs = ElapsedNanoseconds(packetStart);
+        }
+        if (!RenderHeadlessFrame(options, renderSystem, *stats, packet, measured, outputFrame, timing, outResult)) {
+            return false;
+        }
+        timing.totalNs = ElapsedNanoseconds(frameStart);
+        if (trackAllocations) {
+            RecordFrameAllocations(measured, timing, outResult);
+        }
+        // Outside the frame's timing and allocation counts.
+        if (measured && packetCapture.IsOpen() && !packetCapture.WritePacket(*packet, outResult.errorMessage)) {
+            return false;
+        }
+        if (measured) {
+            outResult.frames.push_back(timing);
+        }
+    }
+    if (!packetCapture.Close(outResult.errorMessage)) {
+        return false;
+    }
+
+    const ProcessMemorySnapshot memorySnapshot = MemoryProfiler::SampleProcessMemory();
+    if (memorySnapshot.supported) {
+        outResult.peakResidentBytes = memorySnapshot.peakResidentBytes;
+    }
+    renderSystem.Destroy();
+    return true;
+}
+
+bool RunReplay(const HeadlessOptions& options, HeadlessRunResult& outResult) {
+    outResult = {};
+    if (!options.replayPath.has_value()) {
+        outResult.errorMessage = "No capture given.";
+        return false;
+    }
+
+    const auto loadStart = TimingClock::now();
+    RenderPacketCapture capture;
+    if (!LoadRenderPacketCapture(*options.replayPath, capture, outResult.errorMessage)) {
+        return false;
+    }
+    outResult.sceneLoadNs = ElapsedNanoseconds(loadStart);
+    if (capture.truncated) {
+        LOGW("%s ends inside a record; replaying the %zu complete packets",
+             options.replayPath->generic_string().c_str(),
+             capture.packets.size());
+    }
+
+    // Packets carry their own config snapshot; the render system's config only decides the target size.
+    auto config = std::make_shared<Config>(capture.packets.front()->configSnapshot);
+    auto stats = std::make_shared<Stats>();
+    config->renderer.selectedRenderer = Config::RendererType::SOFTWARE;
+    if (options.resolution.has_value()) {
+        config->renderer.resolution = *options.resolution;
+    }
+    outResult.resolution = config->renderer.resolution;
+
+    MaterialManager materialManager;
+    RenderSystem renderSystem(config, stats, materialManager);
+    if (!renderSystem.Init()) {
+        outResult.errorMessage = "Failed to initialize the render system.";
+        return false;
+    }
+    materialManager.BindRenderServices(renderSystem);
+    if (!materialManager.Init()) {
+        outResult.errorMessage = "Failed to initialize the material manager.";
+        return false;
+    }
+    if (!CreateOutputDirectory(options, outResult)) {
+        return false;
+    }
+
+    const size_t packetCount = capture.packets.size();
+    const int frameCount = options.frameCount > 0 ? options.frameCount : static_cast<int>(packetCount);
+    const int totalFrames = options.warmupFrames + frameCount;
+    outResult.frames.reserve(static_cast<size_t>(frameCount));
+    const bool trackAllocations = RETRO_ALLOCATION_TRACKING && options.trackAllocations;
+    const AllocationTrackingScope allocationTracking(trackAllocations);
+    for (int frameIndex = 0; frameIndex < totalFrames; frameIndex++) {
+        const bool measured = frameIndex >= options.warmupFrames;
+        const int outputFrame = frameIndex - options.warmupFrames;
+        RETRO_TRACE_ZONE("Replay frame");
+        HeadlessFrameTiming timing{};
+        if (trackAllocations) {
+            AllocationTracker::EndFrame();
+        }
+        // Measured frame N replays captured packet N, so written images line up with the capturing run's.
+        const size_t packetIndex = static_cast<size_t>(measured ? outputFrame : frameIndex) % packetCount;
+        const std::shared_ptr<const RenderPacket>& packet = capture.packets[packetIndex];
+        const auto frameStart = TimingClock::now();
+
+        const glm::ivec2 resolution =
+            options.resolution.has_value() ? *options.resolution : packet->configSnapshot.renderer.resolution;
+        if (resolution != config->renderer.resolution) {
+            RETRO_ALLOCATION_TAG(RENDER_SYSTEM);
+            renderSystem.Resize(resolution);
+        }
+        if (!RenderHeadlessFrame(options, renderSystem, *stats, packet, measured, outputFrame, timing, outResult)) {
+            return false;
+        }
+        timing.totalNs = ElapsedNanoseconds(frameStart);
+        if (trackAllocations) {
+            RecordFrameAllocations(measured, timing, outResult);
+        }
+        if (measured) {
+            outResult.frames.push_back(timing);
+        }
+    }
+
+    const ProcessMemorySnapshot memorySnapshot = MemoryProfiler::SampleProcessMemory();
+    if (memorySnapshot.supported) {
+        outResult.peakResidentBytes = memorySnapshot.peakResidentBytes;
+    }
+    renderSystem.Destroy();
+    return true;
+}
+
+void PrintHeadlessReport(const HeadlessOptions& options, const HeadlessRunResult& result) {
+    if (options.replayPath.has_value()) {
+        std::printf("Replay:     %s\n", options.replayPath->generic_string().c_str());
+        std::printf("Resolution: %dx%d\n", result.resolution.x, result.resolution.y);
+        std::printf("Load:       %.3f ms\n", ToMilliseconds(result.sceneLoadNs));
+    } else {
+        std::printf("Scene:      %s\n", options.scenePath.generic_string().c_str());
+        std::printf("Resolution: %dx%d\n", result.resolution.x, result.resolution.y);
+        std::printf("Scene load: %.3f ms\n", ToMilliseconds(result.sceneLoadNs));
+    }
+    if (options.printFrameTimings) {
+        for (size_t i = 0; i < result.frames.size(); i++) {
+            const HeadlessFrameTiming& frame = result.frames[i];
+            std::printf("frame %5zu: update %.3f  packet %.3f  render %.3f  copy %.3f  write %.3f  total %.3f ms  (%zu items)\n",
+                        i,
+                        ToMilliseconds(frame.sceneUpdateNs),
+                        ToMilliseconds(frame.packetBuildNs),
+                        ToMilliseconds(frame.softwareRenderNs),
+                        ToMilliseconds(frame.softwareCopyNs),
+                        ToMilliseconds(frame.writeNs),
+                        ToMilliseconds(frame.totalNs),
+                        frame.renderItems);
+        }
+    }
+
+    const size_t frameCount = result.frames.size();
+    std::printf("Frames:     %zu measured, %d warmup, %zu written\n", frameCount, options.warmupFrames, result.framesWritten);
+    PrintStage("scene update", Summarize(result.frames, [](const HeadlessFrameTiming& f) { return f.sceneUpdateNs; }), frameCount);
+    PrintStage("packet build", Summarize(result.frames, [](const HeadlessFrameTiming& f) { return f.packetBuildNs; }), frameCount);
+    PrintStage("render system", Summarize(result.frames, [](const HeadlessFrameTiming& f) { return f.renderSystemNs; }), frameCount);
+    PrintStage("  sw render", Summarize(result.frames, [](const HeadlessFrameTiming& f) { return f.softwareRenderNs; }), frameCount);
+    PrintStage("  sw copy", Summarize(result.frames, [](const HeadlessFrameTiming& f) { return f.softwareCopyNs; }), frameCount);
+    if (result.framesWritten > 0) {
+        PrintStage("image write", Summarize(result.frames, [](const HeadlessFrameTiming& f) { return f.writeNs; }), frameCount);
+    }
+    const StageSummary total =
+        Summarize(result.frames, [](const HeadlessFrameTiming& f) { return f.totalNs; }, kDefaultFrameBudgetNs);
+    PrintStage("frame total", total, frameCount);
+    std::printf("Over budget: %zu of %zu frames above %.3f ms\n",
+                total.timing.overBudgetCount,
+                frameCount,
+                ToMilliseconds(kDefaultFrameBudgetNs));
+    if (total.sumNs > 0) {
+        std::printf("Throughput: %.2f fps\n", static_cast<double>(frameCount) * 1e9 / static_cast<double>(total.sumNs));
+    }
+    if (result.peakResidentBytes > 0) {
+        std::printf("Peak RSS:   %.2f MiB\n", static_cast<double>(result.peakResidentBytes) / (1024.0 * 1024.0));
+    }
+    if (options.trackAllocations) {
+#if RETRO_ALLOCATION_TRACKING
+        uint64_t maxAllocations = 0;
+        uint64_t maxBytes = 0;
+        for (const HeadlessFrameTiming& frame : result.frames) {
+            maxAllocations = std::max(maxAllocations, frame.allocations);
+            maxBytes = std::max(maxBytes, frame.allocatedBytes);
+        }
+        const double frames = static_cast<double>(std::max<size_t>(frameCount, 1));
+        const AllocationCounts total = result.allocations.Total();
+        std::printf("Allocations: avg %.1f (%.0f bytes), max %" PRIu64 " (%" PRIu64 " bytes) per frame\n",
+                    static_cast<double>(total.allocations) / frames,
+                    static_cast<double>(total.bytes) / frames,
+                    maxAllocations,
+                    maxBytes);
+        for (size_t tag = 0; tag < kAllocationTagCount; tag++) {
+            const AllocationCounts& counts = result.allocations.tags[tag];
+            if (counts.allocations == 0 && counts.deallocations == 0) {
+                continue;
+            }
+            std::printf("  %-18s %9.1f allocs %9.1f frees %12.0f bytes per frame\n",
+                        GetAllocationTagName(static_cast<AllocationTag>(tag)),
+                        static_cast<double>(counts.allocations) / frames,
+                        static_cast<double>(counts.deallocations) / frames,
+                        static_cast<double>(counts.bytes) / frames);
+        }
+#else
+        std::printf("Allocations: not tracked, built without RETRO_ALLOCATION_TRACKING\n");
+#endif
+    }
+}
+
+bool RunPerfSuite(const HeadlessOptions& options, bool& outRegressed, std::string& outErrorMessage) {
+    outRegressed = false;
+    const std::filesystem::path& baselinePath = *options.perfBaselinePath;
+
+    std::vector<PerfBaselineEntry> entries;
+    std::error_code errorCode;
+    const bool baselineExists = std::filesystem::exists(baselinePath, errorCode);
+    if (baselineExists && !LoadPerfBaseline(baselinePath, entries, outErrorMessage)) {
+        return false;
+    }
+    if (!baselineExists && !options.updatePerfBaseline) {
+        outErrorMessage = "Perf baseline " + baselinePath.generic_string() + " does not exist; create it with --perf-update.";
+        return false;
+    }
+    const std::filesystem::path baselineDirectory = baselinePath.parent_path();
+    AppendUnlistedPerfCases(baselineDirectory, entries);
+    if (entries.empty()) {
+        outErrorMessage = "No perf cases in " + baselinePath.generic_string() + ": no example scenes were found and " +
+                          (baselineDirectory / kBundledPerfSceneDirectory).generic_string() + " has no scenes.";
+        return false;
+    }
+    if (!options.updatePerfBaseline) {
+        // A case without metrics cannot regress, so letting it pass would silently shrink the check.
+        const auto isUnrecorded = [](const PerfBaselineEntry& entry) {
+            return !entry.metrics.has_value();
+        };
+        const auto unrecorded = std::find_if(entries.begin(), entries.end(), isUnrecorded);
+        if (unrecorded != entries.end()) {
+            const auto unrecordedCount = std::count_if(entries.begin(), entries.end(), isUnrecorded);
+            outErrorMessage = DescribeCase(unrecorded->perfCase) + " has no recorded baseline (" +
+                              std::to_string(unrecordedCount) + " of " + std::to_string(entries.size()) +
+                              " cases); record them with --perf-update.";
+            return false;
+        }
+    }
+
+    const ExampleSceneCatalog catalog;
+    size_t regressions = 0;
+    for (PerfBaselineEntry& entry : entries) {
+        HeadlessOptions caseOptions = options;
+        caseOptions.perfBaselinePath.reset();
+        caseOptions.outputDirectory.clear();
+        caseOptions.printFrameTimings = false;
+        caseOptions.scenePath = ResolvePerfScenePath(baselineDirectory, catalog, entry.perfCase.scenePath);
+        caseOptions.preset = entry.perfCase.preset;
+        caseOptions.cameraPath = entry.perfCase.cameraPath;
+
+        std::printf("%s\n", DescribeCase(entry.perfCase).c_str());
+        HeadlessRunResult result;
+        if (!RunHeadless(caseOptions, result)) {
+            outErrorMessage = DescribeCase(entry.perfCase) + ": " + result.errorMessage;
+            return false;
+        }
+        const PerfMetrics measured = ComputePerfMetrics(result);
+        PrintMetrics(measured);
+
+        if (options.updatePerfBaseline) {
+            entry.metrics = measured;
+            continue;
+        }
+        const PerfComparison comparison = ComparePerfMetrics(*entry.metrics, measured, options.perfTolerance);
+        for (const std::string& failure : comparison.failures) {
+            std::printf("    REGRESSED: %s\n", failure.c_str());
+        }
+        if (comparison.regressed) {
+            regressions++;
+        }
+    }
+
+    if (options.updatePerfBaseline) {
+        if (!baselineDirectory.empty()) {
+            std::filesystem::create_directories(baselineDirectory, errorCode);
+        }
+        if (!SavePerfBaseline(baselinePath, entries, outErrorMessage)) {
+            return false;
+        }
+        std::printf("Recorded %zu perf cases in %s\n", entries.size(), baselinePath.generic_string().c_str());
+        return true;
+    }
+    std::printf("%zu perf cases, %zu regressed (tolerance %.0f%%)\n",
+                entries.size(),
+                regressions,
+                options.perfTolerance * 100.0);
+    outRegressed = regressions > 0;
+    return true;
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "HeadlessOptions.h"
+#include "../Base/AllocationTracker.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RetroRenderer {
+
+// Per-stage wall times of one rendered frame, taken from Stats after the frame completes.
+struct HeadlessFrameTiming {
+    uint64_t sceneUpdateNs = 0;
+    uint64_t packetBuildNs = 0;
+    uint64_t renderSystemNs = 0;
+    uint64_t softwareRenderNs = 0;
+    uint64_t softwareCopyNs = 0;
+    uint64_t writeNs = 0;
+    uint64_t totalNs = 0;
+    size_t renderItems = 0;
+    // Triangles in the packet's render items, before any culling in the software renderer.
+    uint64_t submittedTriangles = 0;
+    // From the software RasterCounters: triangles that reached pixel traversal and pixels run through shading. Zero
+    // when the packet's config does not collect counters or the build sets RETRO_RASTER_COUNTERS=0.
+    uint64_t rasterizedTriangles = 0;
+    uint64_t shadedPixels = 0;
+    // Occlusion pyramid work in the software renderer: full builds and level-0 tiles rescanned, including the build's.
+    uint64_t occlusionFullBuilds = 0;
+    uint64_t occlusionTilesRescanned = 0;
+    uint64_t occlusionCulledItems = 0;
+    // Heap allocations made during the frame; zero unless HeadlessOptions::trackAllocations is set.
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+};
+
+struct HeadlessRunResult {
+    glm::ivec2 resolution{0, 0};
+    uint64_t sceneLoadNs = 0;
+    // Measured frames only; warmup frames are not recorded.
+    std::vector<HeadlessFrameTiming> frames;
+    size_t framesWritten = 0;
+    uint64_t peakResidentBytes = 0;
+    // Per-tag allocations summed over the measured frames, when allocations were tracked.
+    AllocationFrameReport allocations{};
+    std::string errorMessage;
+};
+
+// Loads the scene through SceneManager and renders it with RenderSystem's software path on the calling thread. No
+// SDL video subsystem, GL context or ImGui context is created, so this runs on machines without a display or GPU.
+bool RunHeadless(const HeadlessOptions& options, HeadlessRunResult& outResult);
+
+// Renders the packets of options.replayPath the same way, without loading a scene, so renderer changes can be
+// profiled against identical input. sceneLoadNs holds the time spent reading the capture.
+bool RunReplay(const HeadlessOptions& options, HeadlessRunResult& outResult);
+
+void PrintHeadlessReport(const HeadlessOptions& options, const HeadlessRunResult& result);
+
+// Renders every case of options.perfBaselinePath with RunHeadless and compares or records it (see PerfRegression.h).
+// Returns false on setup failures such as a missing baseline or an unloadable scene; regressions are reported
+// through outRegressed.
+bool RunPerfSuite(const HeadlessOptions& options, bool& outRegressed, std::string& outErrorMessage);
+
+} // namespace RetroRenderer
@@ -0,0 +1,209 @@
+#include "PerfRegression.h"
+#include "../Renderer/Software/RasterCounters.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace RetroRenderer {
+namespace {
+bool ParseDouble(const std::string& text, double& outValue) {
+    if (text.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    const double value = std::strtod(text.c_str(), &end);
+    if (end != text.c_str() + text.size() || !std::isfinite(value) || value < 0.0) {
+        return false;
+    }
+    outValue = value;
+    return true;
+}
+
+// Nearest-rank percentile of an ascending list.
+double Percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+void CheckUpperBound(const char* name, double baseline, double measured, double tolerance, PerfComparison& comparison) {
+    if (baseline > 0.0 && measured > baseline * (1.0 + tolerance)) {
+        char line[160];
+        std::snprintf(line, sizeof(line), "%s %.3f ms exceeds baseline %.3f ms by %.1f%%", name, measured, baseline,
+                      (measured / baseline - 1.0) * 100.0);
+        comparison.failures.emplace_back(line);
+        comparison.regressed = true;
+    }
+}
+
+void CheckLowerBound(const char* name, double baseline, double measured, double tolerance, PerfComparison& comparison) {
+    if (baseline > 0.0 && measured * (1.0 + tolerance) < baseline) {
+        char line[160];
+        std::snprintf(line, sizeof(line), "%s %.4g/s is %.1f%% below baseline %.4g/s", name, measured,
+                      (1.0 - measured / baseline) * 100.0, baseline);
+        comparison.failures.emplace_back(line);
+        comparison.regressed = true;
+    }
+}
+} // namespace
+
+bool LoadPerfBaseline(const std::filesystem::path& path,
+                      std::vector<PerfBaselineEntry>& outEntries,
+                      std::string& outErrorMessage) {
+    outEntries.clear();
+    std::ifstream input(path);
+    if (!input) {
+        outErrorMessage = "Could not open perf baseline " + path.generic_string() + ".";
+        return false;
+    }
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        const size_t firstNonSpace = line.find_first_not_of(" \t");
+        if (firstNonSpace == std::string::npos || line[firstNonSpace] == '#') {
+            continue;
+        }
+
+        // The scene path comes last and runs to the end of the line, so it may contain spaces.
+        const size_t sceneKey = line.find("scene=");
+        if (sceneKey == std::string::npos || line.size() == sceneKey + 6) {
+            outErrorMessage = path.generic_string() + ":" + std::to_string(lineNumber) + ": missing scene=.";
+            return false;
+        }
+        PerfBaselineEntry entry{};
+        entry.perfCase.scenePath = line.substr(sceneKey + 6);
+
+        PerfMetrics metrics{};
+        int metricCount = 0;
+        std::istringstream fields(line.substr(0, sceneKey));
+        std::string field;
+        while (fields >> field) {
+            const size_t separator = field.find('=');
+            const std::string key = field.substr(0, separator);
+            const std::string value = separator == std::string::npos ? std::string{} : field.substr(separator + 1);
+            bool valid = true;
+            if (key == "preset") {
+                valid = ParseRenderPresetName(value, entry.perfCase.preset);
+            } else if (key == "camera") {
+                valid = ParseCameraPathName(value, entry.perfCase.cameraPath);
+            } else if (key == "median_ms") {
+                valid = ParseDouble(value, metrics.medianFrameMs);
+                metricCount++;
+            } else if (key == "p95_ms") {
+                valid = ParseDouble(value, metrics.p95FrameMs);
+                metricCount++;
+            } else if (key == "p99_ms") {
+                valid = ParseDouble(value, metrics.p99FrameMs);
+                metricCount++;
+            } else if (key == "tris_per_s") {
+                valid = ParseDouble(value, metrics.trianglesPerSecond);
+                metricCount++;
+            } else if (key == "pixels_per_s") {
+                valid = ParseDouble(value, metrics.pixelsPerSecond);
+                metricCount++;
+            } else {
+                valid = false;
+            }
+            if (!valid) {
+                outErrorMessage = path.generic_string() + ":" + std::to_string(lineNumber) + ": invalid field '" + field + "'.";
+                return false;
+            }
+        }
+        if (metricCount != 0 && metricCount != 5) {
+            outErrorMessage = path.generic_string() + ":" + std::to_string(lineNumber) +
+                              ": recorded cases need all of median_ms, p95_ms, p99_ms, tris_per_s and pixels_per_s.";
+            return false;
+        }
+        if (metricCount == 5) {
+            entry.metrics = metrics;
+        }
+        outEntries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool SavePerfBaseline(const std::filesystem::path& path,
+                      const std::vector<PerfBaselineEntry>& entries,
+                      std::string& outErrorMessage) {
+    std::ofstream output(path, std::ios::trunc);
+    if (!output) {
+        outErrorMessage = "Could not write perf baseline " + path.generic_string() + ".";
+        return false;
+    }
+    output << "# Scene perf-regression baseline for retrorenderer_headless --perf-baseline.\n"
+              "# Record on the reference machine with --perf-update; compare runs must use the same frame, warmup and\n"
+              "# resolution options. Compare runs fail while any listed case has no metrics.\n";
+    for (const PerfBaselineEntry& entry : entries) {
+        output << "preset=" << GetRenderPresetName(entry.perfCase.preset) << " camera="
+               << GetCameraPathName(entry.perfCase.cameraPath);
+        if (entry.metrics.has_value()) {
+            char values[256];
+            std::snprintf(values, sizeof(values), " median_ms=%.4f p95_ms=%.4f p99_ms=%.4f tris_per_s=%.6g pixels_per_s=%.6g",
+                          entry.metrics->medianFrameMs,
+                          entry.metrics->p95FrameMs,
+                          entry.metrics->p99FrameMs,
+                          entry.metrics->trianglesPerSecond,
+                          entry.metrics->pixelsPerSecond);
+            output << values;
+        }
+        output << " scene=" << entry.perfCase.scenePath.generic_string() << "\n";
+    }
+    if (!output) {
+        outErrorMessage = "Failed while writing perf baseline " + path.generic_string() + ".";
+        return false;
+    }
+    return true;
+}
+
+PerfMetrics ComputePerfMetrics(const HeadlessRunResult& result) {
+    PerfMetrics metrics{};
+    if (result.frames.empty()) {
+        return metrics;
+    }
+
+    std::vector<double> frameMs;
+    frameMs.reserve(result.frames.size());
+    uint64_t totalNs = 0;
+    uint64_t totalTriangles = 0;
+    uint64_t totalPixels = 0;
+    for (const HeadlessFrameTiming& frame : result.frames) {
+        frameMs.push_back(static_cast<double>(frame.totalNs) / 1e6);
+        totalNs += frame.totalNs;
+        totalTriangles += frame.rasterizedTriangles;
+        totalPixels += frame.shadedPixels;
+    }
+    std::sort(frameMs.begin(), frameMs.end());
+    metrics.medianFrameMs = Percentile(frameMs, 0.50);
+    metrics.p95FrameMs = Percentile(frameMs, 0.95);
+    metrics.p99FrameMs = Percentile(frameMs, 0.99);
+    if (totalNs > 0) {
+        const double seconds = static_cast<double>(totalNs) / 1e9;
+        metrics.trianglesPerSecond = static_cast<double>(totalTriangles) / seconds;
+        metrics.pixelsPerSecond = static_cast<double>(totalPixels) / seconds;
+    }
+    return metrics;
+}
+
+PerfComparison ComparePerfMetrics(const PerfMetrics& baseline, const PerfMetrics& measured, double tolerance) {
+    PerfComparison comparison{};
+    CheckUpperBound("median frame", baseline.medianFrameMs, measured.medianFrameMs, tolerance, comparison);
+    CheckUpperBound("p95 frame", baseline.p95FrameMs, measured.p95FrameMs, tolerance, comparison);
+    CheckUpperBound("p99 frame", baseline.p99FrameMs, measured.p99FrameMs, tolerance, comparison);
+#if RETRO_RASTER_COUNTERS
+    CheckLowerBound("triangles", baseline.trianglesPerSecond, measured.trianglesPerSecond, tolerance, comparison);
+    CheckLowerBound("pixels", baseline.pixelsPerSecond, measured.pixelsPerSecond, tolerance, comparison);
+#endif
+    return comparison;
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "HeadlessRenderer.h"
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace RetroRenderer {
+
+struct PerfCase {
+    // Relative to the baseline file's directory when a scene exists there (the bundled scenes/ cases), otherwise to
+    // the example scene root (assets/), as listed by ExampleSceneCatalog.
+    std::filesystem::path scenePath;
+    Config::RenderPreset preset = Config::RenderPreset::DEFAULT;
+    HeadlessCameraPath cameraPath = HeadlessCameraPath::ORBIT;
+};
+
+struct PerfMetrics {
+    double medianFrameMs = 0.0;
+    double p95FrameMs = 0.0;
+    double p99FrameMs = 0.0;
+    double trianglesPerSecond = 0.0;
+    double pixelsPerSecond = 0.0;
+};
+
+struct PerfBaselineEntry {
+    PerfCase perfCase;
+    // Unset until the case has been recorded with --perf-update; a compare run fails while any case is unset.
+    std::optional<PerfMetrics> metrics;
+};
+
+struct PerfComparison {
+    bool regressed = false;
+    // One line per metric outside the tolerance band.
+    std::vector<std::string> failures;
+};
+
+bool LoadPerfBaseline(const std::filesystem::path& path,
+                      std::vector<PerfBaselineEntry>& outEntries,
+                      std::string& outErrorMessage);
+bool SavePerfBaseline(const std::filesystem::path& path,
+                      const std::vector<PerfBaselineEntry>& entries,
+                      std::string& outErrorMessage);
+
+// Frame times are each frame's total wall time; throughput divides the rasterized triangles and shaded pixels from the
+// software RasterCounters by the summed frame time.
+PerfMetrics ComputePerfMetrics(const HeadlessRunResult& result);
+// Frame times may grow and throughput may drop by at most `tolerance` (a fraction) of the baseline value. Builds with
+// RETRO_RASTER_COUNTERS=0 measure no throughput, so they only compare frame times.
+PerfComparison ComparePerfMetrics(const PerfMetrics& baseline, const PerfMetrics& measured, double tolerance);
+
+} // namespace RetroRenderer
@@ -0,0 +1,562 @@
+#include "AnimationSequenceRenderer.h"
+#include "../Scene/SceneManager.h"
+#include "RenderSystem.h"
+#include "Software/SWRenderer.h"
+#include <KrisLogger/Logger.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <system_error>
+#include <vector>
+#if !defined(__EMSCRIPTEN__)
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace RetroRenderer {
+namespace {
+using TimingClock = std::chrono::steady_clock;
+
+// Frames each worker may have queued before packet building pauses until the next Tick().
+constexpr size_t kFramesInFlightPerWorker = 2;
+
+uint64_t ElapsedNanoseconds(TimingClock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(TimingClock::now() - start).count());
+}
+
+std::filesystem::path MakeFramePath(const AnimationExportSettings& settings, int frame) {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "_%05d", frame);
+    const char* extension = settings.format == ImageSequenceFormat::PNG ? ".png" : ".ppm";
+    return settings.outputDirectory / (settings.fileStem + suffix + extension);
+}
+
+bool WritePpm(const std::filesystem::path& path, const CpuFrame& frame, std::string& outErrorMessage) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        outErrorMessage = "Could not open " + path.generic_string() + " for writing.";
+        return false;
+    }
+
+    file << "P6\n" << frame.width << ' ' << frame.height << "\n255\n";
+    std::vector<uint8_t> row(frame.width * 3);
+    const size_t pixelsPerRow = frame.pitch / sizeof(Pixel);
+    for (size_t y = 0; y < frame.height; y++) {
+        const Pixel* source = frame.pixels.data() + y * pixelsPerRow;
+        for (size_t x = 0; x < frame.width; x++) {
+            row[x * 3 + 0] = source[x].r;
+            row[x * 3 + 1] = source[x].g;
+            row[x * 3 + 2] = source[x].b;
+        }
+        file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+    if (!file) {
+        outErrorMessage = "Failed to write " + path.generic_string() + ".";
+        return false;
+    }
+    return true;
+}
+
+bool WritePng(const std::filesystem::path& path, const CpuFrame& frame, std::string& outErrorMessage) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<Pixel*>(frame.pixels.data()),
+                                                              static_cast<int>(frame.width),
+                                                              static_cast<int>(frame.height),
+                                                              32,
+                                                              static_cast<int>(frame.pitch),
+                                                              SDL_PIXELFORMAT_RGBA32);
+    if (surface == nullptr) {
+        outErrorMessage = std::string("Failed to wrap frame for PNG encoding: ") + SDL_GetError();
+        return false;
+    }
+    const int status = IMG_SavePNG(surface, path.string().c_str());
+    SDL_FreeSurface(surface);
+    if (status != 0) {
+        outErrorMessage = "Failed to write " + path.generic_string() + ": " + IMG_GetError();
+        return false;
+    }
+    return true;
+}
+
+unsigned int ResolveWorkerCount(unsigned int requested) {
+#if defined(__EMSCRIPTEN__)
+    (void)requested;
+    return 1;
+#else
+    if (requested > 0) {
+        return requested;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+} // namespace
+
+struct ExportJob {
+    int frame = 0;
+    std::shared_ptr<const RenderPacket> packet;
+};
+
+// Software renderers fed from a shared job queue. Finished frames wait in a reorder buffer keyed by frame number
+// and are written strictly in sequence, so the files on disk always form a gap-free prefix of the range. The first
+// failure drops the remaining jobs.
+class ExportRenderWorkers {
+  public:
+    ~ExportRenderWorkers() {
+        Stop();
+    }
+
+    bool Start(unsigned int workerCount,
+               const AnimationExportSettings& settings,
+               int firstFrame,
+               int width,
+               int height) {
+#if defined(__EMSCRIPTEN__)
+        workerCount = 1;
+#endif
+        m_Settings = settings;
+        m_NextWriteFrame = firstFrame;
+        m_Renderers.reserve(workerCount);
+        for (unsigned int i = 0; i < workerCount; i++) {
+            auto renderer = std::make_unique<SWRenderer>();
+            if (!renderer->Init(width, height)) {
+                return false;
+            }
+            m_Renderers.push_back(std::move(renderer));
+        }
+#if !defined(__EMSCRIPTEN__)
+        m_Threads.reserve(workerCount);
+        for (auto& renderer : m_Renderers) {
+            m_Threads.emplace_back([this, rendererPtr = renderer.get()]() { WorkerLoop(*rendererPtr); });
+        }
+#endif
+        return true;
+    }
+
+    void Submit(ExportJob job) {
+#if defined(__EMSCRIPTEN__)
+        m_PendingCount++;
+        RunJob(*m_Renderers.front(), TakeFreeFrame(), job);
+#else
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_PendingCount++;
+            m_Jobs.push_back(std::move(job));
+        }
+        m_JobCv.notify_one();
+#endif
+    }
+
+    void WaitForProgress() {
+#if !defined(__EMSCRIPTEN__)
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        const size_t finishedBefore = m_FramesWritten;
+        m_ProgressCv.wait(lock, [&]() {
+            return m_PendingCount == 0 || m_FramesWritten != finishedBefore || !m_ErrorMessage.empty();
+        });
+#endif
+    }
+
+    void Stop() {
+#if !defined(__EMSCRIPTEN__)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_StopRequested = true;
+            m_PendingCount -= m_Jobs.size() + m_ReadyFrames.size();
+            m_Jobs.clear();
+            m_ReadyFrames.clear();
+        }
+        m_JobCv.notify_all();
+        for (std::thread& thread : m_Threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        m_Threads.clear();
+#endif
+        for (auto& renderer : m_Renderers) {
+            renderer->Destroy();
+        }
+        m_Renderers.clear();
+    }
+
+    [[nodiscard]] size_t GetPendingCount() const {
+#if !defined(__EMSCRIPTEN__)
+        std::lock_guard<std::mutex> lock(m_Mutex);
+#endif
+        return m_PendingCount;
+    }
+
+    [[nodiscard]] size_t GetFramesWritten() const {
+#if !defined(__EMSCRIPTEN__)
+        std::lock_guard<std::mutex> lock(m_Mutex);
+#endif
+        return m_FramesWritten;
+    }
+
+    [[nodiscard]] bool GetError(std::string& outErrorMessage) const {
+#if !defined(__EMSCRIPTEN__)
+        std::lock_guard<std::mutex> lock(m_Mutex);
+#endif
+        if (m_ErrorMessage.empty()) {
+            return false;
+        }
+        outErrorMessage = m_ErrorMessage;
+        return true;
+    }
+
+    // Valid after Stop().
+    [[nodiscard]] uint64_t GetRenderNs() const {
+        return m_RenderNs;
+    }
+    [[nodiscard]] uint64_t GetWriteNs() const {
+        return m_WriteNs;
+    }
+
+  private:
+    // Called with m_Mutex held on threaded builds.
+    CpuFrame TakeFreeFrame() {
+        if (m_FreeFrames.empty()) {
+            return CpuFrame{};
+        }
+        CpuFrame frame = std::move(m_FreeFrames.back());
+        m_FreeFrames.pop_back();
+        return frame;
+    }
+
+    void RunJob(SWRenderer& renderer, CpuFrame frame, const ExportJob& job) {
+        const auto renderStart = TimingClock::now();
+        const glm::ivec2 resolution = job.packet->configSnapshot.renderer.resolution;
+        const Buffer<Pixel>& target = renderer.GetFrameBuffer();
+        if (static_cast<int>(target.width) != resolution.x || static_cast<int>(target.height) != resolution.y) {
+            renderer.Resize(resolution.x, resolution.y);
+        }
+        renderer.RenderFrame(*job.packet);
+        const Buffer<Pixel>& buffer = renderer.GetFrameBuffer();
+        frame.width = buffer.width;
+        frame.height = buffer.height;
+        frame.pitch = buffer.pitch;
+        frame.frameId = static_cast<uint64_t>(job.frame);
+        frame.dataRevision = job.packet->dataRevision;
+        frame.pixels.resize(buffer.GetCount());
+        if (!frame.pixels.empty()) {
+            std::memcpy(frame.pixels.data(), buffer.data, frame.pixels.size() * sizeof(Pixel));
+        }
+        const uint64_t renderNs = ElapsedNanoseconds(renderStart);
+
+        {
+#if !defined(__EMSCRIPTEN__)
+            std::lock_guard<std::mutex> lock(m_Mutex);
+#endif
+            m_RenderNs += renderNs;
+            if (!m_ErrorMessage.empty()) {
+                m_PendingCount--;
+                m_FreeFrames.push_back(std::move(frame));
+                return;
+            }
+            m_ReadyFrames.emplace(job.frame, std::move(frame));
+            if (m_WriterActive) {
+                return;
+            }
+            m_WriterActive = true;
+        }
+        WriteReadyFrames();
+    }
+
+    // Writes buffered frames for as long as the next one in sequence is ready. One thread holds the writer role at
+    // a time; a frame finishing ahead of its predecessors stays buffered until the writer reaches it. The buffer
+    // never holds more than the frames in flight, which Tick() already bounds.
+    void WriteReadyFrames() {
+        while (true) {
+            CpuFrame frame{};
+            int frameNumber = 0;
+            {
+#if !defined(__EMSCRIPTEN__)
+                std::lock_guard<std::mutex> lock(m_Mutex);
+#endif
+                if (!m_ErrorMessage.empty() || m_ReadyFrames.empty() ||
+                    m_ReadyFrames.begin()->first != m_NextWriteFrame) {
+                    m_WriterActive = false;
+                    return;
+                }
+                auto node = m_ReadyFrames.extract(m_ReadyFrames.begin());
+                frameNumber = node.key();
+                frame = std::move(node.mapped());
+            }
+
+            const auto writeStart = TimingClock::now();
+            std::string errorMessage;
+            const bool written =
+                WriteCpuFrameImage(MakeFramePath(m_Settings, frameNumber), frame, m_Settings.format, errorMessage);
+            const uint64_t writeNs = ElapsedNanoseconds(writeStart);
+
+#if !defined(__EMSCRIPTEN__)
+            std::lock_guard<std::mutex> lock(m_Mutex);
+#endif
+            m_WriteNs += writeNs;
+            m_PendingCount--;
+            m_NextWriteFrame++;
+            m_FreeFrames.push_back(std::move(frame));
+            if (written) {
+                m_FramesWritten++;
+            } else if (m_ErrorMessage.empty()) {
+                m_ErrorMessage = std::move(errorMessage);
+                m_PendingCount -= m_ReadyFrames.size();
+                m_ReadyFrames.clear();
+#if !defined(__EMSCRIPTEN__)
+                m_PendingCount -= m_Jobs.size();
+                m_Jobs.clear();
+#endif
+            }
+        }
+    }
+
+#if !defined(__EMSCRIPTEN__)
+    void WorkerLoop(SWRenderer& renderer) {
+        while (true) {
+            ExportJob job{};
+            // Written frames are recycled so steady-state exports do not allocate a frame copy per image.
+            CpuFrame frame{};
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_JobCv.wait(lock, [this]() { return m_StopRequested || !m_Jobs.empty(); });
+                if (m_StopRequested) {
+                    return;
+                }
+                job = std::move(m_Jobs.front());
+                m_Jobs.pop_front();
+                frame = TakeFreeFrame();
+            }
+            RunJob(renderer, std::move(frame), job);
+            m_ProgressCv.notify_all();
+        }
+    }
+#endif
+
+  private:
+    AnimationExportSettings m_Settings;
+    std::vector<std::unique_ptr<SWRenderer>> m_Renderers;
+    size_t m_PendingCount = 0;
+    size_t m_FramesWritten = 0;
+    std::string m_ErrorMessage;
+    uint64_t m_RenderNs = 0;
+    uint64_t m_WriteNs = 0;
+    std::map<int, CpuFrame> m_ReadyFrames;
+    std::vector<CpuFrame> m_FreeFrames;
+    int m_NextWriteFrame = 0;
+    bool m_WriterActive = false;
+#if !defined(__EMSCRIPTEN__)
+    std::vector<std::thread> m_Threads;
+    std::deque<ExportJob> m_Jobs;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_JobCv;
+    std::condition_variable m_ProgressCv;
+    bool m_StopRequested = false;
+#endif
+};
+
+double AnimationExportResult::GetFramesPerSecond() const {
+    if (totalNs == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(framesWritten) * 1e9 / static_cast<double>(totalNs);
+}
+
+bool WriteCpuFrameImage(const std::filesystem::path& path,
+                        const CpuFrame& frame,
+                        ImageSequenceFormat format,
+                        std::string& outErrorMessage) {
+    if (frame.pixels.empty() || frame.width == 0 || frame.height == 0) {
+        outErrorMessage = "Cannot write an empty frame.";
+        return false;
+    }
+    switch (format) {
+    case ImageSequenceFormat::PNG:
+        return WritePng(path, frame, outErrorMessage);
+    case ImageSequenceFormat::PPM:
+        return WritePpm(path, frame, outErrorMessage);
+    }
+    outErrorMessage = "Unknown image sequence format.";
+    return false;
+}
+
+AnimationExportJob::AnimationExportJob() = default;
+
+AnimationExportJob::~AnimationExportJob() {
+    Cancel();
+}
+
+bool AnimationExportJob::Start(SceneManager& sceneManager,
+                               RenderSystem& renderSystem,
+                               const AnimationExportSettings& settings,
+                               std::string& outErrorMessage) {
+    if (m_Running) {
+        outErrorMessage = "An animation export is already running.";
+        return false;
+    }
+    const Camera* camera = sceneManager.GetCamera();
+    if (!sceneManager.GetScene() || camera == nullptr) {
+        outErrorMessage = "No scene is loaded.";
+        return false;
+    }
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(settings.outputDirectory, errorCode);
+    if (errorCode) {
+        outErrorMessage = "Could not create " + settings.outputDirectory.generic_string() + ": " + errorCode.message();
+        return false;
+    }
+
+    const SceneAnimationClip& clip = sceneManager.GetAnimationClip();
+    p_SceneManager = &sceneManager;
+    p_RenderSystem = &renderSystem;
+    p_Workers = std::make_unique<ExportRenderWorkers>();
+    m_Settings = settings;
+    m_Result = {};
+    m_Result.workerCount = ResolveWorkerCount(settings.workerCount);
+    m_Camera = *camera;
+    m_StartTime = TimingClock::now();
+    m_StartFrame = clip.startFrame;
+    m_Fps = std::max(clip.fps, 1);
+    m_FrameCount = static_cast<size_t>(clip.endFrame - clip.startFrame + 1);
+    m_NextSubmitIndex = 0;
+    m_Running = true;
+    m_Succeeded = false;
+    return true;
+}
+
+bool AnimationExportJob::Tick() {
+    if (!m_Running) {
+        return false;
+    }
+
+    std::string errorMessage;
+    if (p_Workers->GetError(errorMessage)) {
+        m_Result.errorMessage = std::move(errorMessage);
+        Finish(false);
+        return false;
+    }
+    const std::shared_ptr<Scene> scene = p_SceneManager->GetScene();
+    if (!scene) {
+        m_Result.errorMessage = "The scene was unloaded during export.";
+        Finish(false);
+        return false;
+    }
+
+    const size_t maxFramesInFlight = static_cast<size_t>(m_Result.workerCount) * kFramesInFlightPerWorker;
+    size_t pendingCount = p_Workers->GetPendingCount();
+    size_t submittedThisTick = 0;
+    if (m_NextSubmitIndex < m_FrameCount && pendingCount < maxFramesInFlight) {
+        const double livePlayhead = p_SceneManager->GetAnimationPlayheadFrame();
+        // Bounded per Tick so a frame loop never stalls on packet building; on single-worker builds this also
+        // keeps inline rendering to one export frame per displayed frame.
+        while (m_NextSubmitIndex < m_FrameCount && pendingCount < maxFramesInFlight &&
+               submittedThisTick < m_Result.workerCount) {
+            const auto packetStart = TimingClock::now();
+            const int frame = m_StartFrame + static_cast<int>(m_NextSubmitIndex);
+            p_SceneManager->PoseAnimationFrameForExport(static_cast<double>(frame));
+            p_SceneManager->NewFrame(m_Camera);
+            std::shared_ptr<const RenderPacket> packet = p_RenderSystem->BuildRenderPacket(
+                scene, &m_Camera, static_cast<float>(frame) / static_cast<float>(m_Fps));
+            m_Result.packetBuildNs += ElapsedNanoseconds(packetStart);
+
+            if (m_NextSubmitIndex == 0) {
+                const glm::ivec2 resolution = packet->configSnapshot.renderer.resolution;
+                if (!p_Workers->Start(m_Result.workerCount, m_Settings, m_StartFrame, resolution.x, resolution.y)) {
+                    m_Result.errorMessage = "Failed to create software renderers for export.";
+                    break;
+                }
+            }
+            p_Workers->Submit(ExportJob{.frame = frame, .packet = std::move(packet)});
+            m_NextSubmitIndex++;
+            submittedThisTick++;
+            pendingCount = p_Workers->GetPendingCount();
+        }
+        p_SceneManager->PoseAnimationFrameForExport(livePlayhead);
+        if (!m_Result.errorMessage.empty()) {
+            Finish(false);
+            return false;
+        }
+    }
+
+    if (p_Workers->GetError(errorMessage)) {
+        m_Result.errorMessage = std::move(errorMessage);
+        Finish(false);
+        return false;
+    }
+    if (p_Workers->GetFramesWritten() == m_FrameCount) {
+        Finish(true);
+        return false;
+    }
+    return true;
+}
+
+void AnimationExportJob::WaitForProgress() {
+    if (m_Running) {
+        p_Workers->WaitForProgress();
+    }
+}
+
+void AnimationExportJob::Cancel() {
+    if (!m_Running) {
+        return;
+    }
+    m_Result.errorMessage = "Export cancelled.";
+    Finish(false);
+}
+
+size_t AnimationExportJob::GetFramesWritten() const {
+    if (m_Running) {
+        return p_Workers->GetFramesWritten();
+    }
+    return m_Result.framesWritten;
+}
+
+void AnimationExportJob::Finish(bool success) {
+    p_Workers->Stop();
+    m_Result.framesWritten = p_Workers->GetFramesWritten();
+    m_Result.renderNs = p_Workers->GetRenderNs();
+    m_Result.writeNs = p_Workers->GetWriteNs();
+    m_Result.totalNs = ElapsedNanoseconds(m_StartTime);
+    p_Workers.reset();
+    m_Running = false;
+    m_Succeeded = success;
+
+    if (!success) {
+        LOGE("Animation export stopped after %zu frames: %s", m_Result.framesWritten, m_Result.errorMessage.c_str());
+        return;
+    }
+    LOGI("Exported %zu frames to %s in %.2f s (%.1f fps, %u workers; packets %.1f ms, render %.1f ms, write %.1f ms)",
+         m_Result.framesWritten,
+         m_Settings.outputDirectory.generic_string().c_str(),
+         static_cast<double>(m_Result.totalNs) / 1e9,
+         m_Result.GetFramesPerSecond(),
+         m_Result.workerCount,
+         static_cast<double>(m_Result.packetBuildNs) / 1e6,
+         static_cast<double>(m_Result.renderNs) / 1e6,
+         static_cast<double>(m_Result.writeNs) / 1e6);
+}
+
+bool ExportAnimationSequence(SceneManager& sceneManager,
+                             RenderSystem& renderSystem,
+                             const AnimationExportSettings& settings,
+                             AnimationExportResult& outResult) {
+    outResult = {};
+    AnimationExportJob job;
+    if (!job.Start(sceneManager, renderSystem, settings, outResult.errorMessage)) {
+        return false;
+    }
+    while (job.Tick()) {
+        job.WaitForProgress();
+    }
+    outResult = job.GetResult();
+    return job.Succeeded();
+}
+
+} // namespace RetroRenderer
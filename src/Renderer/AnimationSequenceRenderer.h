@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../Scene/Camera.h"
+#include "CpuFrame.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace RetroRenderer {
+class ExportRenderWorkers;
+class RenderSystem;
+class SceneManager;
+
+enum class ImageSequenceFormat {
+    PNG,
+    PPM,
+};
+
+struct AnimationExportSettings {
+    std::filesystem::path outputDirectory;
+    std::string fileStem = "frame";
+    ImageSequenceFormat format = ImageSequenceFormat::PNG;
+    // Software renderers working on frames in parallel; 0 uses one per hardware thread.
+    unsigned int workerCount = 0;
+};
+
+struct AnimationExportResult {
+    size_t framesWritten = 0;
+    unsigned int workerCount = 0;
+    uint64_t totalNs = 0;
+    uint64_t packetBuildNs = 0;
+    // Summed over all workers, so it can exceed totalNs.
+    uint64_t renderNs = 0;
+    uint64_t writeNs = 0;
+    std::string errorMessage;
+
+    [[nodiscard]] double GetFramesPerSecond() const;
+};
+
+// Renders every frame of the current animation clip offline without blocking the frame loop. Packets are built on
+// the thread that owns the scene, a few frames per Tick(), while private SWRenderer instances render and write the
+// images in the background. The camera is snapshotted on Start() and material time is derived from the frame
+// number, so repeated exports produce identical images. Posing for export leaves the play state and any unkeyed
+// preview pose alone, and the live playhead is put back after every Tick(), so the editor keeps showing (and
+// playing) the user's frame while the export runs. Images are written in frame order.
+class AnimationExportJob {
+  public:
+    AnimationExportJob();
+    ~AnimationExportJob();
+    AnimationExportJob(const AnimationExportJob&) = delete;
+    AnimationExportJob& operator=(const AnimationExportJob&) = delete;
+
+    bool Start(SceneManager& sceneManager,
+               RenderSystem& renderSystem,
+               const AnimationExportSettings& settings,
+               std::string& outErrorMessage);
+    // Queues packets for idle workers and finishes the job once every frame is on disk. Call it from the scene
+    // thread before the scene update. Returns true while the export is still running.
+    bool Tick();
+    // Blocks until a queued frame finishes or fails; lets callers without a frame loop drive Tick() in a loop.
+    void WaitForProgress();
+    // Drops queued frames and waits for the ones being rendered. Frames already written stay on disk and always
+    // form a contiguous run from the first frame.
+    void Cancel();
+
+    [[nodiscard]] bool IsRunning() const {
+        return m_Running;
+    }
+    [[nodiscard]] bool Succeeded() const {
+        return m_Succeeded;
+    }
+    [[nodiscard]] size_t GetFramesWritten() const;
+    [[nodiscard]] size_t GetFrameCount() const {
+        return m_FrameCount;
+    }
+    // Final once IsRunning() turns false.
+    [[nodiscard]] const AnimationExportResult& GetResult() const {
+        return m_Result;
+    }
+
+  private:
+    void Finish(bool success);
+
+  private:
+    SceneManager* p_SceneManager = nullptr;
+    RenderSystem* p_RenderSystem = nullptr;
+    std::unique_ptr<ExportRenderWorkers> p_Workers;
+    AnimationExportSettings m_Settings;
+    AnimationExportResult m_Result;
+    Camera m_Camera;
+    std::chrono::steady_clock::time_point m_StartTime;
+    int m_StartFrame = 0;
+    int m_Fps = 1;
+    size_t m_FrameCount = 0;
+    size_t m_NextSubmitIndex = 0;
+    bool m_Running = false;
+    bool m_Succeeded = false;
+};
+
+// Blocking wrapper around AnimationExportJob for tools without a frame loop.
+bool ExportAnimationSequence(SceneManager& sceneManager,
+                             RenderSystem& renderSystem,
+                             const AnimationExportSettings& settings,
+                             AnimationExportResult& outResult);
+
+bool WriteCpuFrameImage(const std::filesystem::path& path,
+                        const CpuFrame& frame,
+                        ImageSequenceFormat format,
+                        std::string& outErrorMessage);
+
+} // namespace RetroRenderer
@@ -0,0 +1,53 @@
+#include "CpuFramePool.h"
+
+namespace RetroRenderer {
+
+CpuFramePool::CpuFramePool() : p_State(std::make_shared<State>()) {
+    p_State->idleFrames.reserve(kMaxIdleFrames);
+}
+
+std::shared_ptr<CpuFrame> CpuFramePool::Acquire(size_t pixelCount) {
+    std::unique_ptr<CpuFrame> frame;
+    {
+        std::lock_guard<std::mutex> lock(p_State->mutex);
+        if (!p_State->idleFrames.empty()) {
+            frame = std::move(p_State->idleFrames.back());
+            p_State->idleFrames.pop_back();
+        }
+    }
+    if (!frame) {
+        frame = std::make_unique<CpuFrame>();
+    }
+    frame->pixels.resize(pixelCount);
+    return std::shared_ptr<CpuFrame>(frame.release(), Recycler{p_State});
+}
+
+void CpuFramePool::Clear() {
+    std::vector<std::unique_ptr<CpuFrame>> released;
+    {
+        std::lock_guard<std::mutex> lock(p_State->mutex);
+        released.swap(p_State->idleFrames);
+        p_State->idleFrames.reserve(kMaxIdleFrames);
+    }
+}
+
+uint64_t CpuFramePool::EstimateIdleBytes() const {
+    std::lock_guard<std::mutex> lock(p_State->mutex);
+    uint64_t bytes = 0;
+    for (const std::unique_ptr<CpuFrame>& frame : p_State->idleFrames) {
+        bytes += frame->EstimateResidentMemory();
+    }
+    return bytes;
+}
+
+void CpuFramePool::Recycler::operator()(CpuFrame* frame) const {
+    std::unique_ptr<CpuFrame> owned(frame);
+    if (const std::shared_ptr<State> pool = state.lock()) {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (pool->idleFrames.size() < kMaxIdleFrames) {
+            pool->idleFrames.push_back(std::move(owned));
+        }
+    }
+}
+
+} // namespace RetroRenderer
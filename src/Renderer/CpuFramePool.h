@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CpuFrame.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RetroRenderer {
+
+// Hands out CpuFrames whose pixel storage returns to the pool once the last owner (presenter, executor, headless
+// caller) releases them, so a steady stream of same-sized frames never reallocates its pixels. Frames may be acquired
+// and released on any thread; frames released after the pool is gone are simply deleted.
+class CpuFramePool {
+  public:
+    // Ready, presented and in-flight frames; anything released beyond that is freed.
+    static constexpr size_t kMaxIdleFrames = 3;
+
+    CpuFramePool();
+
+    // pixels is resized to pixelCount; its contents are left over from the frame's previous use.
+    [[nodiscard]] std::shared_ptr<CpuFrame> Acquire(size_t pixelCount);
+    // Frees the idle frames, e.g. when the software renderer is released.
+    void Clear();
+    [[nodiscard]] uint64_t EstimateIdleBytes() const;
+
+  private:
+    struct State {
+        mutable std::mutex mutex;
+        std::vector<std::unique_ptr<CpuFrame>> idleFrames;
+    };
+
+    struct Recycler {
+        std::weak_ptr<State> state;
+        void operator()(CpuFrame* frame) const;
+    };
+
+    std::shared_ptr<State> p_State;
+};
+
+} // namespace RetroRenderer
@@ -1,6 +1,7 @@
 #include "GLBackendRendererBase.h"
 
 #include <KrisLogger/Logger.h>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <glm/gtc/type_ptr.hpp>
@@ -196,6 +197,8 @@ void GLBackendRendererBase::RenderFrame(const RenderPacket& packet) {
         m_TextureResources.Clear();
         m_TextureResourceRevision = packet.textureResourceRevision;
     }
+    m_MeshResources.BeginFrame();
+    m_TextureResources.BeginFrame();
 
     m_FrameCameraSnapshot = packet.camera;
     m_FrameConfigSnapshot = packet.configSnapshot;
@@ -224,6 +227,30 @@ void GLBackendRendererBase::RenderFrame(const RenderPacket& packet) {
 
     RenderBackendOverlays();
     EndFrame();
+    EnforceResidencyBudget(packet.configSnapshot);
+}
+
+void GLBackendRendererBase::EnforceResidencyBudget(const Config& configSnapshot) {
+    if (configSnapshot.gl.residencyBudgetMiB <= 0) {
+        return;
+    }
+
+    const uint64_t budgetBytes = static_cast<uint64_t>(configSnapshot.gl.residencyBudgetMiB) * 1024ull * 1024ull;
+    // Anything drawn this frame has age 0, so at least one idle frame keeps the working set resident.
+    const uint64_t minIdleFrames = static_cast<uint64_t>(std::max(configSnapshot.gl.residencyIdleFrames, 1));
+    while (m_MeshResources.EstimateResidentMemory() + m_TextureResources.EstimateResidentMemory() > budgetBytes) {
+        uint64_t meshAge = 0;
+        uint64_t textureAge = 0;
+        const bool canEvictMesh = m_MeshResources.GetLeastRecentlyUsedAge(meshAge) && meshAge >= minIdleFrames;
+        const bool canEvictTexture = m_TextureResources.GetLeastRecentlyUsedAge(textureAge) && textureAge >= minIdleFrames;
+        if (canEvictTexture && (!canEvictMesh || textureAge >= meshAge)) {
+            m_TextureResources.EvictLeastRecentlyUsed();
+        } else if (canEvictMesh) {
+            m_MeshResources.EvictLeastRecentlyUsed();
+        } else {
+            break;
+        }
+    }
 }
 
 void GLBackendRendererBase::SetActiveCamera(const Camera& camera) {
@@ -378,6 +405,15 @@ HardwareRendererMemoryStats GLBackendRendererBase::EstimateResidentMemory() cons
     return stats;
 }
 
+HardwareResidencyStats GLBackendRendererBase::GetResidencyStats() const {
+    HardwareResidencyStats stats{};
+    stats.textureEvictions = m_TextureResources.GetResidencyCounters().evictions;
+    stats.textureReuploads = m_TextureResources.GetResidencyCounters().reuploads;
+    stats.meshEvictions = m_MeshResources.GetResidencyCounters().evictions;
+    stats.meshReuploads = m_MeshResources.GetResidencyCounters().reuploads;
+    return stats;
+}
+
 void GLBackendRendererBase::BeforeFrame(const Color& clearColor) {
     auto c = clearColor.ToImVec4();
 
@@ -23,6 +23,7 @@ class GLBackendRendererBase : public IHardwareRenderer {
     void InvalidateTextureResources() override;
     void RenderFrame(const RenderPacket& packet) override;
     [[nodiscard]] HardwareRendererMemoryStats EstimateResidentMemory() const override;
+    [[nodiscard]] HardwareResidencyStats GetResidencyStats() const override;
 
     void SetActiveCamera(const Camera& camera) override;
     void SetSceneLights(const std::vector<LightSnapshot>& lights) override;
@@ -45,6 +46,8 @@ class GLBackendRendererBase : public IHardwareRenderer {
     GLuint CreateSkyboxVAO();
     void DestroyFramebufferResources();
     void DestroyRendererResources();
+    // Evicts idle GPU textures and meshes, oldest first, until both caches fit gl.residencyBudgetMiB.
+    void EnforceResidencyBudget(const Config& configSnapshot);
     void DrawMesh(const MeshGeometryData& mesh,
                   const glm::mat4& worldTransform,
                   const Texture* texture,
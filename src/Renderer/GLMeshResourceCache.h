@@ -5,6 +5,7 @@
 #include <KrisLogger/Logger.h>
 #include <cstddef>
 #include <cstdint>
+#include <list>
 #include <unordered_map>
 
 namespace RetroRenderer {
@@ -25,40 +26,78 @@ class GLMeshResourceCache {
     GLMeshResourceCache& operator=(const GLMeshResourceCache&) = delete;
 
     const MeshGpuResources& GetOrCreate(const MeshGeometryData& mesh) {
-        return GetOrCreate(&mesh, mesh.vertices, mesh.indices);
+        return GetOrCreate(&mesh, mesh.revision, mesh.vertices, mesh.indices);
     }
 
     void Clear() {
         for (auto& entry : m_Resources) {
-            MeshGpuResources& resources = entry.second;
-            if (resources.ebo != 0) {
-                glDeleteBuffers(1, &resources.ebo);
-            }
-            if (resources.vbo != 0) {
-                glDeleteBuffers(1, &resources.vbo);
-            }
-            if (resources.vao != 0) {
-                glDeleteVertexArrays(1, &resources.vao);
-            }
+            DeleteResources(entry.second.resources);
         }
         m_Resources.clear();
+        m_LruOrder.clear();
+        m_EvictedKeys.clear();
+        m_EvictionOrder.clear();
+        m_ResidentBytes = 0;
     }
 
     [[nodiscard]] uint64_t EstimateResidentMemory() const {
-        uint64_t totalBytes = 0;
-        for (const auto& entry : m_Resources) {
-            totalBytes += entry.second.estimatedBytes;
+        return m_ResidentBytes;
+    }
+
+    // Advances the frame clock used for idle ages; meshes drawn since the last call count as referenced this frame.
+    void BeginFrame() {
+        m_Frame++;
+    }
+
+    // Frames since the least recently used mesh was last drawn; false when the cache is empty.
+    [[nodiscard]] bool GetLeastRecentlyUsedAge(uint64_t& outIdleFrames) const {
+        if (m_LruOrder.empty()) {
+            return false;
+        }
+        outIdleFrames = m_Frame - m_Resources.at(m_LruOrder.back()).lastUsedFrame;
+        return true;
+    }
+
+    // Invalidates references returned by GetOrCreate; only call between frames.
+    void EvictLeastRecentlyUsed() {
+        if (m_LruOrder.empty()) {
+            return;
         }
-        return totalBytes;
+        const auto it = m_Resources.find(m_LruOrder.back());
+        RecordEviction(it->first, it->second.revision);
+        Erase(it);
+        m_Counters.evictions++;
+    }
+
+    struct ResidencyCounters {
+        uint64_t evictions = 0;
+        uint64_t reuploads = 0;
+    };
+
+    [[nodiscard]] const ResidencyCounters& GetResidencyCounters() const {
+        return m_Counters;
     }
 
   private:
     const MeshGpuResources& GetOrCreate(const MeshGeometryData* key,
+                                        uint64_t revision,
                                         const std::vector<Vertex>& vertices,
                                         const std::vector<unsigned int>& indices) {
         auto it = m_Resources.find(key);
         if (it != m_Resources.end()) {
-            return it->second;
+            CachedMesh& cached = it->second;
+            if (cached.revision == revision) {
+                if (cached.lastUsedFrame != m_Frame) {
+                    cached.lastUsedFrame = m_Frame;
+                    m_LruOrder.splice(m_LruOrder.begin(), m_LruOrder, cached.lruPosition);
+                }
+                return cached.resources;
+            }
+            // A new geometry at a freed geometry's address.
+            Erase(it);
+        }
+        if (TakeEvictionRecord(key, revision)) {
+            m_Counters.reuploads++;
         }
 
         MeshGpuResources resources{};
@@ -98,10 +137,83 @@ class GLMeshResourceCache {
 
         resources.estimatedBytes = vertices.size() * sizeof(Vertex) + indices.size() * sizeof(unsigned int);
         LOGD("Created GL mesh resources: %zu verts, %zu indices", vertices.size(), indices.size());
-        return m_Resources.emplace(key, resources).first->second;
+        m_LruOrder.push_front(key);
+        m_ResidentBytes += resources.estimatedBytes;
+        return m_Resources.emplace(key, CachedMesh{resources, revision, m_Frame, m_LruOrder.begin()}).first->second.resources;
+    }
+
+    using LruList = std::list<const MeshGeometryData*>;
+
+    struct CachedMesh {
+        MeshGpuResources resources;
+        uint64_t revision = 0;
+        uint64_t lastUsedFrame = 0;
+        LruList::iterator lruPosition;
+    };
+
+    struct EvictionRecord {
+        uint64_t revision = 0;
+        LruList::iterator position;
+    };
+
+    // Eviction records only feed the reupload counter, so past a fixed count the oldest are forgotten.
+    static constexpr size_t kMaxEvictionRecords = 4096;
+
+    void RecordEviction(const MeshGeometryData* key, uint64_t revision) {
+        const auto [it, inserted] = m_EvictedKeys.try_emplace(key);
+        if (!inserted) {
+            m_EvictionOrder.erase(it->second.position);
+        }
+        m_EvictionOrder.push_front(key);
+        it->second = EvictionRecord{revision, m_EvictionOrder.begin()};
+        if (m_EvictedKeys.size() > kMaxEvictionRecords) {
+            m_EvictedKeys.erase(m_EvictionOrder.back());
+            m_EvictionOrder.pop_back();
+        }
+    }
+
+    // True when this exact geometry was evicted earlier; the record is consumed either way.
+    bool TakeEvictionRecord(const MeshGeometryData* key, uint64_t revision) {
+        const auto it = m_EvictedKeys.find(key);
+        if (it == m_EvictedKeys.end()) {
+            return false;
+        }
+        const bool sameGeometry = it->second.revision == revision;
+        m_EvictionOrder.erase(it->second.position);
+        m_EvictedKeys.erase(it);
+        return sameGeometry;
+    }
+
+    using ResourceMap = std::unordered_map<const MeshGeometryData*, CachedMesh>;
+
+    static void DeleteResources(MeshGpuResources& resources) {
+        if (resources.ebo != 0) {
+            glDeleteBuffers(1, &resources.ebo);
+        }
+        if (resources.vbo != 0) {
+            glDeleteBuffers(1, &resources.vbo);
+        }
+        if (resources.vao != 0) {
+            glDeleteVertexArrays(1, &resources.vao);
+        }
+    }
+
+    void Erase(ResourceMap::iterator it) {
+        DeleteResources(it->second.resources);
+        m_ResidentBytes -= it->second.resources.estimatedBytes;
+        m_LruOrder.erase(it->second.lruPosition);
+        m_Resources.erase(it);
     }
 
-    std::unordered_map<const MeshGeometryData*, MeshGpuResources> m_Resources;
+    ResourceMap m_Resources;
+    // Most recently used first.
+    LruList m_LruOrder;
+    std::unordered_map<const MeshGeometryData*, EvictionRecord> m_EvictedKeys;
+    // Most recently evicted first.
+    LruList m_EvictionOrder;
+    uint64_t m_ResidentBytes = 0;
+    uint64_t m_Frame = 0;
+    ResidencyCounters m_Counters{};
 };
 
 } // namespace RetroRenderer
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <list>
 #include <unordered_map>
 
 namespace RetroRenderer {
@@ -30,10 +31,13 @@ class GLTextureResourceCache {
         auto it = m_Resources.find(key);
         if (it != m_Resources.end()) {
             if (it->second.revision == texture.GetRevision()) {
+                Touch(it->second);
                 return it->second.textureId;
             }
-            DeleteTexture(it->second.textureId);
-            m_Resources.erase(it);
+            Erase(it);
+        }
+        if (TakeEvictionRecord(key, texture.GetRevision())) {
+            m_Counters.reuploads++;
         }
 
         GLuint textureId = 0;
@@ -69,7 +73,10 @@ class GLTextureResourceCache {
         }
         glBindTexture(GL_TEXTURE_2D, 0);
 
-        m_Resources.emplace(key, TextureGpuResource{textureId, texture.GetRevision(), EstimateTextureBytes(texture, useNearest)});
+        m_LruOrder.push_front(key);
+        const uint64_t estimatedBytes = EstimateTextureBytes(texture, useNearest);
+        m_Resources.emplace(key, TextureGpuResource{textureId, texture.GetRevision(), estimatedBytes, m_Frame, m_LruOrder.begin()});
+        m_ResidentBytes += estimatedBytes;
         LOGD("Created GL texture resource: %d x %d", texture.GetWidth(), texture.GetHeight());
         return textureId;
     }
@@ -79,14 +86,47 @@ class GLTextureResourceCache {
             DeleteTexture(entry.second.textureId);
         }
         m_Resources.clear();
+        m_LruOrder.clear();
+        m_EvictedKeys.clear();
+        m_EvictionOrder.clear();
+        m_ResidentBytes = 0;
     }
 
     [[nodiscard]] uint64_t EstimateResidentMemory() const {
-        uint64_t totalBytes = 0;
-        for (const auto& entry : m_Resources) {
-            totalBytes += entry.second.estimatedBytes;
+        return m_ResidentBytes;
+    }
+
+    // Advances the frame clock used for idle ages; textures used since the last call count as referenced this frame.
+    void BeginFrame() {
+        m_Frame++;
+    }
+
+    // Frames since the least recently used texture was last bound; false when the cache is empty.
+    [[nodiscard]] bool GetLeastRecentlyUsedAge(uint64_t& outIdleFrames) const {
+        if (m_LruOrder.empty()) {
+            return false;
+        }
+        outIdleFrames = m_Frame - m_Resources.at(m_LruOrder.back()).lastUsedFrame;
+        return true;
+    }
+
+    void EvictLeastRecentlyUsed() {
+        if (m_LruOrder.empty()) {
+            return;
         }
-        return totalBytes;
+        const auto it = m_Resources.find(m_LruOrder.back());
+        RecordEviction(it->first, it->second.revision);
+        Erase(it);
+        m_Counters.evictions++;
+    }
+
+    struct ResidencyCounters {
+        uint64_t evictions = 0;
+        uint64_t reuploads = 0;
+    };
+
+    [[nodiscard]] const ResidencyCounters& GetResidencyCounters() const {
+        return m_Counters;
     }
 
   private:
@@ -117,12 +157,66 @@ class GLTextureResourceCache {
         }
     };
 
+    using LruList = std::list<TextureCacheKey>;
+
     struct TextureGpuResource {
         GLuint textureId = 0;
         uint64_t revision = 0;
         uint64_t estimatedBytes = 0;
+        uint64_t lastUsedFrame = 0;
+        LruList::iterator lruPosition;
+    };
+
+    using ResourceMap = std::unordered_map<TextureCacheKey, TextureGpuResource, TextureCacheKeyHash>;
+
+    struct EvictionRecord {
+        uint64_t revision = 0;
+        LruList::iterator position;
     };
 
+    // Eviction records only feed the reupload counter, so past a fixed count the oldest are forgotten.
+    static constexpr size_t kMaxEvictionRecords = 4096;
+
+    void RecordEviction(const TextureCacheKey& key, uint64_t revision) {
+        const auto [it, inserted] = m_EvictedKeys.try_emplace(key);
+        if (!inserted) {
+            m_EvictionOrder.erase(it->second.position);
+        }
+        m_EvictionOrder.push_front(key);
+        it->second = EvictionRecord{revision, m_EvictionOrder.begin()};
+        if (m_EvictedKeys.size() > kMaxEvictionRecords) {
+            m_EvictedKeys.erase(m_EvictionOrder.back());
+            m_EvictionOrder.pop_back();
+        }
+    }
+
+    // True when these exact pixels were evicted for this sampler earlier; the record is consumed either way. Revisions
+    // are process-unique, so a new texture at a freed texture's address does not count.
+    bool TakeEvictionRecord(const TextureCacheKey& key, uint64_t revision) {
+        const auto it = m_EvictedKeys.find(key);
+        if (it == m_EvictedKeys.end()) {
+            return false;
+        }
+        const bool samePixels = it->second.revision == revision;
+        m_EvictionOrder.erase(it->second.position);
+        m_EvictedKeys.erase(it);
+        return samePixels;
+    }
+
+    void Touch(TextureGpuResource& resource) {
+        if (resource.lastUsedFrame != m_Frame) {
+            resource.lastUsedFrame = m_Frame;
+            m_LruOrder.splice(m_LruOrder.begin(), m_LruOrder, resource.lruPosition);
+        }
+    }
+
+    void Erase(ResourceMap::iterator it) {
+        DeleteTexture(it->second.textureId);
+        m_ResidentBytes -= it->second.estimatedBytes;
+        m_LruOrder.erase(it->second.lruPosition);
+        m_Resources.erase(it);
+    }
+
     static uint64_t EstimateTextureBytes(const Texture& texture, bool useNearest) {
         const uint64_t baseBytes =
             static_cast<uint64_t>(std::max(texture.GetWidth(), 0)) *
@@ -141,7 +235,15 @@ class GLTextureResourceCache {
         }
     }
 
-    std::unordered_map<TextureCacheKey, TextureGpuResource, TextureCacheKeyHash> m_Resources;
+    ResourceMap m_Resources;
+    // Most recently used first.
+    LruList m_LruOrder;
+    std::unordered_map<TextureCacheKey, EvictionRecord, TextureCacheKeyHash> m_EvictedKeys;
+    // Most recently evicted first.
+    LruList m_EvictionOrder;
+    uint64_t m_ResidentBytes = 0;
+    uint64_t m_Frame = 0;
+    ResidencyCounters m_Counters{};
 };
 
 } // namespace RetroRenderer
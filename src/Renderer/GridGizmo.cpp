@@ -3,6 +3,12 @@
 
 namespace RetroRenderer {
 std::vector<GridGizmoVertex> BuildGridGizmoVertices(const glm::vec3& cameraPosition) {
+    std::vector<GridGizmoVertex> vertices;
+    BuildGridGizmoVertices(cameraPosition, vertices);
+    return vertices;
+}
+
+void BuildGridGizmoVertices(const glm::vec3& cameraPosition, std::vector<GridGizmoVertex>& outVertices) {
     constexpr int kHalfExtent = 64;
     constexpr int kMajorLineStep = 5;
     constexpr float kGridHeight = 0.001f;
@@ -18,7 +24,8 @@ std::vector<GridGizmoVertex> BuildGridGizmoVertices(const glm::vec3& cameraPosit
     const float gridMinZ = static_cast<float>(centerZ - kHalfExtent) * kGridCellSize;
     const float gridMaxZ = static_cast<float>(centerZ + kHalfExtent) * kGridCellSize;
 
-    std::vector<GridGizmoVertex> vertices;
+    std::vector<GridGizmoVertex>& vertices = outVertices;
+    vertices.clear();
     vertices.reserve(static_cast<size_t>(kHalfExtent * 4 + 2) * 4);
 
     for (int i = -kHalfExtent; i <= kHalfExtent; i++) {
@@ -36,7 +43,5 @@ std::vector<GridGizmoVertex> BuildGridGizmoVertices(const glm::vec3& cameraPosit
         vertices.push_back({glm::vec3(offsetX, kGridHeight, gridMinZ), zAlignedColor});
         vertices.push_back({glm::vec3(offsetX, kGridHeight, gridMaxZ), zAlignedColor});
     }
-
-    return vertices;
 }
 } // namespace RetroRenderer
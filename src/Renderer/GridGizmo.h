@@ -10,4 +10,6 @@ struct GridGizmoVertex {
 };
 
 [[nodiscard]] std::vector<GridGizmoVertex> BuildGridGizmoVertices(const glm::vec3& cameraPosition);
+// Refills outVertices in place, so a caller that keeps the vector drawing every frame does not allocate.
+void BuildGridGizmoVertices(const glm::vec3& cameraPosition, std::vector<GridGizmoVertex>& outVertices);
 } // namespace RetroRenderer
@@ -16,6 +16,7 @@ class IHardwareRenderer : public IRenderer {
     virtual void InvalidateSceneResources() = 0;
     virtual void InvalidateTextureResources() = 0;
     [[nodiscard]] virtual HardwareRendererMemoryStats EstimateResidentMemory() const = 0;
+    [[nodiscard]] virtual HardwareResidencyStats GetResidencyStats() const = 0;
 };
 
 } // namespace RetroRenderer
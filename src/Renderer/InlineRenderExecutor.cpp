@@ -1,4 +1,5 @@
 #include "InlineRenderExecutor.h"
+#include "../Base/FrameTrace.h"
 #if defined(__ANDROID__) || defined(__EMSCRIPTEN__)
 #include "GLES/GLESRenderer.h"
 #else
@@ -121,6 +122,7 @@ GLuint InlineRenderExecutor::ResolveUiTexture(TextureHandle handle) const {
 }
 
 void InlineRenderExecutor::Execute(FrameSubmission&& submission) {
+    RETRO_TRACE_ZONE("InlineRenderExecutor::Execute");
     AssertOwnerThread();
     if (!m_Initialized || !submission.renderPacket) {
         return;
@@ -140,33 +142,41 @@ void InlineRenderExecutor::Execute(FrameSubmission&& submission) {
 
     if (packet.hasScene && packet.configSnapshot.renderer.selectedRenderer == Config::RendererType::GL) {
         if (EnsureHardwareRenderer()) {
+            RETRO_TRACE_ZONE("GL render");
             const auto glRenderStart = TimingClock::now();
             m_GLRenderer->RenderFrame(packet);
-            p_Stats->lastGlRenderNs.store(ElapsedNanoseconds(glRenderStart), std::memory_order_relaxed);
+            p_Stats->glRenderTiming.Record(ElapsedNanoseconds(glRenderStart));
         } else {
-            p_Stats->lastGlRenderNs.store(0, std::memory_order_relaxed);
+            p_Stats->glRenderTiming.Record(0);
         }
-        p_Stats->lastCpuOutputUploadNs.store(0, std::memory_order_relaxed);
+        p_Stats->cpuOutputUploadTiming.Record(0);
     } else if (submission.softwareFrame && !submission.softwareFrame->pixels.empty()) {
         ReleaseHardwareRenderer();
-        p_Stats->lastGlRenderNs.store(0, std::memory_order_relaxed);
+        p_Stats->glRenderTiming.Record(0);
         const CpuFrame& frame = *submission.softwareFrame;
+        RETRO_TRACE_ZONE("CPU output upload");
         const auto uploadStart = TimingClock::now();
         m_OutputPresenter.UploadPixels(frame.pixels.data(), frame.width, frame.height);
-        p_Stats->lastCpuOutputUploadNs.store(ElapsedNanoseconds(uploadStart), std::memory_order_relaxed);
+        p_Stats->cpuOutputUploadTiming.Record(ElapsedNanoseconds(uploadStart));
     } else {
         ReleaseHardwareRenderer();
-        p_Stats->lastGlRenderNs.store(0, std::memory_order_relaxed);
-        p_Stats->lastCpuOutputUploadNs.store(0, std::memory_order_relaxed);
+        p_Stats->glRenderTiming.Record(0);
+        p_Stats->cpuOutputUploadTiming.Record(0);
     }
 
     ApplyUiTextureSnapshots(submission.uiTextures);
     const auto uiRenderStart = TimingClock::now();
-    m_UiRenderer.Render(submission.ui, [this](TextureHandle handle) { return ResolveUiTexture(handle); });
-    p_Stats->lastImGuiRenderNs.store(ElapsedNanoseconds(uiRenderStart), std::memory_order_relaxed);
+    {
+        RETRO_TRACE_ZONE("UI render");
+        m_UiRenderer.Render(submission.ui, [this](TextureHandle handle) { return ResolveUiTexture(handle); });
+    }
+    p_Stats->imGuiRenderTiming.Record(ElapsedNanoseconds(uiRenderStart));
     const auto swapStart = TimingClock::now();
-    SDL_GL_SwapWindow(m_Window);
-    p_Stats->lastSwapBuffersNs.store(ElapsedNanoseconds(swapStart), std::memory_order_relaxed);
+    {
+        RETRO_TRACE_ZONE("Swap buffers");
+        SDL_GL_SwapWindow(m_Window);
+    }
+    p_Stats->swapBuffersTiming.Record(ElapsedNanoseconds(swapStart));
     UpdateMemoryStats();
 }
 
@@ -228,6 +238,12 @@ void InlineRenderExecutor::UpdateMemoryStats() {
     p_Stats->glRendererTextureCacheBytes = rendererStats.textureCacheBytes;
     p_Stats->glRendererSkyboxBytes = rendererStats.skyboxBytes;
     p_Stats->glRendererFallbackTextureBytes = rendererStats.fallbackTextureBytes;
+    const HardwareResidencyStats residencyStats =
+        m_GLRenderer ? m_GLRenderer->GetResidencyStats() : HardwareResidencyStats{};
+    p_Stats->glTextureEvictions = residencyStats.textureEvictions;
+    p_Stats->glTextureReuploads = residencyStats.textureReuploads;
+    p_Stats->glMeshEvictions = residencyStats.meshEvictions;
+    p_Stats->glMeshReuploads = residencyStats.meshReuploads;
     p_Stats->outputPresenterBytes = m_OutputPresenter.EstimateResidentMemory();
     p_Stats->previewPresenterBytes = m_PreviewPresenter.EstimateResidentMemory();
     p_Stats->fontPresenterBytes = m_FontPresenter.EstimateResidentMemory();
@@ -95,58 +95,66 @@ float WrapCoordinate(float value, MaterialWrapMode wrapMode) {
     return value - std::floor(value);
 }
 
-Pixel SampleNearest(const ResolvedMaterialSampler& sampler, const glm::vec2& uv) {
+Pixel SampleNearest(const ResolvedMaterialSampler& sampler, const glm::vec2& uv, int mipLevel) {
     if (sampler.texture == nullptr || !sampler.texture->HasCpuPixels()) {
         return Pixel{255, 255, 255, 255};
     }
 
-    const float wrappedU = WrapCoordinate(uv.x, sampler.wrapU);
-    const float wrappedV = WrapCoordinate(uv.y, sampler.wrapV);
-    const int width = sampler.texture->GetWidth();
-    const int height = sampler.texture->GetHeight();
-    const int x = std::clamp(static_cast<int>(std::floor(wrappedU * static_cast<float>(width))), 0, width - 1);
-    const int y = std::clamp(static_cast<int>(std::floor((1.0f - wrappedV) * static_cast<float>(height))), 0, height - 1);
-    return sampler.texture->GetPixels()[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)];
+    const Texture& texture = *sampler.texture;
+    const int width = texture.GetLevelWidth(mipLevel);
+    const int height = texture.GetLevelHeight(mipLevel);
+    int x = 0;
+    int y = 0;
+    // Mips of a power-of-two texture stay power-of-two, so size - 1 is the wrap mask at every level.
+    if (sampler.wrapU == MaterialWrapMode::REPEAT && texture.HasWrapMasks()) {
+        x = FloorToInt(uv.x * static_cast<float>(width)) & (width - 1);
+    } else {
+        x = std::clamp(FloorToInt(WrapCoordinate(uv.x, sampler.wrapU) * static_cast<float>(width)), 0, width - 1);
+    }
+    if (sampler.wrapV == MaterialWrapMode::REPEAT) {
+        y = RepeatRowFromV(uv.y, height);
+    } else {
+        y = std::clamp(FloorToInt((1.0f - WrapCoordinate(uv.y, sampler.wrapV)) * static_cast<float>(height)), 0, height - 1);
+    }
+    return texture.FetchTexel(mipLevel, x, y);
 }
 
 glm::vec4 PixelToUnitVec4(const Pixel& pixel) {
     return glm::vec4(pixel.r / 255.0f, pixel.g / 255.0f, pixel.b / 255.0f, pixel.a / 255.0f);
 }
 
-Pixel SampleLinear(const ResolvedMaterialSampler& sampler, const glm::vec2& uv) {
+Pixel SampleLinear(const ResolvedMaterialSampler& sampler, const glm::vec2& uv, int mipLevel) {
     if (sampler.texture == nullptr || !sampler.texture->HasCpuPixels()) {
         return Pixel{255, 255, 255, 255};
     }
 
+    const Texture& texture = *sampler.texture;
     const float wrappedU = WrapCoordinate(uv.x, sampler.wrapU);
     const float wrappedV = WrapCoordinate(uv.y, sampler.wrapV);
-    const int width = sampler.texture->GetWidth();
-    const int height = sampler.texture->GetHeight();
+    const int width = texture.GetLevelWidth(mipLevel);
+    const int height = texture.GetLevelHeight(mipLevel);
     const float sampleX = wrappedU * static_cast<float>(width - 1);
     const float sampleY = (1.0f - wrappedV) * static_cast<float>(height - 1);
 
-    const int x0 = std::clamp(static_cast<int>(std::floor(sampleX)), 0, width - 1);
-    const int y0 = std::clamp(static_cast<int>(std::floor(sampleY)), 0, height - 1);
-    const int x1 = std::clamp(x0 + 1, 0, width - 1);
-    const int y1 = std::clamp(y0 + 1, 0, height - 1);
-    const float tx = sampleX - static_cast<float>(x0);
-    const float ty = sampleY - static_cast<float>(y0);
-
-    const auto& pixels = sampler.texture->GetPixels();
-    const glm::vec4 p00 = PixelToUnitVec4(pixels[static_cast<size_t>(y0) * static_cast<size_t>(width) + static_cast<size_t>(x0)]);
-    const glm::vec4 p10 = PixelToUnitVec4(pixels[static_cast<size_t>(y0) * static_cast<size_t>(width) + static_cast<size_t>(x1)]);
-    const glm::vec4 p01 = PixelToUnitVec4(pixels[static_cast<size_t>(y1) * static_cast<size_t>(width) + static_cast<size_t>(x0)]);
-    const glm::vec4 p11 = PixelToUnitVec4(pixels[static_cast<size_t>(y1) * static_cast<size_t>(width) + static_cast<size_t>(x1)]);
+    // Wrapped coordinates are already in [0, 1], so the sample position stays inside the image and only the
+    // far neighbour needs an edge check.
+    const int x0 = static_cast<int>(sampleX);
+    const int y0 = static_cast<int>(sampleY);
+    const int x1 = x0 + (x0 < width - 1 ? 1 : 0);
+    const int y1 = y0 + (y0 < height - 1 ? 1 : 0);
+    return BilinearFilterRgba8(texture.FetchTexel(mipLevel, x0, y0),
+                               texture.FetchTexel(mipLevel, x1, y0),
+                               texture.FetchTexel(mipLevel, x0, y1),
+                               texture.FetchTexel(mipLevel, x1, y1),
+                               sampleX - static_cast<float>(x0),
+                               sampleY - static_cast<float>(y0));
+}
 
-    const glm::vec4 top = glm::mix(p00, p10, tx);
-    const glm::vec4 bottom = glm::mix(p01, p11, tx);
-    const glm::vec4 sampled = glm::mix(top, bottom, ty);
-    return Pixel{
-        static_cast<uint8_t>(std::clamp(std::lround(sampled.r * 255.0f), 0L, 255L)),
-        static_cast<uint8_t>(std::clamp(std::lround(sampled.g * 255.0f), 0L, 255L)),
-        static_cast<uint8_t>(std::clamp(std::lround(sampled.b * 255.0f), 0L, 255L)),
-        static_cast<uint8_t>(std::clamp(std::lround(sampled.a * 255.0f), 0L, 255L)),
-    };
+// One register file per thread, reused by every vertex and fragment it shades; stages never nest, so a single buffer
+// is enough and evaluation stays allocation-free once it has grown to the largest program's register count.
+std::vector<glm::vec4>& ThreadRegisterScratch() {
+    thread_local std::vector<glm::vec4> registers;
+    return registers;
 }
 
 template <typename TInput>
@@ -302,7 +310,16 @@ void ExecuteProgram(const MaterialStageProgram& program,
             if (samplers != nullptr && instruction.samplerIndex >= 0 && instruction.samplerIndex < static_cast<int>(samplers->size())) {
                 const ResolvedMaterialSampler& sampler = (*samplers)[static_cast<size_t>(instruction.samplerIndex)];
                 const glm::vec2 uv = glm::vec2(read(instruction.srcRegisters[0]));
-                sampled = sampler.filter == MaterialFilterMode::LINEAR ? SampleLinear(sampler, uv) : SampleNearest(sampler, uv);
+                if (sampler.reducedLevel != nullptr) {
+                    sampled = SampleLevelNearestRepeat(*sampler.reducedLevel, uv);
+                } else {
+                    int mipLevel = 0;
+                    if constexpr (std::is_same_v<TInput, MaterialFragmentStageInput>) {
+                        mipLevel = sampler.texture != nullptr ? sampler.texture->SelectMipLevel(input.uvFootprintLog2) : 0;
+                    }
+                    sampled = sampler.filter == MaterialFilterMode::LINEAR ? SampleLinear(sampler, uv, mipLevel)
+                                                                           : SampleNearest(sampler, uv, mipLevel);
+                }
             }
             value = PixelToUnitVec4(sampled);
             break;
@@ -319,7 +336,7 @@ bool EvaluateMaterialVertexStage(const CompiledMaterialTemplate& material,
                                  const std::vector<glm::vec4>& parameterValues,
                                  const MaterialVertexStageInput& input,
                                  MaterialVertexStageOutput& output) {
-    std::vector<glm::vec4> registers;
+    std::vector<glm::vec4>& registers = ThreadRegisterScratch();
     ExecuteProgram(material.vertexProgram, parameterValues, nullptr, input, registers);
     const auto read = [&](int registerIndex, const glm::vec4& fallback) -> glm::vec4 {
         return registerIndex >= 0 && registerIndex < static_cast<int>(registers.size()) ? registers[static_cast<size_t>(registerIndex)] : fallback;
@@ -339,7 +356,7 @@ MaterialFragmentStageOutput EvaluateMaterialFragmentStage(const CompiledMaterial
                                                           const std::vector<glm::vec4>& parameterValues,
                                                           const std::vector<ResolvedMaterialSampler>& samplers,
                                                           const MaterialFragmentStageInput& input) {
-    std::vector<glm::vec4> registers;
+    std::vector<glm::vec4>& registers = ThreadRegisterScratch();
     ExecuteProgram(material.fragmentProgram, parameterValues, &samplers, input, registers);
     const auto read = [&](int registerIndex, const glm::vec4& fallback) -> glm::vec4 {
         return registerIndex >= 0 && registerIndex < static_cast<int>(registers.size()) ? registers[static_cast<size_t>(registerIndex)] : fallback;
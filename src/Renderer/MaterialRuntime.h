@@ -2,6 +2,7 @@
 
 #include "MaterialTypes.h"
 #include <array>
+#include <memory>
 #include <vector>
 
 namespace RetroRenderer {
@@ -34,6 +35,8 @@ struct MaterialFragmentStageInput {
     glm::vec4 color0 = glm::vec4(1.0f);
     glm::vec3 viewDirWS = glm::vec3(0.0f, 0.0f, 1.0f);
     glm::vec2 screenUV = glm::vec2(0.0f);
+    // log2 of the UV distance one pixel spans; texture samples use it to pick a mip level.
+    float uvFootprintLog2 = kBaseLevelUvFootprintLog2;
     std::array<glm::vec4, 4> varyings = {
         glm::vec4(0.0f),
         glm::vec4(0.0f),
@@ -56,6 +59,10 @@ struct ResolvedMaterialSampler {
     MaterialFilterMode filter = MaterialFilterMode::LINEAR;
     MaterialWrapMode wrapU = MaterialWrapMode::REPEAT;
     MaterialWrapMode wrapV = MaterialWrapMode::REPEAT;
+    // Set when retro.textureMaxDimension shrinks this texture; samples then read it with nearest REPEAT lookups.
+    std::shared_ptr<const TextureLevel> reducedLevel;
+    // Palette indices of reducedLevel, resolved for the PS1 CLUT path.
+    std::shared_ptr<const IndexedTextureLevel> reducedIndexedLevel;
 };
 
 bool EvaluateMaterialVertexStage(const CompiledMaterialTemplate& material,
@@ -183,6 +183,8 @@ struct MaterialParameterOverride {
 struct MaterialTextureBinding {
     std::string slotName;
     std::shared_ptr<const Texture> texture;
+    // File this material asked for; a registry-shared texture may report another file with the same pixels.
+    std::string sourcePath;
 };
 
 struct SceneMaterialOverrides {
@@ -30,6 +30,8 @@ struct RenderItem {
     std::shared_ptr<const MeshGeometryData> geometry;
     glm::mat4 worldTransform = glm::mat4(1.0f);
     FrameMaterialId materialId = kInvalidFrameMaterialId;
+    // View-space distance of the geometry bounds center, used for front-to-back ordering.
+    float viewDepth = 0.0f;
 };
 
 // Renderer input packet. Per-frame state is copied, while immutable shared
@@ -43,6 +45,9 @@ struct RenderPacket {
     std::vector<RenderItem> items;
     Config configSnapshot{};
     Color clearColor{};
+    // Time fed to material stages. The interactive loop passes real time; offline export, headless and perf runs
+    // derive it from the frame number so their images do not depend on how long frames took.
+    float materialTimeSeconds = 0.0f;
     uint64_t dataRevision = 0;
     uint64_t sceneResourceRevision = 0;
     uint64_t textureResourceRevision = 0;
@@ -0,0 +1,805 @@
+#include "RenderPacketCapture.h"
+#include "../Base/FrameTrace.h"
+#include <algorithm>
+#include <array>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace RetroRenderer {
+namespace {
+constexpr std::array<char, 8> kCaptureMagic = {'R', 'R', 'P', 'K', 'T', 'C', 'A', 'P'};
+// Bump whenever a record layout or a visited struct changes.
+constexpr uint32_t kCaptureVersion = 2;
+constexpr uint32_t kByteOrderMark = 0x01020304u;
+constexpr uint32_t kNoResource = std::numeric_limits<uint32_t>::max();
+
+enum class RecordType : uint8_t {
+    GEOMETRY = 1,
+    TEXTURE = 2,
+    MATERIAL_TEMPLATE = 3,
+    PACKET = 4,
+};
+
+// VisitConfig lists Config field by field, so a new or resized field has to be added there and kCaptureVersion
+// bumped. This size check catches layout changes; update it together with both.
+static_assert(sizeof(Config) == 320, "Config changed: update VisitConfig, bump kCaptureVersion and this size");
+
+// Last valid value of every enum a capture stores; a value past it fails the read instead of producing an
+// out-of-range enum. Reading an enum without an overload here does not compile.
+constexpr Config::AAType LastCapturedValue(Config::AAType) {
+    return Config::AAType::FXAA;
+}
+constexpr Config::RendererType LastCapturedValue(Config::RendererType) {
+    return Config::RendererType::GL;
+}
+constexpr Config::RenderPreset LastCapturedValue(Config::RenderPreset) {
+    return Config::RenderPreset::PS1;
+}
+constexpr Config::PaletteType LastCapturedValue(Config::PaletteType) {
+    return Config::PaletteType::CUSTOM;
+}
+constexpr Config::Ps1SemiTransparencyMode LastCapturedValue(Config::Ps1SemiTransparencyMode) {
+    return Config::Ps1SemiTransparencyMode::ADD_QUARTER;
+}
+constexpr Config::Ps1MaterialMode LastCapturedValue(Config::Ps1MaterialMode) {
+    return Config::Ps1MaterialMode::FLAT_COLOR_UNLIT;
+}
+constexpr Config::RasterizationLineMode LastCapturedValue(Config::RasterizationLineMode) {
+    return Config::RasterizationLineMode::BRESENHAM;
+}
+constexpr Config::RasterizationPolygonMode LastCapturedValue(Config::RasterizationPolygonMode) {
+    return Config::RasterizationPolygonMode::FILL;
+}
+constexpr Config::RasterizationFillMode LastCapturedValue(Config::RasterizationFillMode) {
+    return Config::RasterizationFillMode::PINEDA;
+}
+constexpr Config::GLTextureSampling LastCapturedValue(Config::GLTextureSampling) {
+    return Config::GLTextureSampling::RETRO_NEAREST;
+}
+constexpr CameraType LastCapturedValue(CameraType) {
+    return CameraType::ORTHOGRAPHIC;
+}
+constexpr LightType LastCapturedValue(LightType) {
+    return LightType::POINT;
+}
+constexpr MaterialDataType LastCapturedValue(MaterialDataType) {
+    return MaterialDataType::BOOL1;
+}
+constexpr MaterialShadingModel LastCapturedValue(MaterialShadingModel) {
+    return MaterialShadingModel::PHONG;
+}
+constexpr MaterialBlendMode LastCapturedValue(MaterialBlendMode) {
+    return MaterialBlendMode::ALPHA_CUTOUT;
+}
+constexpr MaterialCullMode LastCapturedValue(MaterialCullMode) {
+    return MaterialCullMode::FRONT;
+}
+constexpr MaterialWrapMode LastCapturedValue(MaterialWrapMode) {
+    return MaterialWrapMode::CLAMP_TO_EDGE;
+}
+constexpr MaterialFilterMode LastCapturedValue(MaterialFilterMode) {
+    return MaterialFilterMode::LINEAR;
+}
+constexpr MaterialSemantic LastCapturedValue(MaterialSemantic) {
+    return MaterialSemantic::VARYING3;
+}
+constexpr MaterialOpcode LastCapturedValue(MaterialOpcode) {
+    return MaterialOpcode::SAMPLE_TEXTURE;
+}
+
+template <typename T>
+bool IsCapturedEnumValue(std::underlying_type_t<T> raw) {
+    using TRaw = std::underlying_type_t<T>;
+    return raw >= TRaw{0} && raw <= static_cast<TRaw>(LastCapturedValue(T{}));
+}
+
+class CaptureOutput {
+  public:
+    explicit CaptureOutput(std::ostream& stream) : m_Stream(stream) {
+    }
+
+    template <typename T>
+    void Value(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Capture values must be trivially copyable");
+        m_Stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void Value(const Color& color) {
+        Value(color.r);
+        Value(color.g);
+        Value(color.b);
+        Value(color.a);
+    }
+    void Value(const std::string& text) {
+        Value(static_cast<uint32_t>(text.size()));
+        m_Stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    void Value(const std::filesystem::path& path) {
+        Value(path.generic_string());
+    }
+
+    template <typename T>
+    void Array(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "Capture arrays must hold trivially copyable values");
+        Value(static_cast<uint32_t>(values.size()));
+        m_Stream.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    template <typename T, typename TVisitor>
+    void Elements(const std::vector<T>& values, TVisitor&& visit) {
+        Value(static_cast<uint32_t>(values.size()));
+        for (const T& value : values) {
+            visit(*this, value);
+        }
+    }
+
+  private:
+    std::ostream& m_Stream;
+};
+
+// Every read is bounded by the bytes left in the file, so a corrupt count fails instead of allocating gigabytes.
+class CaptureInput {
+  public:
+    CaptureInput(std::istream& stream, uint64_t remainingBytes) : m_Stream(stream), m_RemainingBytes(remainingBytes) {
+    }
+
+    template <typename T>
+    void Value(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Capture values must be trivially copyable");
+        Read(&value, sizeof(T));
+    }
+    // Bools and enums are read through their raw bytes and checked, since any other bit pattern is not a valid value.
+    void Value(bool& value) {
+        uint8_t raw = 0;
+        Value(raw);
+        Validate(raw <= 1);
+        value = raw != 0;
+    }
+    template <typename T>
+        requires std::is_enum_v<T>
+    void Value(T& value) {
+        std::underlying_type_t<T> raw{};
+        Value(raw);
+        if (Validate(IsCapturedEnumValue<T>(raw))) {
+            value = static_cast<T>(raw);
+        }
+    }
+    void Value(Color& color) {
+        Value(color.r);
+        Value(color.g);
+        Value(color.b);
+        Value(color.a);
+    }
+    void Value(std::string& text) {
+        uint32_t size = 0;
+        Value(size);
+        if (!Reserve(size)) {
+            return;
+        }
+        text.resize(size);
+        Read(text.data(), size);
+    }
+    void Value(std::filesystem::path& path) {
+        std::string text;
+        Value(text);
+        path = text;
+    }
+
+    template <typename T>
+    void Array(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "Capture arrays must hold trivially copyable values");
+        uint32_t count = 0;
+        Value(count);
+        if (!Reserve(static_cast<uint64_t>(count) * sizeof(T))) {
+            return;
+        }
+        values.resize(count);
+        Read(values.data(), static_cast<uint64_t>(count) * sizeof(T));
+        if constexpr (std::is_enum_v<T>) {
+            for (const T& value : values) {
+                if (!Validate(IsCapturedEnumValue<T>(static_cast<std::underlying_type_t<T>>(value)))) {
+                    return;
+                }
+            }
+        }
+    }
+
+    template <typename T, typename TVisitor>
+    void Elements(std::vector<T>& values, TVisitor&& visit) {
+        uint32_t count = 0;
+        Value(count);
+        // Every element takes at least one byte.
+        if (!Reserve(count)) {
+            return;
+        }
+        values.resize(count);
+        for (T& value : values) {
+            visit(*this, value);
+            if (!m_Ok) {
+                return;
+            }
+        }
+    }
+
+    [[nodiscard]] bool Ok() const {
+        return m_Ok;
+    }
+    [[nodiscard]] bool AtEnd() const {
+        return m_RemainingBytes == 0;
+    }
+    // Set when a read stopped on an out-of-range bool or enum rather than at the end of the file.
+    [[nodiscard]] bool HasInvalidValue() const {
+        return m_InvalidValue;
+    }
+
+  private:
+    bool Validate(bool valid) {
+        if (!valid) {
+            m_InvalidValue = true;
+            m_Ok = false;
+        }
+        return m_Ok;
+    }
+
+    bool Reserve(uint64_t bytes) {
+        if (bytes > m_RemainingBytes) {
+            m_Ok = false;
+        }
+        return m_Ok;
+    }
+
+    void Read(void* destination, uint64_t bytes) {
+        if (!Reserve(bytes) || bytes == 0) {
+            return;
+        }
+        m_Stream.read(static_cast<char*>(destination), static_cast<std::streamsize>(bytes));
+        if (static_cast<uint64_t>(m_Stream.gcount()) != bytes) {
+            m_Ok = false;
+            return;
+        }
+        m_RemainingBytes -= bytes;
+    }
+
+    std::istream& m_Stream;
+    uint64_t m_RemainingBytes = 0;
+    bool m_Ok = true;
+    bool m_InvalidValue = false;
+};
+
+// The visitors below list each captured field once for both directions; TValue is const when writing.
+template <typename TArchive, typename TConfig>
+void VisitConfig(TArchive& archive, TConfig& config) {
+    archive.Value(config.window.size);
+    archive.Value(config.window.fullscreen);
+    archive.Value(config.window.enableVsync);
+    archive.Value(config.window.showFPS);
+    archive.Value(config.window.showConfigPanel);
+    archive.Value(config.window.showControls);
+
+    archive.Value(config.environment.showSkybox);
+    archive.Value(config.environment.showGrid);
+    archive.Value(config.environment.showFloor);
+    archive.Value(config.environment.showLightGizmos);
+    archive.Value(config.environment.shadowMap);
+    archive.Value(config.environment.lightPosition);
+
+    archive.Value(config.cull.backfaceCulling);
+    archive.Value(config.cull.depthTest);
+    archive.Value(config.cull.rasterClip);
+    archive.Value(config.cull.geometricClip);
+    archive.Value(config.cull.frustumCull);
+    archive.Value(config.cull.occlusionCull);
+
+    archive.Value(config.renderer.resolution);
+    archive.Value(config.renderer.resolutionScale);
+    archive.Value(config.renderer.selectedRenderer);
+    archive.Value(config.renderer.aaType);
+    archive.Value(config.renderer.enablePerspectiveCorrect);
+    archive.Value(config.renderer.nearestNeighborPresentation);
+    archive.Value(config.renderer.clearColor);
+
+    archive.Value(config.software.renderer.showNormals);
+    archive.Value(config.software.renderer.showTangents);
+    archive.Value(config.software.renderer.showBitangents);
+    archive.Value(config.software.renderer.showBoundingBox);
+    archive.Value(config.software.renderer.showOctree);
+    archive.Value(config.software.renderer.showBVH);
+    archive.Value(config.software.rasterizer.pointSize);
+    archive.Value(config.software.rasterizer.lineWidth);
+    archive.Value(config.software.rasterizer.lineColor);
+    archive.Value(config.software.rasterizer.basicLineColors);
+    archive.Value(config.software.rasterizer.lineMode);
+    archive.Value(config.software.rasterizer.polygonMode);
+    archive.Value(config.software.rasterizer.fillMode);
+    archive.Value(config.software.rasterizer.mipmapping);
+    archive.Value(config.software.rasterizer.collectCounters);
+    archive.Value(config.software.rasterizer.overdrawHeatmap);
+
+    archive.Value(config.gl.rasterizer.polygonMode);
+    archive.Value(config.gl.textureSampling);
+    archive.Value(config.gl.residencyBudgetMiB);
+    archive.Value(config.gl.residencyIdleFrames);
+
+    archive.Value(config.retro.preset);
+    archive.Value(config.retro.palette);
+    archive.Value(config.retro.enablePalette);
+    archive.Value(config.retro.useTextureDerivedPalette);
+    archive.Value(config.retro.customPalette);
+    archive.Value(config.retro.customPaletteRevision);
+    archive.Value(config.retro.enableColorRamps);
+    archive.Value(config.retro.enableOrderedDithering);
+    archive.Value(config.retro.lightingBands);
+    archive.Value(config.retro.flatFaceLighting);
+    archive.Value(config.retro.enableOutline);
+    archive.Value(config.retro.outlineThickness);
+    archive.Value(config.retro.outlineColor);
+    archive.Value(config.retro.useStableUntexturedBaseColor);
+    archive.Value(config.retro.untexturedBaseColor);
+    archive.Value(config.retro.textureMaxDimension);
+    archive.Value(config.retro.snapVertices);
+    archive.Value(config.retro.affineTextureMapping);
+    archive.Value(config.retro.usePs1ShadingModel);
+    archive.Value(config.retro.ps1MaterialMode);
+    archive.Value(config.retro.usePs1TextureClut);
+    archive.Value(config.retro.textureCoordPrecisionBits);
+    archive.Value(config.retro.quantizePs1TextureColor);
+    archive.Value(config.retro.enablePs1SemiTransparency);
+    archive.Value(config.retro.ps1SemiTransparencyMode);
+    archive.Value(config.retro.ps1SemiTransparencyAlpha);
+    archive.Value(config.retro.ps1SemiTransparencyWritesDepth);
+    archive.Value(config.retro.ps1LightingPrecisionBits);
+    archive.Value(config.retro.quantizeToRgb555);
+    archive.Value(config.retro.enablePs1OutputDither);
+    archive.Value(config.retro.depthPrecisionBits);
+    archive.Value(config.retro.vertexSnapStep);
+    archive.Value(config.retro.useGouraudShading);
+    archive.Value(config.retro.enableFog);
+    archive.Value(config.retro.fogNear);
+    archive.Value(config.retro.fogFar);
+    archive.Value(config.retro.fogColor);
+
+    archive.Value(config.diagnostics.memorySampleRateHz);
+    archive.Value(config.diagnostics.trackAllocations);
+    archive.Value(config.diagnostics.capturePackets);
+}
+
+template <typename TArchive, typename TCamera>
+void VisitCamera(TArchive& archive, TCamera& camera) {
+    archive.Value(camera.m_Position);
+    archive.Value(camera.m_Up);
+    archive.Value(camera.m_Direction);
+    archive.Value(camera.m_EulerRotation);
+    archive.Value(camera.m_Type);
+    archive.Value(camera.m_Fov);
+    archive.Value(camera.m_Near);
+    archive.Value(camera.m_Far);
+    archive.Value(camera.m_OrthoSize);
+    archive.Value(camera.m_AspectRatio);
+    archive.Value(camera.m_ViewMat);
+    archive.Value(camera.m_ProjMat);
+}
+
+template <typename TArchive, typename TLight>
+void VisitLight(TArchive& archive, TLight& light) {
+    archive.Value(light.type);
+    archive.Value(light.position);
+    archive.Value(light.color);
+    archive.Value(light.intensity);
+}
+
+template <typename TArchive, typename TState>
+void VisitPipelineState(TArchive& archive, TState& state) {
+    archive.Value(state.shadingModel);
+    archive.Value(state.blendMode);
+    archive.Value(state.cullMode);
+    archive.Value(state.depthTest);
+    archive.Value(state.depthWrite);
+    archive.Value(state.alphaCutoff);
+    archive.Value(state.boundsPadding);
+}
+
+template <typename TArchive, typename TInstruction>
+void VisitInstruction(TArchive& archive, TInstruction& instruction) {
+    archive.Value(instruction.opcode);
+    archive.Value(instruction.resultType);
+    archive.Value(instruction.dstRegister);
+    archive.Value(instruction.srcRegisters);
+    archive.Value(instruction.immediate);
+    archive.Value(instruction.parameterIndex);
+    archive.Value(instruction.samplerIndex);
+    archive.Value(instruction.semantic);
+    archive.Value(instruction.swizzle);
+    archive.Value(instruction.componentCount);
+}
+
+template <typename TArchive, typename TProgram>
+void VisitStageProgram(TArchive& archive, TProgram& program) {
+    archive.Elements(program.instructions, [](auto& a, auto& instruction) { VisitInstruction(a, instruction); });
+    archive.Value(program.registerCount);
+    archive.Array(program.registerTypes);
+}
+
+template <typename TArchive, typename TTemplate>
+void VisitMaterialTemplate(TArchive& archive, TTemplate& material) {
+    archive.Value(material.name);
+    archive.Value(material.assetPath);
+    VisitPipelineState(archive, material.pipelineState);
+    archive.Elements(material.parameters, [](auto& a, auto& parameter) {
+        a.Value(parameter.name);
+        a.Value(parameter.type);
+        a.Value(parameter.defaultValue.type);
+        a.Value(parameter.defaultValue.data);
+    });
+    archive.Elements(material.samplers, [](auto& a, auto& sampler) {
+        a.Value(sampler.name);
+        a.Value(sampler.filter);
+        a.Value(sampler.wrapU);
+        a.Value(sampler.wrapV);
+    });
+    VisitStageProgram(archive, material.vertexProgram);
+    VisitStageProgram(archive, material.fragmentProgram);
+    archive.Value(material.vertexOutputs.positionRegister);
+    archive.Value(material.vertexOutputs.normalRegister);
+    archive.Value(material.vertexOutputs.uvRegister);
+    archive.Value(material.vertexOutputs.colorRegister);
+    archive.Value(material.vertexOutputs.varyingRegisters);
+    archive.Value(material.fragmentOutputs.baseColorRegister);
+    archive.Value(material.fragmentOutputs.emissiveRegister);
+    archive.Value(material.fragmentOutputs.alphaRegister);
+    archive.Value(material.fragmentOutputs.ambientStrengthRegister);
+    archive.Value(material.fragmentOutputs.specularStrengthRegister);
+    archive.Value(material.fragmentOutputs.shininessRegister);
+    archive.Value(material.cacheKey);
+    archive.Value(material.usesVertexColor);
+    archive.Value(material.usesTextureSampling);
+    archive.Value(material.varyingCount);
+}
+
+template <typename TArchive, typename TGeometry>
+void VisitGeometry(TArchive& archive, TGeometry& geometry) {
+    archive.Array(geometry.vertices);
+    archive.Array(geometry.indices);
+    archive.Array(geometry.clusterIndices);
+    archive.Array(geometry.clusters);
+    archive.Value(geometry.boundsMin);
+    archive.Value(geometry.boundsMax);
+}
+
+// Clusters and index buffers are trusted by the software rasterizer, so a capture must not point past them.
+bool IsGeometryConsistent(const MeshGeometryData& geometry) {
+    if (!geometry.clusterIndices.empty() && geometry.clusterIndices.size() != geometry.indices.size()) {
+        return false;
+    }
+    const auto indicesInRange = [&geometry](const std::vector<unsigned int>& indices) {
+        return std::all_of(indices.begin(), indices.end(), [&geometry](unsigned int index) {
+            return index < geometry.vertices.size();
+        });
+    };
+    if (!indicesInRange(geometry.indices) || !indicesInRange(geometry.clusterIndices)) {
+        return false;
+    }
+    const size_t clusterIndexCount = geometry.GetClusterIndices().size();
+    return std::all_of(geometry.clusters.begin(), geometry.clusters.end(), [clusterIndexCount](const MeshCluster& cluster) {
+        return static_cast<size_t>(cluster.firstIndex) + cluster.indexCount <= clusterIndexCount;
+    });
+}
+
+// Per-packet fields; resource references are handled by the writer and reader around it.
+template <typename TArchive, typename TPacket>
+void VisitPacketState(TArchive& archive, TPacket& packet) {
+    archive.Value(packet.hasScene);
+    VisitCamera(archive, packet.camera);
+    archive.Elements(packet.lights, [](auto& a, auto& light) { VisitLight(a, light); });
+    VisitConfig(archive, packet.configSnapshot);
+    archive.Value(packet.clearColor);
+    archive.Value(packet.materialTimeSeconds);
+    archive.Value(packet.dataRevision);
+    archive.Value(packet.sceneResourceRevision);
+    archive.Value(packet.textureResourceRevision);
+}
+
+template <typename TResource>
+uint32_t FindResourceId(const std::unordered_map<const TResource*, uint32_t>& ids, const TResource* resource) {
+    const auto it = ids.find(resource);
+    return it != ids.end() ? it->second : kNoResource;
+}
+
+template <typename TResource>
+bool ResolveResource(const std::vector<std::shared_ptr<const TResource>>& resources,
+                     uint32_t id,
+                     std::shared_ptr<const TResource>& outResource) {
+    if (id == kNoResource) {
+        outResource.reset();
+        return true;
+    }
+    if (id >= resources.size()) {
+        return false;
+    }
+    outResource = resources[id];
+    return true;
+}
+} // namespace
+
+RenderPacketCaptureWriter::~RenderPacketCaptureWriter() {
+    std::string ignoredError;
+    Close(ignoredError);
+}
+
+bool RenderPacketCaptureWriter::Open(const std::filesystem::path& path, std::string& outErrorMessage) {
+    std::string ignoredError;
+    Close(ignoredError);
+    m_File.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_File) {
+        outErrorMessage = "Could not write packet capture " + path.generic_string() + ".";
+        return false;
+    }
+    m_Path = path;
+    CaptureOutput output(m_File);
+    output.Value(kCaptureMagic);
+    output.Value(kCaptureVersion);
+    output.Value(kByteOrderMark);
+    return true;
+}
+
+bool RenderPacketCaptureWriter::WritePacket(const RenderPacket& packet, std::string& outErrorMessage) {
+    RETRO_TRACE_ZONE("RenderPacketCaptureWriter::WritePacket");
+    if (!m_File.is_open()) {
+        outErrorMessage = "Packet capture is not open.";
+        return false;
+    }
+
+    for (const FrameMaterialState& material : packet.materials) {
+        WriteMaterialTemplate(material.compiledTemplate);
+    }
+    std::vector<uint32_t> textureIds;
+    textureIds.reserve(packet.textures.size());
+    for (const std::shared_ptr<const Texture>& texture : packet.textures) {
+        textureIds.push_back(WriteTexture(texture));
+    }
+    for (const RenderItem& item : packet.items) {
+        WriteGeometry(item.geometry);
+    }
+
+    CaptureOutput output(m_File);
+    output.Value(RecordType::PACKET);
+    VisitPacketState(output, packet);
+    output.Array(textureIds);
+    output.Elements(packet.materials, [this](CaptureOutput& a, const FrameMaterialState& material) {
+        a.Value(FindResourceId(m_MaterialTemplateIds, material.compiledTemplate.get()));
+        a.Array(material.parameterValues);
+        a.Array(material.textureIds);
+        VisitPipelineState(a, material.pipelineState);
+    });
+    output.Elements(packet.items, [this](CaptureOutput& a, const RenderItem& item) {
+        a.Value(FindResourceId(m_GeometryIds, item.geometry.get()));
+        a.Value(item.worldTransform);
+        a.Value(item.materialId);
+        a.Value(item.viewDepth);
+    });
+    if (!m_File) {
+        outErrorMessage = "Could not write packet capture " + m_Path.generic_string() + ".";
+        return false;
+    }
+    m_PacketCount++;
+    return true;
+}
+
+bool RenderPacketCaptureWriter::Close(std::string& outErrorMessage) {
+    if (!m_File.is_open()) {
+        return true;
+    }
+    m_File.close();
+    const bool written = !m_File.fail();
+    if (!written) {
+        outErrorMessage = "Could not finish packet capture " + m_Path.generic_string() + ".";
+    }
+    m_GeometryIds.clear();
+    m_TextureIds.clear();
+    m_MaterialTemplateIds.clear();
+    m_WrittenResources.clear();
+    m_PacketCount = 0;
+    return written;
+}
+
+uint32_t RenderPacketCaptureWriter::WriteGeometry(const std::shared_ptr<const MeshGeometryData>& geometry) {
+    if (!geometry) {
+        return kNoResource;
+    }
+    const auto [it, inserted] = m_GeometryIds.emplace(geometry.get(), static_cast<uint32_t>(m_GeometryIds.size()));
+    if (inserted) {
+        CaptureOutput output(m_File);
+        output.Value(RecordType::GEOMETRY);
+        output.Value(it->second);
+        VisitGeometry(output, *geometry);
+        m_WrittenResources.push_back(geometry);
+    }
+    return it->second;
+}
+
+uint32_t RenderPacketCaptureWriter::WriteTexture(const std::shared_ptr<const Texture>& texture) {
+    if (!texture) {
+        return kNoResource;
+    }
+    const auto [it, inserted] = m_TextureIds.emplace(texture.get(), static_cast<uint32_t>(m_TextureIds.size()));
+    if (inserted) {
+        // Only the base image is stored; mips, tiled copies and palettes are rebuilt when the capture is loaded.
+        static const std::vector<Pixel> kNoPixels;
+        const bool hasPixels = texture->HasCpuPixels();
+        CaptureOutput output(m_File);
+        output.Value(RecordType::TEXTURE);
+        output.Value(it->second);
+        output.Value(static_cast<int32_t>(hasPixels ? texture->GetWidth() : 0));
+        output.Value(static_cast<int32_t>(hasPixels ? texture->GetHeight() : 0));
+        output.Array(hasPixels ? texture->GetPixels() : kNoPixels);
+        m_WrittenResources.push_back(texture);
+    }
+    return it->second;
+}
+
+uint32_t RenderPacketCaptureWriter::WriteMaterialTemplate(
+    const std::shared_ptr<const CompiledMaterialTemplate>& materialTemplate) {
+    if (!materialTemplate) {
+        return kNoResource;
+    }
+    const auto [it, inserted] =
+        m_MaterialTemplateIds.emplace(materialTemplate.get(), static_cast<uint32_t>(m_MaterialTemplateIds.size()));
+    if (inserted) {
+        CaptureOutput output(m_File);
+        output.Value(RecordType::MATERIAL_TEMPLATE);
+        output.Value(it->second);
+        VisitMaterialTemplate(output, *materialTemplate);
+        m_WrittenResources.push_back(materialTemplate);
+    }
+    return it->second;
+}
+
+bool LoadRenderPacketCapture(const std::filesystem::path& path,
+                             RenderPacketCapture& outCapture,
+                             std::string& outErrorMessage) {
+    RETRO_TRACE_ZONE("LoadRenderPacketCapture");
+    outCapture = {};
+    std::error_code errorCode;
+    const uintmax_t fileSize = std::filesystem::file_size(path, errorCode);
+    std::ifstream file(path, std::ios::binary);
+    if (errorCode || !file) {
+        outErrorMessage = "Could not read packet capture " + path.generic_string() + ".";
+        return false;
+    }
+
+    CaptureInput input(file, static_cast<uint64_t>(fileSize));
+    std::array<char, 8> magic{};
+    uint32_t version = 0;
+    uint32_t byteOrderMark = 0;
+    input.Value(magic);
+    input.Value(version);
+    input.Value(byteOrderMark);
+    if (!input.Ok() || magic != kCaptureMagic) {
+        outErrorMessage = path.generic_string() + " is not a packet capture.";
+        return false;
+    }
+    if (byteOrderMark != kByteOrderMark) {
+        outErrorMessage = path.generic_string() + " was captured on a machine with a different byte order.";
+        return false;
+    }
+    if (version != kCaptureVersion) {
+        outErrorMessage = path.generic_string() + " has capture format version " + std::to_string(version) +
+                          "; this build reads version " + std::to_string(kCaptureVersion) + ".";
+        return false;
+    }
+
+    std::vector<std::shared_ptr<const MeshGeometryData>> geometries;
+    std::vector<std::shared_ptr<const Texture>> textures;
+    std::vector<std::shared_ptr<const CompiledMaterialTemplate>> materialTemplates;
+    const auto fail = [&](const std::string& reason) {
+        outErrorMessage = path.generic_string() + ", packet " + std::to_string(outCapture.packets.size()) + ": " + reason;
+        return false;
+    };
+
+    while (!input.AtEnd()) {
+        uint8_t rawType = 0;
+        input.Value(rawType);
+        const auto type = static_cast<RecordType>(rawType);
+        uint32_t id = 0;
+        if (type == RecordType::GEOMETRY) {
+            auto geometry = std::make_shared<MeshGeometryData>();
+            input.Value(id);
+            VisitGeometry(input, *geometry);
+            if (input.Ok() && id != geometries.size()) {
+                return fail("geometry records out of order.");
+            }
+            if (input.Ok() && !IsGeometryConsistent(*geometry)) {
+                return fail("invalid geometry " + std::to_string(id) + ".");
+            }
+            geometries.push_back(std::move(geometry));
+        } else if (type == RecordType::TEXTURE) {
+            int32_t width = 0;
+            int32_t height = 0;
+            std::vector<Pixel> pixels;
+            input.Value(id);
+            input.Value(width);
+            input.Value(height);
+            input.Array(pixels);
+            if (input.Ok() && id != textures.size()) {
+                return fail("texture records out of order.");
+            }
+            auto texture = std::make_shared<Texture>();
+            if (input.Ok() && width > 0 && !texture->LoadFromPixels(std::move(pixels), width, height)) {
+                return fail("invalid texture " + std::to_string(id) + ".");
+            }
+            textures.push_back(std::move(texture));
+        } else if (type == RecordType::MATERIAL_TEMPLATE) {
+            auto materialTemplate = std::make_shared<CompiledMaterialTemplate>();
+            input.Value(id);
+            VisitMaterialTemplate(input, *materialTemplate);
+            if (input.Ok() && id != materialTemplates.size()) {
+                return fail("material template records out of order.");
+            }
+            materialTemplates.push_back(std::move(materialTemplate));
+        } else if (type == RecordType::PACKET) {
+            auto packet = std::make_shared<RenderPacket>();
+            std::vector<uint32_t> textureIds;
+            std::vector<uint32_t> geometryIds;
+            std::vector<uint32_t> materialTemplateIds;
+            VisitPacketState(input, *packet);
+            input.Array(textureIds);
+            input.Elements(packet->materials, [&materialTemplateIds](CaptureInput& a, FrameMaterialState& material) {
+                uint32_t templateId = kNoResource;
+                a.Value(templateId);
+                materialTemplateIds.push_back(templateId);
+                a.Array(material.parameterValues);
+                a.Array(material.textureIds);
+                VisitPipelineState(a, material.pipelineState);
+            });
+            input.Elements(packet->items, [&geometryIds](CaptureInput& a, RenderItem& item) {
+                uint32_t geometryId = kNoResource;
+                a.Value(geometryId);
+                geometryIds.push_back(geometryId);
+                a.Value(item.worldTransform);
+                a.Value(item.materialId);
+                a.Value(item.viewDepth);
+            });
+            if (!input.Ok()) {
+                break;
+            }
+            packet->textures.resize(textureIds.size());
+            for (size_t i = 0; i < textureIds.size(); i++) {
+                if (!ResolveResource(textures, textureIds[i], packet->textures[i])) {
+                    return fail("reference to an unknown texture.");
+                }
+            }
+            for (size_t i = 0; i < packet->materials.size(); i++) {
+                if (!ResolveResource(materialTemplates, materialTemplateIds[i], packet->materials[i].compiledTemplate)) {
+                    return fail("reference to an unknown material template.");
+                }
+            }
+            for (size_t i = 0; i < packet->items.size(); i++) {
+                if (!ResolveResource(geometries, geometryIds[i], packet->items[i].geometry)) {
+                    return fail("reference to an unknown geometry.");
+                }
+            }
+            outCapture.packets.push_back(std::move(packet));
+        } else if (input.Ok()) {
+            return fail("unknown record type " + std::to_string(static_cast<int>(type)) + ".");
+        }
+        if (!input.Ok()) {
+            break;
+        }
+    }
+
+    if (input.HasInvalidValue()) {
+        return fail("out-of-range bool or enum value.");
+    }
+    outCapture.truncated = !input.Ok();
+    outCapture.geometryCount = geometries.size();
+    outCapture.textureCount = textures.size();
+    outCapture.materialTemplateCount = materialTemplates.size();
+    if (outCapture.packets.empty()) {
+        outErrorMessage = path.generic_string() + " holds no complete packets.";
+        return false;
+    }
+    return true;
+}
+
+} // namespace RetroRenderer
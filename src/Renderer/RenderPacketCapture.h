@@ -0,0 +1,71 @@
+#pragma once
+
+#include "RenderPacket.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RetroRenderer {
+
+// Written to the working directory while Config::DiagnosticsSettings::capturePackets is on.
+inline constexpr const char* kDefaultPacketCapturePath = "retrorenderer-packets.rrcap";
+
+// Streams RenderPackets into a binary capture for offline replay (retrorenderer_headless --replay). Geometry, textures
+// and compiled material templates are written once, the first time a packet references them, and later packets refer
+// to them by id. Values are stored in host byte order and Config is written field by field, so a capture replays on
+// any build with the same format version and byte order. GL shader snapshots are not captured.
+class RenderPacketCaptureWriter {
+  public:
+    RenderPacketCaptureWriter() = default;
+    ~RenderPacketCaptureWriter();
+    RenderPacketCaptureWriter(const RenderPacketCaptureWriter&) = delete;
+    RenderPacketCaptureWriter& operator=(const RenderPacketCaptureWriter&) = delete;
+
+    bool Open(const std::filesystem::path& path, std::string& outErrorMessage);
+    bool WritePacket(const RenderPacket& packet, std::string& outErrorMessage);
+    // Also done by the destructor, which drops the error.
+    bool Close(std::string& outErrorMessage);
+    [[nodiscard]] bool IsOpen() const {
+        return m_File.is_open();
+    }
+    [[nodiscard]] size_t GetPacketCount() const {
+        return m_PacketCount;
+    }
+
+  private:
+    uint32_t WriteGeometry(const std::shared_ptr<const MeshGeometryData>& geometry);
+    uint32_t WriteTexture(const std::shared_ptr<const Texture>& texture);
+    uint32_t WriteMaterialTemplate(const std::shared_ptr<const CompiledMaterialTemplate>& materialTemplate);
+
+    std::ofstream m_File;
+    std::filesystem::path m_Path;
+    size_t m_PacketCount = 0;
+    std::unordered_map<const MeshGeometryData*, uint32_t> m_GeometryIds;
+    std::unordered_map<const Texture*, uint32_t> m_TextureIds;
+    std::unordered_map<const CompiledMaterialTemplate*, uint32_t> m_MaterialTemplateIds;
+    // Written resources stay alive until the capture closes, so a freed address is never reused under a stale id.
+    std::vector<std::shared_ptr<const void>> m_WrittenResources;
+};
+
+struct RenderPacketCapture {
+    std::vector<std::shared_ptr<const RenderPacket>> packets;
+    size_t geometryCount = 0;
+    size_t textureCount = 0;
+    size_t materialTemplateCount = 0;
+    // The file ended inside a record, e.g. the capturing process exited without closing it; the packets before it
+    // are kept.
+    bool truncated = false;
+};
+
+// Reads a whole capture into memory, so replay does no file I/O between frames. Packets referring to the same
+// resource share one instance of it, as they did when captured.
+bool LoadRenderPacketCapture(const std::filesystem::path& path,
+                             RenderPacketCapture& outCapture,
+                             std::string& outErrorMessage);
+
+} // namespace RetroRenderer
@@ -1,5 +1,8 @@
 #include "RenderSystem.h"
+#include "../Base/AllocationTracker.h"
+#include "../Base/FrameTrace.h"
 #include "../Scene/MaterialManager.h"
+#include "../Scene/TextureRegistry.h"
 #include <KrisLogger/Logger.h>
 #include <algorithm>
 #include <cassert>
@@ -73,6 +76,41 @@ namespace RetroRenderer
                 state.alphaCutoff = *overrides.alphaCutoff;
             }
         }
+
+        bool IsFrontToBackSortable(const RenderPacket& packet, const RenderItem& item)
+        {
+            const MaterialPipelineState& state = packet.materials[item.materialId].pipelineState;
+            return state.blendMode != MaterialBlendMode::ALPHA_BLEND && state.depthTest && state.depthWrite;
+        }
+
+        // Runs of depth-tested opaque items are drawn nearest first, so early depth rejection and the software
+        // occlusion test see occluders before what they hide. Blended and non-depth-writing items stay where they
+        // were submitted and split the runs, so anything drawn after them still is.
+        void SortOpaqueItemsFrontToBack(RenderPacket& packet)
+        {
+            if (!packet.configSnapshot.cull.depthTest)
+            {
+                return;
+            }
+
+            auto runBegin = packet.items.begin();
+            while (runBegin != packet.items.end())
+            {
+                runBegin = std::find_if(runBegin, packet.items.end(), [&packet](const RenderItem& item)
+                {
+                    return IsFrontToBackSortable(packet, item);
+                });
+                const auto runEnd = std::find_if(runBegin, packet.items.end(), [&packet](const RenderItem& item)
+                {
+                    return !IsFrontToBackSortable(packet, item);
+                });
+                std::stable_sort(runBegin, runEnd, [](const RenderItem& lhs, const RenderItem& rhs)
+                {
+                    return lhs.viewDepth < rhs.viewDepth;
+                });
+                runBegin = runEnd;
+            }
+        }
     } // namespace
 
     RenderSystem::RenderSystem(std::shared_ptr<Config> config,
@@ -94,6 +132,8 @@ namespace RetroRenderer
         ClearSoftwareWorkerFrameState();
         ClearSoftwareMemoryStats();
         UpdateSceneMemoryStats(nullptr);
+        p_MemoryStatsScene = nullptr;
+        m_MemoryStatsRevision = 0;
         return true;
     }
 
@@ -112,24 +152,36 @@ namespace RetroRenderer
     }
 
     std::shared_ptr<const RenderPacket> RenderSystem::BuildRenderPacket(const std::shared_ptr<Scene>& scene,
-                                                                        const Camera* camera)
+                                                                        const Camera* camera,
+                                                                        float materialTimeSeconds)
     {
+        RETRO_TRACE_ZONE("RenderSystem::BuildRenderPacket");
         assert(p_Config_ != nullptr && "RenderSystem requires a config instance");
         auto mutablePacket = std::make_shared<RenderPacket>();
         RenderPacket& packet = *mutablePacket;
         packet.configSnapshot = *p_Config_;
         packet.clearColor = p_Config_->renderer.clearColor;
+        packet.materialTimeSeconds = materialTimeSeconds;
         packet.dataRevision = m_FrameDataRevision;
         packet.sceneResourceRevision = m_SceneResourceRevision;
         packet.textureResourceRevision = m_TextureResourceRevision;
 
-        UpdateSceneMemoryStats(scene.get());
+        // Estimating scene memory walks every geometry and texture through hash sets, so it only reruns when the scene
+        // or its data revision changed.
+        if (scene.get() != p_MemoryStatsScene || m_FrameDataRevision != m_MemoryStatsRevision)
+        {
+            UpdateSceneMemoryStats(scene.get());
+            p_MemoryStatsScene = scene.get();
+            m_MemoryStatsRevision = m_FrameDataRevision;
+        }
         if (!scene)
         {
             return mutablePacket;
         }
 
         packet.hasScene = true;
+        // Picks up transform edits made after NewFrame, e.g. timeline scrubbing from the UI.
+        scene->UpdateTransforms();
         if (camera != nullptr)
         {
             packet.camera = *camera;
@@ -203,6 +255,8 @@ namespace RetroRenderer
                 RenderItem item{};
                 item.geometry = geometry;
                 item.worldTransform = model.GetWorldTransform();
+                const glm::vec3 localCenter = (geometry->boundsMin + geometry->boundsMax) * 0.5f;
+                item.viewDepth = -(packet.camera.m_ViewMat * item.worldTransform * glm::vec4(localCenter, 1.0f)).z;
 
                 const SceneMaterialHandle sceneMaterialHandle = mesh.GetMaterialHandle();
                 auto materialIt = materialIds.find(sceneMaterialHandle);
@@ -247,11 +301,17 @@ namespace RetroRenderer
             }
         }
 
+        // Only the software path reorders; GL draws keep submission order.
+        if (packet.configSnapshot.renderer.selectedRenderer == Config::RendererType::SOFTWARE)
+        {
+            SortOpaqueItemsFrontToBack(packet);
+        }
         return mutablePacket;
     }
 
     std::shared_ptr<const CpuFrame> RenderSystem::PrepareFrame(const std::shared_ptr<const RenderPacket>& packet)
     {
+        RETRO_TRACE_ZONE("RenderSystem::PrepareFrame");
         assert(packet && packet->hasScene && "Render called with empty render packet");
         assert(p_Stats_ != nullptr && "RenderSystem requires stats");
         const auto renderSystemStart = TimingClock::now();
@@ -259,33 +319,57 @@ namespace RetroRenderer
 
         if (packet->configSnapshot.renderer.selectedRenderer == Config::RendererType::SOFTWARE)
         {
-            p_Stats_->lastGlRenderNs.store(0, std::memory_order_relaxed);
+            p_Stats_->glRenderTiming.Record(0);
             if (!EnsureSoftwareRenderer())
             {
-                p_Stats_->lastRenderSystemNs.store(ElapsedNanoseconds(renderSystemStart), std::memory_order_relaxed);
+                p_Stats_->renderSystemTiming.Record(ElapsedNanoseconds(renderSystemStart));
                 return nullptr;
             }
+#if !defined(__EMSCRIPTEN__)
+            StartSoftwareWorker();
+#endif
 #if defined(__EMSCRIPTEN__)
             RenderSoftwareSync(*packet);
-            p_Stats_->lastRenderSystemNs.store(ElapsedNanoseconds(renderSystemStart), std::memory_order_relaxed);
+            p_Stats_->renderSystemTiming.Record(ElapsedNanoseconds(renderSystemStart));
             return m_PresentedSoftwareFrame;
 #else
             SubmitSoftwareJob(packet);
             PresentCompletedSoftwareFrame();
-            p_Stats_->lastRenderSystemNs.store(ElapsedNanoseconds(renderSystemStart), std::memory_order_relaxed);
+            p_Stats_->renderSystemTiming.Record(ElapsedNanoseconds(renderSystemStart));
             return m_PresentedSoftwareFrame;
 #endif
         }
 
         ReleaseSoftwareRenderer();
-        p_Stats_->lastSoftwarePacketCopyNs.store(0, std::memory_order_relaxed);
-        p_Stats_->lastSoftwareWorkerRenderNs.store(0, std::memory_order_relaxed);
-        p_Stats_->lastSoftwareWorkerCopyNs.store(0, std::memory_order_relaxed);
-        p_Stats_->lastSoftwareFramePresentIntervalNs.store(0, std::memory_order_relaxed);
-        p_Stats_->lastRenderSystemNs.store(ElapsedNanoseconds(renderSystemStart), std::memory_order_relaxed);
+        p_Stats_->softwarePacketCopyTiming.Record(0);
+        p_Stats_->softwareWorkerRenderTiming.Record(0);
+        p_Stats_->softwareWorkerCopyTiming.Record(0);
+        p_Stats_->softwareFramePresentIntervalTiming.Record(0);
+        RecordSoftwareCullStats({});
+        p_Stats_->renderSystemTiming.Record(ElapsedNanoseconds(renderSystemStart));
         return nullptr;
     }
 
+    std::shared_ptr<const CpuFrame> RenderSystem::RenderFrameBlocking(const std::shared_ptr<const RenderPacket>& packet)
+    {
+        RETRO_TRACE_ZONE("RenderSystem::RenderFrameBlocking");
+        assert(packet && packet->hasScene && "Render called with empty render packet");
+        assert(p_Stats_ != nullptr && "RenderSystem requires stats");
+        const auto renderSystemStart = TimingClock::now();
+        p_Stats_->Reset();
+        p_Stats_->glRenderTiming.Record(0);
+
+        if (!EnsureSoftwareRenderer())
+        {
+            p_Stats_->renderSystemTiming.Record(ElapsedNanoseconds(renderSystemStart));
+            return nullptr;
+        }
+        StopSoftwareWorker();
+        RenderSoftwareSync(*packet);
+        p_Stats_->renderSystemTiming.Record(ElapsedNanoseconds(renderSystemStart));
+        return m_PresentedSoftwareFrame;
+    }
+
     void RenderSystem::Resize(const glm::ivec2& resolution)
     {
         assert(resolution.x > 0 && resolution.y > 0 && "Tried to resize renderer with invalid resolution");
@@ -383,6 +467,7 @@ namespace RetroRenderer
             p_SWRenderer_->Destroy();
             p_SWRenderer_.reset();
         }
+        m_SoftwareFramePool.Clear();
         ClearSoftwareMemoryStats();
     }
 
@@ -443,8 +528,7 @@ namespace RetroRenderer
         SoftwareRenderJob job{};
         const auto softwarePacketCopyStart = TimingClock::now();
         job.packet = packet;
-        p_Stats_->lastSoftwarePacketCopyNs.store(ElapsedNanoseconds(softwarePacketCopyStart),
-                                                 std::memory_order_relaxed);
+        p_Stats_->softwarePacketCopyTiming.Record(ElapsedNanoseconds(softwarePacketCopyStart));
         if (!job.packet || !job.packet->hasScene)
         {
             return;
@@ -511,15 +595,43 @@ namespace RetroRenderer
         const uint64_t previousNs = p_Stats_->lastSoftwareFramePresentedNs.exchange(nowNs, std::memory_order_relaxed);
         if (previousNs != 0 && nowNs > previousNs)
         {
-            p_Stats_->lastSoftwareFramePresentIntervalNs.store(nowNs - previousNs, std::memory_order_relaxed);
+            p_Stats_->softwareFramePresentIntervalTiming.Record(nowNs - previousNs);
         }
         p_Stats_->swFramesPresented.fetch_add(1, std::memory_order_relaxed);
     }
 
+    void RenderSystem::RecordSoftwareCullStats(const SoftwareCullStats& cullStats)
+    {
+        p_Stats_->lastSoftwareClustersTested.store(cullStats.clustersTested, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareClustersFrustumCulled.store(cullStats.clustersFrustumCulled, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareClustersBackfaceCulled.store(cullStats.clustersBackfaceCulled, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareClustersOcclusionCulled.store(cullStats.clustersOcclusionCulled, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareItemsTested.store(cullStats.itemsTested, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareItemsOcclusionCulled.store(cullStats.itemsOcclusionCulled, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareOcclusionFullBuilds.store(cullStats.occlusionFullBuilds, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareOcclusionTilesRescanned.store(cullStats.occlusionTilesRescanned, std::memory_order_relaxed);
+    }
+
+    void RenderSystem::RecordSoftwareRasterCounters(const RasterCounters& counters)
+    {
+        p_Stats_->lastSoftwareRasterTrianglesSubmitted.store(counters.trianglesSubmitted, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareRasterTrianglesCulled.store(counters.trianglesCulled, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareRasterTrianglesClipped.store(counters.trianglesClipped, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareRasterTrianglesDeferred.store(counters.trianglesDeferred, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareRasterPixelsCovered.store(counters.pixelsCovered, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareRasterPixelsShaded.store(counters.pixelsShaded, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareRasterPixelsDepthRejected.store(counters.pixelsDepthRejected, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareRasterPixelsAlphaDiscarded.store(counters.pixelsAlphaDiscarded, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareRasterPixelsWritten.store(counters.pixelsWritten, std::memory_order_relaxed);
+        p_Stats_->lastSoftwareRasterMaterialInstructions.store(counters.materialInstructions, std::memory_order_relaxed);
+    }
+
     void RenderSystem::SoftwareWorkerLoop()
     {
 #if !defined(__EMSCRIPTEN__)
         assert(p_Stats_ != nullptr && "RenderSystem requires stats");
+        FrameTrace::SetThreadName("sw worker");
+        RETRO_ALLOCATION_TAG(SOFTWARE_RENDERER);
 
         while (true)
         {
@@ -543,25 +655,26 @@ namespace RetroRenderer
                 m_SoftwareWorkerBusy = true;
             }
 
+            RETRO_TRACE_ZONE("SW worker job");
             const auto workerRenderStart = TimingClock::now();
             p_SWRenderer_->RenderFrame(*job.packet);
-            p_Stats_->lastSoftwareWorkerRenderNs.
-                      store(ElapsedNanoseconds(workerRenderStart), std::memory_order_relaxed);
+            p_Stats_->softwareWorkerRenderTiming.Record(ElapsedNanoseconds(workerRenderStart));
+            RecordSoftwareCullStats(p_SWRenderer_->GetCullStats());
+            RecordSoftwareRasterCounters(p_SWRenderer_->GetRasterCounters());
 
             const auto workerCopyStart = TimingClock::now();
             const auto& buffer = p_SWRenderer_->GetFrameBuffer();
-            auto finishedFrame = std::make_shared<CpuFrame>();
+            std::shared_ptr<CpuFrame> finishedFrame = m_SoftwareFramePool.Acquire(buffer.GetCount());
             finishedFrame->width = buffer.width;
             finishedFrame->height = buffer.height;
             finishedFrame->pitch = buffer.pitch;
             finishedFrame->frameId = job.jobId;
             finishedFrame->dataRevision = job.packet->dataRevision;
-            finishedFrame->pixels.resize(buffer.GetCount());
             if (!finishedFrame->pixels.empty())
             {
                 std::memcpy(finishedFrame->pixels.data(), buffer.data, finishedFrame->pixels.size() * sizeof(Pixel));
             }
-            p_Stats_->lastSoftwareWorkerCopyNs.store(ElapsedNanoseconds(workerCopyStart), std::memory_order_relaxed);
+            p_Stats_->softwareWorkerCopyTiming.Record(ElapsedNanoseconds(workerCopyStart));
             const SoftwareRendererMemoryStats rendererMemoryStats = p_SWRenderer_->EstimateResidentMemory();
 
             bool stopRequested = false;
@@ -600,30 +713,34 @@ namespace RetroRenderer
         {
             return;
         }
+        RETRO_ALLOCATION_TAG(SOFTWARE_RENDERER);
 
-        p_Stats_->lastSoftwarePacketCopyNs.store(0, std::memory_order_relaxed);
+        p_Stats_->softwarePacketCopyTiming.Record(0);
 
         const auto workerRenderStart = TimingClock::now();
         p_SWRenderer_->RenderFrame(packet);
-        p_Stats_->lastSoftwareWorkerRenderNs.store(ElapsedNanoseconds(workerRenderStart), std::memory_order_relaxed);
+        p_Stats_->softwareWorkerRenderTiming.Record(ElapsedNanoseconds(workerRenderStart));
+        RecordSoftwareCullStats(p_SWRenderer_->GetCullStats());
+        RecordSoftwareRasterCounters(p_SWRenderer_->GetRasterCounters());
         m_SoftwareRendererMemoryStats = p_SWRenderer_->EstimateResidentMemory();
 
         const auto workerCopyStart = TimingClock::now();
         const auto& buffer = p_SWRenderer_->GetFrameBuffer();
         StoreSoftwareFrame(buffer, 0, packet.dataRevision);
-        p_Stats_->lastSoftwareWorkerCopyNs.store(ElapsedNanoseconds(workerCopyStart), std::memory_order_relaxed);
+        p_Stats_->softwareWorkerCopyTiming.Record(ElapsedNanoseconds(workerCopyStart));
         RecordSoftwareFramePresented();
     }
 
     void RenderSystem::StoreSoftwareFrame(const Buffer<Pixel>& buffer, uint64_t frameId, uint64_t dataRevision)
     {
-        auto frame = std::make_shared<CpuFrame>();
+        // Drop the previous frame first so that, when nobody else holds it, its pixels are reused for this one.
+        m_PresentedSoftwareFrame.reset();
+        std::shared_ptr<CpuFrame> frame = m_SoftwareFramePool.Acquire(buffer.GetCount());
         frame->width = buffer.width;
         frame->height = buffer.height;
         frame->pitch = buffer.pitch;
         frame->frameId = frameId;
         frame->dataRevision = dataRevision;
-        frame->pixels.resize(buffer.GetCount());
         if (!frame->pixels.empty())
         {
             std::memcpy(frame->pixels.data(), buffer.data, frame->pixels.size() * sizeof(Pixel));
@@ -646,7 +763,7 @@ namespace RetroRenderer
         if (p_Stats_)
         {
             p_Stats_->lastSoftwareFramePresentedNs.store(0, std::memory_order_relaxed);
-            p_Stats_->lastSoftwareFramePresentIntervalNs.store(0, std::memory_order_relaxed);
+            p_Stats_->softwareFramePresentIntervalTiming.Record(0);
         }
         UpdateSoftwareMemoryStats();
     }
@@ -668,6 +785,11 @@ namespace RetroRenderer
         const SceneMemoryStats stats = scene->EstimateResidentMemory();
         p_Stats_->sceneGeometryCpuBytes = stats.geometryBytes;
         p_Stats_->sceneTextureCpuBytes = stats.textureBytes;
+
+        const TextureRegistryStats registryStats = TextureRegistry::Get().GetStats();
+        p_Stats_->textureRegistryPathHits = registryStats.pathHits;
+        p_Stats_->textureRegistryContentHits = registryStats.contentHits;
+        p_Stats_->textureRegistrySharedBytes = registryStats.sharedBytes;
     }
 
     void RenderSystem::UpdateSoftwareMemoryStats()
@@ -696,6 +818,8 @@ namespace RetroRenderer
             */
         }
 #endif
+        // Pooled frames waiting to be reused keep their pixels resident.
+        readyFrameBytes += m_SoftwareFramePool.EstimateIdleBytes();
 
         p_Stats_->softwareFramebufferColorBytes = rendererStats.framebufferColorBytes;
         p_Stats_->softwareDepthBufferBytes = rendererStats.depthBufferBytes;
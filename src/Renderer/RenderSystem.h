@@ -4,6 +4,7 @@
 #include "../Base/Stats.h"
 #include "../Scene/Scene.h"
 #include "CpuFrame.h"
+#include "CpuFramePool.h"
 #include "RenderServices.h"
 #include "Software/SWRenderer.h"
 #if !defined(__EMSCRIPTEN__)
@@ -32,10 +33,15 @@ class RenderSystem : public IRenderInvalidationSink {
     [[nodiscard]] bool PollSoftwareFrame();
 
     [[nodiscard]] std::shared_ptr<const RenderPacket> BuildRenderPacket(const std::shared_ptr<Scene>& scene,
-                                                                        const Camera* camera);
+                                                                        const Camera* camera,
+                                                                        float materialTimeSeconds);
 
     [[nodiscard]] std::shared_ptr<const CpuFrame> PrepareFrame(
         const std::shared_ptr<const RenderPacket>& packet);
+    // Renders the packet with the software renderer on the calling thread and returns that exact frame. For offline
+    // callers that need every frame; the latest-wins worker is stopped and restarts on the next PrepareFrame.
+    [[nodiscard]] std::shared_ptr<const CpuFrame> RenderFrameBlocking(
+        const std::shared_ptr<const RenderPacket>& packet);
 
     void Resize(const glm::ivec2& resolution);
 
@@ -59,6 +65,8 @@ class RenderSystem : public IRenderInvalidationSink {
     void SubmitSoftwareJob(const std::shared_ptr<const RenderPacket>& packet);
     void PresentCompletedSoftwareFrame();
     void RecordSoftwareFramePresented();
+    void RecordSoftwareCullStats(const SoftwareCullStats& cullStats);
+    void RecordSoftwareRasterCounters(const RasterCounters& counters);
     void SoftwareWorkerLoop();
     void RenderSoftwareSync(const RenderPacket& packet);
     void StoreSoftwareFrame(const Buffer<Pixel>& buffer, uint64_t frameId, uint64_t dataRevision);
@@ -74,11 +82,14 @@ class RenderSystem : public IRenderInvalidationSink {
     std::unique_ptr<SWRenderer> p_SWRenderer_ = nullptr;
     SoftwareRendererMemoryStats m_SoftwareRendererMemoryStats{};
     std::shared_ptr<const CpuFrame> m_PresentedSoftwareFrame;
+    CpuFramePool m_SoftwareFramePool;
     Color m_SoftwareClearColor = Color::DefaultBackground();
     bool m_IsDestroyed = false;
     uint64_t m_FrameDataRevision = 1;
     uint64_t m_SceneResourceRevision = 1;
     uint64_t m_TextureResourceRevision = 1;
+    const Scene* p_MemoryStatsScene = nullptr;
+    uint64_t m_MemoryStatsRevision = 0;
 
 #if !defined(__EMSCRIPTEN__)
     std::thread m_SoftwareWorkerThread;
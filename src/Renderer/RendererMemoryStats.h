@@ -38,4 +38,13 @@ struct HardwareRendererMemoryStats {
     }
 };
 
+// Cumulative GPU cache churn since the hardware renderer was created.
+struct HardwareResidencyStats {
+    uint64_t textureEvictions = 0;
+    uint64_t meshEvictions = 0;
+    // Uploads of resources that had been evicted earlier; a high rate means the budget is too small.
+    uint64_t textureReuploads = 0;
+    uint64_t meshReuploads = 0;
+};
+
 } // namespace RetroRenderer
@@ -4,19 +4,13 @@
 #include <cmath>
 #include <limits>
 #include <memory>
+#include <mutex>
 
 namespace RetroRenderer {
 namespace RetroPalette {
 namespace {
 constexpr size_t kRgb5AxisSize = 32;
-constexpr size_t kRgb5LutSize = kRgb5AxisSize * kRgb5AxisSize * kRgb5AxisSize;
-
-struct PaletteData {
-    std::array<Color, kPico8PaletteSize> colors{};
-    std::array<PaletteRamp, kPico8PaletteSize> ramps{};
-    std::array<std::array<Pixel, 16>, kPico8PaletteSize> ditherPatterns{};
-    std::array<uint8_t, kRgb5LutSize> nearestIndexLut{};
-};
+static_assert(kRgb5AxisSize * kRgb5AxisSize * kRgb5AxisSize == kNearestIndexLutSize);
 
 Color MakeColor(uint8_t r, uint8_t g, uint8_t b) {
     return Color(Color::Uint8Tag{}, r, g, b);
@@ -233,9 +227,9 @@ std::array<PaletteRamp, kPico8PaletteSize> BuildGenericRamps(const std::array<Co
     return ramps;
 }
 
-std::unique_ptr<PaletteData> BuildPaletteData(const std::array<Color, kPico8PaletteSize>& colors,
+std::shared_ptr<PaletteData> BuildPaletteData(const std::array<Color, kPico8PaletteSize>& colors,
                                               const std::array<PaletteRamp, kPico8PaletteSize>* rampsOverride = nullptr) {
-    auto data = std::make_unique<PaletteData>();
+    auto data = std::make_shared<PaletteData>();
     data->colors = colors;
     data->ramps = rampsOverride ? *rampsOverride : BuildGenericRamps(colors);
 
@@ -281,49 +275,71 @@ std::array<Color, kPico8PaletteSize> ConvertCustomPalette(const std::array<Pixel
     return colors;
 }
 
-const PaletteData& GetBuiltInPaletteData(Config::PaletteType palette) {
+const PaletteSnapshot& GetBuiltInPaletteSnapshot(Config::PaletteType palette) {
     switch (NormalizeBuiltInPalette(palette)) {
     case Config::PaletteType::PICO8: {
-        static const std::unique_ptr<PaletteData> data = BuildPaletteData(kPico8Palette, &kPico8Ramps);
-        return *data;
+        static const PaletteSnapshot data = BuildPaletteData(kPico8Palette, &kPico8Ramps);
+        return data;
     }
     case Config::PaletteType::DB16: {
-        static const std::unique_ptr<PaletteData> data = BuildPaletteData(kDb16Palette);
-        return *data;
+        static const PaletteSnapshot data = BuildPaletteData(kDb16Palette);
+        return data;
     }
     case Config::PaletteType::SWEETIE16: {
-        static const std::unique_ptr<PaletteData> data = BuildPaletteData(kSweetie16Palette);
-        return *data;
+        static const PaletteSnapshot data = BuildPaletteData(kSweetie16Palette);
+        return data;
     }
     case Config::PaletteType::CUSTOM:
     case Config::PaletteType::NONE:
         break;
     }
 
-    static const std::unique_ptr<PaletteData> fallback = BuildPaletteData(kPico8Palette, &kPico8Ramps);
-    return *fallback;
+    static const PaletteSnapshot fallback = BuildPaletteData(kPico8Palette, &kPico8Ramps);
+    return fallback;
+}
+
+PaletteSnapshot AcquireCustomPaletteSnapshot(const Config::RetroStyleSettings& retro) {
+    // Only the most recent revision is kept; snapshots still held by in-flight frames stay alive through their
+    // own references. Revision 0 predates any edit and maps to the default custom palette.
+    static std::mutex mutex;
+    static PaletteSnapshot cached;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!cached || cached->customRevision != retro.customPaletteRevision) {
+        auto data = BuildPaletteData(ConvertCustomPalette(
+            retro.customPaletteRevision == 0 ? Config::DefaultCustomPalette() : retro.customPalette));
+        data->customRevision = retro.customPaletteRevision;
+        cached = std::move(data);
+    }
+    return cached;
+}
+
+} // namespace
+
+PaletteSnapshot AcquirePaletteSnapshot(const Config::RetroStyleSettings& retro) {
+    if (retro.palette != Config::PaletteType::CUSTOM) {
+        return GetBuiltInPaletteSnapshot(retro.palette);
+    }
+    return AcquireCustomPaletteSnapshot(retro);
 }
 
 const PaletteData& GetPaletteData(const Config::RetroStyleSettings& retro) {
     if (retro.palette != Config::PaletteType::CUSTOM) {
-        return GetBuiltInPaletteData(retro.palette);
+        return *GetBuiltInPaletteSnapshot(retro.palette);
     }
 
-    static uint64_t cachedRevision = 0;
-    static std::unique_ptr<PaletteData> cachedData = BuildPaletteData(ConvertCustomPalette(Config::DefaultCustomPalette()));
-    if (cachedRevision != retro.customPaletteRevision) {
-        cachedData = BuildPaletteData(ConvertCustomPalette(retro.customPalette));
-        cachedRevision = retro.customPaletteRevision;
+    // Per-thread reference so the convenience overloads never touch shared mutable state; only a revision change
+    // goes through the locked cache.
+    thread_local PaletteSnapshot snapshot;
+    if (!snapshot || snapshot->customRevision != retro.customPaletteRevision) {
+        snapshot = AcquireCustomPaletteSnapshot(retro);
     }
-    return *cachedData;
+    return *snapshot;
 }
 
 const PaletteData& GetPaletteData(Config::PaletteType palette) {
-    return GetBuiltInPaletteData(palette);
+    return *GetBuiltInPaletteSnapshot(palette);
 }
 
-} // namespace
-
 const std::array<Color, kPico8PaletteSize>& GetPico8Palette() {
     return kPico8Palette;
 }
@@ -336,24 +352,32 @@ const std::array<Color, kPico8PaletteSize>& GetPaletteColors(const Config::Retro
     return GetPaletteData(retro).colors;
 }
 
+const Color& GetPaletteColor(const PaletteData& palette, size_t index) {
+    return palette.colors[std::min(index, palette.colors.size() - 1)];
+}
+
 const Color& GetPaletteColor(Config::PaletteType palette, size_t index) {
-    const auto& colors = GetPaletteData(palette).colors;
-    return colors[std::min(index, colors.size() - 1)];
+    return GetPaletteColor(GetPaletteData(palette), index);
 }
 
 const Color& GetPaletteColor(const Config::RetroStyleSettings& retro, size_t index) {
-    const auto& colors = GetPaletteData(retro).colors;
-    return colors[std::min(index, colors.size() - 1)];
+    return GetPaletteColor(GetPaletteData(retro), index);
+}
+
+const std::array<Pixel, 16>& GetOrderedDitherPattern4x4(const PaletteData& palette, uint8_t paletteIndex) {
+    return palette.ditherPatterns[std::min<size_t>(paletteIndex, palette.ditherPatterns.size() - 1)];
 }
 
 const std::array<Pixel, 16>& GetOrderedDitherPattern4x4(Config::PaletteType palette, uint8_t paletteIndex) {
-    const auto& patterns = GetPaletteData(palette).ditherPatterns;
-    return patterns[std::min<size_t>(paletteIndex, patterns.size() - 1)];
+    return GetOrderedDitherPattern4x4(GetPaletteData(palette), paletteIndex);
 }
 
 const std::array<Pixel, 16>& GetOrderedDitherPattern4x4(const Config::RetroStyleSettings& retro, uint8_t paletteIndex) {
-    const auto& patterns = GetPaletteData(retro).ditherPatterns;
-    return patterns[std::min<size_t>(paletteIndex, patterns.size() - 1)];
+    return GetOrderedDitherPattern4x4(GetPaletteData(retro), paletteIndex);
+}
+
+uint8_t FindNearestPaletteIndex(uint8_t r, uint8_t g, uint8_t b, const PaletteData& palette) {
+    return palette.nearestIndexLut[QuantizedRgb5Index(r, g, b)];
 }
 
 uint8_t FindNearestPaletteIndex(const Color& color, Config::PaletteType palette) {
@@ -367,7 +391,7 @@ uint8_t FindNearestPaletteIndex(uint8_t r, uint8_t g, uint8_t b, Config::Palette
     if (palette == Config::PaletteType::NONE) {
         return 0;
     }
-    return GetPaletteData(palette).nearestIndexLut[QuantizedRgb5Index(r, g, b)];
+    return FindNearestPaletteIndex(r, g, b, GetPaletteData(palette));
 }
 
 uint8_t FindNearestPaletteIndex(const Color& color, const Config::RetroStyleSettings& retro) {
@@ -381,23 +405,25 @@ uint8_t FindNearestPaletteIndex(uint8_t r, uint8_t g, uint8_t b, const Config::R
     if (retro.palette == Config::PaletteType::NONE) {
         return 0;
     }
-    return GetPaletteData(retro).nearestIndexLut[QuantizedRgb5Index(r, g, b)];
+    return FindNearestPaletteIndex(r, g, b, GetPaletteData(retro));
+}
+
+Color FindNearestPaletteColor(const Color& color, const PaletteData& palette) {
+    return PreserveAlpha(color, palette.colors[FindNearestPaletteIndex(color.r, color.g, color.b, palette)]);
 }
 
 Color FindNearestPaletteColor(const Color& color, Config::PaletteType palette) {
     if (palette == Config::PaletteType::NONE) {
         return color;
     }
-    const Color& quantized = GetPaletteColor(palette, FindNearestPaletteIndex(color.r, color.g, color.b, palette));
-    return PreserveAlpha(color, quantized);
+    return FindNearestPaletteColor(color, GetPaletteData(palette));
 }
 
 Color FindNearestPaletteColor(const Color& color, const Config::RetroStyleSettings& retro) {
     if (retro.palette == Config::PaletteType::NONE) {
         return color;
     }
-    const Color& quantized = GetPaletteColor(retro, FindNearestPaletteIndex(color.r, color.g, color.b, retro));
-    return PreserveAlpha(color, quantized);
+    return FindNearestPaletteColor(color, GetPaletteData(retro));
 }
 
 Pixel FindNearestPalettePixel(const Color& color, Config::PaletteType palette) {
@@ -425,15 +451,11 @@ float GetOrderedDitherThreshold4x4(const glm::ivec2& pixelPos) {
 
 Color ApplyOrderedDither4x4(const Color& color,
                             const glm::ivec2& pixelPos,
-                            Config::PaletteType palette,
+                            const PaletteData& palette,
                             float strength) {
-    if (palette == Config::PaletteType::NONE) {
-        return color;
-    }
-
     if (strength == 1.0f) {
         const uint8_t paletteIndex = FindNearestPaletteIndex(color.r, color.g, color.b, palette);
-        const Pixel pixel = GetOrderedDitherPattern4x4(palette, paletteIndex)[static_cast<size_t>(((pixelPos.y & 3) << 2) | (pixelPos.x & 3))];
+        const Pixel pixel = palette.ditherPatterns[paletteIndex][static_cast<size_t>(((pixelPos.y & 3) << 2) | (pixelPos.x & 3))];
         return Color(Color::Uint8Tag{}, pixel.r, pixel.g, pixel.b, color.a);
     }
 
@@ -456,33 +478,22 @@ Color ApplyOrderedDither4x4(const Color& color,
 
 Color ApplyOrderedDither4x4(const Color& color,
                             const glm::ivec2& pixelPos,
-                            const Config::RetroStyleSettings& retro,
+                            Config::PaletteType palette,
                             float strength) {
-    if (retro.palette == Config::PaletteType::NONE) {
+    if (palette == Config::PaletteType::NONE) {
         return color;
     }
+    return ApplyOrderedDither4x4(color, pixelPos, GetPaletteData(palette), strength);
+}
 
-    if (strength == 1.0f) {
-        const uint8_t paletteIndex = FindNearestPaletteIndex(color.r, color.g, color.b, retro);
-        const Pixel pixel = GetOrderedDitherPattern4x4(retro, paletteIndex)[static_cast<size_t>(((pixelPos.y & 3) << 2) | (pixelPos.x & 3))];
-        return Color(Color::Uint8Tag{}, pixel.r, pixel.g, pixel.b, color.a);
+Color ApplyOrderedDither4x4(const Color& color,
+                            const glm::ivec2& pixelPos,
+                            const Config::RetroStyleSettings& retro,
+                            float strength) {
+    if (retro.palette == Config::PaletteType::NONE) {
+        return color;
     }
-
-    const float clampedStrength = std::clamp(strength, 0.0f, 2.0f);
-    const float centeredThreshold = GetOrderedDitherThreshold4x4(pixelPos) - 0.5f;
-    const int offset = static_cast<int>(std::lround(centeredThreshold * clampedStrength * 64.0f));
-
-    auto applyOffset = [offset](uint8_t channel) {
-        return static_cast<uint8_t>(std::clamp(static_cast<int>(channel) + offset, 0, 255));
-    };
-
-    const Color adjusted(
-        Color::Uint8Tag{},
-        applyOffset(color.r),
-        applyOffset(color.g),
-        applyOffset(color.b),
-        color.a);
-    return FindNearestPaletteColor(adjusted, retro);
+    return ApplyOrderedDither4x4(color, pixelPos, GetPaletteData(retro), strength);
 }
 
 float QuantizeUnitToBands(float value, int bandCount) {
@@ -498,9 +509,8 @@ float QuantizeUnitToBands(float value, int bandCount) {
     return std::round(clamped * static_cast<float>(safeBandCount - 1)) / static_cast<float>(safeBandCount - 1);
 }
 
-Color SampleRamp(Config::PaletteType palette, uint8_t basePaletteIndex, float value, int bandCount) {
-    const auto& ramps = GetPaletteData(palette).ramps;
-    const PaletteRamp& ramp = ramps[std::min<size_t>(basePaletteIndex, ramps.size() - 1)];
+Color SampleRamp(const PaletteData& palette, uint8_t basePaletteIndex, float value, int bandCount) {
+    const PaletteRamp& ramp = palette.ramps[std::min<size_t>(basePaletteIndex, palette.ramps.size() - 1)];
     const float quantized = QuantizeUnitToBands(value, bandCount);
     const size_t slot =
         std::min<size_t>(static_cast<size_t>(std::lround(quantized * static_cast<float>(ramp.paletteIndices.size() - 1))),
@@ -508,17 +518,15 @@ Color SampleRamp(Config::PaletteType palette, uint8_t basePaletteIndex, float va
     return GetPaletteColor(palette, ramp.paletteIndices[slot]);
 }
 
+Color SampleRamp(Config::PaletteType palette, uint8_t basePaletteIndex, float value, int bandCount) {
+    return SampleRamp(GetPaletteData(palette), basePaletteIndex, value, bandCount);
+}
+
 Color SampleRamp(const Config::RetroStyleSettings& retro, uint8_t basePaletteIndex, float value, int bandCount) {
-    const auto& ramps = GetPaletteData(retro).ramps;
-    const PaletteRamp& ramp = ramps[std::min<size_t>(basePaletteIndex, ramps.size() - 1)];
-    const float quantized = QuantizeUnitToBands(value, bandCount);
-    const size_t slot =
-        std::min<size_t>(static_cast<size_t>(std::lround(quantized * static_cast<float>(ramp.paletteIndices.size() - 1))),
-                         ramp.paletteIndices.size() - 1);
-    return GetPaletteColor(retro, ramp.paletteIndices[slot]);
+    return SampleRamp(GetPaletteData(retro), basePaletteIndex, value, bandCount);
 }
 
-Pixel SampleRampPixel(Config::PaletteType palette,
+Pixel SampleRampPixel(const PaletteData& palette,
                       uint8_t basePaletteIndex,
                       float value,
                       int bandCount,
@@ -527,13 +535,20 @@ Pixel SampleRampPixel(Config::PaletteType palette,
     return Pixel{rampColor.r, rampColor.g, rampColor.b, alpha};
 }
 
+Pixel SampleRampPixel(Config::PaletteType palette,
+                      uint8_t basePaletteIndex,
+                      float value,
+                      int bandCount,
+                      uint8_t alpha) {
+    return SampleRampPixel(GetPaletteData(palette), basePaletteIndex, value, bandCount, alpha);
+}
+
 Pixel SampleRampPixel(const Config::RetroStyleSettings& retro,
                       uint8_t basePaletteIndex,
                       float value,
                       int bandCount,
                       uint8_t alpha) {
-    const Color rampColor = SampleRamp(retro, basePaletteIndex, value, bandCount);
-    return Pixel{rampColor.r, rampColor.g, rampColor.b, alpha};
+    return SampleRampPixel(GetPaletteData(retro), basePaletteIndex, value, bandCount, alpha);
 }
 
 void CopyPaletteToCustom(Config::RetroStyleSettings& retro, Config::PaletteType sourcePalette) {
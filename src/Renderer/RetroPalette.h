@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <glm/vec2.hpp>
+#include <memory>
 
 namespace RetroRenderer {
 namespace RetroPalette {
@@ -16,6 +17,28 @@ struct PaletteRamp {
 };
 
 constexpr size_t kPico8PaletteSize = 16;
+constexpr size_t kNearestIndexLutSize = 32 * 32 * 32;
+
+// Lookup tables for one 16-color palette. Never modified once published, so any number of raster threads can read
+// the same instance without locking.
+struct PaletteData {
+    // customPaletteRevision the tables were built from; always 0 for built-in palettes.
+    uint64_t customRevision = 0;
+    std::array<Color, kPico8PaletteSize> colors{};
+    std::array<PaletteRamp, kPico8PaletteSize> ramps{};
+    std::array<std::array<Pixel, 16>, kPico8PaletteSize> ditherPatterns{};
+    std::array<uint8_t, kNearestIndexLutSize> nearestIndexLut{};
+};
+
+using PaletteSnapshot = std::shared_ptr<const PaletteData>;
+
+// Resolves the tables for retro.palette. Custom palettes are built once per customPaletteRevision and shared by every
+// caller holding that revision; resolve once per frame and pass the snapshot down instead of calling per pixel.
+PaletteSnapshot AcquirePaletteSnapshot(const Config::RetroStyleSettings& retro);
+// Per-thread view of the same tables for callers without a frame snapshot; valid until this thread asks for another
+// custom palette revision.
+const PaletteData& GetPaletteData(const Config::RetroStyleSettings& retro);
+const PaletteData& GetPaletteData(Config::PaletteType palette);
 
 const std::array<Color, kPico8PaletteSize>& GetPico8Palette();
 const PaletteRamp& GetPico8Ramp(uint8_t paletteIndex);
@@ -57,6 +80,22 @@ Pixel SampleRampPixel(const Config::RetroStyleSettings& retro,
                       float value,
                       int bandCount = 4,
                       uint8_t alpha = 255);
+// Snapshot variants: no palette-type or revision checks, callers skip them for PaletteType::NONE themselves.
+const Color& GetPaletteColor(const PaletteData& palette, size_t index);
+const std::array<Pixel, 16>& GetOrderedDitherPattern4x4(const PaletteData& palette, uint8_t paletteIndex);
+uint8_t FindNearestPaletteIndex(uint8_t r, uint8_t g, uint8_t b, const PaletteData& palette);
+Color FindNearestPaletteColor(const Color& color, const PaletteData& palette);
+Color ApplyOrderedDither4x4(const Color& color,
+                            const glm::ivec2& pixelPos,
+                            const PaletteData& palette,
+                            float strength = 1.0f);
+Color SampleRamp(const PaletteData& palette, uint8_t basePaletteIndex, float value, int bandCount = 4);
+Pixel SampleRampPixel(const PaletteData& palette,
+                      uint8_t basePaletteIndex,
+                      float value,
+                      int bandCount = 4,
+                      uint8_t alpha = 255);
+
 void CopyPaletteToCustom(Config::RetroStyleSettings& retro, Config::PaletteType sourcePalette);
 
 } // namespace RetroPalette
@@ -0,0 +1,89 @@
+#include "DepthClip.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace RetroRenderer {
+namespace {
+float PlaneDistance(const ClipPlane& plane, const ClipVertex& v) {
+    return glm::dot(plane.equation, v.clipPosition);
+}
+
+ClipVertex LerpVertex(const ClipVertex& a, const ClipVertex& b, float t) {
+    ClipVertex out;
+    out.clipPosition = glm::mix(a.clipPosition, b.clipPosition, t);
+    out.worldPosition = glm::mix(a.worldPosition, b.worldPosition, t);
+    out.normal = glm::mix(a.normal, b.normal, t);
+    out.texCoords = glm::mix(a.texCoords, b.texCoords, t);
+    out.color = glm::mix(a.color, b.color, t);
+    for (size_t varyingIndex = 0; varyingIndex < out.varyings.size(); varyingIndex++) {
+        out.varyings[varyingIndex] = glm::mix(a.varyings[varyingIndex], b.varyings[varyingIndex], t);
+    }
+    return out;
+}
+
+bool PushVertex(ClippedPolygon& polygon, const ClipVertex& vertex) {
+    if (polygon.count >= polygon.vertices.size()) {
+        return false;
+    }
+    polygon.vertices[polygon.count++] = vertex;
+    return true;
+}
+} // namespace
+
+ClippedPolygon ClipPolygonDepthClipSpace(const std::array<ClipVertex, 3>& inputTriangle) {
+    static const ClipPlane kPlanes[] = {
+        {{0.0f, 0.0f, 1.0f, 1.0f}},   // z >= -w
+        {{0.0f, 0.0f, -1.0f, 1.0f}},  // z <= w
+    };
+
+    ClippedPolygon poly{};
+    poly.vertices[0] = inputTriangle[0];
+    poly.vertices[1] = inputTriangle[1];
+    poly.vertices[2] = inputTriangle[2];
+    poly.count = 3;
+
+    ClippedPolygon output{};
+    for (const auto& plane : kPlanes) {
+        if (poly.count == 0) {
+            break;
+        }
+        output.count = 0;
+        ClipVertex prev = poly.vertices[poly.count - 1];
+        float prevDist = PlaneDistance(plane, prev);
+        bool prevInside = prevDist >= -kClipEpsilon;
+
+        for (size_t i = 0; i < poly.count; i++) {
+            const ClipVertex& curr = poly.vertices[i];
+            float currDist = PlaneDistance(plane, curr);
+            bool currInside = currDist >= -kClipEpsilon;
+
+            if (currInside != prevInside) {
+                const float denominator = prevDist - currDist;
+                if (std::abs(denominator) <= 1e-8f) {
+                    prev = curr;
+                    prevDist = currDist;
+                    prevInside = currInside;
+                    continue;
+                }
+                const float t = std::clamp(prevDist / denominator, 0.0f, 1.0f);
+                if (!PushVertex(output, LerpVertex(prev, curr, t))) {
+                    output.count = 0;
+                    return output;
+                }
+            }
+            if (currInside) {
+                if (!PushVertex(output, curr)) {
+                    output.count = 0;
+                    return output;
+                }
+            }
+            prev = curr;
+            prevDist = currDist;
+            prevInside = currInside;
+        }
+        std::swap(poly, output);
+    }
+    return poly;
+}
+} // namespace RetroRenderer
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace RetroRenderer {
+struct ClipPlane {
+    glm::vec4 equation;
+};
+
+constexpr size_t kMaxClippedPolygonVertices = 12;
+constexpr float kClipEpsilon = 1e-5f;
+
+struct ClipVertex {
+    glm::vec4 clipPosition = glm::vec4(0.0f);
+    glm::vec3 worldPosition = glm::vec3(0.0f);
+    glm::vec3 normal = glm::vec3(0.0f, 0.0f, 1.0f);
+    glm::vec2 texCoords = glm::vec2(0.0f);
+    glm::vec4 color = glm::vec4(1.0f);
+    std::array<glm::vec4, 4> varyings = {
+        glm::vec4(0.0f),
+        glm::vec4(0.0f),
+        glm::vec4(0.0f),
+        glm::vec4(0.0f),
+    };
+};
+
+struct ClippedPolygon {
+    std::array<ClipVertex, kMaxClippedPolygonVertices> vertices{};
+    size_t count = 0;
+};
+
+// Sutherland-Hodgman clip of a clip-space triangle against the near (z >= -w) and far (z <= w) planes. The result is
+// a convex fan around vertices[0]; count is 0 when the triangle is fully outside or the polygon overflows.
+ClippedPolygon ClipPolygonDepthClipSpace(const std::array<ClipVertex, 3>& inputTriangle);
+} // namespace RetroRenderer
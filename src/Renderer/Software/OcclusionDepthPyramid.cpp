@@ -0,0 +1,271 @@
+#include "OcclusionDepthPyramid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace RetroRenderer {
+namespace {
+// Coarsest level whose tile span over the tested rectangle stays within this many tiles per axis.
+constexpr size_t kMaxTestedTileSpan = 4;
+
+struct TileRange {
+    size_t x0 = 0;
+    size_t y0 = 0;
+    size_t x1 = 0;
+    size_t y1 = 0;
+};
+
+enum class BoxProjection {
+    ON_SCREEN,
+    OFF_SCREEN,
+    // A corner lies behind the eye, so the box projects unbounded.
+    UNBOUNDED,
+};
+
+BoxProjection ProjectAabbToTiles(const glm::mat4& mvp,
+                                 const glm::vec3& boundsMin,
+                                 const glm::vec3& boundsMax,
+                                 float pixelPadding,
+                                 size_t sourceWidth,
+                                 size_t sourceHeight,
+                                 TileRange& outTiles,
+                                 float& outNearestDepth) {
+    glm::vec2 screenMin(std::numeric_limits<float>::max());
+    glm::vec2 screenMax(std::numeric_limits<float>::lowest());
+    outNearestDepth = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < 8; i++) {
+        const glm::vec3 corner((i & 1u) ? boundsMax.x : boundsMin.x,
+                               (i & 2u) ? boundsMax.y : boundsMin.y,
+                               (i & 4u) ? boundsMax.z : boundsMin.z);
+        const glm::vec4 clip = mvp * glm::vec4(corner, 1.0f);
+        if (clip.w <= 1e-5f) {
+            return BoxProjection::UNBOUNDED;
+        }
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        const glm::vec2 screen((ndc.x + 1.0f) * 0.5f * static_cast<float>(sourceWidth),
+                               (1.0f - ndc.y) * 0.5f * static_cast<float>(sourceHeight));
+        screenMin = glm::min(screenMin, screen);
+        screenMax = glm::max(screenMax, screen);
+        outNearestDepth = std::min(outNearestDepth, ndc.z * 0.5f + 0.5f);
+    }
+
+    const float padding = 1.0f + std::max(pixelPadding, 0.0f);
+    const float minX = std::floor(screenMin.x - padding);
+    const float minY = std::floor(screenMin.y - padding);
+    const float maxX = std::ceil(screenMax.x + padding);
+    const float maxY = std::ceil(screenMax.y + padding);
+    if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(sourceWidth) ||
+        minY >= static_cast<float>(sourceHeight)) {
+        return BoxProjection::OFF_SCREEN;
+    }
+
+    outTiles.x0 = static_cast<size_t>(std::max(minX, 0.0f)) / OcclusionDepthPyramid::kTileSize;
+    outTiles.y0 = static_cast<size_t>(std::max(minY, 0.0f)) / OcclusionDepthPyramid::kTileSize;
+    outTiles.x1 = static_cast<size_t>(std::min(maxX, static_cast<float>(sourceWidth - 1))) / OcclusionDepthPyramid::kTileSize;
+    outTiles.y1 = static_cast<size_t>(std::min(maxY, static_cast<float>(sourceHeight - 1))) / OcclusionDepthPyramid::kTileSize;
+    return BoxProjection::ON_SCREEN;
+}
+} // namespace
+
+void OcclusionDepthPyramid::Build(const Buffer<float>& depthBuffer) {
+    m_Valid = false;
+    if (depthBuffer.data == nullptr || depthBuffer.width == 0 || depthBuffer.height == 0) {
+        return;
+    }
+
+    m_SourceWidth = depthBuffer.width;
+    m_SourceHeight = depthBuffer.height;
+    size_t levelWidth = (m_SourceWidth + kTileSize - 1) / kTileSize;
+    size_t levelHeight = (m_SourceHeight + kTileSize - 1) / kTileSize;
+    size_t levelCount = 1;
+    for (size_t w = levelWidth, h = levelHeight; w > 1 || h > 1; levelCount++) {
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+    m_Levels.resize(levelCount);
+    m_DirtyFlags.assign(levelWidth * levelHeight, 0);
+    m_DirtyTiles.clear();
+
+    Level& base = m_Levels[0];
+    base.width = levelWidth;
+    base.height = levelHeight;
+    base.maxDepth.assign(levelWidth * levelHeight, 0.0f);
+    for (size_t y = 0; y < m_SourceHeight; y++) {
+        const float* row = depthBuffer.data + y * depthBuffer.width;
+        float* tileRow = base.maxDepth.data() + (y / kTileSize) * levelWidth;
+        for (size_t x = 0; x < m_SourceWidth; x++) {
+            float& tileDepth = tileRow[x / kTileSize];
+            tileDepth = std::max(tileDepth, row[x]);
+        }
+    }
+
+    for (size_t levelIndex = 1; levelIndex < levelCount; levelIndex++) {
+        const Level& source = m_Levels[levelIndex - 1];
+        Level& level = m_Levels[levelIndex];
+        level.width = (source.width + 1) / 2;
+        level.height = (source.height + 1) / 2;
+        level.maxDepth.resize(level.width * level.height);
+        for (size_t y = 0; y < level.height; y++) {
+            for (size_t x = 0; x < level.width; x++) {
+                ReduceTile(levelIndex, x, y);
+            }
+        }
+    }
+    m_Valid = true;
+}
+
+void OcclusionDepthPyramid::Invalidate() {
+    m_Valid = false;
+    m_DirtyTiles.clear();
+}
+
+void OcclusionDepthPyramid::MarkAabbDirty(const glm::mat4& mvp,
+                                          const glm::vec3& boundsMin,
+                                          const glm::vec3& boundsMax,
+                                          float pixelPadding) {
+    if (!m_Valid || m_DirtyTiles.size() == m_DirtyFlags.size()) {
+        return;
+    }
+    const size_t baseWidth = m_Levels[0].width;
+    TileRange tiles{};
+    float nearestDepth = 0.0f;
+    switch (ProjectAabbToTiles(mvp, boundsMin, boundsMax, pixelPadding, m_SourceWidth, m_SourceHeight, tiles, nearestDepth)) {
+    case BoxProjection::OFF_SCREEN:
+        return;
+    case BoxProjection::UNBOUNDED:
+        tiles = TileRange{0, 0, baseWidth - 1, m_Levels[0].height - 1};
+        break;
+    case BoxProjection::ON_SCREEN:
+        break;
+    }
+    for (size_t y = tiles.y0; y <= tiles.y1; y++) {
+        for (size_t x = tiles.x0; x <= tiles.x1; x++) {
+            const size_t tile = y * baseWidth + x;
+            if (m_DirtyFlags[tile] == 0) {
+                m_DirtyFlags[tile] = 1;
+                m_DirtyTiles.push_back(tile);
+            }
+        }
+    }
+}
+
+size_t OcclusionDepthPyramid::Update(const Buffer<float>& depthBuffer) {
+    if (!m_Valid || depthBuffer.width != m_SourceWidth || depthBuffer.height != m_SourceHeight) {
+        Build(depthBuffer);
+        return m_Valid ? GetTileCount() : 0;
+    }
+
+    const size_t rescannedTiles = m_DirtyTiles.size();
+    const size_t baseWidth = m_Levels[0].width;
+    for (const size_t tile : m_DirtyTiles) {
+        RescanBaseTile(depthBuffer, tile % baseWidth, tile / baseWidth);
+        m_DirtyFlags[tile] = 0;
+    }
+    for (size_t levelIndex = 1; levelIndex < m_Levels.size() && !m_DirtyTiles.empty(); levelIndex++) {
+        const size_t sourceWidth = m_Levels[levelIndex - 1].width;
+        const size_t levelWidth = m_Levels[levelIndex].width;
+        m_ParentScratch.clear();
+        for (const size_t tile : m_DirtyTiles) {
+            m_ParentScratch.push_back((tile / sourceWidth / 2) * levelWidth + (tile % sourceWidth) / 2);
+        }
+        std::sort(m_ParentScratch.begin(), m_ParentScratch.end());
+        m_ParentScratch.erase(std::unique(m_ParentScratch.begin(), m_ParentScratch.end()), m_ParentScratch.end());
+        for (const size_t tile : m_ParentScratch) {
+            ReduceTile(levelIndex, tile % levelWidth, tile / levelWidth);
+        }
+        m_DirtyTiles.swap(m_ParentScratch);
+    }
+    m_DirtyTiles.clear();
+    return rescannedTiles;
+}
+
+size_t OcclusionDepthPyramid::GetDirtyTileCount() const {
+    return m_DirtyTiles.size();
+}
+
+size_t OcclusionDepthPyramid::GetTileCount() const {
+    return m_DirtyFlags.size();
+}
+
+void OcclusionDepthPyramid::RescanBaseTile(const Buffer<float>& depthBuffer, size_t tileX, size_t tileY) {
+    const size_t x0 = tileX * kTileSize;
+    const size_t y0 = tileY * kTileSize;
+    const size_t x1 = std::min(x0 + kTileSize, m_SourceWidth);
+    const size_t y1 = std::min(y0 + kTileSize, m_SourceHeight);
+    float tileDepth = 0.0f;
+    for (size_t y = y0; y < y1; y++) {
+        const float* row = depthBuffer.data + y * depthBuffer.width;
+        for (size_t x = x0; x < x1; x++) {
+            tileDepth = std::max(tileDepth, row[x]);
+        }
+    }
+    Level& base = m_Levels[0];
+    base.maxDepth[tileY * base.width + tileX] = tileDepth;
+}
+
+void OcclusionDepthPyramid::ReduceTile(size_t levelIndex, size_t x, size_t y) {
+    const Level& source = m_Levels[levelIndex - 1];
+    Level& level = m_Levels[levelIndex];
+    const size_t y0 = y * 2;
+    const size_t y1 = std::min(y0 + 1, source.height - 1);
+    const size_t x0 = x * 2;
+    const size_t x1 = std::min(x0 + 1, source.width - 1);
+    level.maxDepth[y * level.width + x] =
+        std::max(std::max(source.maxDepth[y0 * source.width + x0], source.maxDepth[y0 * source.width + x1]),
+                 std::max(source.maxDepth[y1 * source.width + x0], source.maxDepth[y1 * source.width + x1]));
+}
+
+bool OcclusionDepthPyramid::IsValid() const {
+    return m_Valid;
+}
+
+bool OcclusionDepthPyramid::IsAabbOccluded(const glm::mat4& mvp,
+                                           const glm::vec3& boundsMin,
+                                           const glm::vec3& boundsMax,
+                                           float depthBias,
+                                           float pixelPadding) const {
+    if (!m_Valid) {
+        return false;
+    }
+
+    // Boxes reaching behind the eye or leaving the screen are treated as visible.
+    TileRange tiles{};
+    float nearestDepth = 0.0f;
+    if (ProjectAabbToTiles(mvp, boundsMin, boundsMax, pixelPadding, m_SourceWidth, m_SourceHeight, tiles, nearestDepth) !=
+        BoxProjection::ON_SCREEN) {
+        return false;
+    }
+    size_t tileX0 = tiles.x0;
+    size_t tileY0 = tiles.y0;
+    size_t tileX1 = tiles.x1;
+    size_t tileY1 = tiles.y1;
+    size_t levelIndex = 0;
+    while (levelIndex + 1 < m_Levels.size() &&
+           (tileX1 - tileX0 >= kMaxTestedTileSpan || tileY1 - tileY0 >= kMaxTestedTileSpan)) {
+        tileX0 /= 2;
+        tileY0 /= 2;
+        tileX1 /= 2;
+        tileY1 /= 2;
+        levelIndex++;
+    }
+
+    const Level& level = m_Levels[levelIndex];
+    for (size_t y = tileY0; y <= tileY1 && y < level.height; y++) {
+        for (size_t x = tileX0; x <= tileX1 && x < level.width; x++) {
+            if (nearestDepth <= level.maxDepth[y * level.width + x] + depthBias) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint64_t OcclusionDepthPyramid::EstimateResidentBytes() const {
+    uint64_t bytes = m_Levels.capacity() * sizeof(Level) + m_DirtyFlags.capacity() +
+                     (m_DirtyTiles.capacity() + m_ParentScratch.capacity()) * sizeof(size_t);
+    for (const Level& level : m_Levels) {
+        bytes += level.maxDepth.capacity() * sizeof(float);
+    }
+    return bytes;
+}
+} // namespace RetroRenderer
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../Buffer.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace RetroRenderer {
+// Conservative max-depth pyramid over the software depth buffer. Level 0 keeps the farthest depth of each
+// kTileSize x kTileSize pixel tile and every further level halves the resolution of the previous one.
+class OcclusionDepthPyramid {
+  public:
+    static constexpr size_t kTileSize = 8;
+
+    void Build(const Buffer<float>& depthBuffer);
+    void Invalidate();
+    [[nodiscard]] bool IsValid() const;
+
+    // Marks the level-0 tiles a draw of the box may have written depth to since the last Build or Update. Boxes
+    // reaching behind the eye mark every tile. Does nothing while the pyramid is invalid.
+    void MarkAabbDirty(const glm::mat4& mvp, const glm::vec3& boundsMin, const glm::vec3& boundsMax, float pixelPadding);
+    // Rescans only the dirty level-0 tiles and the tiles above them; returns how many level-0 tiles were rescanned.
+    size_t Update(const Buffer<float>& depthBuffer);
+    [[nodiscard]] size_t GetDirtyTileCount() const;
+    [[nodiscard]] size_t GetTileCount() const;
+
+    // True when the whole box lies behind the depth recorded in the pyramid. `depthBias` absorbs depth-buffer
+    // quantization and `pixelPadding` grows the projected rectangle to cover vertex snapping.
+    [[nodiscard]] bool IsAabbOccluded(const glm::mat4& mvp,
+                                      const glm::vec3& boundsMin,
+                                      const glm::vec3& boundsMax,
+                                      float depthBias,
+                                      float pixelPadding) const;
+    [[nodiscard]] uint64_t EstimateResidentBytes() const;
+
+  private:
+    struct Level {
+        size_t width = 0;
+        size_t height = 0;
+        std::vector<float> maxDepth;
+    };
+
+    void RescanBaseTile(const Buffer<float>& depthBuffer, size_t tileX, size_t tileY);
+    void ReduceTile(size_t levelIndex, size_t x, size_t y);
+
+    std::vector<Level> m_Levels;
+    // Level-0 tiles written since the last Build or Update, as flags and as a list of tile indices.
+    std::vector<uint8_t> m_DirtyFlags;
+    std::vector<size_t> m_DirtyTiles;
+    std::vector<size_t> m_ParentScratch;
+    size_t m_SourceWidth = 0;
+    size_t m_SourceHeight = 0;
+    bool m_Valid = false;
+};
+} // namespace RetroRenderer
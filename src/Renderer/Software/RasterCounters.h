@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../Buffer.h"
+#include <cstdint>
+#include <limits>
+
+// Builds with -DRETRO_RASTER_COUNTERS=0 compile every RETRO_RASTER_COUNT and overdraw write away.
+#ifndef RETRO_RASTER_COUNTERS
+#define RETRO_RASTER_COUNTERS 1
+#endif
+
+namespace RetroRenderer {
+
+// Work done by the software pipeline in one frame. Pixel counters cover triangle fills only; lines, points, the
+// skybox and the grid are not counted.
+struct RasterCounters {
+    uint64_t trianglesSubmitted = 0;
+    // Rejected before any pixel was visited: depth-trivial, degenerate, backfacing, or clipped away entirely.
+    uint64_t trianglesCulled = 0;
+    // Crossed the near or far plane and were split by the geometric clipper.
+    uint64_t trianglesClipped = 0;
+    // Queued for the PS1 back-to-front pass instead of drawn immediately.
+    uint64_t trianglesDeferred = 0;
+    uint64_t pixelsCovered = 0;
+    // Barycentric fills shade before the depth test; flat fills only resolve a colour for pixels that pass it.
+    uint64_t pixelsShaded = 0;
+    uint64_t pixelsDepthRejected = 0;
+    uint64_t pixelsAlphaDiscarded = 0;
+    uint64_t pixelsWritten = 0;
+    // Vertex- and fragment-stage material program instructions.
+    uint64_t materialInstructions = 0;
+};
+
+// Binds counters and an optional overdraw buffer (one write count per framebuffer pixel) to the calling thread for
+// the scope's lifetime. Each rendering thread counts into its own plain struct, so the per-pixel path never touches
+// shared cache lines; the owner publishes the totals once the frame is done. Scopes nest and restore the outer
+// binding.
+class RasterCounterScope {
+  public:
+    RasterCounterScope(RasterCounters* counters, Buffer<uint16_t>* overdraw)
+        : m_PreviousCounters(t_Counters), m_PreviousOverdraw(t_Overdraw) {
+        t_Counters = counters;
+        t_Overdraw = overdraw;
+    }
+    ~RasterCounterScope() {
+        t_Counters = m_PreviousCounters;
+        t_Overdraw = m_PreviousOverdraw;
+    }
+    RasterCounterScope(const RasterCounterScope&) = delete;
+    RasterCounterScope& operator=(const RasterCounterScope&) = delete;
+
+    [[nodiscard]] static RasterCounters* Counters() {
+        return t_Counters;
+    }
+    static void RecordOverdraw(size_t pixelIndex) {
+        if (t_Overdraw != nullptr && pixelIndex < t_Overdraw->GetCount() &&
+            t_Overdraw->data[pixelIndex] < std::numeric_limits<uint16_t>::max()) {
+            t_Overdraw->data[pixelIndex]++;
+        }
+    }
+
+  private:
+    static inline thread_local RasterCounters* t_Counters = nullptr;
+    static inline thread_local Buffer<uint16_t>* t_Overdraw = nullptr;
+    RasterCounters* m_PreviousCounters;
+    Buffer<uint16_t>* m_PreviousOverdraw;
+};
+
+} // namespace RetroRenderer
+
+#if RETRO_RASTER_COUNTERS
+#define RETRO_RASTER_COUNT(field, amount)                                                                            \
+    do {                                                                                                             \
+        if (::RetroRenderer::RasterCounters* retroRasterCounters = ::RetroRenderer::RasterCounterScope::Counters()) { \
+            retroRasterCounters->field += static_cast<uint64_t>(amount);                                             \
+        }                                                                                                            \
+    } while (false)
+#define RETRO_RASTER_OVERDRAW(pixelIndex) ::RetroRenderer::RasterCounterScope::RecordOverdraw(pixelIndex)
+#else
+#define RETRO_RASTER_COUNT(field, amount) static_cast<void>(0)
+#define RETRO_RASTER_OVERDRAW(pixelIndex) static_cast<void>(0)
+#endif
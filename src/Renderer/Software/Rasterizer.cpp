@@ -1,8 +1,10 @@
 #include "Rasterizer.h"
+#include "RasterCounters.h"
 #include "../RetroPalette.h"
 #include "../../Scene/Texture.h"
 #include <KrisLogger/Logger.h>
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstdint>
 
@@ -198,6 +200,31 @@ Pixel QuantizePs1TexturePixel(Pixel inputColor, const Config& cfg) {
     };
 }
 
+// Reduced copies are resolved per draw in SWRenderer; reuse the ones that belong to the texture being sampled.
+const ResolvedMaterialSampler* FindTextureSampler(const SoftwareMaterialState& materialState, const Texture* texture) {
+    if (texture == nullptr) {
+        return nullptr;
+    }
+    for (const ResolvedMaterialSampler& sampler : materialState.samplers) {
+        if (sampler.texture == texture) {
+            return &sampler;
+        }
+    }
+    return nullptr;
+}
+
+// Per-triangle mip footprint: log2 of the UV distance covered by one pixel, from the ratio of the triangle's UV
+// area to its screen area. Both areas are doubled (edge-function convention), so the factor cancels.
+float ComputeUvFootprintLog2(const std::array<RasterVertex, 3>& vertices, float doubledScreenArea) {
+    const glm::vec2 uvEdge1 = vertices[1].texCoords - vertices[0].texCoords;
+    const glm::vec2 uvEdge2 = vertices[2].texCoords - vertices[0].texCoords;
+    const float doubledUvArea = std::abs(uvEdge1.x * uvEdge2.y - uvEdge1.y * uvEdge2.x);
+    if (doubledUvArea <= 0.0f || doubledScreenArea <= 0.0f) {
+        return kBaseLevelUvFootprintLog2;
+    }
+    return 0.5f * std::log2(doubledUvArea / doubledScreenArea);
+}
+
 Pixel ApplyPs1TextureStyle(Pixel inputColor, const Texture* texture, const Config& cfg) {
     Pixel styledColor = inputColor;
     if (UsePs1ShadingModel(cfg) && cfg.retro.usePs1TextureClut && texture != nullptr && texture->HasAutoPalette()) {
@@ -284,10 +311,10 @@ T InterpolateAttribute(const std::array<T, 3>& values, const InterpolationWeight
 }
 
 bool UseTextureAutoPalette(const Texture* texture, const Config& cfg) {
-    return texture != nullptr &&
-           texture->HasAutoPalette() &&
-           cfg.retro.useTextureDerivedPalette &&
-           cfg.retro.enablePalette;
+    return cfg.retro.useTextureDerivedPalette &&
+           cfg.retro.enablePalette &&
+           texture != nullptr &&
+           texture->HasAutoPalette();
 }
 
 bool UsePs1ShadingModel(const Config& cfg) {
@@ -581,6 +608,7 @@ Pixel BlendSourceOver(Pixel destinationColor, Pixel sourceColor) {
 Pixel ShadeRetroColor(const Color& baseColor,
                       const glm::vec3& lightingColor,
                       const Config& cfg,
+                      const RetroPalette::PaletteData& palette,
                       const Texture* paletteTexture = nullptr) {
     const glm::vec3 clampedLighting = glm::max(lightingColor, glm::vec3(0.0f));
     const float lightAmount = std::clamp(glm::dot(clampedLighting, glm::vec3(0.2126f, 0.7152f, 0.0722f)), 0.0f, 1.0f);
@@ -595,8 +623,8 @@ Pixel ShadeRetroColor(const Color& baseColor,
     }
 
     if (cfg.retro.enableColorRamps && cfg.retro.enablePalette && retro.palette != Config::PaletteType::NONE) {
-        const uint8_t baseIndex = RetroPalette::FindNearestPaletteIndex(baseColor, retro);
-        return RetroPalette::SampleRampPixel(retro, baseIndex, bandedLight, lightingBands > 0 ? lightingBands : 4, baseColor.a);
+        const uint8_t baseIndex = RetroPalette::FindNearestPaletteIndex(baseColor.r, baseColor.g, baseColor.b, palette);
+        return RetroPalette::SampleRampPixel(palette, baseIndex, bandedLight, lightingBands > 0 ? lightingBands : 4, baseColor.a);
     }
 
     const uint8_t shadedR = static_cast<uint8_t>(
@@ -611,9 +639,8 @@ Pixel ShadeRetroColor(const Color& baseColor,
     }
 
     if (cfg.retro.enablePalette && retro.palette != Config::PaletteType::NONE) {
-        const Color& quantized = RetroPalette::GetPaletteColor(
-            retro,
-            RetroPalette::FindNearestPaletteIndex(shadedR, shadedG, shadedB, retro));
+        const Color& quantized =
+            RetroPalette::GetPaletteColor(palette, RetroPalette::FindNearestPaletteIndex(shadedR, shadedG, shadedB, palette));
         return Pixel{quantized.r, quantized.g, quantized.b, baseColor.a};
     }
     return Pixel{shadedR, shadedG, shadedB, baseColor.a};
@@ -629,7 +656,11 @@ Pixel ShadePs1Color(const Color& baseColor, const glm::vec3& lightingColor) {
     };
 }
 
-Pixel ApplyRetroFillStyle(Pixel inputColor, const glm::ivec2& pixelPos, const Config& cfg, const Texture* paletteTexture = nullptr) {
+Pixel ApplyRetroFillStyle(Pixel inputColor,
+                          const glm::ivec2& pixelPos,
+                          const Config& cfg,
+                          const RetroPalette::PaletteData& palette,
+                          const Texture* paletteTexture = nullptr) {
     if (!cfg.retro.enableOrderedDithering) {
         return inputColor;
     }
@@ -642,17 +673,23 @@ Pixel ApplyRetroFillStyle(Pixel inputColor, const glm::ivec2& pixelPos, const Co
     }
 
     if (cfg.retro.enablePalette && cfg.retro.palette != Config::PaletteType::NONE) {
-        const uint8_t paletteIndex = RetroPalette::FindNearestPaletteIndex(inputColor.r, inputColor.g, inputColor.b, cfg.retro);
-        Pixel pixel = RetroPalette::GetOrderedDitherPattern4x4(cfg.retro, paletteIndex)[DitherPatternIndex(pixelPos.x, pixelPos.y)];
+        const uint8_t paletteIndex = RetroPalette::FindNearestPaletteIndex(inputColor.r, inputColor.g, inputColor.b, palette);
+        Pixel pixel = palette.ditherPatterns[paletteIndex][DitherPatternIndex(pixelPos.x, pixelPos.y)];
         pixel.a = inputColor.a;
         return pixel;
     }
 
+    if (cfg.retro.palette == Config::PaletteType::NONE) {
+        return inputColor;
+    }
     const Color color(Color::Uint8Tag{}, inputColor.r, inputColor.g, inputColor.b, inputColor.a);
-    return RetroPalette::ApplyOrderedDither4x4(color, pixelPos, cfg.retro).ToPixel();
+    return RetroPalette::ApplyOrderedDither4x4(color, pixelPos, palette).ToPixel();
 }
 
-DitherPattern BuildRetroFillPattern(Pixel inputColor, const Config& cfg, const Texture* paletteTexture = nullptr) {
+DitherPattern BuildRetroFillPattern(Pixel inputColor,
+                                    const Config& cfg,
+                                    const RetroPalette::PaletteData& palette,
+                                    const Texture* paletteTexture = nullptr) {
     DitherPattern pattern{};
     if (!cfg.retro.enableOrderedDithering) {
         pattern.fill(inputColor);
@@ -671,8 +708,8 @@ DitherPattern BuildRetroFillPattern(Pixel inputColor, const Config& cfg, const T
     }
 
     if (cfg.retro.enablePalette && cfg.retro.palette != Config::PaletteType::NONE) {
-        const uint8_t paletteIndex = RetroPalette::FindNearestPaletteIndex(inputColor.r, inputColor.g, inputColor.b, cfg.retro);
-        DitherPattern pattern = RetroPalette::GetOrderedDitherPattern4x4(cfg.retro, paletteIndex);
+        const uint8_t paletteIndex = RetroPalette::FindNearestPaletteIndex(inputColor.r, inputColor.g, inputColor.b, palette);
+        DitherPattern pattern = palette.ditherPatterns[paletteIndex];
         if (inputColor.a != 255) {
             for (Pixel& pixel : pattern) {
                 pixel.a = inputColor.a;
@@ -683,7 +720,7 @@ DitherPattern BuildRetroFillPattern(Pixel inputColor, const Config& cfg, const T
 
     for (int y = 0; y < 4; y++) {
         for (int x = 0; x < 4; x++) {
-            pattern[DitherPatternIndex(x, y)] = ApplyRetroFillStyle(inputColor, glm::ivec2{x, y}, cfg);
+            pattern[DitherPatternIndex(x, y)] = ApplyRetroFillStyle(inputColor, glm::ivec2{x, y}, cfg, palette);
         }
     }
     return pattern;
@@ -698,7 +735,9 @@ void WriteTrianglePixel(Buffer<Pixel>& framebuffer,
                         Pixel fillColor,
                         const DitherPattern* fillPattern = nullptr,
                         const Texture* paletteTexture = nullptr,
-                        const MaterialPipelineState* pipelineState = nullptr) {
+                        const MaterialPipelineState* pipelineState = nullptr,
+                        const RetroPalette::PaletteData* palette = nullptr) {
+    assert((fillPattern != nullptr || palette != nullptr) && "Per-pixel retro fill needs a palette snapshot");
     if (!cfg.cull.rasterClip) {
         if (x < 0 || x >= static_cast<int>(framebuffer.width) || y < 0 || y >= static_cast<int>(framebuffer.height)) {
             return;
@@ -708,45 +747,60 @@ void WriteTrianglePixel(Buffer<Pixel>& framebuffer,
     const size_t pixelIndex = static_cast<size_t>(y) * framebuffer.width + static_cast<size_t>(x);
     const float quantizedDepth = QuantizeDepth(z, cfg);
     const bool depthTestEnabled = cfg.cull.depthTest && (pipelineState == nullptr || pipelineState->depthTest);
-    if (!depthTestEnabled || quantizedDepth < depthBuffer.data[pixelIndex]) {
-        const Pixel retroColor =
-            fillPattern ? (*fillPattern)[DitherPatternIndex(x, y)] : ApplyRetroFillStyle(fillColor, glm::ivec2{x, y}, cfg, paletteTexture);
-        if (retroColor.a == 0) {
-            return;
-        }
-        const Pixel sourceColor = ApplyPs1OutputStyle(ApplyPs1SourceTransparency(retroColor, cfg), glm::ivec2{x, y}, cfg);
-        const bool shouldWriteDepth =
-            (pipelineState == nullptr || pipelineState->depthWrite) && ShouldWriteDepthForPixel(sourceColor, cfg);
-        if (shouldWriteDepth) {
-            depthBuffer.data[pixelIndex] = quantizedDepth;
-        }
-        if (UsePs1ShadingModel(cfg) && cfg.retro.enablePs1SemiTransparency && sourceColor.a < 255) {
-            const Pixel blendedColor = BlendPs1SemiTransparent(framebuffer.data[pixelIndex], sourceColor, cfg);
-            framebuffer.data[pixelIndex] = ApplyPs1OutputStyle(blendedColor, glm::ivec2{x, y}, cfg);
-            return;
-        }
-        if (pipelineState != nullptr && pipelineState->blendMode == MaterialBlendMode::ALPHA_BLEND && sourceColor.a < 255) {
-            framebuffer.data[pixelIndex] = BlendSourceOver(framebuffer.data[pixelIndex], sourceColor);
-            return;
-        }
-        framebuffer.data[pixelIndex] = sourceColor;
+    if (depthTestEnabled && !(quantizedDepth < depthBuffer.data[pixelIndex])) {
+        RETRO_RASTER_COUNT(pixelsDepthRejected, 1);
+        return;
+    }
+    if (fillPattern != nullptr) {
+        // Flat fills resolve their colour here; barycentric fragments were counted when they were shaded.
+        RETRO_RASTER_COUNT(pixelsShaded, 1);
+    }
+    const Pixel retroColor = fillPattern ? (*fillPattern)[DitherPatternIndex(x, y)]
+                                         : ApplyRetroFillStyle(fillColor, glm::ivec2{x, y}, cfg, *palette, paletteTexture);
+    if (retroColor.a == 0) {
+        RETRO_RASTER_COUNT(pixelsAlphaDiscarded, 1);
+        return;
+    }
+    RETRO_RASTER_COUNT(pixelsWritten, 1);
+    RETRO_RASTER_OVERDRAW(pixelIndex);
+    const Pixel sourceColor = ApplyPs1OutputStyle(ApplyPs1SourceTransparency(retroColor, cfg), glm::ivec2{x, y}, cfg);
+    const bool shouldWriteDepth =
+        (pipelineState == nullptr || pipelineState->depthWrite) && ShouldWriteDepthForPixel(sourceColor, cfg);
+    if (shouldWriteDepth) {
+        depthBuffer.data[pixelIndex] = quantizedDepth;
+    }
+    if (UsePs1ShadingModel(cfg) && cfg.retro.enablePs1SemiTransparency && sourceColor.a < 255) {
+        const Pixel blendedColor = BlendPs1SemiTransparent(framebuffer.data[pixelIndex], sourceColor, cfg);
+        framebuffer.data[pixelIndex] = ApplyPs1OutputStyle(blendedColor, glm::ivec2{x, y}, cfg);
+        return;
     }
+    if (pipelineState != nullptr && pipelineState->blendMode == MaterialBlendMode::ALPHA_BLEND && sourceColor.a < 255) {
+        framebuffer.data[pixelIndex] = BlendSourceOver(framebuffer.data[pixelIndex], sourceColor);
+        return;
+    }
+    framebuffer.data[pixelIndex] = sourceColor;
 }
 } // namespace
 
 Pixel Rasterizer::ApplyRetroPixelStyle(Pixel inputColor, const glm::ivec2& pixelPos, const Config& cfg) {
+    return ApplyRetroPixelStyle(inputColor, pixelPos, cfg, RetroPalette::GetPaletteData(cfg.retro));
+}
+
+Pixel Rasterizer::ApplyRetroPixelStyle(Pixel inputColor,
+                                       const glm::ivec2& pixelPos,
+                                       const Config& cfg,
+                                       const RetroPalette::PaletteData& palette) {
     Pixel styledColor = inputColor;
     if (!UsePs1ShadingModel(cfg) &&
         !cfg.retro.enableOrderedDithering &&
         cfg.retro.enablePalette &&
         cfg.retro.palette != Config::PaletteType::NONE) {
         const Color& quantized = RetroPalette::GetPaletteColor(
-            cfg.retro,
-            RetroPalette::FindNearestPaletteIndex(inputColor.r, inputColor.g, inputColor.b, cfg.retro));
+            palette, RetroPalette::FindNearestPaletteIndex(inputColor.r, inputColor.g, inputColor.b, palette));
         styledColor = Pixel{quantized.r, quantized.g, quantized.b, inputColor.a};
     }
 
-    styledColor = ApplyRetroFillStyle(styledColor, pixelPos, cfg);
+    styledColor = ApplyRetroFillStyle(styledColor, pixelPos, cfg, palette);
     return ApplyPs1OutputStyle(styledColor, pixelPos, cfg);
 }
 
@@ -852,7 +906,10 @@ void Rasterizer::DrawTriangle(Buffer<Pixel>& framebuffer,
                               const std::vector<LightSnapshot>& lights,
                               const SoftwareMaterialState& materialState,
                               const glm::vec3& viewPosition,
-                              const Texture* texture) {
+                              const Texture* texture,
+                              const RetroPalette::PaletteData* palette) {
+    // Draws without a frame snapshot (tests, tools) fall back to this thread's cached copy.
+    const RetroPalette::PaletteData& framePalette = palette != nullptr ? *palette : RetroPalette::GetPaletteData(cfg.retro);
 
     // Convert vertices to viewport space.
     std::array<glm::vec3, 3> viewportVertices{};
@@ -872,6 +929,7 @@ void Rasterizer::DrawTriangle(Buffer<Pixel>& framebuffer,
         const bool shouldCull =
             materialState.pipelineState.cullMode == MaterialCullMode::FRONT ? !backface : backface;
         if (IsTriangleDegenerate(cullVertices) || shouldCull) {
+            RETRO_RASTER_COUNT(trianglesCulled, 1);
             return;
         }
     }
@@ -907,13 +965,13 @@ void Rasterizer::DrawTriangle(Buffer<Pixel>& framebuffer,
             // Route material-backed draws through it so software and GL agree on texture
             // sampling, vertex colors, alpha, and lighting semantics.
             DrawBarycentricTriangle(
-                framebuffer, depthBuffer, vertices, viewportVertices, cfg, lights, materialState, viewPosition, shadingTexture);
+                framebuffer, depthBuffer, vertices, viewportVertices, cfg, lights, materialState, viewPosition, shadingTexture, framePalette);
             break;
         }
         switch (cfg.software.rasterizer.fillMode) {
         case Config::RasterizationFillMode::BARYCENTRIC:
             DrawBarycentricTriangle(
-                framebuffer, depthBuffer, vertices, viewportVertices, cfg, lights, materialState, viewPosition, shadingTexture);
+                framebuffer, depthBuffer, vertices, viewportVertices, cfg, lights, materialState, viewPosition, shadingTexture, framePalette);
             break;
         default: {
             const glm::vec3 averageWorldPosition = ComputeAverageWorldPosition(vertices);
@@ -941,9 +999,9 @@ void Rasterizer::DrawTriangle(Buffer<Pixel>& framebuffer,
                 useVertexColor
                     ? ComputeAverageVertexColor(vertices)
                     : (usePs1Shading ? GetPs1FallbackBaseColor(cfg.retro.ps1MaterialMode, cfg) : GetStableUntexturedBaseColor(cfg));
-            const Pixel shadedColor = usePs1Shading ? ShadePs1Color(baseColor, lighting) : ShadeRetroColor(baseColor, lighting, cfg, shadingTexture);
+            const Pixel shadedColor = usePs1Shading ? ShadePs1Color(baseColor, lighting) : ShadeRetroColor(baseColor, lighting, cfg, framePalette, shadingTexture);
             const Pixel fillColor = ApplyDistanceFog(shadedColor, averageWorldPosition, viewPosition, cfg);
-            DrawFlatTriangle(framebuffer, depthBuffer, viewportVertices, cfg, fillColor);
+            DrawFlatTriangle(framebuffer, depthBuffer, viewportVertices, cfg, framePalette, fillColor);
             break;
         }
         }
@@ -1003,7 +1061,8 @@ void Rasterizer::DrawBarycentricTriangle(Buffer<Pixel>& framebuffer,
                                          const std::vector<LightSnapshot>& lights,
                                          const SoftwareMaterialState& materialState,
                                          const glm::vec3& viewPosition,
-                                         const Texture* texture) {
+                                         const Texture* texture,
+                                         const RetroPalette::PaletteData& palette) {
     std::array<RasterVertex, 3> shadeVertices = vertices;
     const bool usePs1Shading = UsePs1ShadingModel(cfg);
     const bool useLighting =
@@ -1012,12 +1071,17 @@ void Rasterizer::DrawBarycentricTriangle(Buffer<Pixel>& framebuffer,
                             materialState.pipelineState.shadingModel != MaterialShadingModel::UNLIT;
     const Texture* primaryTexture =
         texture != nullptr ? texture : (!materialState.samplers.empty() ? materialState.samplers.front().texture : nullptr);
+    const ResolvedMaterialSampler* primarySampler = FindTextureSampler(materialState, primaryTexture);
+    const TextureLevel* primaryReducedLevel = primarySampler != nullptr ? primarySampler->reducedLevel.get() : nullptr;
+    const IndexedTextureLevel* primaryReducedIndexedLevel =
+        primarySampler != nullptr ? primarySampler->reducedIndexedLevel.get() : nullptr;
     glm::vec2 v0 = {viewportVertices[0].x, viewportVertices[0].y};
     glm::vec2 v1 = {viewportVertices[1].x, viewportVertices[1].y};
     glm::vec2 v2 = {viewportVertices[2].x, viewportVertices[2].y};
 
     float area = EdgeFunction(v0, v1, v2);
     if (area == 0.0f) {
+        RETRO_RASTER_COUNT(trianglesCulled, 1);
         return;
     }
     if (area < 0.0f) {
@@ -1026,6 +1090,10 @@ void Rasterizer::DrawBarycentricTriangle(Buffer<Pixel>& framebuffer,
         std::swap(shadeVertices[1], shadeVertices[2]);
         area = -area;
     }
+    const float uvFootprintLog2 =
+        cfg.software.rasterizer.mipmapping ? ComputeUvFootprintLog2(shadeVertices, area) : kBaseLevelUvFootprintLog2;
+    const bool useIndexedClut =
+        usePs1Shading && cfg.retro.usePs1TextureClut && primaryTexture != nullptr && primaryTexture->HasIndexedPixels();
 
     std::array<glm::vec3, 3> vertexLighting{};
     if (cfg.retro.useGouraudShading && useLighting) {
@@ -1093,6 +1161,8 @@ void Rasterizer::DrawBarycentricTriangle(Buffer<Pixel>& framebuffer,
                 (w1 > 0.0f || (w1 == 0.0f && e1TopLeft)) &&
                 (w2 > 0.0f || (w2 == 0.0f && e2TopLeft));
             if (inside) {
+                RETRO_RASTER_COUNT(pixelsCovered, 1);
+                RETRO_RASTER_COUNT(pixelsShaded, 1);
                 const float b0 = w0 * invArea;
                 const float b1 = w1 * invArea;
                 const float b2 = w2 * invArea;
@@ -1108,9 +1178,11 @@ void Rasterizer::DrawBarycentricTriangle(Buffer<Pixel>& framebuffer,
                     fragmentInput.viewDirWS = glm::normalize(viewPosition - interpolants.worldPosition);
                     fragmentInput.screenUV = glm::vec2((static_cast<float>(x) + 0.5f) / static_cast<float>(framebuffer.width),
                                                        (static_cast<float>(y) + 0.5f) / static_cast<float>(framebuffer.height));
+                    fragmentInput.uvFootprintLog2 = uvFootprintLog2;
                     fragmentInput.varyings = interpolants.varyings;
                     surface = EvaluateMaterialFragmentStage(
                         *materialState.compiledTemplate, materialState.parameterValues, materialState.samplers, fragmentInput);
+                    RETRO_RASTER_COUNT(materialInstructions, materialState.compiledTemplate->fragmentProgram.instructions.size());
                 }
 
                 surface.baseColor = glm::clamp(surface.baseColor, 0.0f, 1.0f);
@@ -1118,6 +1190,7 @@ void Rasterizer::DrawBarycentricTriangle(Buffer<Pixel>& framebuffer,
                 surface.alpha = std::clamp(surface.alpha, 0.0f, 1.0f);
                 if (materialState.pipelineState.blendMode == MaterialBlendMode::ALPHA_CUTOUT &&
                     surface.alpha < materialState.pipelineState.alphaCutoff) {
+                    RETRO_RASTER_COUNT(pixelsAlphaDiscarded, 1);
                     continue;
                 }
 
@@ -1128,13 +1201,23 @@ void Rasterizer::DrawBarycentricTriangle(Buffer<Pixel>& framebuffer,
                     case Config::Ps1MaterialMode::TEXTURED_LIT:
                     case Config::Ps1MaterialMode::TEXTURED_UNLIT:
                         if (primaryTexture && primaryTexture->HasCpuPixels()) {
-                            ResolvedMaterialSampler sampler{};
-                            sampler.texture = primaryTexture;
-                            sampler.filter = MaterialFilterMode::NEAREST;
-                            sampler.wrapU = MaterialWrapMode::REPEAT;
-                            sampler.wrapV = MaterialWrapMode::REPEAT;
-                            Pixel texel = sampler.texture->SampleNearestRepeat(QuantizeTextureCoords(interpolants.texCoords, cfg));
-                            texel = ApplyPs1TextureStyle(texel, primaryTexture, cfg);
+                            const glm::vec2 texCoords = QuantizeTextureCoords(interpolants.texCoords, cfg);
+                            const int mipLevel = primaryTexture->SelectMipLevel(uvFootprintLog2);
+                            const bool sampleIndices =
+                                useIndexedClut &&
+                                (primaryReducedLevel != nullptr ? primaryReducedIndexedLevel != nullptr : mipLevel == 0);
+                            Pixel texel{};
+                            if (sampleIndices) {
+                                // CLUT lookup straight from the index copy; equivalent to the nearest-palette pass.
+                                const uint8_t paletteIndex = primaryReducedIndexedLevel != nullptr
+                                                                 ? SampleLevelNearestRepeat(*primaryReducedIndexedLevel, texCoords)
+                                                                 : primaryTexture->SampleIndexedNearestRepeat(texCoords);
+                                texel = QuantizePs1TexturePixel(primaryTexture->GetAutoPalettePixels()[paletteIndex], cfg);
+                            } else {
+                                texel = primaryReducedLevel != nullptr ? SampleLevelNearestRepeat(*primaryReducedLevel, texCoords)
+                                                                       : primaryTexture->SampleNearestRepeat(texCoords, mipLevel);
+                                texel = ApplyPs1TextureStyle(texel, primaryTexture, cfg);
+                            }
                             baseColor = MakeColorFromPixel(texel);
                         } else {
                             baseColor = GetPs1FallbackBaseColor(cfg.retro.ps1MaterialMode, cfg);
@@ -1191,11 +1274,12 @@ void Rasterizer::DrawBarycentricTriangle(Buffer<Pixel>& framebuffer,
                                                                   cfg,
                                                                   false)));
                 Pixel shadedColor =
-                    usePs1Shading ? ShadePs1Color(baseColor, lighting) : ShadeRetroColor(baseColor, lighting, cfg, primaryTexture);
+                    usePs1Shading ? ShadePs1Color(baseColor, lighting) : ShadeRetroColor(baseColor, lighting, cfg, palette, primaryTexture);
                 shadedColor = AddEmissiveToPixel(shadedColor, surface.emissive);
                 shadedColor.a = baseColor.a;
                 const Pixel fillColor = ApplyDistanceFog(shadedColor, interpolants.worldPosition, viewPosition, cfg);
-                WriteTrianglePixel(framebuffer, depthBuffer, x, y, z, cfg, fillColor, nullptr, primaryTexture, &materialState.pipelineState);
+                WriteTrianglePixel(
+                    framebuffer, depthBuffer, x, y, z, cfg, fillColor, nullptr, primaryTexture, &materialState.pipelineState, &palette);
             }
             w0 += w0StepX;
             w1 += w1StepX;
@@ -1268,8 +1352,9 @@ void Rasterizer::DrawFlatTriangle(Buffer<Pixel>& framebuffer,
                                   Buffer<float>& depthBuffer,
                                   std::array<glm::vec3, 3>& viewportVertices,
                                   const Config& cfg,
+                                  const RetroPalette::PaletteData& palette,
                                   Pixel fillColor) {
-    const DitherPattern fillPattern = BuildRetroFillPattern(fillColor, cfg);
+    const DitherPattern fillPattern = BuildRetroFillPattern(fillColor, cfg, palette);
     auto& v0 = viewportVertices[0];
     auto& v1 = viewportVertices[1];
     auto& v2 = viewportVertices[2];
@@ -1371,6 +1456,7 @@ void Rasterizer::FillFlatBottomTri(Buffer<Pixel>& framebuffer,
 
         float z = minZ;
         const float zStep = (xEnd != xStart) ? (maxZ - minZ) / static_cast<float>(xEnd - xStart) : 0.0f;
+        RETRO_RASTER_COUNT(pixelsCovered, xEnd - xStart + 1);
         for (int x = xStart; x <= xEnd; x++) {
             // Depth test (lower z is closer).
             WriteTrianglePixel(framebuffer, depthBuffer, x, y, z, cfg, fillColor, &fillPattern);
@@ -1440,6 +1526,7 @@ void Rasterizer::FillFlatTopTri(Buffer<Pixel>& framebuffer,
 
         float z = minZ;
         const float zStep = (xEnd != xStart) ? (maxZ - minZ) / static_cast<float>(xEnd - xStart) : 0.0f;
+        RETRO_RASTER_COUNT(pixelsCovered, xEnd - xStart + 1);
         for (int x = xStart; x <= xEnd; x++) {
             WriteTrianglePixel(framebuffer, depthBuffer, x, y, z, cfg, fillColor, &fillPattern);
             z += zStep;
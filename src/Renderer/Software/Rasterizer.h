@@ -11,6 +11,9 @@
 
 namespace RetroRenderer {
 class Texture;
+namespace RetroPalette {
+struct PaletteData;
+}
 
 struct RasterVertex {
     glm::vec3 position = glm::vec3(0.0f);
@@ -35,6 +38,11 @@ class Rasterizer {
     // TODO: add configurable line/triangle colors
     static glm::vec2 NDCToViewport(const glm::vec2& v, size_t width, size_t height);
     static Pixel ApplyRetroPixelStyle(Pixel inputColor, const glm::ivec2& pixelPos, const Config& cfg);
+    static Pixel ApplyRetroPixelStyle(Pixel inputColor,
+                                      const glm::ivec2& pixelPos,
+                                      const Config& cfg,
+                                      const RetroPalette::PaletteData& palette);
+    // palette is the frame's snapshot for cfg.retro; nullptr resolves it per call.
     static void DrawTriangle(Buffer<Pixel>& framebuffer,
                              Buffer<float>& depthBuffer,
                              std::array<RasterVertex, 3>& vertices,
@@ -42,7 +50,8 @@ class Rasterizer {
                              const std::vector<LightSnapshot>& lights,
                              const SoftwareMaterialState& materialState,
                              const glm::vec3& viewPosition,
-                             const Texture* texture = nullptr);
+                             const Texture* texture = nullptr,
+                             const RetroPalette::PaletteData* palette = nullptr);
     static void DrawTriangle(Buffer<Pixel>& framebuffer,
                              Buffer<float>& depthBuffer,
                              std::array<Vertex, 3>& vertices,
@@ -62,7 +71,8 @@ class Rasterizer {
                                         const std::vector<LightSnapshot>& lights,
                                         const SoftwareMaterialState& materialState,
                                         const glm::vec3& viewPosition,
-                                        const Texture* texture);
+                                        const Texture* texture,
+                                        const RetroPalette::PaletteData& palette);
     // Line drawing algos
     static void DrawLineDDA(Buffer<Pixel>& framebuffer, glm::vec2 p0, glm::vec2 p1, const Config& cfg, Pixel color);
     static void DrawLineBresenham(Buffer<Pixel>& framebuffer, glm::vec2 p0, glm::vec2 p1, const Config& cfg, Pixel color);
@@ -75,6 +85,7 @@ class Rasterizer {
                                  Buffer<float>& depthBuffer,
                                  std::array<glm::vec3, 3>& viewportVertices,
                                  const Config& cfg,
+                                 const RetroPalette::PaletteData& palette,
                                  Pixel fillColor);
     static void FillFlatBottomTri(Buffer<Pixel>& framebuffer,
                                   Buffer<float>& depthBuffer,
@@ -1,5 +1,7 @@
 #include "SWRenderer.h"
+#include "DepthClip.h"
 #include "../GridGizmo.h"
+#include "../../Base/FrameTrace.h"
 #include <SDL_image.h>
 #include <KrisLogger/Logger.h>
 #include <glm/gtx/string_cast.hpp>
@@ -45,57 +47,6 @@ glm::vec3 ComputeTriangleLightingNormal(const glm::vec3& worldPos0,
     return glm::normalize(normal0 + normal1 + normal2);
 }
 
-struct ClipPlane {
-    glm::vec4 equation;
-};
-
-constexpr size_t kMaxClippedPolygonVertices = 12;
-constexpr float kClipEpsilon = 1e-5f;
-
-struct ClipVertex {
-    glm::vec4 clipPosition = glm::vec4(0.0f);
-    glm::vec3 worldPosition = glm::vec3(0.0f);
-    glm::vec3 normal = glm::vec3(0.0f, 0.0f, 1.0f);
-    glm::vec2 texCoords = glm::vec2(0.0f);
-    glm::vec4 color = glm::vec4(1.0f);
-    std::array<glm::vec4, 4> varyings = {
-        glm::vec4(0.0f),
-        glm::vec4(0.0f),
-        glm::vec4(0.0f),
-        glm::vec4(0.0f),
-    };
-};
-
-struct ClippedPolygon {
-    std::array<ClipVertex, kMaxClippedPolygonVertices> vertices{};
-    size_t count = 0;
-};
-
-float PlaneDistance(const ClipPlane& plane, const ClipVertex& v) {
-    return glm::dot(plane.equation, v.clipPosition);
-}
-
-ClipVertex LerpVertex(const ClipVertex& a, const ClipVertex& b, float t) {
-    ClipVertex out;
-    out.clipPosition = glm::mix(a.clipPosition, b.clipPosition, t);
-    out.worldPosition = glm::mix(a.worldPosition, b.worldPosition, t);
-    out.normal = glm::mix(a.normal, b.normal, t);
-    out.texCoords = glm::mix(a.texCoords, b.texCoords, t);
-    out.color = glm::mix(a.color, b.color, t);
-    for (size_t varyingIndex = 0; varyingIndex < out.varyings.size(); varyingIndex++) {
-        out.varyings[varyingIndex] = glm::mix(a.varyings[varyingIndex], b.varyings[varyingIndex], t);
-    }
-    return out;
-}
-
-bool PushVertex(ClippedPolygon& polygon, const ClipVertex& vertex) {
-    if (polygon.count >= polygon.vertices.size()) {
-        return false;
-    }
-    polygon.vertices[polygon.count++] = vertex;
-    return true;
-}
-
 bool IsVertexInsideDepthClipSpace(const ClipVertex& vertex) {
     const glm::vec4& p = vertex.clipPosition;
     return p.z >= -p.w - kClipEpsilon &&
@@ -157,6 +108,116 @@ void SnapProjectedVertex(RasterVertex& vertex, size_t framebufferWidth, size_t f
     vertex.position.y = 1.0f - ((snappedViewport.y - 0.5f) / static_cast<float>(framebufferHeight)) * 2.0f;
 }
 
+bool IsAabbOutsideClipVolume(const glm::mat4& mvp, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    std::array<glm::vec4, 8> clipCorners{};
+    for (size_t i = 0; i < clipCorners.size(); i++) {
+        const glm::vec3 corner((i & 1u) ? boundsMax.x : boundsMin.x,
+                               (i & 2u) ? boundsMax.y : boundsMin.y,
+                               (i & 4u) ? boundsMax.z : boundsMin.z);
+        clipCorners[i] = mvp * glm::vec4(corner, 1.0f);
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        bool allBelow = true;
+        bool allAbove = true;
+        for (const glm::vec4& corner : clipCorners) {
+            allBelow = allBelow && corner[axis] < -corner.w;
+            allAbove = allAbove && corner[axis] > corner.w;
+        }
+        if (allBelow || allAbove) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Normal cones stay valid under rotation, translation and uniform scale only.
+bool IsSimilarityTransform(const glm::mat4& transform) {
+    const glm::vec3 x(transform[0]);
+    const glm::vec3 y(transform[1]);
+    const glm::vec3 z(transform[2]);
+    const float scale = glm::length(x);
+    if (scale <= 1e-6f || glm::determinant(glm::mat3(transform)) <= 0.0f) {
+        return false;
+    }
+    const float tolerance = scale * 1e-3f;
+    return std::abs(glm::length(y) - scale) <= tolerance &&
+           std::abs(glm::length(z) - scale) <= tolerance &&
+           std::abs(glm::dot(x, y)) <= tolerance * scale &&
+           std::abs(glm::dot(y, z)) <= tolerance * scale &&
+           std::abs(glm::dot(z, x)) <= tolerance * scale;
+}
+
+bool IsClusterBackfacing(const MeshCluster& cluster, const glm::mat4& worldTransform, const Camera& camera) {
+    if (cluster.coneCutoff >= 1.0f) {
+        return false;
+    }
+
+    const glm::vec3 axis = glm::normalize(glm::mat3(worldTransform) * cluster.coneAxis);
+    if (camera.m_Type == CameraType::ORTHOGRAPHIC) {
+        return glm::dot(glm::normalize(camera.m_Direction), axis) >= cluster.coneCutoff;
+    }
+
+    const glm::vec3 localCenter = (cluster.boundsMin + cluster.boundsMax) * 0.5f;
+    const glm::vec3 center = glm::vec3(worldTransform * glm::vec4(localCenter, 1.0f));
+    const float radius = glm::length(cluster.boundsMax - localCenter) * glm::length(glm::vec3(worldTransform[0]));
+    const glm::vec3 toCenter = center - camera.m_Position;
+    return glm::dot(toCenter, axis) >= cluster.coneCutoff * glm::length(toCenter) + radius;
+}
+
+// Items between pyramid updates; a stale pyramid only holds farther depths, so it stays conservative.
+constexpr size_t kOcclusionUpdateInterval = 4;
+// Level-0 tiles rescanned per frame, in screens and counting the first full build. Past it the pyramid is left stale
+// for the rest of the frame.
+constexpr size_t kOcclusionRescanBudgetScreens = 3;
+
+bool ShouldTestOcclusion(const Config& cfg, const MaterialPipelineState& pipelineState) {
+    return cfg.cull.occlusionCull && cfg.cull.depthTest && pipelineState.depthTest;
+}
+
+// Passed for items drawn from the authored index buffer, which the clusters do not index.
+const std::vector<MeshCluster> kNoClusters;
+
+// Blended draws and draws without depth test or write depend on triangle order, so they keep the authored index
+// buffer instead of the Morton-ordered cluster copy.
+bool CanDrawInClusterOrder(const Config& cfg, const MaterialPipelineState& pipelineState) {
+    return cfg.cull.depthTest && pipelineState.depthTest && pipelineState.depthWrite &&
+           pipelineState.blendMode != MaterialBlendMode::ALPHA_BLEND;
+}
+
+float ComputeOcclusionDepthBias(const Config& cfg) {
+    const int bits = cfg.retro.depthPrecisionBits;
+    if (bits <= 0) {
+        return 1e-6f;
+    }
+    const uint32_t levels = (1u << std::min(bits, 24)) - 1u;
+    return levels == 0u ? 1e-6f : 1.0f / static_cast<float>(levels) + 1e-6f;
+}
+
+float ComputeOcclusionPixelPadding(const Config& cfg) {
+    return cfg.retro.snapVertices ? std::max(cfg.retro.vertexSnapStep, 0.0f) : 0.0f;
+}
+
+bool UsesTextureAutoPalette(const Config& cfg) {
+    return (cfg.retro.usePs1ShadingModel && cfg.retro.usePs1TextureClut) ||
+           (cfg.retro.enablePalette && cfg.retro.useTextureDerivedPalette);
+}
+
+// 0 writes stay black, 1 is blue and each further write steps towards red; 7 or more saturate to white.
+Pixel OverdrawHeatmapColor(uint16_t writes) {
+    static constexpr std::array<Pixel, 8> kRamp = {{
+        {0, 0, 0, 255},
+        {20, 40, 160, 255},
+        {0, 140, 200, 255},
+        {0, 180, 80, 255},
+        {200, 200, 0, 255},
+        {240, 130, 0, 255},
+        {220, 30, 30, 255},
+        {255, 255, 255, 255},
+    }};
+    return kRamp[std::min<size_t>(writes, kRamp.size() - 1)];
+}
+
 bool ShouldDeferPs1Triangles(const Config& cfg) {
     return cfg.software.rasterizer.polygonMode == Config::RasterizationPolygonMode::FILL &&
            cfg.retro.usePs1ShadingModel &&
@@ -165,13 +226,25 @@ bool ShouldDeferPs1Triangles(const Config& cfg) {
 
 const Texture* ResolveFrameTexture(const RenderPacket& packet, FrameTextureId textureId);
 
-SoftwareMaterialState MakeSoftwareMaterialState(const RenderPacket& packet,
-                                                const FrameMaterialState& materialState,
-                                                const Config& config) {
-    SoftwareMaterialState state{};
+void ResolveReducedTextureLevels(ResolvedMaterialSampler& sampler, const Config& config) {
+    if (sampler.texture == nullptr || config.retro.textureMaxDimension <= 0) {
+        return;
+    }
+    sampler.reducedLevel = sampler.texture->GetReducedLevel(config.retro.textureMaxDimension);
+    if (config.retro.usePs1ShadingModel && config.retro.usePs1TextureClut) {
+        sampler.reducedIndexedLevel = sampler.texture->GetReducedIndexedLevel(config.retro.textureMaxDimension);
+    }
+}
+
+// Refills state in place so its vectors keep their capacity from one item to the next.
+void FillSoftwareMaterialState(const RenderPacket& packet,
+                               const FrameMaterialState& materialState,
+                               const Config& config,
+                               SoftwareMaterialState& state) {
     state.compiledTemplate = materialState.compiledTemplate;
-    state.parameterValues = materialState.parameterValues;
+    state.parameterValues.assign(materialState.parameterValues.begin(), materialState.parameterValues.end());
     state.pipelineState = materialState.pipelineState;
+    state.samplers.clear();
     if (materialState.compiledTemplate != nullptr) {
         state.samplers.reserve(materialState.compiledTemplate->samplers.size());
         for (size_t samplerIndex = 0; samplerIndex < materialState.compiledTemplate->samplers.size(); samplerIndex++) {
@@ -184,10 +257,10 @@ SoftwareMaterialState MakeSoftwareMaterialState(const RenderPacket& packet,
                 (config.retro.usePs1ShadingModel || config.retro.enablePalette) ? MaterialFilterMode::NEAREST : samplerDesc.filter;
             resolvedSampler.wrapU = samplerDesc.wrapU;
             resolvedSampler.wrapV = samplerDesc.wrapV;
-            state.samplers.push_back(resolvedSampler);
+            ResolveReducedTextureLevels(resolvedSampler, config);
+            state.samplers.push_back(std::move(resolvedSampler));
         }
     }
-    return state;
 }
 
 const FrameMaterialState* ResolveFrameMaterial(const RenderPacket& packet, FrameMaterialId materialId) {
@@ -284,6 +357,7 @@ void DrawDepthTestedLine(Buffer<Pixel>& framebuffer,
                          const glm::vec3& start,
                          const glm::vec3& end,
                          const Config& cfg,
+                         const RetroPalette::PaletteData& palette,
                          Pixel color) {
     const float dx = end.x - start.x;
     const float dy = end.y - start.y;
@@ -306,7 +380,7 @@ void DrawDepthTestedLine(Buffer<Pixel>& framebuffer,
             const size_t pixelIndex = static_cast<size_t>(pixelY) * framebuffer.width + static_cast<size_t>(pixelX);
             const float depth = QuantizeGridDepth(z, cfg);
             if (!cfg.cull.depthTest || depth < depthBuffer.data[pixelIndex]) {
-                framebuffer.data[pixelIndex] = Rasterizer::ApplyRetroPixelStyle(color, glm::ivec2{pixelX, pixelY}, cfg);
+                framebuffer.data[pixelIndex] = Rasterizer::ApplyRetroPixelStyle(color, glm::ivec2{pixelX, pixelY}, cfg, palette);
                 if (cfg.cull.depthTest) {
                     depthBuffer.data[pixelIndex] = depth;
                 }
@@ -319,62 +393,6 @@ void DrawDepthTestedLine(Buffer<Pixel>& framebuffer,
     }
 }
 
-ClippedPolygon ClipPolygonDepthClipSpace(const std::array<ClipVertex, 3>& inputTriangle) {
-    static const ClipPlane kPlanes[] = {
-        {{0.0f, 0.0f, 1.0f, 1.0f}},   // z >= -w
-        {{0.0f, 0.0f, -1.0f, 1.0f}},  // z <= w
-    };
-
-    ClippedPolygon poly{};
-    poly.vertices[0] = inputTriangle[0];
-    poly.vertices[1] = inputTriangle[1];
-    poly.vertices[2] = inputTriangle[2];
-    poly.count = 3;
-
-    ClippedPolygon output{};
-    for (const auto& plane : kPlanes) {
-        if (poly.count == 0) {
-            break;
-        }
-        output.count = 0;
-        ClipVertex prev = poly.vertices[poly.count - 1];
-        float prevDist = PlaneDistance(plane, prev);
-        bool prevInside = prevDist >= -kClipEpsilon;
-
-        for (size_t i = 0; i < poly.count; i++) {
-            const ClipVertex& curr = poly.vertices[i];
-            float currDist = PlaneDistance(plane, curr);
-            bool currInside = currDist >= -kClipEpsilon;
-
-            if (currInside != prevInside) {
-                const float denominator = prevDist - currDist;
-                if (std::abs(denominator) <= 1e-8f) {
-                    prev = curr;
-                    prevDist = currDist;
-                    prevInside = currInside;
-                    continue;
-                }
-                const float t = std::clamp(prevDist / denominator, 0.0f, 1.0f);
-                if (!PushVertex(output, LerpVertex(prev, curr, t))) {
-                    output.count = 0;
-                    return output;
-                }
-            }
-            if (currInside) {
-                if (!PushVertex(output, curr)) {
-                    output.count = 0;
-                    return output;
-                }
-            }
-            prev = curr;
-            prevDist = currDist;
-            prevInside = currInside;
-        }
-        std::swap(poly, output);
-    }
-    return poly;
-}
-
 std::string DefaultSkyboxCrossPath() {
 #ifdef __ANDROID__
     return "img/skybox-cubemap/Cubemap_Sky_23-512x512.png";
@@ -610,6 +628,7 @@ bool SWRenderer::Init(int w, int h) {
     m_FrameBuffer = std::move(fb);
     m_DepthBuffer = std::make_unique<Buffer<float>>(w, h);
     m_Rasterizer = std::make_unique<Rasterizer>();
+    m_FramePalette = RetroPalette::AcquirePaletteSnapshot(m_FrameConfigSnapshot.retro);
     m_SkyboxCacheValid = false;
     return true;
 }
@@ -638,6 +657,7 @@ void SWRenderer::Destroy() {
     m_NormalScratch.clear();
     m_WorldPositionScratch.clear();
     m_DeferredPs1Triangles.clear();
+    m_OverdrawCounts.reset();
     p_Camera = nullptr;
 }
 
@@ -645,11 +665,41 @@ void SWRenderer::RenderFrame(const RenderPacket& packet) {
     if (!packet.hasScene) {
         return;
     }
+    RETRO_TRACE_ZONE("SWRenderer::RenderFrame");
 
     m_FrameCameraSnapshot = packet.camera;
     SetActiveCamera(m_FrameCameraSnapshot);
     SetSceneLights(packet.lights);
     SetFrameConfig(packet.configSnapshot);
+    m_CullStats = {};
+    m_RasterCounters = {};
+#if RETRO_RASTER_COUNTERS
+    const Config::SoftwareRasterizerSettings& rasterSettings = packet.configSnapshot.software.rasterizer;
+    if (!rasterSettings.overdrawHeatmap) {
+        m_OverdrawCounts.reset();
+    } else if (!m_OverdrawCounts ||
+               m_OverdrawCounts->width != m_FrameBuffer->width ||
+               m_OverdrawCounts->height != m_FrameBuffer->height) {
+        m_OverdrawCounts = std::make_unique<Buffer<uint16_t>>(m_FrameBuffer->width, m_FrameBuffer->height);
+    }
+    const RasterCounterScope rasterCounterScope(rasterSettings.collectCounters ? &m_RasterCounters : nullptr,
+                                                m_OverdrawCounts.get());
+#endif
+    m_FrameMaterialTimeSeconds = packet.materialTimeSeconds;
+    const bool usesAutoPalette = UsesTextureAutoPalette(packet.configSnapshot);
+    const bool usesMipmaps = packet.configSnapshot.software.rasterizer.mipmapping;
+    for (const std::shared_ptr<const Texture>& texture : packet.textures) {
+        if (texture == nullptr) {
+            continue;
+        }
+        texture->EnsureTiledLayout();
+        if (usesMipmaps) {
+            texture->EnsureMipChain();
+        }
+        if (usesAutoPalette) {
+            texture->EnsureAutoPalette();
+        }
+    }
 
     BeforeFrame(packet.clearColor);
     if (packet.configSnapshot.environment.showSkybox) {
@@ -658,6 +708,13 @@ void SWRenderer::RenderFrame(const RenderPacket& packet) {
         ReleaseSkyboxResources();
     }
 
+    // Items arrive roughly front-to-back, so the pyramid is built once from the depth written so far and then
+    // patched where later items drew, to reject items hidden behind earlier ones.
+    m_OcclusionPyramid.Invalidate();
+    const float occlusionDepthBias = ComputeOcclusionDepthBias(packet.configSnapshot);
+    const float occlusionPixelPadding = ComputeOcclusionPixelPadding(packet.configSnapshot);
+    const glm::mat4 viewProjection = packet.camera.m_ProjMat * packet.camera.m_ViewMat;
+    size_t itemsSinceOcclusionUpdate = 0;
     for (const RenderItem& item : packet.items) {
         if (!item.geometry) {
             continue;
@@ -667,12 +724,49 @@ void SWRenderer::RenderFrame(const RenderPacket& packet) {
             continue;
         }
 
+        const glm::mat4 itemMvp = viewProjection * item.worldTransform;
+        const glm::vec3 padding(std::max(materialState->pipelineState.boundsPadding, 0.0f));
+        if (ShouldTestOcclusion(packet.configSnapshot, materialState->pipelineState) && !item.geometry->clusters.empty()) {
+            if (itemsSinceOcclusionUpdate > 0 && !m_OcclusionPyramid.IsValid()) {
+                RETRO_TRACE_ZONE("SW occlusion build");
+                m_OcclusionPyramid.Build(*m_DepthBuffer);
+                m_CullStats.occlusionFullBuilds++;
+                m_CullStats.occlusionTilesRescanned += m_OcclusionPyramid.GetTileCount();
+                itemsSinceOcclusionUpdate = 0;
+            } else if (itemsSinceOcclusionUpdate >= kOcclusionUpdateInterval &&
+                       m_OcclusionPyramid.GetDirtyTileCount() > 0 &&
+                       m_CullStats.occlusionTilesRescanned + m_OcclusionPyramid.GetDirtyTileCount() <=
+                           kOcclusionRescanBudgetScreens * m_OcclusionPyramid.GetTileCount()) {
+                RETRO_TRACE_ZONE("SW occlusion update");
+                m_CullStats.occlusionTilesRescanned += m_OcclusionPyramid.Update(*m_DepthBuffer);
+                itemsSinceOcclusionUpdate = 0;
+            }
+            m_CullStats.itemsTested++;
+            if (m_OcclusionPyramid.IsAabbOccluded(itemMvp,
+                                                  item.geometry->boundsMin - padding,
+                                                  item.geometry->boundsMax + padding,
+                                                  occlusionDepthBias,
+                                                  occlusionPixelPadding)) {
+                m_CullStats.itemsOcclusionCulled++;
+                continue;
+            }
+        }
+
+        itemsSinceOcclusionUpdate++;
+        FillSoftwareMaterialState(packet, *materialState, packet.configSnapshot, m_ItemMaterialScratch);
+        const bool useClusters = item.geometry->clusterIndices.empty() ||
+                                 CanDrawInClusterOrder(packet.configSnapshot, materialState->pipelineState);
         DrawMeshData(
             item.geometry->vertices,
-            item.geometry->indices,
+            useClusters ? item.geometry->GetClusterIndices() : item.geometry->indices,
+            useClusters ? item.geometry->clusters : kNoClusters,
             item.worldTransform,
-            MakeSoftwareMaterialState(packet, *materialState, packet.configSnapshot),
+            m_ItemMaterialScratch,
             nullptr);
+        m_OcclusionPyramid.MarkAabbDirty(itemMvp,
+                                         item.geometry->boundsMin - padding,
+                                         item.geometry->boundsMax + padding,
+                                         occlusionPixelPadding);
     }
 
     EndFrame();
@@ -691,10 +785,12 @@ void SWRenderer::SetSceneLights(const std::vector<LightSnapshot>& lights) {
 
 void SWRenderer::SetFrameConfig(const Config& config) {
     m_FrameConfigSnapshot = config;
+    m_FramePalette = RetroPalette::AcquirePaletteSnapshot(config.retro);
 }
 
 void SWRenderer::DrawMeshData(const std::vector<Vertex>& vertices,
                               const std::vector<unsigned int>& indices,
+                              const std::vector<MeshCluster>& clusters,
                               const glm::mat4& worldTransform,
                               const SoftwareMaterialState& materialState,
                               const Texture* texture) {
@@ -712,40 +808,115 @@ void SWRenderer::DrawMeshData(const std::vector<Vertex>& vertices,
     if (!materialState.compiledTemplate || vertices.empty() || indices.empty() || indices.size() % 3 != 0) {
         return;
     }
+    RETRO_TRACE_ZONE("SW draw mesh");
     const unsigned int faceCount = static_cast<unsigned int>(indices.size() / 3);
 
+    // Reject whole clusters before any vertex-stage work. Meshes without clusters draw as a single index range.
+    auto& visibleIndexRanges = m_VisibleIndexRangeScratch;
+    visibleIndexRanges.clear();
+    if (clusters.empty()) {
+        visibleIndexRanges.emplace_back(0u, static_cast<uint32_t>(indices.size()));
+    } else {
+        const MaterialPipelineState& pipelineState = materialState.pipelineState;
+        const float boundsPadding = std::max(pipelineState.boundsPadding, 0.0f);
+        const bool testFrustum = cfg.cull.frustumCull;
+        const bool testOcclusion = ShouldTestOcclusion(cfg, pipelineState) && m_OcclusionPyramid.IsValid();
+        const float occlusionDepthBias = ComputeOcclusionDepthBias(cfg);
+        const float occlusionPixelPadding = ComputeOcclusionPixelPadding(cfg);
+        const bool testBackface = cfg.cull.backfaceCulling &&
+                                  pipelineState.cullMode == MaterialCullMode::BACK &&
+                                  boundsPadding == 0.0f &&
+                                  IsSimilarityTransform(worldTransform);
+        for (const MeshCluster& cluster : clusters) {
+            m_CullStats.clustersTested++;
+            if (testFrustum &&
+                IsAabbOutsideClipVolume(mvp,
+                                        cluster.boundsMin - glm::vec3(boundsPadding),
+                                        cluster.boundsMax + glm::vec3(boundsPadding))) {
+                m_CullStats.clustersFrustumCulled++;
+                continue;
+            }
+            if (testBackface && IsClusterBackfacing(cluster, worldTransform, *p_Camera)) {
+                m_CullStats.clustersBackfaceCulled++;
+                continue;
+            }
+            if (testOcclusion &&
+                m_OcclusionPyramid.IsAabbOccluded(mvp,
+                                                  cluster.boundsMin - glm::vec3(boundsPadding),
+                                                  cluster.boundsMax + glm::vec3(boundsPadding),
+                                                  occlusionDepthBias,
+                                                  occlusionPixelPadding)) {
+                m_CullStats.clustersOcclusionCulled++;
+                continue;
+            }
+
+            const uint32_t rangeEnd = cluster.firstIndex + cluster.indexCount;
+            if (!visibleIndexRanges.empty() && visibleIndexRanges.back().second == cluster.firstIndex) {
+                visibleIndexRanges.back().second = rangeEnd;
+            } else {
+                visibleIndexRanges.emplace_back(cluster.firstIndex, rangeEnd);
+            }
+        }
+        if (visibleIndexRanges.empty()) {
+            return;
+        }
+    }
+    const bool evaluateAllVertices = visibleIndexRanges.size() == 1 &&
+                                     visibleIndexRanges.front().first == 0 &&
+                                     visibleIndexRanges.front().second == indices.size();
+    if (!evaluateAllVertices) {
+        m_VertexReferencedScratch.assign(vertices.size(), 0);
+        for (const auto& [rangeBegin, rangeEnd] : visibleIndexRanges) {
+            for (uint32_t index = rangeBegin; index < rangeEnd; index++) {
+                if (indices[index] < vertices.size()) {
+                    m_VertexReferencedScratch[indices[index]] = 1;
+                }
+            }
+        }
+    }
+
     const bool deferPs1Triangles = ShouldDeferPs1Triangles(cfg);
     m_ClipPositionScratch.resize(vertices.size());
     m_NormalScratch.resize(vertices.size());
     m_WorldPositionScratch.resize(vertices.size());
-    std::vector<MaterialVertexStageOutput> vertexStageOutputs(vertices.size());
+    m_VertexStageOutputScratch.resize(vertices.size());
+    auto& vertexStageOutputs = m_VertexStageOutputScratch;
     auto& clipPositions = m_ClipPositionScratch;
     auto& transformedNormals = m_NormalScratch;
     auto& worldPositions = m_WorldPositionScratch;
-    const float materialTimeSeconds = static_cast<float>(SDL_GetTicks()) / 1000.0f;
-    for (size_t vertexIndex = 0; vertexIndex < vertices.size(); vertexIndex++) {
-        const Vertex& sourceVertex = vertices[vertexIndex];
-        MaterialVertexStageInput stageInput{};
-        stageInput.positionOS = sourceVertex.position;
-        stageInput.normalOS = sourceVertex.normal;
-        stageInput.uv0 = sourceVertex.texCoords;
-        stageInput.color0 = glm::vec4(sourceVertex.color, 1.0f);
-        stageInput.time = materialTimeSeconds;
-        EvaluateMaterialVertexStage(*materialState.compiledTemplate, materialState.parameterValues, stageInput, vertexStageOutputs[vertexIndex]);
-
-        clipPositions[vertexIndex] = mvp * vertexStageOutputs[vertexIndex].positionOS;
-        transformedNormals[vertexIndex] =
-            glm::normalize(glm::vec3(n * glm::vec4(vertexStageOutputs[vertexIndex].normalOS, 0.0f)));
-        worldPositions[vertexIndex] = glm::vec3(worldTransform * vertexStageOutputs[vertexIndex].positionOS);
-    }
-    SoftwareMaterialState drawMaterialState = materialState;
-    if (drawMaterialState.samplers.empty() && texture != nullptr) {
-        drawMaterialState.samplers.push_back(ResolvedMaterialSampler{
+    {
+        RETRO_TRACE_ZONE("SW vertex stage");
+        for (size_t vertexIndex = 0; vertexIndex < vertices.size(); vertexIndex++) {
+            if (!evaluateAllVertices && m_VertexReferencedScratch[vertexIndex] == 0) {
+                continue;
+            }
+            const Vertex& sourceVertex = vertices[vertexIndex];
+            MaterialVertexStageInput stageInput{};
+            stageInput.positionOS = sourceVertex.position;
+            stageInput.normalOS = sourceVertex.normal;
+            stageInput.uv0 = sourceVertex.texCoords;
+            stageInput.color0 = glm::vec4(sourceVertex.color, 1.0f);
+            stageInput.time = m_FrameMaterialTimeSeconds;
+            EvaluateMaterialVertexStage(*materialState.compiledTemplate, materialState.parameterValues, stageInput, vertexStageOutputs[vertexIndex]);
+            RETRO_RASTER_COUNT(materialInstructions, materialState.compiledTemplate->vertexProgram.instructions.size());
+
+            clipPositions[vertexIndex] = mvp * vertexStageOutputs[vertexIndex].positionOS;
+            transformedNormals[vertexIndex] =
+                glm::normalize(glm::vec3(n * glm::vec4(vertexStageOutputs[vertexIndex].normalOS, 0.0f)));
+            worldPositions[vertexIndex] = glm::vec3(worldTransform * vertexStageOutputs[vertexIndex].positionOS);
+        }
+    }
+    const SoftwareMaterialState* drawMaterialState = &materialState;
+    if (materialState.samplers.empty() && texture != nullptr) {
+        m_TextureFallbackMaterialScratch = materialState;
+        m_TextureFallbackMaterialScratch.samplers.push_back(ResolvedMaterialSampler{
             .texture = texture,
             .filter = MaterialFilterMode::LINEAR,
             .wrapU = MaterialWrapMode::REPEAT,
             .wrapV = MaterialWrapMode::REPEAT,
         });
+        ResolveReducedTextureLevels(m_TextureFallbackMaterialScratch.samplers.back(), cfg);
+        drawMaterialState = &m_TextureFallbackMaterialScratch;
     }
     if (deferPs1Triangles) {
         m_DeferredPs1Triangles.reserve(m_DeferredPs1Triangles.size() + faceCount);
@@ -756,9 +927,10 @@ void SWRenderer::DrawMeshData(const std::vector<Vertex>& vertices,
             DeferredTriangle deferredTriangle{};
             deferredTriangle.vertices = rasterVertices;
             deferredTriangle.texture = texture;
-            deferredTriangle.materialState = drawMaterialState;
+            deferredTriangle.materialState = *drawMaterialState;
             deferredTriangle.sortKey = ComputeDeferredTriangleSortKey(rasterVertices, p_Camera->m_Position);
-            m_DeferredPs1Triangles.push_back(deferredTriangle);
+            m_DeferredPs1Triangles.push_back(std::move(deferredTriangle));
+            RETRO_RASTER_COUNT(trianglesDeferred, 1);
             return;
         }
 
@@ -769,76 +941,98 @@ void SWRenderer::DrawMeshData(const std::vector<Vertex>& vertices,
             drawVertices,
             cfg,
             m_FrameLights,
-            drawMaterialState,
+            *drawMaterialState,
             p_Camera->m_Position,
-            texture);
+            texture,
+            m_FramePalette.get());
     };
 
-    for (unsigned int i = 0; i < faceCount; i++) {
-        const unsigned int baseIndex = i * 3;
-        const unsigned int i0 = indices[baseIndex];
-        const unsigned int i1 = indices[baseIndex + 1];
-        const unsigned int i2 = indices[baseIndex + 2];
-        if (i0 >= vertices.size() || i1 >= vertices.size() || i2 >= vertices.size()) {
-            continue;
-        }
-        const glm::vec4& clipPos0 = clipPositions[i0];
-        const glm::vec4& clipPos1 = clipPositions[i1];
-        const glm::vec4& clipPos2 = clipPositions[i2];
-        const unsigned int triangleIndices[3] = {i0, i1, i2};
-
-        const glm::vec3& worldPos0 = worldPositions[i0];
-        const glm::vec3& worldPos1 = worldPositions[i1];
-        const glm::vec3& worldPos2 = worldPositions[i2];
-        const glm::vec3 triangleNormal = ComputeTriangleLightingNormal(
-            worldPos0,
-            worldPos1,
-            worldPos2,
-            transformedNormals[i0],
-            transformedNormals[i1],
-            transformedNormals[i2],
-            cfg);
-
-        std::array<ClipVertex, 3> clipVertices{};
-        const glm::vec4 clipPositionsForTri[3] = {clipPos0, clipPos1, clipPos2};
-        for (int v = 0; v < 3; v++) {
-            const unsigned int vertexIndex = triangleIndices[v];
-            clipVertices[v].clipPosition = clipPositionsForTri[v];
-            clipVertices[v].worldPosition = worldPositions[vertexIndex];
-            clipVertices[v].normal = cfg.retro.flatFaceLighting ? triangleNormal : transformedNormals[vertexIndex];
-            clipVertices[v].texCoords = vertexStageOutputs[vertexIndex].uv0;
-            clipVertices[v].color = vertexStageOutputs[vertexIndex].color0;
-            clipVertices[v].varyings = vertexStageOutputs[vertexIndex].varyings;
-        }
-
-        if (cfg.cull.rasterClip && IsTriangleTriviallyRejectedByDepth(clipVertices)) {
-            continue;
-        }
-        if (cfg.cull.geometricClip) {
-            std::array<RasterVertex, 3> rasterVertices{};
-            if (IsTriangleFullyInsideDepthClipSpace(clipVertices)) {
-                if (!TryMakeRasterTriangle(clipVertices, rasterVertices)) {
-                    continue;
-                }
-                if (cfg.retro.snapVertices) {
-                    for (auto& vertex : rasterVertices) {
-                        SnapProjectedVertex(vertex, m_FrameBuffer->width, m_FrameBuffer->height, cfg.retro.vertexSnapStep);
-                    }
-                }
-                submitTriangle(rasterVertices);
+    // Clipping and rasterization interleave per triangle, so they share one zone; per-triangle zones would cost more
+    // than the work they measure.
+    RETRO_TRACE_ZONE("SW clip/raster");
+    for (const auto& [rangeBegin, rangeEnd] : visibleIndexRanges) {
+        for (uint32_t baseIndex = rangeBegin; baseIndex + 2 < rangeEnd; baseIndex += 3) {
+            const unsigned int i0 = indices[baseIndex];
+            const unsigned int i1 = indices[baseIndex + 1];
+            const unsigned int i2 = indices[baseIndex + 2];
+            if (i0 >= vertices.size() || i1 >= vertices.size() || i2 >= vertices.size()) {
                 continue;
             }
+            RETRO_RASTER_COUNT(trianglesSubmitted, 1);
+            const glm::vec4& clipPos0 = clipPositions[i0];
+            const glm::vec4& clipPos1 = clipPositions[i1];
+            const glm::vec4& clipPos2 = clipPositions[i2];
+            const unsigned int triangleIndices[3] = {i0, i1, i2};
+
+            const glm::vec3& worldPos0 = worldPositions[i0];
+            const glm::vec3& worldPos1 = worldPositions[i1];
+            const glm::vec3& worldPos2 = worldPositions[i2];
+            const glm::vec3 triangleNormal = ComputeTriangleLightingNormal(
+                worldPos0,
+                worldPos1,
+                worldPos2,
+                transformedNormals[i0],
+                transformedNormals[i1],
+                transformedNormals[i2],
+                cfg);
+
+            std::array<ClipVertex, 3> clipVertices{};
+            const glm::vec4 clipPositionsForTri[3] = {clipPos0, clipPos1, clipPos2};
+            for (int v = 0; v < 3; v++) {
+                const unsigned int vertexIndex = triangleIndices[v];
+                clipVertices[v].clipPosition = clipPositionsForTri[v];
+                clipVertices[v].worldPosition = worldPositions[vertexIndex];
+                clipVertices[v].normal = cfg.retro.flatFaceLighting ? triangleNormal : transformedNormals[vertexIndex];
+                clipVertices[v].texCoords = vertexStageOutputs[vertexIndex].uv0;
+                clipVertices[v].color = vertexStageOutputs[vertexIndex].color0;
+                clipVertices[v].varyings = vertexStageOutputs[vertexIndex].varyings;
+            }
 
-            const ClippedPolygon clipped = ClipPolygonDepthClipSpace(clipVertices);
-            if (clipped.count < 3) {
+            if (cfg.cull.rasterClip && IsTriangleTriviallyRejectedByDepth(clipVertices)) {
+                RETRO_RASTER_COUNT(trianglesCulled, 1);
                 continue;
             }
-            for (size_t t = 1; t + 1 < clipped.count; t++) {
-                const std::array<ClipVertex, 3> clippedTriangle = {
-                    clipped.vertices[0],
-                    clipped.vertices[t],
-                    clipped.vertices[t + 1]};
-                if (!TryMakeRasterTriangle(clippedTriangle, rasterVertices)) {
+            if (cfg.cull.geometricClip) {
+                std::array<RasterVertex, 3> rasterVertices{};
+                if (IsTriangleFullyInsideDepthClipSpace(clipVertices)) {
+                    if (!TryMakeRasterTriangle(clipVertices, rasterVertices)) {
+                        RETRO_RASTER_COUNT(trianglesCulled, 1);
+                        continue;
+                    }
+                    if (cfg.retro.snapVertices) {
+                        for (auto& vertex : rasterVertices) {
+                            SnapProjectedVertex(vertex, m_FrameBuffer->width, m_FrameBuffer->height, cfg.retro.vertexSnapStep);
+                        }
+                    }
+                    submitTriangle(rasterVertices);
+                    continue;
+                }
+
+                const ClippedPolygon clipped = ClipPolygonDepthClipSpace(clipVertices);
+                if (clipped.count < 3) {
+                    RETRO_RASTER_COUNT(trianglesCulled, 1);
+                    continue;
+                }
+                RETRO_RASTER_COUNT(trianglesClipped, 1);
+                for (size_t t = 1; t + 1 < clipped.count; t++) {
+                    const std::array<ClipVertex, 3> clippedTriangle = {
+                        clipped.vertices[0],
+                        clipped.vertices[t],
+                        clipped.vertices[t + 1]};
+                    if (!TryMakeRasterTriangle(clippedTriangle, rasterVertices)) {
+                        continue;
+                    }
+                    if (cfg.retro.snapVertices) {
+                        for (auto& vertex : rasterVertices) {
+                            SnapProjectedVertex(vertex, m_FrameBuffer->width, m_FrameBuffer->height, cfg.retro.vertexSnapStep);
+                        }
+                    }
+                    submitTriangle(rasterVertices);
+                }
+            } else {
+                std::array<RasterVertex, 3> rasterVertices{};
+                if (!TryMakeRasterTriangle(clipVertices, rasterVertices)) {
+                    RETRO_RASTER_COUNT(trianglesCulled, 1);
                     continue;
                 }
                 if (cfg.retro.snapVertices) {
@@ -848,38 +1042,35 @@ void SWRenderer::DrawMeshData(const std::vector<Vertex>& vertices,
                 }
                 submitTriangle(rasterVertices);
             }
-        } else {
-            std::array<RasterVertex, 3> rasterVertices{};
-            if (!TryMakeRasterTriangle(clipVertices, rasterVertices)) {
-                continue;
-            }
-            if (cfg.retro.snapVertices) {
-                for (auto& vertex : rasterVertices) {
-                    SnapProjectedVertex(vertex, m_FrameBuffer->width, m_FrameBuffer->height, cfg.retro.vertexSnapStep);
-                }
-            }
-            submitTriangle(rasterVertices);
         }
     }
 }
 
 void SWRenderer::BeforeFrame(const Color& clearColor) {
+    RETRO_TRACE_ZONE("SW clear");
     m_FrameBuffer->Clear(clearColor.ToPixel());
     if (m_DepthBuffer) {
         m_DepthBuffer->Clear(1.0f);
     }
     m_DeferredPs1Triangles.clear();
+    if (m_OverdrawCounts) {
+        m_OverdrawCounts->Clear();
+    }
 }
 
 void SWRenderer::EndFrame() {
     if (!m_DeferredPs1Triangles.empty()) {
-        std::stable_sort(
-            m_DeferredPs1Triangles.begin(),
-            m_DeferredPs1Triangles.end(),
-            [](const DeferredTriangle& lhs, const DeferredTriangle& rhs) {
-                return lhs.sortKey > rhs.sortKey;
-            });
+        {
+            RETRO_TRACE_ZONE("SW deferred sort");
+            std::stable_sort(
+                m_DeferredPs1Triangles.begin(),
+                m_DeferredPs1Triangles.end(),
+                [](const DeferredTriangle& lhs, const DeferredTriangle& rhs) {
+                    return lhs.sortKey > rhs.sortKey;
+                });
+        }
 
+        RETRO_TRACE_ZONE("SW deferred raster");
         for (const DeferredTriangle& deferredTriangle : m_DeferredPs1Triangles) {
             std::array<RasterVertex, 3> drawVertices = deferredTriangle.vertices;
             Rasterizer::DrawTriangle(
@@ -890,11 +1081,22 @@ void SWRenderer::EndFrame() {
                 m_FrameLights,
                 deferredTriangle.materialState,
                 p_Camera->m_Position,
-                deferredTriangle.texture);
+                deferredTriangle.texture,
+                m_FramePalette.get());
         }
         m_DeferredPs1Triangles.clear();
     }
     ApplyOutlinePass();
+    ApplyOverdrawHeatmap();
+}
+
+void SWRenderer::ApplyOverdrawHeatmap() {
+    if (!m_OverdrawCounts || m_OverdrawCounts->GetCount() != m_FrameBuffer->GetCount()) {
+        return;
+    }
+    for (size_t pixelIndex = 0; pixelIndex < m_FrameBuffer->GetCount(); pixelIndex++) {
+        m_FrameBuffer->data[pixelIndex] = OverdrawHeatmapColor(m_OverdrawCounts->data[pixelIndex]);
+    }
 }
 
 void SWRenderer::ApplyOutlinePass() {
@@ -904,6 +1106,7 @@ void SWRenderer::ApplyOutlinePass() {
         m_FrameConfigSnapshot.software.rasterizer.polygonMode != Config::RasterizationPolygonMode::FILL) {
         return;
     }
+    RETRO_TRACE_ZONE("SW outline");
 
     const size_t width = m_FrameBuffer->width;
     const size_t height = m_FrameBuffer->height;
@@ -914,7 +1117,8 @@ void SWRenderer::ApplyOutlinePass() {
     const int radius = std::clamp(m_FrameConfigSnapshot.retro.outlineThickness, 1, 4);
     const Pixel outlineColor = m_FrameConfigSnapshot.retro.outlineColor.ToPixel();
     const float backgroundDepth = 1.0f - 1e-4f;
-    std::vector<uint8_t> outlineMask(width * height, 0);
+    std::vector<uint8_t>& outlineMask = m_OutlineMaskScratch;
+    outlineMask.assign(width * height, 0);
 
     for (size_t y = 0; y < height; y++) {
         for (size_t x = 0; x < width; x++) {
@@ -958,6 +1162,7 @@ void SWRenderer::ApplyOutlinePass() {
 }
 
 void SWRenderer::DrawSkybox() {
+    RETRO_TRACE_ZONE("SW skybox");
     if (!EnsureSkyboxLoaded() || !p_Camera || !m_FrameBuffer) {
         return;
     }
@@ -1004,7 +1209,8 @@ void SWRenderer::DrawSkybox() {
             dstRow[x] = Rasterizer::ApplyRetroPixelStyle(
                 srcRow[x],
                 glm::ivec2{static_cast<int>(x), static_cast<int>(y)},
-                m_FrameConfigSnapshot);
+                m_FrameConfigSnapshot,
+                *m_FramePalette);
         }
     }
 }
@@ -1013,9 +1219,11 @@ void SWRenderer::DrawGridGizmo() {
     if (!p_Camera || !m_FrameBuffer || !m_DepthBuffer) {
         return;
     }
+    RETRO_TRACE_ZONE("SW grid");
 
     const glm::mat4 viewProjection = p_Camera->m_ProjMat * p_Camera->m_ViewMat;
-    const std::vector<GridGizmoVertex> gridVertices = BuildGridGizmoVertices(p_Camera->m_Position);
+    BuildGridGizmoVertices(p_Camera->m_Position, m_GridVertexScratch);
+    const std::vector<GridGizmoVertex>& gridVertices = m_GridVertexScratch;
     for (size_t i = 0; i + 1 < gridVertices.size(); i += 2) {
         glm::vec4 clipStart = viewProjection * glm::vec4(gridVertices[i].position, 1.0f);
         glm::vec4 clipEnd = viewProjection * glm::vec4(gridVertices[i + 1].position, 1.0f);
@@ -1038,6 +1246,7 @@ void SWRenderer::DrawGridGizmo() {
             lineStart,
             lineEnd,
             m_FrameConfigSnapshot,
+            *m_FramePalette,
             GridColorToPixel(gridVertices[i].color));
     }
 }
@@ -1058,7 +1267,14 @@ SoftwareRendererMemoryStats SWRenderer::EstimateResidentMemory() const {
     stats.scratchBytes =
         m_ClipPositionScratch.capacity() * sizeof(glm::vec4) +
         m_NormalScratch.capacity() * sizeof(glm::vec3) +
-        m_WorldPositionScratch.capacity() * sizeof(glm::vec3);
+        m_WorldPositionScratch.capacity() * sizeof(glm::vec3) +
+        m_VisibleIndexRangeScratch.capacity() * sizeof(std::pair<uint32_t, uint32_t>) +
+        m_VertexReferencedScratch.capacity() * sizeof(uint8_t) +
+        m_VertexStageOutputScratch.capacity() * sizeof(MaterialVertexStageOutput) +
+        m_OutlineMaskScratch.capacity() * sizeof(uint8_t) +
+        m_GridVertexScratch.capacity() * sizeof(GridGizmoVertex) +
+        m_OcclusionPyramid.EstimateResidentBytes() +
+        (m_OverdrawCounts ? m_OverdrawCounts->GetSize() : 0);
     stats.deferredTriangleBytes = m_DeferredPs1Triangles.capacity() * sizeof(DeferredTriangle);
     for (const auto& face : m_SkyboxFaces) {
         stats.skyboxFaceBytes += face.capacity() * sizeof(Pixel);
@@ -1067,6 +1283,14 @@ SoftwareRendererMemoryStats SWRenderer::EstimateResidentMemory() const {
     return stats;
 }
 
+const SoftwareCullStats& SWRenderer::GetCullStats() const {
+    return m_CullStats;
+}
+
+const RasterCounters& SWRenderer::GetRasterCounters() const {
+    return m_RasterCounters;
+}
+
 bool SWRenderer::EnsureSkyboxLoaded() {
     if (m_HasSkybox) {
         return true;
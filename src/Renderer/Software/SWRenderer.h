@@ -3,16 +3,34 @@
 #include "../../Base/Color.h"
 #include "../../Base/Config.h"
 #include "../../Scene/Camera.h"
+#include "../../Scene/MeshClusters.h"
 #include "../RendererMemoryStats.h"
+#include "../RetroPalette.h"
 #include "../Buffer.h"
+#include "../GridGizmo.h"
 #include "../IRenderer.h"
+#include "OcclusionDepthPyramid.h"
+#include "RasterCounters.h"
 #include "SoftwareLighting.h"
 #include "Rasterizer.h"
 #include <array>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace RetroRenderer {
+struct SoftwareCullStats {
+    uint64_t clustersTested = 0;
+    uint64_t clustersFrustumCulled = 0;
+    uint64_t clustersBackfaceCulled = 0;
+    uint64_t clustersOcclusionCulled = 0;
+    uint64_t itemsTested = 0;
+    uint64_t itemsOcclusionCulled = 0;
+    // At most one full pyramid build per frame; later items only rescan the tiles earlier items drew to.
+    uint64_t occlusionFullBuilds = 0;
+    uint64_t occlusionTilesRescanned = 0;
+};
+
 class SWRenderer : public IRenderer {
   public:
     SWRenderer() = default;
@@ -36,10 +54,14 @@ class SWRenderer : public IRenderer {
 
     [[nodiscard]] const Buffer<Pixel>& GetFrameBuffer() const;
     [[nodiscard]] SoftwareRendererMemoryStats EstimateResidentMemory() const;
+    [[nodiscard]] const SoftwareCullStats& GetCullStats() const;
+    // Zero unless the frame's config enabled software.rasterizer.collectCounters.
+    [[nodiscard]] const RasterCounters& GetRasterCounters() const;
 
   private:
     void DrawMeshData(const std::vector<Vertex>& vertices,
                       const std::vector<unsigned int>& indices,
+                      const std::vector<MeshCluster>& clusters,
                       const glm::mat4& worldTransform,
                       const SoftwareMaterialState& materialState,
                       const Texture* texture);
@@ -58,11 +80,28 @@ class SWRenderer : public IRenderer {
     Camera* p_Camera = nullptr;
     std::vector<LightSnapshot> m_FrameLights;
     Config m_FrameConfigSnapshot{};
+    // Palette tables for m_FrameConfigSnapshot.retro, resolved once per frame and shared with every raster call.
+    RetroPalette::PaletteSnapshot m_FramePalette;
     std::vector<DeferredTriangle> m_DeferredPs1Triangles;
     std::unique_ptr<Rasterizer> m_Rasterizer = nullptr;
     std::vector<glm::vec4> m_ClipPositionScratch;
     std::vector<glm::vec3> m_NormalScratch;
     std::vector<glm::vec3> m_WorldPositionScratch;
+    std::vector<std::pair<uint32_t, uint32_t>> m_VisibleIndexRangeScratch;
+    std::vector<uint8_t> m_VertexReferencedScratch;
+    std::vector<MaterialVertexStageOutput> m_VertexStageOutputScratch;
+    // Material state of the item being drawn, refilled in place for every item.
+    SoftwareMaterialState m_ItemMaterialScratch{};
+    // Copy of the item's material with the fallback texture sampler added; only used by textured DrawMeshData calls.
+    SoftwareMaterialState m_TextureFallbackMaterialScratch{};
+    std::vector<uint8_t> m_OutlineMaskScratch;
+    std::vector<GridGizmoVertex> m_GridVertexScratch;
+    SoftwareCullStats m_CullStats{};
+    RasterCounters m_RasterCounters{};
+    // Framebuffer writes per pixel; allocated only while the overdraw heatmap is enabled.
+    std::unique_ptr<Buffer<uint16_t>> m_OverdrawCounts = nullptr;
+    float m_FrameMaterialTimeSeconds = 0.0f;
+    OcclusionDepthPyramid m_OcclusionPyramid;
     bool m_HasSkybox = false;
     int m_SkyboxFaceSize = 0;
     std::array<std::vector<Pixel>, 6> m_SkyboxFaces{};
@@ -76,6 +115,7 @@ class SWRenderer : public IRenderer {
     bool m_SkyboxCacheValid = false;
 
     void ApplyOutlinePass();
+    void ApplyOverdrawHeatmap();
 };
 
 } // namespace RetroRenderer
@@ -4,6 +4,7 @@
 #include <glm/gtc/quaternion.hpp>
 #include <nlohmann/json.hpp>
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <fstream>
 
@@ -19,6 +20,24 @@ glm::vec3 QuaternionToEulerDegrees(const glm::quat& quaternion) {
     return glm::degrees(glm::eulerAngles(quaternion));
 }
 
+glm::mat4 ComposeTrs(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale) {
+    // Same as translate * mat4_cast(rotation) * scale, without the two extra matrix products.
+    glm::mat4 matrix = glm::mat4_cast(rotation);
+    matrix[0] *= scale.x;
+    matrix[1] *= scale.y;
+    matrix[2] *= scale.z;
+    matrix[3] = glm::vec4(translation, 1.0f);
+    return matrix;
+}
+
+// Index of the last key at or before `frame`. Callers clamp `frame` to the key range first.
+size_t FindSegmentStart(const std::vector<int>& frames, double frame) {
+    const auto next = std::upper_bound(frames.begin(), frames.end(), frame, [](double value, int keyFrame) {
+        return value < static_cast<double>(keyFrame);
+    });
+    return static_cast<size_t>(std::max<std::ptrdiff_t>(std::distance(frames.begin(), next) - 1, 0));
+}
+
 bool JsonArrayToVec3(const json& value, glm::vec3& outVec, const char* fieldName, std::string& outErrorMessage) {
     if (!value.is_array() || value.size() != 3) {
         outErrorMessage = std::string("Animation field `") + fieldName + "` must be an array of three numbers.";
@@ -202,9 +221,6 @@ TransformPose SampleAnimationTrackPose(const AnimationTrack& track, double frame
         return track.keys.front().pose;
     }
 
-    const TransformKeyframe* previousKey = &track.keys.front();
-    const TransformKeyframe* nextKey = &track.keys.back();
-
     if (frame <= static_cast<double>(track.keys.front().frame)) {
         return track.keys.front().pose;
     }
@@ -212,13 +228,11 @@ TransformPose SampleAnimationTrackPose(const AnimationTrack& track, double frame
         return track.keys.back().pose;
     }
 
-    for (size_t i = 1; i < track.keys.size(); i++) {
-        if (frame <= static_cast<double>(track.keys[i].frame)) {
-            previousKey = &track.keys[i - 1];
-            nextKey = &track.keys[i];
-            break;
-        }
-    }
+    const auto next = std::upper_bound(track.keys.begin(), track.keys.end(), frame, [](double value, const TransformKeyframe& key) {
+        return value < static_cast<double>(key.frame);
+    });
+    const TransformKeyframe* previousKey = &*(next - 1);
+    const TransformKeyframe* nextKey = &*next;
 
     const double frameSpan = static_cast<double>(nextKey->frame - previousKey->frame);
     if (frameSpan <= 1e-6) {
@@ -238,12 +252,63 @@ TransformPose SampleAnimationTrackPose(const AnimationTrack& track, double frame
 }
 
 int FindAnimationKeyIndex(const AnimationTrack& track, int frame) {
-    for (size_t i = 0; i < track.keys.size(); i++) {
-        if (track.keys[i].frame == frame) {
-            return static_cast<int>(i);
-        }
+    const auto it = std::lower_bound(track.keys.begin(), track.keys.end(), frame, [](const TransformKeyframe& key, int value) {
+        return key.frame < value;
+    });
+    if (it == track.keys.end() || it->frame != frame) {
+        return -1;
+    }
+    return static_cast<int>(std::distance(track.keys.begin(), it));
+}
+
+CompiledAnimationTrack CompileAnimationTrack(const AnimationTrack& track) {
+    CompiledAnimationTrack compiled{};
+    compiled.modelIndex = track.resolvedModelIndex;
+    compiled.frames.reserve(track.keys.size());
+    compiled.translations.reserve(track.keys.size());
+    compiled.rotations.reserve(track.keys.size());
+    compiled.scales.reserve(track.keys.size());
+    for (const TransformKeyframe& key : track.keys) {
+        compiled.frames.push_back(key.frame);
+        compiled.translations.push_back(key.pose.translation);
+        compiled.rotations.push_back(EulerDegreesToQuaternion(key.pose.rotationEulerDegrees));
+        compiled.scales.push_back(key.pose.scale);
     }
-    return -1;
+    return compiled;
+}
+
+glm::mat4 SampleCompiledAnimationTrack(CompiledAnimationTrack& track, double frame) {
+    assert(!track.frames.empty() && "Compiled animation track has no keys");
+    const std::vector<int>& frames = track.frames;
+    const size_t keyCount = frames.size();
+    if (keyCount == 1 || frame <= static_cast<double>(frames.front())) {
+        return ComposeTrs(track.translations.front(), track.rotations.front(), track.scales.front());
+    }
+    if (frame >= static_cast<double>(frames.back())) {
+        return ComposeTrs(track.translations.back(), track.rotations.back(), track.scales.back());
+    }
+
+    size_t start = track.cursor;
+    const auto segmentContains = [&](size_t segment) {
+        return segment + 1 < keyCount && frame >= static_cast<double>(frames[segment]) &&
+               frame < static_cast<double>(frames[segment + 1]);
+    };
+    if (!segmentContains(start)) {
+        // Forward playback usually lands in the next segment; anything else is a seek.
+        start = segmentContains(start + 1) ? start + 1 : FindSegmentStart(frames, frame);
+    }
+    track.cursor = start;
+
+    const size_t end = start + 1;
+    const double frameSpan = static_cast<double>(frames[end] - frames[start]);
+    if (frameSpan <= 1e-6) {
+        return ComposeTrs(track.translations[end], track.rotations[end], track.scales[end]);
+    }
+
+    const float t = static_cast<float>(std::clamp((frame - static_cast<double>(frames[start])) / frameSpan, 0.0, 1.0));
+    return ComposeTrs(glm::mix(track.translations[start], track.translations[end], t),
+                      glm::normalize(glm::slerp(track.rotations[start], track.rotations[end], t)),
+                      glm::mix(track.scales[start], track.scales[end], t));
 }
 
 bool LoadAnimationClipFromFile(const std::filesystem::path& path,
@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <string>
 #include <vector>
 
@@ -34,6 +35,18 @@ struct SceneAnimationClip {
     std::vector<AnimationTrack> tracks;
 };
 
+// Playback form of an AnimationTrack, rebuilt whenever the clip is edited. Keys are split into flat per-channel
+// arrays and rotations are baked to quaternions so sampling never touches Euler angles.
+struct CompiledAnimationTrack {
+    int modelIndex = -1;
+    std::vector<int> frames;
+    std::vector<glm::vec3> translations;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+    // Index of the key starting the last sampled segment; lets monotonic playback skip the binary search.
+    size_t cursor = 0;
+};
+
 struct AnimationPlaybackState {
     bool playing = false;
     double playheadFrame = 0.0;
@@ -45,6 +58,9 @@ struct AnimationPlaybackState {
                                                     double frame,
                                                     const TransformPose& fallbackPose);
 [[nodiscard]] int FindAnimationKeyIndex(const AnimationTrack& track, int frame);
+[[nodiscard]] CompiledAnimationTrack CompileAnimationTrack(const AnimationTrack& track);
+// Samples a non-empty compiled track straight into a local matrix, updating the track's cursor.
+[[nodiscard]] glm::mat4 SampleCompiledAnimationTrack(CompiledAnimationTrack& track, double frame);
 bool LoadAnimationClipFromFile(const std::filesystem::path& path,
                                SceneAnimationClip& outClip,
                                std::string& outErrorMessage);
@@ -1076,6 +1076,7 @@ void MaterialManager::ClearTexture() {
     }
     if (!material->textureBindings.empty()) {
         material->textureBindings.front().texture.reset();
+        material->textureBindings.front().sourcePath.clear();
     }
     if (p_RenderInvalidationSink_ != nullptr) {
         p_RenderInvalidationSink_->OnTextureMutated();
@@ -1103,6 +1104,14 @@ std::shared_ptr<const Texture> MaterialManager::GetSelectedPreviewTextureShared(
     return material->textureBindings.front().texture;
 }
 
+std::string MaterialManager::GetSelectedTextureSourcePath() const {
+    const SceneMaterial* material = ResolveSelectedSceneMaterial();
+    if (material == nullptr || material->textureBindings.empty()) {
+        return {};
+    }
+    return material->textureBindings.front().sourcePath;
+}
+
 const Texture* MaterialManager::GetSelectedPreviewTexture() const {
     const std::shared_ptr<const Texture> texture = GetSelectedPreviewTextureShared();
     return texture ? texture.get() : nullptr;
@@ -1113,16 +1122,19 @@ std::shared_ptr<const CompiledMaterialTemplate> MaterialManager::GetCompiledTemp
 }
 
 std::shared_ptr<const CompiledMaterialTemplate> MaterialManager::GetCompiledTemplate(const std::filesystem::path& templatePath) const {
+    const auto requestedIt = m_TemplateCacheByRequestedPath.find(templatePath);
+    if (requestedIt != m_TemplateCacheByRequestedPath.end()) {
+        return requestedIt->second;
+    }
+
     const std::filesystem::path resolvedPath = ResolveTemplateAssetPath(templatePath);
     const std::string cacheKey = resolvedPath.generic_string();
     auto it = m_TemplateCache.find(cacheKey);
-    if (it != m_TemplateCache.end()) {
-        return it->second;
+    if (it == m_TemplateCache.end()) {
+        it = m_TemplateCache.emplace(cacheKey, LoadAndCompileTemplate(resolvedPath)).first;
     }
-
-    std::shared_ptr<const CompiledMaterialTemplate> compiled = LoadAndCompileTemplate(resolvedPath);
-    m_TemplateCache.emplace(cacheKey, compiled);
-    return compiled;
+    m_TemplateCacheByRequestedPath.emplace(templatePath, it->second);
+    return it->second;
 }
 
 std::filesystem::path MaterialManager::ResolveBuiltInTemplatePath(bool useVertexColor) const {
@@ -1238,13 +1250,16 @@ void MaterialManager::LoadTextureIntoSelectedMaterial(Texture texture) {
         return;
     }
 
+    std::string sourcePath = texture.GetPath();
     if (material->textureBindings.empty()) {
         material->textureBindings.push_back(MaterialTextureBinding{
             .slotName = "albedo",
             .texture = std::make_shared<Texture>(std::move(texture)),
+            .sourcePath = std::move(sourcePath),
         });
     } else {
         material->textureBindings.front().texture = std::make_shared<Texture>(std::move(texture));
+        material->textureBindings.front().sourcePath = std::move(sourcePath);
     }
 
     if (p_RenderInvalidationSink_ != nullptr) {
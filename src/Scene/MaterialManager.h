@@ -5,6 +5,7 @@
 #include "../Renderer/ShaderHandle.h"
 #include "../Renderer/ShaderResource.h"
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -41,6 +42,7 @@ class MaterialManager {
     [[nodiscard]] SceneMaterial* GetSelectedSceneMaterial();
     [[nodiscard]] const SceneMaterial* GetSelectedSceneMaterial() const;
     [[nodiscard]] std::shared_ptr<const Texture> GetSelectedPreviewTextureShared() const;
+    [[nodiscard]] std::string GetSelectedTextureSourcePath() const;
     [[nodiscard]] const Texture* GetSelectedPreviewTexture() const;
 
     [[nodiscard]] std::shared_ptr<const CompiledMaterialTemplate> GetCompiledTemplate(const std::filesystem::path& templatePath) const;
@@ -67,6 +69,9 @@ class MaterialManager {
     std::function<std::shared_ptr<Scene>()> m_SceneAccessor;
     SceneMaterialHandle m_SelectedSceneMaterialHandle = kInvalidSceneMaterialHandle;
     mutable std::unordered_map<std::string, std::shared_ptr<const CompiledMaterialTemplate>> m_TemplateCache;
+    // Same templates keyed by the path as requested. Render packets look every material up each frame, and comparing
+    // paths here avoids resolving and re-keying them, which allocates.
+    mutable std::map<std::filesystem::path, std::shared_ptr<const CompiledMaterialTemplate>> m_TemplateCacheByRequestedPath;
 };
 
 } // namespace RetroRenderer
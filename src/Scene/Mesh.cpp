@@ -1,4 +1,5 @@
 #include "Mesh.h"
+#include <atomic>
 #include <utility>
 
 namespace RetroRenderer {
@@ -14,18 +15,38 @@ const std::vector<unsigned int>& EmptyIndices() {
 }
 } // namespace
 
+uint64_t NextMeshGeometryRevision() {
+    static std::atomic<uint64_t> nextRevision = 1;
+    return nextRevision.fetch_add(1, std::memory_order_relaxed);
+}
+
+const std::vector<unsigned int>& MeshGeometryData::GetClusterIndices() const {
+    return clusterIndices.empty() ? indices : clusterIndices;
+}
+
 uint64_t MeshGeometryData::EstimateResidentCpuBytes() const {
-    return sizeof(MeshGeometryData) + vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(unsigned int);
+    return sizeof(MeshGeometryData) +
+           vertices.capacity() * sizeof(Vertex) +
+           indices.capacity() * sizeof(unsigned int) +
+           clusterIndices.capacity() * sizeof(unsigned int) +
+           clusters.capacity() * sizeof(MeshCluster);
 }
 
 Mesh::Mesh(std::vector<Vertex> vertices,
            std::vector<unsigned int> indices,
            SceneMaterialHandle materialHandle)
-    : m_Geometry(std::make_shared<MeshGeometryData>(MeshGeometryData{
-          .vertices = std::move(vertices),
-          .indices = std::move(indices),
-      })),
-      m_MaterialHandle(materialHandle) {
+    : m_MaterialHandle(materialHandle) {
+    auto geometry = std::make_shared<MeshGeometryData>(MeshGeometryData{
+        .vertices = std::move(vertices),
+        .indices = std::move(indices),
+    });
+    geometry->clusters = BuildMeshClusters(geometry->vertices, geometry->indices, geometry->clusterIndices);
+    for (size_t i = 0; i < geometry->clusters.size(); i++) {
+        const MeshCluster& cluster = geometry->clusters[i];
+        geometry->boundsMin = i == 0 ? cluster.boundsMin : glm::min(geometry->boundsMin, cluster.boundsMin);
+        geometry->boundsMax = i == 0 ? cluster.boundsMax : glm::max(geometry->boundsMax, cluster.boundsMax);
+    }
+    m_Geometry = std::move(geometry);
 }
 
 Mesh::Mesh(std::shared_ptr<const MeshGeometryData> geometry, SceneMaterialHandle materialHandle)
@@ -1,5 +1,6 @@
 #pragma once
 #include "../Renderer/MaterialTypes.h"
+#include "MeshClusters.h"
 #include "Vertex.h"
 #include <cstdint>
 #include <memory>
@@ -7,10 +8,20 @@
 
 namespace RetroRenderer {
 
+// Process-unique, so GPU caches keyed by geometry address can tell a reused allocation from the geometry they uploaded.
+uint64_t NextMeshGeometryRevision();
+
 struct MeshGeometryData {
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
+    // Software-only copy of `indices` in cluster (Morton) order; empty when the clusters index `indices` directly.
+    std::vector<unsigned int> clusterIndices;
+    std::vector<MeshCluster> clusters;
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    uint64_t revision = NextMeshGeometryRevision();
 
+    [[nodiscard]] const std::vector<unsigned int>& GetClusterIndices() const;
     [[nodiscard]] uint64_t EstimateResidentCpuBytes() const;
 };
 
@@ -0,0 +1,155 @@
+#include "MeshClusters.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace RetroRenderer {
+namespace {
+struct SortableTriangle {
+    uint32_t mortonCode = 0;
+    uint32_t triangleIndex = 0;
+};
+
+uint32_t SpreadBits10(uint32_t value) {
+    value &= 0x3ffu;
+    value = (value | (value << 16)) & 0x030000ffu;
+    value = (value | (value << 8)) & 0x0300f00fu;
+    value = (value | (value << 4)) & 0x030c30c3u;
+    value = (value | (value << 2)) & 0x09249249u;
+    return value;
+}
+
+uint32_t ComputeMortonCode(const glm::vec3& normalizedPosition) {
+    const glm::vec3 clamped = glm::clamp(normalizedPosition, glm::vec3(0.0f), glm::vec3(1.0f));
+    const uint32_t x = static_cast<uint32_t>(clamped.x * 1023.0f);
+    const uint32_t y = static_cast<uint32_t>(clamped.y * 1023.0f);
+    const uint32_t z = static_cast<uint32_t>(clamped.z * 1023.0f);
+    return (SpreadBits10(x) << 2) | (SpreadBits10(y) << 1) | SpreadBits10(z);
+}
+
+bool HasValidTriangleIndices(const std::vector<Vertex>& vertices, const unsigned int* triangle) {
+    return triangle[0] < vertices.size() && triangle[1] < vertices.size() && triangle[2] < vertices.size();
+}
+
+std::vector<unsigned int> SortTrianglesAlongMortonCurve(const std::vector<Vertex>& vertices,
+                                                        const std::vector<unsigned int>& indices) {
+    const size_t triangleCount = indices.size() / 3;
+    glm::vec3 meshMin(std::numeric_limits<float>::max());
+    glm::vec3 meshMax(std::numeric_limits<float>::lowest());
+    for (const Vertex& vertex : vertices) {
+        meshMin = glm::min(meshMin, glm::vec3(vertex.position));
+        meshMax = glm::max(meshMax, glm::vec3(vertex.position));
+    }
+    const glm::vec3 extent = glm::max(meshMax - meshMin, glm::vec3(1e-6f));
+
+    std::vector<SortableTriangle> triangles(triangleCount);
+    for (size_t i = 0; i < triangleCount; i++) {
+        const unsigned int* triangle = &indices[i * 3];
+        glm::vec3 centroid = meshMin;
+        if (HasValidTriangleIndices(vertices, triangle)) {
+            centroid = (glm::vec3(vertices[triangle[0]].position) +
+                        glm::vec3(vertices[triangle[1]].position) +
+                        glm::vec3(vertices[triangle[2]].position)) /
+                       3.0f;
+        }
+        triangles[i].mortonCode = ComputeMortonCode((centroid - meshMin) / extent);
+        triangles[i].triangleIndex = static_cast<uint32_t>(i);
+    }
+    std::stable_sort(triangles.begin(), triangles.end(), [](const SortableTriangle& a, const SortableTriangle& b) {
+        return a.mortonCode < b.mortonCode;
+    });
+
+    std::vector<unsigned int> sortedIndices(indices.size());
+    for (size_t i = 0; i < triangleCount; i++) {
+        const size_t source = static_cast<size_t>(triangles[i].triangleIndex) * 3;
+        sortedIndices[i * 3] = indices[source];
+        sortedIndices[i * 3 + 1] = indices[source + 1];
+        sortedIndices[i * 3 + 2] = indices[source + 2];
+    }
+    return sortedIndices;
+}
+
+MeshCluster MakeCluster(const std::vector<Vertex>& vertices,
+                        const std::vector<unsigned int>& indices,
+                        uint32_t firstIndex,
+                        uint32_t indexCount) {
+    MeshCluster cluster{};
+    cluster.firstIndex = firstIndex;
+    cluster.indexCount = indexCount;
+
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    glm::vec3 normalSum(0.0f);
+    std::vector<glm::vec3> faceNormals;
+    faceNormals.reserve(indexCount / 3);
+    for (uint32_t i = firstIndex; i + 2 < firstIndex + indexCount; i += 3) {
+        const unsigned int* triangle = &indices[i];
+        if (!HasValidTriangleIndices(vertices, triangle)) {
+            continue;
+        }
+        const glm::vec3 p0(vertices[triangle[0]].position);
+        const glm::vec3 p1(vertices[triangle[1]].position);
+        const glm::vec3 p2(vertices[triangle[2]].position);
+        boundsMin = glm::min(boundsMin, glm::min(p0, glm::min(p1, p2)));
+        boundsMax = glm::max(boundsMax, glm::max(p0, glm::max(p1, p2)));
+
+        const glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);
+        const float length = glm::length(faceNormal);
+        if (length <= 1e-12f) {
+            continue;
+        }
+        faceNormals.push_back(faceNormal / length);
+        normalSum += faceNormals.back();
+    }
+
+    if (boundsMin.x > boundsMax.x) {
+        boundsMin = glm::vec3(0.0f);
+        boundsMax = glm::vec3(0.0f);
+    }
+    cluster.boundsMin = boundsMin;
+    cluster.boundsMax = boundsMax;
+
+    const float normalSumLength = glm::length(normalSum);
+    if (faceNormals.empty() || normalSumLength <= 1e-6f) {
+        return cluster;
+    }
+    cluster.coneAxis = normalSum / normalSumLength;
+    float minDot = 1.0f;
+    for (const glm::vec3& faceNormal : faceNormals) {
+        minDot = std::min(minDot, glm::dot(faceNormal, cluster.coneAxis));
+    }
+    // A cone wider than a hemisphere always contains a front-facing direction.
+    if (minDot > 0.0f) {
+        cluster.coneCutoff = std::sqrt(std::max(0.0f, 1.0f - minDot * minDot));
+    }
+    return cluster;
+}
+} // namespace
+
+std::vector<MeshCluster> BuildMeshClusters(const std::vector<Vertex>& vertices,
+                                           const std::vector<unsigned int>& indices,
+                                           std::vector<unsigned int>& outClusterIndices) {
+    std::vector<MeshCluster> clusters;
+    outClusterIndices.clear();
+    if (vertices.empty() || indices.size() < 3 || indices.size() % 3 != 0) {
+        return clusters;
+    }
+
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount > kMeshClusterTriangleCount) {
+        outClusterIndices = SortTrianglesAlongMortonCurve(vertices, indices);
+    }
+    const std::vector<unsigned int>& clusterIndices = outClusterIndices.empty() ? indices : outClusterIndices;
+
+    const uint32_t clusterIndexCount = kMeshClusterTriangleCount * 3;
+    clusters.reserve((clusterIndices.size() + clusterIndexCount - 1) / clusterIndexCount);
+    for (size_t firstIndex = 0; firstIndex < clusterIndices.size(); firstIndex += clusterIndexCount) {
+        const uint32_t indexCount =
+            static_cast<uint32_t>(std::min<size_t>(clusterIndexCount, clusterIndices.size() - firstIndex));
+        clusters.push_back(MakeCluster(vertices, clusterIndices, static_cast<uint32_t>(firstIndex), indexCount));
+    }
+    return clusters;
+}
+
+} // namespace RetroRenderer
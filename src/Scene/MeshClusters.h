@@ -0,0 +1,30 @@
+#pragma once
+#include "Vertex.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace RetroRenderer {
+
+constexpr uint32_t kMeshClusterTriangleCount = 128;
+
+// Contiguous run of triangles in a mesh's cluster index buffer (see MeshGeometryData::GetClusterIndices). Bounds and the normal cone are in object space.
+struct MeshCluster {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    // Sine of the cone half-angle; 1 means the cluster faces too many directions to be culled as a whole.
+    float coneCutoff = 1.0f;
+};
+
+// Splits the triangles of `indices` into clusters of at most kMeshClusterTriangleCount triangles. Larger meshes get
+// a copy of their triangles reordered along a Morton curve of the centroids in `outClusterIndices`, which the
+// clusters then index; `indices` keeps the authored order for order-dependent draws. Meshes that fit into a single
+// cluster leave `outClusterIndices` empty and their clusters index `indices` directly.
+[[nodiscard]] std::vector<MeshCluster> BuildMeshClusters(const std::vector<Vertex>& vertices,
+                                                         const std::vector<unsigned int>& indices,
+                                                         std::vector<unsigned int>& outClusterIndices);
+
+} // namespace RetroRenderer
@@ -4,17 +4,15 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
+#include <cassert>
 #include <limits>
 
 namespace RetroRenderer {
 void Model::Init(Scene* scene, const std::string& name, const glm::mat4& localMatrix) {
+    assert(scene != nullptr && "Models must be initialized with their owning scene");
     p_Scene = scene;
     m_Name = name;
-    m_LocalMatrix = localMatrix;
-    m_WorldMatrix = localMatrix;
-    m_HasLocalBounds = false;
-    m_LocalBoundsMin = glm::vec3(0.0f);
-    m_LocalBoundsMax = glm::vec3(0.0f);
+    m_TransformIndex = scene->GetTransforms().Append(localMatrix);
 }
 
 const std::vector<Mesh>& Model::GetMeshes() const {
@@ -38,27 +36,35 @@ void Model::SetName(const std::string& name) {
 }
 
 void Model::MarkDirty() {
-    RecomputeWorldMatrix();
     assert(p_Scene != nullptr && "Scene hasn't been assigned to model");
-    for (const auto& childIx : m_Children) {
-        p_Scene->MarkDirtyModel(childIx);
-    }
+    p_Scene->GetTransforms().MarkDirty(m_TransformIndex);
 }
 
-void Model::SetParent(int parent) {
-    m_Parent = parent;
-    MarkDirty();
+bool Model::SetParent(int parent) {
+    assert(p_Scene != nullptr && "Scene hasn't been assigned to model");
+    const int parentTransform = parent >= 0 && static_cast<size_t>(parent) < p_Scene->GetModelCount()
+                                    ? p_Scene->GetModel(static_cast<size_t>(parent)).GetTransformIndex()
+                                    : TransformHierarchy::kNoParent;
+    if (parent >= 0 && parentTransform == TransformHierarchy::kNoParent) {
+        return false;
+    }
+    if (!p_Scene->GetTransforms().SetParent(m_TransformIndex, parentTransform)) {
+        return false;
+    }
+    m_Parent = parent >= 0 ? std::optional<int>(parent) : std::nullopt;
+    return true;
 }
 
 void Model::SetLocalTransform(const glm::mat4& mat) {
-    m_LocalMatrix = mat;
-    MarkDirty();
+    assert(p_Scene != nullptr && "Scene hasn't been assigned to model");
+    p_Scene->GetTransforms().SetLocalMatrix(m_TransformIndex, mat);
 }
 
 void Model::SetLocalPosition(const glm::vec3& position) {
     // Preserve the existing local basis and only move the translation column.
-    m_LocalMatrix[3] = glm::vec4(position, 1.0f);
-    MarkDirty();
+    glm::mat4 localTransform = GetLocalTransform();
+    localTransform[3] = glm::vec4(position, 1.0f);
+    SetLocalTransform(localTransform);
 }
 
 void Model::SetLocalTRS(const glm::vec3& translation, const glm::vec3& rotationEulerDegrees, const glm::vec3& scale) {
@@ -70,11 +76,20 @@ void Model::SetLocalTRS(const glm::vec3& translation, const glm::vec3& rotationE
 }
 
 const glm::mat4& Model::GetLocalTransform() const {
-    return m_LocalMatrix;
+    assert(p_Scene != nullptr && "Scene hasn't been assigned to model");
+    return p_Scene->GetTransforms().GetLocalMatrix(m_TransformIndex);
 }
 
 const glm::mat4& Model::GetWorldTransform() const {
-    return m_WorldMatrix;
+    assert(p_Scene != nullptr && "Scene hasn't been assigned to model");
+    assert(!p_Scene->GetTransforms().HasPendingUpdates() && "Flush transform edits with Scene::UpdateTransforms first");
+    return p_Scene->GetTransforms().GetWorldMatrix(m_TransformIndex);
+}
+
+void Model::GetWorldBounds(glm::vec3& outMin, glm::vec3& outMax) const {
+    assert(p_Scene != nullptr && "Scene hasn't been assigned to model");
+    assert(!p_Scene->GetTransforms().HasPendingUpdates() && "Flush transform edits with Scene::UpdateTransforms first");
+    p_Scene->GetTransforms().GetWorldBounds(m_TransformIndex, outMin, outMax);
 }
 
 void Model::RecomputeLocalBounds() {
@@ -91,32 +106,18 @@ void Model::RecomputeLocalBounds() {
         }
     }
 
-    m_HasLocalBounds = hasVertices;
-    if (m_HasLocalBounds) {
-        m_LocalBoundsMin = minBounds;
-        m_LocalBoundsMax = maxBounds;
-    } else {
-        m_LocalBoundsMin = glm::vec3(0.0f);
-        m_LocalBoundsMax = glm::vec3(0.0f);
-    }
+    assert(p_Scene != nullptr && "Scene hasn't been assigned to model");
+    p_Scene->GetTransforms().SetLocalBounds(m_TransformIndex, hasVertices, minBounds, maxBounds);
 }
 
 bool Model::HasLocalBounds() const {
-    return m_HasLocalBounds;
+    assert(p_Scene != nullptr && "Scene hasn't been assigned to model");
+    return p_Scene->GetTransforms().HasLocalBounds(m_TransformIndex);
 }
 
 void Model::GetLocalBounds(glm::vec3& outMin, glm::vec3& outMax) const {
-    outMin = m_LocalBoundsMin;
-    outMax = m_LocalBoundsMax;
-}
-
-void Model::RecomputeWorldMatrix() {
-    auto parentWorld = glm::mat4(1.0f);
     assert(p_Scene != nullptr && "Scene hasn't been assigned to model");
-    if (m_Parent.has_value()) {
-        parentWorld = p_Scene->GetModelWorldTransform(m_Parent.value());
-    }
-    m_WorldMatrix = parentWorld * m_LocalMatrix;
+    p_Scene->GetTransforms().GetLocalBounds(m_TransformIndex, outMin, outMax);
 }
 
 void Model::GetLocalTRS(glm::vec3& outTranslation, glm::vec3& outRotationEuler, glm::vec3& outScale) const {
@@ -124,7 +125,7 @@ void Model::GetLocalTRS(glm::vec3& outTranslation, glm::vec3& outRotationEuler,
     glm::vec4 perspective;
     glm::quat rotation;
 
-    glm::decompose(m_LocalMatrix, outScale, rotation, outTranslation, skew, perspective);
+    glm::decompose(GetLocalTransform(), outScale, rotation, outTranslation, skew, perspective);
     outRotationEuler = glm::degrees(glm::eulerAngles(rotation));
 }
 
@@ -133,7 +134,7 @@ void Model::GetWorldTRS(glm::vec3& outTranslation, glm::vec3& outRotationEuler,
     glm::vec4 perspective;
     glm::quat rotation;
 
-    glm::decompose(m_WorldMatrix, outScale, rotation, outTranslation, skew, perspective);
+    glm::decompose(GetWorldTransform(), outScale, rotation, outTranslation, skew, perspective);
     outRotationEuler = glm::degrees(glm::eulerAngles(rotation));
 }
 
@@ -144,4 +145,8 @@ const std::optional<int>& Model::GetParent() const {
 const std::vector<int>& Model::GetChildren() const {
     return m_Children;
 }
+
+int Model::GetTransformIndex() const {
+    return m_TransformIndex;
+}
 } // namespace RetroRenderer
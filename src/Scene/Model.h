@@ -30,9 +30,12 @@ class Model {
     void SetLocalTransform(const glm::mat4& mat);
     void SetLocalPosition(const glm::vec3& position);
     void SetLocalTRS(const glm::vec3& translation, const glm::vec3& rotationEulerDegrees, const glm::vec3& scale);
-    void SetParent(int parent);
+    // Takes the parent's model index. Fails when the parent does not exist or is this model or one of its descendants.
+    bool SetParent(int parent);
     [[nodiscard]] const glm::mat4& GetLocalTransform() const;
+    // World getters are read-only and expect a clean hierarchy; edits show up after the next Scene::UpdateTransforms.
     const glm::mat4& GetWorldTransform() const;
+    void GetWorldBounds(glm::vec3& outMin, glm::vec3& outMax) const;
     void MarkDirty();
     void RecomputeLocalBounds();
     bool HasLocalBounds() const;
@@ -41,23 +44,18 @@ class Model {
     void GetWorldTRS(glm::vec3& outTranslation, glm::vec3& outRotationEuler, glm::vec3& outScale) const;
     [[nodiscard]] const std::optional<int>& GetParent() const;
     [[nodiscard]] const std::vector<int>& GetChildren() const;
+    [[nodiscard]] int GetTransformIndex() const;
 
     std::optional<int> m_Parent;
     std::vector<int> m_Children;
     std::vector<Mesh> m_Meshes;
 
   private:
-    void RecomputeWorldMatrix();
-
+    // Transforms and bounds live in the owning scene's TransformHierarchy; world data is refreshed by
+    // Scene::UpdateTransforms, which SceneManager::NewFrame and RenderSystem::BuildRenderPacket run once per frame.
     Scene* p_Scene = nullptr;
+    int m_TransformIndex = -1;
     std::string m_Name;
-    glm::mat4 m_WorldMatrix = glm::mat4(1.0f);
-    glm::mat4 m_LocalMatrix = glm::mat4(1.0f);
-    bool m_HasLocalBounds = false;
-    glm::vec3 m_LocalBoundsMin = glm::vec3(0.0f);
-    glm::vec3 m_LocalBoundsMax = glm::vec3(0.0f);
-
-    // TODO: replace with handles if needed to improve performance
 };
 
 } // namespace RetroRenderer
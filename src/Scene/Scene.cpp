@@ -1,12 +1,15 @@
 #include "Scene.h"
 #include "ISceneImporter.h"
+#include "TextureRegistry.h"
 #include "../Base/Config.h"
 #include <KrisLogger/Logger.h>
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <cmath>
 #include <filesystem>
 #include <limits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -46,34 +49,6 @@ std::array<FrustumPlane, 6> ExtractFrustumPlanes(const glm::mat4& viewProjection
     };
 }
 
-void TransformBounds(const glm::mat4& transform, const glm::vec3& localMin, const glm::vec3& localMax, glm::vec3& outMin, glm::vec3& outMax) {
-    static constexpr std::array<glm::vec3, 8> kCorners = {
-        glm::vec3{0.0f, 0.0f, 0.0f},
-        glm::vec3{1.0f, 0.0f, 0.0f},
-        glm::vec3{0.0f, 1.0f, 0.0f},
-        glm::vec3{1.0f, 1.0f, 0.0f},
-        glm::vec3{0.0f, 0.0f, 1.0f},
-        glm::vec3{1.0f, 0.0f, 1.0f},
-        glm::vec3{0.0f, 1.0f, 1.0f},
-        glm::vec3{1.0f, 1.0f, 1.0f},
-    };
-
-    const glm::vec3 extent = localMax - localMin;
-    bool initialized = false;
-    for (const glm::vec3& cornerWeights : kCorners) {
-        const glm::vec3 localCorner = localMin + extent * cornerWeights;
-        const glm::vec3 worldCorner = glm::vec3(transform * glm::vec4(localCorner, 1.0f));
-        if (!initialized) {
-            outMin = worldCorner;
-            outMax = worldCorner;
-            initialized = true;
-            continue;
-        }
-        outMin = glm::min(outMin, worldCorner);
-        outMax = glm::max(outMax, worldCorner);
-    }
-}
-
 bool IsAabbOutsidePlane(const FrustumPlane& plane, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
     glm::vec3 positiveVertex = boundsMin;
     if (plane.normal.x >= 0.0f) {
@@ -90,16 +65,13 @@ bool IsAabbOutsidePlane(const FrustumPlane& plane, const glm::vec3& boundsMin, c
 }
 
 bool IsModelVisibleInFrustum(const Model& model, const std::array<FrustumPlane, 6>& frustumPlanes) {
-    glm::vec3 localMin{};
-    glm::vec3 localMax{};
     if (!model.HasLocalBounds()) {
         return true;
     }
-    model.GetLocalBounds(localMin, localMax);
 
     glm::vec3 worldMin{};
     glm::vec3 worldMax{};
-    TransformBounds(model.GetWorldTransform(), localMin, localMax, worldMin, worldMax);
+    model.GetWorldBounds(worldMin, worldMax);
     for (const FrustumPlane& plane : frustumPlanes) {
         if (IsAabbOutsidePlane(plane, worldMin, worldMax)) {
             return false;
@@ -177,6 +149,7 @@ bool Scene::Load(const std::string& path, bool append) {
 bool Scene::ProcessImportedScene(const ImportedSceneData& sceneData, bool append) {
     if (!append) {
         m_Models.clear();
+        m_Transforms.Clear();
         m_Materials.clear();
     }
     m_VisibleModels.clear();
@@ -186,6 +159,28 @@ bool Scene::ProcessImportedScene(const ImportedSceneData& sceneData, bool append
         return false;
     }
 
+    // Diffuse textures are resolved up front in one batch through the registry, so materials referencing the same image
+    // (in this scene or one loaded earlier) share it and only unseen files are decoded, concurrently.
+    std::vector<std::string> texturePaths;
+    std::vector<int> materialTextureSlots(sceneData.materials.size(), -1);
+    std::unordered_map<std::string, int> textureSlotsByPath;
+    for (size_t materialIndex = 0; materialIndex < sceneData.materials.size(); materialIndex++) {
+        const ImportedMaterial& material = sceneData.materials[materialIndex];
+        if (material.diffuseTexturePath.empty()) {
+            continue;
+        }
+        std::filesystem::path texturePath = material.diffuseTexturePath;
+        if (texturePath.is_relative() && !sceneData.sourceDirectory.empty()) {
+            texturePath = std::filesystem::path(sceneData.sourceDirectory) / texturePath;
+        }
+        const auto [it, inserted] = textureSlotsByPath.emplace(texturePath.string(), static_cast<int>(texturePaths.size()));
+        if (inserted) {
+            texturePaths.push_back(it->first);
+        }
+        materialTextureSlots[materialIndex] = it->second;
+    }
+    const std::vector<std::shared_ptr<const Texture>> textures = TextureRegistry::Get().LoadFromFiles(texturePaths);
+
     std::vector<SceneMaterialHandle> importedMaterialHandles;
     importedMaterialHandles.reserve(sceneData.materials.size());
     for (size_t materialIndex = 0; materialIndex < sceneData.materials.size(); materialIndex++) {
@@ -196,13 +191,22 @@ bool Scene::ProcessImportedScene(const ImportedSceneData& sceneData, bool append
                 break;
             }
         }
-        importedMaterialHandles.push_back(
-            AppendImportedMaterial(sceneData.materials[materialIndex],
-                                   sceneData.sourceDirectory,
-                                   preferVertexColor,
-                                   sceneData.materials[materialIndex].name.empty()
-                                       ? "Imported material " + std::to_string(materialIndex)
-                                       : sceneData.materials[materialIndex].name));
+        const std::string materialName = sceneData.materials[materialIndex].name.empty()
+                                             ? "Imported material " + std::to_string(materialIndex)
+                                             : sceneData.materials[materialIndex].name;
+        std::shared_ptr<const Texture> diffuseTexture;
+        std::string diffuseTexturePath;
+        if (const int textureSlot = materialTextureSlots[materialIndex]; textureSlot >= 0) {
+            diffuseTexture = textures[static_cast<size_t>(textureSlot)];
+            diffuseTexturePath = texturePaths[static_cast<size_t>(textureSlot)];
+            if (!diffuseTexture) {
+                LOGW("Failed to load diffuse texture '%s' for material %s",
+                     texturePaths[static_cast<size_t>(textureSlot)].c_str(),
+                     materialName.c_str());
+            }
+        }
+        importedMaterialHandles.push_back(AppendImportedMaterial(
+            sceneData.materials[materialIndex], std::move(diffuseTexture), diffuseTexturePath, preferVertexColor, materialName));
     }
 
     if (ProcessImportedNode(sceneData.rootNodeIndex, sceneData, importedMaterialHandles, -1)) {
@@ -244,8 +248,11 @@ bool Scene::ProcessImportedNode(int nodeIndex,
 
     const int currentNodeIndex = static_cast<int>(m_Models.size());
     if (parentIndex != -1) {
-        newModel.SetParent(parentIndex);
-        m_Models[parentIndex].m_Children.push_back(currentNodeIndex);
+        if (newModel.SetParent(parentIndex)) {
+            m_Models[parentIndex].m_Children.push_back(currentNodeIndex);
+        } else {
+            LOGW("Node %s cannot be parented to model %d; keeping it at the scene root", node.name.c_str(), parentIndex);
+        }
     }
     m_Models.emplace_back(std::move(newModel));
 
@@ -301,7 +308,12 @@ void Scene::BuildLightSnapshots(std::vector<LightSnapshot>& outSnapshots) const
     }
 }
 
+void Scene::UpdateTransforms() {
+    m_Transforms.Update();
+}
+
 void Scene::FrustumCull(const Camera& camera, const Config::CullSettings& cullSettings) {
+    UpdateTransforms();
     m_VisibleModels.clear();
     m_VisibleModels.reserve(m_Models.size());
 
@@ -328,7 +340,17 @@ const glm::mat4& Scene::GetModelWorldTransform(int index) const {
 }
 
 void Scene::MarkDirtyModel(int index) {
-    m_Models[index].MarkDirty();
+    const size_t modelIndex = static_cast<size_t>(index);
+    assert(index >= 0 && modelIndex < m_Models.size() && "Invalid model index");
+    m_Models[modelIndex].MarkDirty();
+}
+
+TransformHierarchy& Scene::GetTransforms() {
+    return m_Transforms;
+}
+
+const TransformHierarchy& Scene::GetTransforms() const {
+    return m_Transforms;
 }
 
 Model& Scene::GetModel(size_t index) {
@@ -401,7 +423,8 @@ void Scene::SetAllMaterialTemplates(const std::filesystem::path& templatePath) {
 }
 
 SceneMaterialHandle Scene::AppendImportedMaterial(const ImportedMaterial& material,
-                                                  const std::string& sourceDirectory,
+                                                  std::shared_ptr<const Texture> diffuseTexture,
+                                                  const std::string& diffuseTexturePath,
                                                   bool preferVertexColor,
                                                   const std::string& name) {
     SceneMaterial sceneMaterial{};
@@ -430,21 +453,12 @@ SceneMaterialHandle Scene::AppendImportedMaterial(const ImportedMaterial& materi
         sceneMaterial.pipelineOverrides.blendMode = MaterialBlendMode::ALPHA_BLEND;
     }
 
-    if (!material.diffuseTexturePath.empty()) {
-        std::filesystem::path texturePath = material.diffuseTexturePath;
-        if (texturePath.is_relative() && !sourceDirectory.empty()) {
-            texturePath = std::filesystem::path(sourceDirectory) / texturePath;
-        }
-
-        Texture texture;
-        if (texture.LoadFromFile(texturePath.string().c_str())) {
-            sceneMaterial.textureBindings.push_back(MaterialTextureBinding{
-                .slotName = "albedo",
-                .texture = std::make_shared<Texture>(std::move(texture)),
-            });
-        } else {
-            LOGW("Failed to load diffuse texture '%s' for material %s", texturePath.string().c_str(), name.c_str());
-        }
+    if (diffuseTexture) {
+        sceneMaterial.textureBindings.push_back(MaterialTextureBinding{
+            .slotName = "albedo",
+            .texture = std::move(diffuseTexture),
+            .sourcePath = diffuseTexturePath,
+        });
     }
 
     const SceneMaterialHandle handle = static_cast<SceneMaterialHandle>(m_Materials.size());
@@ -8,6 +8,7 @@
 #include "Light.h"
 #include "Mesh.h"
 #include "Model.h"
+#include "TransformHierarchy.h"
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -26,6 +27,9 @@ class Scene {
     bool Load(const std::string& path, bool append = false);
     void SetImporter(std::unique_ptr<ISceneImporter> importer);
     void SetDefaultLightPosition(const glm::vec3& lightPosition);
+    // Resolves pending transform changes in one parent-before-child sweep. FrustumCull runs it first, so
+    // SceneManager::NewFrame flushes once per frame; call it directly before reading world data after other edits.
+    void UpdateTransforms();
     void FrustumCull(const Camera& camera, const Config::CullSettings& cullSettings);
     [[nodiscard]] std::vector<int>& GetVisibleModels();
     [[nodiscard]] std::vector<SceneLight>& GetLights();
@@ -33,6 +37,8 @@ class Scene {
     void BuildLightSnapshots(std::vector<LightSnapshot>& outSnapshots) const;
     [[nodiscard]] const glm::mat4& GetModelWorldTransform(int index) const;
     void MarkDirtyModel(int index);
+    [[nodiscard]] TransformHierarchy& GetTransforms();
+    [[nodiscard]] const TransformHierarchy& GetTransforms() const;
     [[nodiscard]] Model& GetModel(size_t index);
     [[nodiscard]] const Model& GetModel(size_t index) const;
     [[nodiscard]] size_t GetModelCount() const;
@@ -57,7 +63,8 @@ class Scene {
                              std::vector<Mesh>& meshes,
                              const std::string& modelName);
     SceneMaterialHandle AppendImportedMaterial(const ImportedMaterial& material,
-                                               const std::string& sourceDirectory,
+                                               std::shared_ptr<const Texture> diffuseTexture,
+                                               const std::string& diffuseTexturePath,
                                                bool preferVertexColor,
                                                const std::string& name);
     SceneMaterialHandle GetOrCreateFallbackMaterial(bool preferVertexColor);
@@ -66,6 +73,7 @@ class Scene {
     std::unique_ptr<ISceneImporter> p_SceneImporter;
     std::vector<int> m_VisibleModels;
     std::vector<Model> m_Models;
+    TransformHierarchy m_Transforms;
     std::vector<SceneMaterial> m_Materials;
     std::vector<SceneLight> m_Lights;
 };
@@ -25,6 +25,7 @@ void SceneManager::ResetAnimationState() {
     m_AnimationPlaybackState.playheadFrame = static_cast<double>(m_AnimationClip.startFrame);
     m_PreviewPoseState.reset();
     m_AnimationStatusMessage.clear();
+    m_CompiledAnimationStale = true;
 }
 
 void SceneManager::SetScenePath(const std::optional<std::filesystem::path>& scenePath) {
@@ -175,11 +176,12 @@ void SceneManager::SetAnimationPlayheadFrameInternal(double frame, bool clearPre
     const bool frameChanged = std::abs(normalizedFrame - m_AnimationPlaybackState.playheadFrame) > 1e-4;
     const bool previewCleared = clearPreview && m_PreviewPoseState.has_value();
 
+    // Sub-threshold moves are stored without re-posing so a restored playhead round-trips exactly.
+    m_AnimationPlaybackState.playheadFrame = normalizedFrame;
     if (!frameChanged && !previewCleared) {
         return;
     }
 
-    m_AnimationPlaybackState.playheadFrame = normalizedFrame;
     if (clearPreview) {
         m_PreviewPoseState.reset();
     }
@@ -212,6 +214,13 @@ void SceneManager::NewFrame() {
     p_Scene->FrustumCull(*p_Camera, p_Config_->cull);
 }
 
+void SceneManager::NewFrame(const Camera& camera) {
+    if (!p_Scene) {
+        return;
+    }
+    p_Scene->FrustumCull(camera, p_Config_->cull);
+}
+
 void SceneManager::NotifySceneMutated() {
     if (p_RenderInvalidationSink_ != nullptr) {
         p_RenderInvalidationSink_->OnSceneMutated();
@@ -356,6 +365,23 @@ void SceneManager::ResolveAnimationTrackBindings() {
     for (AnimationTrack& track : m_AnimationClip.tracks) {
         track.resolvedModelIndex = ResolveModelIndexFromNodePath(track.nodePath);
     }
+    m_CompiledAnimationStale = true;
+}
+
+void SceneManager::CompileAnimationClip() {
+    m_CompiledAnimationTracks.clear();
+    m_CompiledTrackByModel.assign(p_Scene ? p_Scene->GetModelCount() : 0, -1);
+    for (const AnimationTrack& track : m_AnimationClip.tracks) {
+        // Mirror GetAnimationTrackForModel: the first track bound to a model wins.
+        if (!IsModelIndexValid(track.resolvedModelIndex) ||
+            m_CompiledTrackByModel[static_cast<size_t>(track.resolvedModelIndex)] >= 0) {
+            continue;
+        }
+        m_CompiledTrackByModel[static_cast<size_t>(track.resolvedModelIndex)] =
+            static_cast<int>(m_CompiledAnimationTracks.size());
+        m_CompiledAnimationTracks.push_back(CompileAnimationTrack(track));
+    }
+    m_CompiledAnimationStale = false;
 }
 
 AnimationTrack* SceneManager::FindAnimationTrackForModelMutable(int modelIndex) {
@@ -421,13 +447,17 @@ void SceneManager::ApplyAnimationToScene() {
         return;
     }
 
+    if (m_CompiledAnimationStale || m_CompiledTrackByModel.size() != p_Scene->GetModelCount()) {
+        CompileAnimationClip();
+    }
+
     const int previewFrame = GetCurrentAnimationFrame();
     for (size_t i = 0; i < p_Scene->GetModelCount(); i++) {
         Model& model = p_Scene->GetModel(i);
         const int modelIndex = static_cast<int>(i);
         const bool hasPreviewOverride = m_PreviewPoseState.has_value() && m_PreviewPoseState->modelIndex == modelIndex &&
                                         m_PreviewPoseState->frame == previewFrame;
-        const AnimationTrack* track = GetAnimationTrackForModel(modelIndex);
+        const int compiledTrackIndex = m_CompiledTrackByModel[i];
 
         if (hasPreviewOverride) {
             const TransformPose& pose = m_PreviewPoseState->pose;
@@ -435,12 +465,12 @@ void SceneManager::ApplyAnimationToScene() {
             continue;
         }
 
-        if (track && !track->keys.empty()) {
-            const TransformPose pose = SampleAnimationTrackPose(*track,
-                                                                m_AnimationPlaybackState.playheadFrame,
-                                                                m_RestPoseSnapshots[i].pose);
-            model.SetLocalTRS(pose.translation, pose.rotationEulerDegrees, pose.scale);
-            continue;
+        if (compiledTrackIndex >= 0) {
+            CompiledAnimationTrack& track = m_CompiledAnimationTracks[static_cast<size_t>(compiledTrackIndex)];
+            if (!track.frames.empty()) {
+                model.SetLocalTransform(SampleCompiledAnimationTrack(track, m_AnimationPlaybackState.playheadFrame));
+                continue;
+            }
         }
 
         if (i < m_RestPoseSnapshots.size()) {
@@ -515,9 +545,13 @@ void SceneManager::StepAnimation(int deltaFrames) {
     SetAnimationPlayheadFrameInternal(static_cast<double>(GetCurrentAnimationFrame() + deltaFrames), true, true);
 }
 
-void SceneManager::SetAnimationPlayheadFrame(int frame) {
+void SceneManager::SetAnimationPlayheadFrame(double frame) {
     m_AnimationPlaybackState.playing = false;
-    SetAnimationPlayheadFrameInternal(static_cast<double>(frame), true, true);
+    SetAnimationPlayheadFrameInternal(frame, true, true);
+}
+
+void SceneManager::PoseAnimationFrameForExport(double frame) {
+    SetAnimationPlayheadFrameInternal(frame, false, false);
 }
 
 void SceneManager::SetAnimationLoop(bool loop) {
@@ -577,6 +611,7 @@ void SceneManager::ClearAnimationPreviewPose() {
 
 void SceneManager::MarkAnimationDocumentDirty() {
     m_AnimationPlaybackState.dirty = true;
+    m_CompiledAnimationStale = true;
 }
 
 bool SceneManager::AddAnimationKeyForCurrentFrame(int modelIndex, const TransformPose& pose) {
@@ -26,6 +26,8 @@ class SceneManager {
     bool ProcessInput(InputActionMask actions, unsigned int deltaTime);
     void Update(unsigned int deltaTime, const glm::ivec2& renderResolution);
     void NewFrame();
+    // Culls against a camera other than the scene's own, e.g. a snapshot taken for an offline export.
+    void NewFrame(const Camera& camera);
     void NotifySceneMutated();
 
     [[nodiscard]] std::shared_ptr<Scene> GetScene() const;
@@ -47,7 +49,10 @@ class SceneManager {
     void SetAnimationPlaying(bool playing);
     void StopAnimation();
     void StepAnimation(int deltaFrames);
-    void SetAnimationPlayheadFrame(int frame);
+    void SetAnimationPlayheadFrame(double frame);
+    // Moves the playhead for offline rendering: keeps the play state and preview pose, and does not notify the
+    // render invalidation sink. Callers restore the previous playhead the same way when done.
+    void PoseAnimationFrameForExport(double frame);
     void SetAnimationLoop(bool loop);
     void SetAnimationFps(int fps);
     void SetAnimationFrameRange(int startFrame, int endFrame);
@@ -76,6 +81,7 @@ class SceneManager {
     void ResetAnimationState();
     void CaptureRestPoses();
     void ResolveAnimationTrackBindings();
+    void CompileAnimationClip();
     void ApplyAnimationToScene();
     void SetScenePath(const std::optional<std::filesystem::path>& scenePath);
     void SetAnimationStatus(std::string statusMessage);
@@ -100,6 +106,10 @@ class SceneManager {
     SceneAnimationClip m_AnimationClip = MakeDefaultAnimationClip();
     AnimationPlaybackState m_AnimationPlaybackState{};
     std::vector<RestPoseSnapshot> m_RestPoseSnapshots;
+    // Tracks compiled for playback, plus the compiled track driving each model (-1 when it has none).
+    std::vector<CompiledAnimationTrack> m_CompiledAnimationTracks;
+    std::vector<int> m_CompiledTrackByModel;
+    bool m_CompiledAnimationStale = true;
     std::optional<PreviewPoseState> m_PreviewPoseState;
     std::optional<std::filesystem::path> m_CurrentScenePath;
     std::string m_AnimationStatusMessage;
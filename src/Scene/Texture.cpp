@@ -4,10 +4,16 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <mutex>
 #include <vector>
+#if !defined(__EMSCRIPTEN__)
+#include <thread>
+#endif
 
 namespace RetroRenderer {
 namespace {
@@ -78,36 +84,220 @@ int ComputeRampNeighborScore(const Pixel& baseColor, const Pixel& candidateColor
     return WeightedColorDistanceSq(baseColor, candidateColor) + rankDistance * 96;
 }
 
+// Copies a tightly or loosely pitched RGBA32 image into an already sized pixel vector.
+void CopyRgba32Rows(const uint8_t* srcPixels, int pitch, int width, int height, Pixel* dst) {
+    const size_t rowBytes = static_cast<size_t>(width) * sizeof(Pixel);
+    if (static_cast<size_t>(pitch) == rowBytes) {
+        std::memcpy(dst, srcPixels, rowBytes * static_cast<size_t>(height));
+        return;
+    }
+    for (int y = 0; y < height; y++) {
+        std::memcpy(dst + static_cast<size_t>(y) * static_cast<size_t>(width),
+                    srcPixels + static_cast<size_t>(y) * static_cast<size_t>(pitch),
+                    rowBytes);
+    }
+}
+
+// Decodes the surface straight into the final pixel storage. Direct-color surfaces are converted by SDL_ConvertPixels
+// into the vector itself, so no converted copy of the image is ever allocated; only indexed or color-keyed surfaces,
+// whose transparency SDL resolves during surface conversion, still go through an intermediate RGBA32 surface.
 bool PopulateTextureStorage(SDL_Surface* surface,
                             std::vector<Pixel>& outPixels,
                             int& outWidth,
                             int& outHeight) {
-    if (!surface) {
+    static_assert(sizeof(Pixel) == 4, "Pixel must match the RGBA32 byte layout");
+    if (!surface || surface->w <= 0 || surface->h <= 0) {
         return false;
     }
 
-    SDL_Surface* rgbaSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
-    if (!rgbaSurface) {
-        LOGE("Failed to convert texture surface to RGBA32: %s", SDL_GetError());
-        return false;
+    const Uint32 srcFormat = surface->format->format;
+    const bool needsSurfaceConversion = SDL_ISPIXELFORMAT_INDEXED(srcFormat) || SDL_HasColorKey(surface);
+    if (needsSurfaceConversion) {
+        SDL_Surface* rgbaSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+        if (!rgbaSurface) {
+            LOGE("Failed to convert texture surface to RGBA32: %s", SDL_GetError());
+            return false;
+        }
+        outWidth = rgbaSurface->w;
+        outHeight = rgbaSurface->h;
+        outPixels.resize(static_cast<size_t>(outWidth) * static_cast<size_t>(outHeight));
+        CopyRgba32Rows(static_cast<const uint8_t*>(rgbaSurface->pixels), rgbaSurface->pitch, outWidth, outHeight, outPixels.data());
+        SDL_FreeSurface(rgbaSurface);
+        return true;
     }
 
-    outWidth = rgbaSurface->w;
-    outHeight = rgbaSurface->h;
+    outWidth = surface->w;
+    outHeight = surface->h;
     outPixels.resize(static_cast<size_t>(outWidth) * static_cast<size_t>(outHeight));
+    if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0) {
+        LOGE("Failed to lock texture surface: %s", SDL_GetError());
+        return false;
+    }
+    bool ok = true;
+    if (srcFormat == SDL_PIXELFORMAT_RGBA32) {
+        CopyRgba32Rows(static_cast<const uint8_t*>(surface->pixels), surface->pitch, outWidth, outHeight, outPixels.data());
+    } else if (SDL_ConvertPixels(outWidth,
+                                 outHeight,
+                                 srcFormat,
+                                 surface->pixels,
+                                 surface->pitch,
+                                 SDL_PIXELFORMAT_RGBA32,
+                                 outPixels.data(),
+                                 outWidth * static_cast<int>(sizeof(Pixel))) != 0) {
+        LOGE("Failed to convert texture pixels to RGBA32: %s", SDL_GetError());
+        ok = false;
+    }
+    if (SDL_MUSTLOCK(surface)) {
+        SDL_UnlockSurface(surface);
+    }
+    return ok;
+}
 
-    const auto* srcPixels = static_cast<const uint8_t*>(rgbaSurface->pixels);
-    for (int y = 0; y < outHeight; y++) {
-        const uint8_t* row = srcPixels + static_cast<size_t>(y) * static_cast<size_t>(rgbaSurface->pitch);
-        for (int x = 0; x < outWidth; x++) {
-            const size_t srcIndex = static_cast<size_t>(x) * 4;
-            outPixels[static_cast<size_t>(y) * static_cast<size_t>(outWidth) + static_cast<size_t>(x)] =
-                Pixel{row[srcIndex], row[srcIndex + 1], row[srcIndex + 2], row[srcIndex + 3]};
+// SDL_image codec initialization is not thread safe, so it runs once before any decode; the codecs stay loaded for
+// the rest of the process instead of being torn down after every in-memory load.
+bool EnsureImageCodecsInitialized() {
+    static const bool initialized = []() {
+        constexpr int flags = IMG_INIT_PNG; // TODO: don't hardcode
+        if ((IMG_Init(flags) & flags) != flags) {
+            LOGE("Failed to initialize SDL_image: %s", IMG_GetError());
+            return false;
         }
+        return true;
+    }();
+    return initialized;
+}
+
+unsigned int TextureDecodeWorkerCount(size_t textureCount, unsigned int requested) {
+#if defined(__EMSCRIPTEN__)
+    (void)textureCount;
+    (void)requested;
+    return 1;
+#else
+    const size_t workers = requested > 0 ? requested : std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned int>(std::clamp<size_t>(textureCount, 1, workers));
+#endif
+}
+
+// Smaller images stay cache resident in row-major order, so only larger ones get a tiled sampling copy.
+constexpr size_t kTiledLayoutMinTexels = 128 * 128;
+
+bool IsPowerOfTwo(int value) {
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+struct BucketAccum {
+    uint32_t count = 0;
+    uint32_t sumR = 0;
+    uint32_t sumG = 0;
+    uint32_t sumB = 0;
+};
+
+// Below these sizes the thread start-up costs more than the work it would split.
+constexpr size_t kHistogramTexelsPerWorker = 256 * 256;
+constexpr size_t kLutRedSlicesPerWorker = 4;
+
+unsigned int PaletteBuildWorkerCount(size_t workItems, size_t minItemsPerWorker) {
+#if defined(__EMSCRIPTEN__)
+    (void)workItems;
+    (void)minItemsPerWorker;
+    return 1;
+#else
+    const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned int>(std::clamp<size_t>(workItems / minItemsPerWorker, 1, hardwareThreads));
+#endif
+}
+
+// Splits [0, count) into workerCount contiguous ranges and runs fn(begin, end, workerIndex) on each; range 0 runs on
+// the calling thread.
+template <typename TFn>
+void RunPaletteBuildRanges(size_t count, unsigned int workerCount, TFn&& fn) {
+    if (workerCount <= 1 || count == 0) {
+        fn(size_t{0}, count, 0u);
+        return;
+    }
+#if !defined(__EMSCRIPTEN__)
+    const size_t chunk = (count + workerCount - 1) / workerCount;
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount - 1);
+    for (unsigned int worker = 1; worker < workerCount; worker++) {
+        const size_t begin = std::min(count, static_cast<size_t>(worker) * chunk);
+        const size_t end = std::min(count, begin + chunk);
+        threads.emplace_back([&fn, begin, end, worker]() { fn(begin, end, worker); });
+    }
+    fn(size_t{0}, std::min(count, chunk), 0u);
+    for (std::thread& thread : threads) {
+        thread.join();
     }
+#endif
+}
 
-    SDL_FreeSurface(rgbaSurface);
-    return true;
+void AccumulateHistogram(const Pixel* pixels, size_t count, std::vector<BucketAccum>& buckets) {
+    for (size_t i = 0; i < count; i++) {
+        const Pixel& pixel = pixels[i];
+        if (pixel.a == 0) {
+            continue;
+        }
+        BucketAccum& bucket = buckets[QuantizedRgb5Index(pixel.r, pixel.g, pixel.b)];
+        bucket.count++;
+        bucket.sumR += pixel.r;
+        bucket.sumG += pixel.g;
+        bucket.sumB += pixel.b;
+    }
+}
+
+// Palette split into per-channel lanes so the 16-entry distance loop below compiles to packed integer math.
+struct PaletteChannels {
+    alignas(64) std::array<int32_t, Texture::kAutoPaletteSize> r{};
+    alignas(64) std::array<int32_t, Texture::kAutoPaletteSize> g{};
+    alignas(64) std::array<int32_t, Texture::kAutoPaletteSize> b{};
+};
+
+PaletteChannels SplitPaletteChannels(const std::array<Pixel, Texture::kAutoPaletteSize>& palette) {
+    PaletteChannels channels{};
+    for (size_t i = 0; i < palette.size(); i++) {
+        channels.r[i] = palette[i].r;
+        channels.g[i] = palette[i].g;
+        channels.b[i] = palette[i].b;
+    }
+    return channels;
+}
+
+constexpr int32_t ExpandRgb5(size_t value) {
+    return static_cast<int32_t>((value << 3) | (value >> 2));
+}
+
+// Fills the 32x32 (g, b) entries of one red slice of the RGB555 nearest-index table. Uses the
+// WeightedColorDistanceSq weights. Ties go to the lowest palette index.
+void FillNearestIndexLutSlice(const PaletteChannels& palette, size_t r, uint8_t* outSlice) {
+    constexpr size_t kCount = Texture::kAutoPaletteSize;
+    std::array<int32_t, kCount> redTerms{};
+    for (size_t i = 0; i < kCount; i++) {
+        const int32_t dr = ExpandRgb5(r) - palette.r[i];
+        redTerms[i] = dr * dr * 3;
+    }
+    for (size_t g = 0; g < 32; g++) {
+        std::array<int32_t, kCount> redGreenTerms{};
+        for (size_t i = 0; i < kCount; i++) {
+            const int32_t dg = ExpandRgb5(g) - palette.g[i];
+            redGreenTerms[i] = redTerms[i] + dg * dg * 4;
+        }
+        for (size_t b = 0; b < 32; b++) {
+            std::array<int32_t, kCount> distances{};
+            for (size_t i = 0; i < kCount; i++) {
+                const int32_t db = ExpandRgb5(b) - palette.b[i];
+                distances[i] = redGreenTerms[i] + db * db * 2;
+            }
+            int32_t bestDistance = distances[0];
+            uint8_t bestIndex = 0;
+            for (size_t i = 1; i < kCount; i++) {
+                if (distances[i] < bestDistance) {
+                    bestDistance = distances[i];
+                    bestIndex = static_cast<uint8_t>(i);
+                }
+            }
+            outSlice[(g << 5) | b] = bestIndex;
+        }
+    }
 }
 
 uint64_t NextTextureRevision() {
@@ -123,7 +313,7 @@ bool Texture::LoadTextureFromFile(const char* filePath,
                                   std::vector<Pixel>& outPixels,
                                   int& outWidth,
                                   int& outHeight) {
-    IMG_Init(IMG_INIT_PNG); // TODO: don't hardcode
+    EnsureImageCodecsInitialized();
     SDL_Surface* surface = IMG_Load(filePath);
     if (!surface) {
         LOGE("Failed to load texture file %s: %s", filePath, IMG_GetError());
@@ -140,40 +330,72 @@ bool Texture::LoadTextureFromMemory(const uint8_t* data,
                                     std::vector<Pixel>& outPixels,
                                     int& outWidth,
                                     int& outHeight) {
-    int flags = IMG_INIT_PNG;
-    int initted = IMG_Init(flags);
-    if ((initted & flags) != flags) {
-        LOGE("Failed to initialize SDL_image: %s", IMG_GetError());
+    if (!EnsureImageCodecsInitialized()) {
         return false;
     }
 
     SDL_RWops* rw = SDL_RWFromConstMem(data, static_cast<int>(size));
     if (!rw) {
         LOGE("Failed to create RWops: %s", SDL_GetError());
-        IMG_Quit();
         return false;
     }
 
     SDL_Surface* surface = IMG_Load_RW(rw, 1); // 1 = auto-close rw after loading
     if (!surface) {
         LOGE("Failed to load texture from memory: %s", IMG_GetError());
-        IMG_Quit();
         return false;
     }
 
     const bool ok = PopulateTextureStorage(surface, outPixels, outWidth, outHeight);
     SDL_FreeSurface(surface);
-    IMG_Quit();
-
     return ok;
 }
 
+std::vector<std::shared_ptr<const Texture>> Texture::LoadFromFiles(const std::vector<std::string>& filePaths,
+                                                                   unsigned int workerCount) {
+    std::vector<std::shared_ptr<const Texture>> textures(filePaths.size());
+    if (filePaths.empty()) {
+        return textures;
+    }
+    EnsureImageCodecsInitialized();
+
+    // Each worker decodes whole files, so at most one surface per worker is alive next to the finished pixel vectors.
+    std::atomic<size_t> nextIndex = 0;
+    const auto decodeWorker = [&]() {
+        for (size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed); index < filePaths.size();
+             index = nextIndex.fetch_add(1, std::memory_order_relaxed)) {
+            auto texture = std::make_shared<Texture>();
+            if (texture->LoadFromFile(filePaths[index].c_str())) {
+                textures[index] = std::move(texture);
+            }
+        }
+    };
+
+    const unsigned int resolvedWorkerCount = TextureDecodeWorkerCount(filePaths.size(), workerCount);
+#if !defined(__EMSCRIPTEN__)
+    std::vector<std::thread> threads;
+    threads.reserve(resolvedWorkerCount - 1);
+    for (unsigned int worker = 1; worker < resolvedWorkerCount; worker++) {
+        threads.emplace_back(decodeWorker);
+    }
+    decodeWorker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+#else
+    (void)resolvedWorkerCount;
+    decodeWorker();
+#endif
+    return textures;
+}
+
 bool Texture::LoadFromFile(const char* filePath) {
     m_Pixels.clear();
     m_Width = 0;
     m_Height = 0;
     m_Revision = 0;
     ClearAutoPaletteCaches();
+    ClearSamplingCaches();
 
     std::vector<Pixel> newPixels;
     int newWidth = 0;
@@ -186,7 +408,7 @@ bool Texture::LoadFromFile(const char* filePath) {
     m_Width = newWidth;
     m_Height = newHeight;
     m_Revision = NextTextureRevision();
-    RebuildAutoPaletteCaches();
+    RebuildSamplingCaches();
     LOGI("Loaded texture %s", filePath);
     m_Path = std::string(filePath);
     return true;
@@ -198,6 +420,7 @@ bool Texture::LoadFromMemory(const uint8_t* data, const size_t size) {
     m_Height = 0;
     m_Revision = 0;
     ClearAutoPaletteCaches();
+    ClearSamplingCaches();
 
     std::vector<Pixel> newPixels;
     int newWidth = 0;
@@ -210,14 +433,42 @@ bool Texture::LoadFromMemory(const uint8_t* data, const size_t size) {
     m_Width = newWidth;
     m_Height = newHeight;
     m_Revision = NextTextureRevision();
-    RebuildAutoPaletteCaches();
+    RebuildSamplingCaches();
     LOGI("Loaded texture from memory");
     m_Path = "memory";
     return true;
 }
 
+bool Texture::LoadFromPixels(std::vector<Pixel> pixels, int width, int height) {
+    m_Pixels.clear();
+    m_Width = 0;
+    m_Height = 0;
+    m_Revision = 0;
+    ClearAutoPaletteCaches();
+    ClearSamplingCaches();
+
+    if (width <= 0 || height <= 0 || pixels.size() != static_cast<size_t>(width) * static_cast<size_t>(height)) {
+        LOGE("Invalid texture pixel data (%d x %d, %zu texels)", width, height, pixels.size());
+        return false;
+    }
+    m_Pixels = std::move(pixels);
+    m_Width = width;
+    m_Height = height;
+    m_Revision = NextTextureRevision();
+    RebuildSamplingCaches();
+    m_Path = "pixels";
+    return true;
+}
+
 uint64_t Texture::EstimateResidentCpuBytes() const {
-    return sizeof(Texture) + m_Path.capacity() + m_Pixels.capacity() * sizeof(Pixel);
+    std::lock_guard<std::mutex> lock(m_CacheMutex.mutex);
+    uint64_t bytes = sizeof(Texture) + m_Path.capacity() + m_Pixels.capacity() * sizeof(Pixel) +
+                     m_TiledLevel.EstimateResidentBytes() + m_MipLevels.capacity() * sizeof(TextureLevel) +
+                     m_IndexedLevel.EstimateResidentBytes();
+    for (const TextureLevel& level : m_MipLevels) {
+        bytes += level.EstimateResidentBytes();
+    }
+    return bytes;
 }
 
 Texture Texture::CloneCpuOnly() const {
@@ -227,7 +478,19 @@ Texture Texture::CloneCpuOnly() const {
     clone.m_Height = m_Height;
     clone.m_Revision = m_Revision;
     clone.m_Pixels = m_Pixels;
+    clone.m_WrapMaskX = m_WrapMaskX;
+    clone.m_WrapMaskY = m_WrapMaskY;
+    clone.m_MipLodBias = m_MipLodBias;
+    std::lock_guard<std::mutex> lock(m_CacheMutex.mutex);
+    clone.m_TiledLayoutBuilt = m_TiledLayoutBuilt;
+    clone.m_TiledLevel = m_TiledLevel;
+    clone.m_MipChainBuilt = m_MipChainBuilt;
+    clone.m_MipLevels = m_MipLevels;
+    clone.m_ReducedLevel = m_ReducedLevel;
+    clone.m_AutoPaletteBuilt = m_AutoPaletteBuilt;
+    clone.m_AutoPaletteBuildNs = m_AutoPaletteBuildNs;
     clone.m_HasAutoPalette = m_HasAutoPalette;
+    clone.m_IndexedLevel = m_IndexedLevel;
     clone.m_AutoPalette = m_AutoPalette;
     clone.m_AutoRampPixels = m_AutoRampPixels;
     clone.m_AutoDitherPatterns = m_AutoDitherPatterns;
@@ -235,35 +498,134 @@ Texture Texture::CloneCpuOnly() const {
     return clone;
 }
 
-Pixel Texture::SampleNearestRepeat(const glm::vec2& uv) const {
+Pixel Texture::SampleNearestRepeat(const glm::vec2& uv, int mipLevel) const {
     if (!HasCpuPixels()) {
         return Pixel{255, 255, 255, 255};
     }
+    const int width = GetLevelWidth(mipLevel);
+    const int height = GetLevelHeight(mipLevel);
+    const int y = RepeatRowFromV(uv.y, height);
+    if (HasWrapMasks()) {
+        // Mips of a power-of-two image stay power-of-two, so every level wraps u with its own size - 1.
+        return FetchTexel(mipLevel, FloorToInt(uv.x * static_cast<float>(width)) & (width - 1), y);
+    }
 
     const float wrappedU = uv.x - std::floor(uv.x);
-    const float wrappedV = uv.y - std::floor(uv.y);
-    const int x = std::clamp(static_cast<int>(std::floor(wrappedU * static_cast<float>(m_Width))), 0, m_Width - 1);
-    const int y = std::clamp(static_cast<int>(std::floor((1.0f - wrappedV) * static_cast<float>(m_Height))), 0, m_Height - 1);
-    return m_Pixels[static_cast<size_t>(y) * static_cast<size_t>(m_Width) + static_cast<size_t>(x)];
+    const int x = std::clamp(static_cast<int>(std::floor(wrappedU * static_cast<float>(width))), 0, width - 1);
+    return FetchTexel(mipLevel, x, y);
 }
 
 Pixel Texture::SampleReducedNearestRepeat(const glm::vec2& uv, int maxDimension) const {
-    if (!HasCpuPixels() || maxDimension <= 0) {
-        return SampleNearestRepeat(uv);
+    const std::shared_ptr<const TextureLevel> reducedLevel = GetReducedLevel(maxDimension);
+    return reducedLevel ? SampleLevelNearestRepeat(*reducedLevel, uv) : SampleNearestRepeat(uv);
+}
+
+std::shared_ptr<const TextureLevel> Texture::GetReducedLevel(int maxDimension) const {
+    std::shared_ptr<const ReducedLevelCache> cache = GetReducedLevelCache(maxDimension);
+    if (cache == nullptr) {
+        return nullptr;
     }
+    const TextureLevel* level = &cache->level;
+    return std::shared_ptr<const TextureLevel>(std::move(cache), level);
+}
 
+uint8_t Texture::SampleIndexedNearestRepeat(const glm::vec2& uv) const {
+    if (!m_IndexedLevel.IsValid()) {
+        return 0;
+    }
+    if (HasWrapMasks()) {
+        return m_IndexedLevel.Fetch(FloorToInt(uv.x * static_cast<float>(m_Width)) & m_WrapMaskX,
+                                    RepeatRowFromV(uv.y, m_Height));
+    }
+    return SampleLevelNearestRepeat(m_IndexedLevel, uv);
+}
+
+std::shared_ptr<const IndexedTextureLevel> Texture::GetReducedIndexedLevel(int maxDimension) const {
+    std::shared_ptr<const ReducedLevelCache> cache = GetReducedLevelCache(maxDimension);
+    if (cache == nullptr || !cache->indexed.IsValid()) {
+        return nullptr;
+    }
+    const IndexedTextureLevel* indexed = &cache->indexed;
+    return std::shared_ptr<const IndexedTextureLevel>(std::move(cache), indexed);
+}
+
+std::shared_ptr<const Texture::ReducedLevelCache> Texture::GetReducedLevelCache(int maxDimension) const {
+    if (!HasCpuPixels() || maxDimension <= 0) {
+        return nullptr;
+    }
     const glm::ivec2 reducedSize = ComputeReducedDimensions(m_Width, m_Height, maxDimension);
-    const float wrappedU = uv.x - std::floor(uv.x);
-    const float wrappedV = uv.y - std::floor(uv.y);
-    const int reducedX = std::clamp(static_cast<int>(std::floor(wrappedU * static_cast<float>(reducedSize.x))),
-                                    0,
-                                    reducedSize.x - 1);
-    const int reducedY = std::clamp(static_cast<int>(std::floor((1.0f - wrappedV) * static_cast<float>(reducedSize.y))),
-                                    0,
-                                    reducedSize.y - 1);
-    const int x = std::clamp(((reducedX * 2 + 1) * m_Width) / (reducedSize.x * 2), 0, m_Width - 1);
-    const int y = std::clamp(((reducedY * 2 + 1) * m_Height) / (reducedSize.y * 2), 0, m_Height - 1);
-    return m_Pixels[static_cast<size_t>(y) * static_cast<size_t>(m_Width) + static_cast<size_t>(x)];
+    if (reducedSize.x == m_Width && reducedSize.y == m_Height) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_CacheMutex.mutex);
+    if (m_ReducedLevel == nullptr || m_ReducedLevel->revision != m_Revision || m_ReducedLevel->maxDimension != maxDimension) {
+        // Each reduced texel takes the source texel under its center.
+        std::vector<Pixel> reducedPixels(static_cast<size_t>(reducedSize.x) * static_cast<size_t>(reducedSize.y));
+        for (int reducedY = 0; reducedY < reducedSize.y; reducedY++) {
+            const int y = std::clamp(((reducedY * 2 + 1) * m_Height) / (reducedSize.y * 2), 0, m_Height - 1);
+            for (int reducedX = 0; reducedX < reducedSize.x; reducedX++) {
+                const int x = std::clamp(((reducedX * 2 + 1) * m_Width) / (reducedSize.x * 2), 0, m_Width - 1);
+                reducedPixels[static_cast<size_t>(reducedY) * static_cast<size_t>(reducedSize.x) + static_cast<size_t>(reducedX)] =
+                    FetchTexel(x, y);
+            }
+        }
+        auto cache = std::make_shared<ReducedLevelCache>();
+        cache->revision = m_Revision;
+        cache->maxDimension = maxDimension;
+        cache->level = BuildTiledTextureLevel(reducedPixels, reducedSize.x, reducedSize.y);
+        if (m_IndexedLevel.IsValid()) {
+            cache->indexed =
+                BuildIndexedTextureLevel(reducedPixels, reducedSize.x, reducedSize.y, m_AutoPaletteNearestIndexLut.data());
+        }
+        m_ReducedLevel = std::move(cache);
+    }
+    return m_ReducedLevel;
+}
+
+void Texture::EnsureTiledLayout() const {
+    std::lock_guard<std::mutex> lock(m_CacheMutex.mutex);
+    if (m_TiledLayoutBuilt || !HasCpuPixels()) {
+        return;
+    }
+    if (static_cast<size_t>(m_Width) * static_cast<size_t>(m_Height) >= kTiledLayoutMinTexels) {
+        m_TiledLevel = BuildTiledTextureLevel(m_Pixels, m_Width, m_Height);
+    }
+    m_TiledLayoutBuilt = true;
+}
+
+void Texture::EnsureMipChain() const {
+    std::lock_guard<std::mutex> lock(m_CacheMutex.mutex);
+    if (m_MipChainBuilt || !HasCpuPixels()) {
+        return;
+    }
+    m_MipLevels = BuildBoxFilteredMipChain(m_Pixels, m_Width, m_Height);
+    m_MipChainBuilt = true;
+}
+
+void Texture::EnsureAutoPalette() const {
+    std::lock_guard<std::mutex> lock(m_CacheMutex.mutex);
+    if (m_AutoPaletteBuilt || !HasCpuPixels()) {
+        return;
+    }
+
+    const auto buildStart = std::chrono::steady_clock::now();
+    RebuildAutoPaletteCaches();
+    m_AutoPaletteBuildNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - buildStart).count());
+    m_AutoPaletteBuilt = true;
+    // Reduced copies made before the palette existed have no index image.
+    m_ReducedLevel.reset();
+    LOGD("Built auto palette for %s (%d x %d) in %.2f ms",
+         m_Path.c_str(),
+         m_Width,
+         m_Height,
+         static_cast<double>(m_AutoPaletteBuildNs) / 1.0e6);
+}
+
+uint64_t Texture::GetAutoPaletteBuildNs() const {
+    std::lock_guard<std::mutex> lock(m_CacheMutex.mutex);
+    return m_AutoPaletteBuildNs;
 }
 
 uint8_t Texture::FindNearestAutoPaletteIndex(const Color& color) const {
@@ -303,7 +665,32 @@ const std::array<Pixel, 16>& Texture::GetAutoDitherPattern4x4(uint8_t paletteInd
     return m_AutoDitherPatterns[std::min<size_t>(paletteIndex, kAutoPaletteSize - 1)];
 }
 
-void Texture::ClearAutoPaletteCaches() {
+void Texture::ClearSamplingCaches() {
+    m_TiledLayoutBuilt = false;
+    m_TiledLevel = {};
+    m_WrapMaskX = -1;
+    m_WrapMaskY = -1;
+    m_MipChainBuilt = false;
+    m_MipLevels.clear();
+    m_MipLodBias = 0.0f;
+    m_ReducedLevel.reset();
+}
+
+void Texture::RebuildSamplingCaches() {
+    ClearSamplingCaches();
+    if (!HasCpuPixels()) {
+        return;
+    }
+    if (IsPowerOfTwo(m_Width) && IsPowerOfTwo(m_Height)) {
+        m_WrapMaskX = m_Width - 1;
+        m_WrapMaskY = m_Height - 1;
+    }
+    m_MipLodBias = 0.5f * std::log2(static_cast<float>(m_Width) * static_cast<float>(m_Height));
+}
+
+void Texture::ClearAutoPaletteCaches() const {
+    m_AutoPaletteBuilt = false;
+    m_AutoPaletteBuildNs = 0;
     m_HasAutoPalette = false;
     m_AutoPalette.fill(Pixel{255, 255, 255, 255});
     for (auto& ramp : m_AutoRampPixels) {
@@ -313,36 +700,32 @@ void Texture::ClearAutoPaletteCaches() {
         pattern.fill(Pixel{255, 255, 255, 255});
     }
     m_AutoPaletteNearestIndexLut.fill(0);
+    m_IndexedLevel = {};
 }
 
-void Texture::RebuildAutoPaletteCaches() {
+void Texture::RebuildAutoPaletteCaches() const {
     ClearAutoPaletteCaches();
     if (!HasCpuPixels()) {
         return;
     }
 
-    struct BucketAccum {
-        uint32_t count = 0;
-        uint32_t sumR = 0;
-        uint32_t sumG = 0;
-        uint32_t sumB = 0;
-    };
-
-    static thread_local std::vector<BucketAccum> buckets(kRgb5LutSize);
-    std::fill(buckets.begin(), buckets.end(), BucketAccum{});
-    for (const Pixel& pixel : m_Pixels) {
-        if (pixel.a == 0) {
-            continue;
+    // Each worker fills a private histogram over its slice of texels; integer sums merge in any order.
+    const unsigned int histogramWorkers = PaletteBuildWorkerCount(m_Pixels.size(), kHistogramTexelsPerWorker);
+    std::vector<BucketAccum> buckets(kRgb5LutSize);
+    std::vector<std::vector<BucketAccum>> workerBuckets(histogramWorkers - 1, std::vector<BucketAccum>(kRgb5LutSize));
+    RunPaletteBuildRanges(m_Pixels.size(), histogramWorkers, [&](size_t begin, size_t end, unsigned int worker) {
+        AccumulateHistogram(m_Pixels.data() + begin, end - begin, worker == 0 ? buckets : workerBuckets[worker - 1]);
+    });
+    for (const std::vector<BucketAccum>& partial : workerBuckets) {
+        for (size_t i = 0; i < kRgb5LutSize; i++) {
+            buckets[i].count += partial[i].count;
+            buckets[i].sumR += partial[i].sumR;
+            buckets[i].sumG += partial[i].sumG;
+            buckets[i].sumB += partial[i].sumB;
         }
-        BucketAccum& bucket = buckets[QuantizedRgb5Index(pixel.r, pixel.g, pixel.b)];
-        bucket.count++;
-        bucket.sumR += pixel.r;
-        bucket.sumG += pixel.g;
-        bucket.sumB += pixel.b;
     }
 
-    static thread_local std::vector<PaletteCandidate> candidates;
-    candidates.clear();
+    std::vector<PaletteCandidate> candidates;
     candidates.reserve(kRgb5LutSize);
     for (const BucketAccum& bucket : buckets) {
         if (bucket.count == 0) {
@@ -405,29 +788,18 @@ void Texture::RebuildAutoPaletteCaches() {
         m_AutoPalette[i] = selectedPalette[i];
     }
 
-    for (size_t r = 0; r < 32; r++) {
-        for (size_t g = 0; g < 32; g++) {
-            for (size_t b = 0; b < 32; b++) {
-                const Pixel sample{
-                    static_cast<uint8_t>((r << 3) | (r >> 2)),
-                    static_cast<uint8_t>((g << 3) | (g >> 2)),
-                    static_cast<uint8_t>((b << 3) | (b >> 2)),
-                    255};
-                int bestDistance = WeightedColorDistanceSq(sample, m_AutoPalette[0]);
-                uint8_t bestIndex = 0;
-                for (size_t i = 1; i < kAutoPaletteSize; i++) {
-                    const int distance = WeightedColorDistanceSq(sample, m_AutoPalette[i]);
-                    if (distance < bestDistance) {
-                        bestDistance = distance;
-                        bestIndex = static_cast<uint8_t>(i);
-                    }
-                }
-                m_AutoPaletteNearestIndexLut[(r << 10) | (g << 5) | b] = bestIndex;
-            }
+    const PaletteChannels paletteChannels = SplitPaletteChannels(m_AutoPalette);
+    RunPaletteBuildRanges(32, PaletteBuildWorkerCount(32, kLutRedSlicesPerWorker), [&](size_t begin, size_t end, unsigned int) {
+        for (size_t r = begin; r < end; r++) {
+            FillNearestIndexLutSlice(paletteChannels, r, m_AutoPaletteNearestIndexLut.data() + (r << 10));
         }
-    }
+    });
 
     m_HasAutoPalette = true;
+    // The palette has no alpha, so textures with transparent texels keep sampling RGBA.
+    if (std::all_of(m_Pixels.begin(), m_Pixels.end(), [](const Pixel& pixel) { return pixel.a == 255; })) {
+        m_IndexedLevel = BuildIndexedTextureLevel(m_Pixels, m_Width, m_Height, m_AutoPaletteNearestIndexLut.data());
+    }
 
     std::array<size_t, kAutoPaletteSize> luminanceOrder{};
     for (size_t i = 0; i < kAutoPaletteSize; i++) {
@@ -1,9 +1,13 @@
 #pragma once
 #include "../Base/Color.h"
+#include "TextureLevel.h"
 #include <SDL_image.h>
+#include <algorithm>
 #include <array>
 #include <glm/vec2.hpp>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -23,6 +27,11 @@ class Texture {
 
     bool LoadFromFile(const char* filePath);
     bool LoadFromMemory(const uint8_t* data, const size_t size);
+    bool LoadFromPixels(std::vector<Pixel> pixels, int width, int height);
+    // Decodes the files concurrently (one worker per hardware thread when workerCount is 0). The result is index
+    // aligned with filePaths and holds nullptr for files that failed to load.
+    static std::vector<std::shared_ptr<const Texture>> LoadFromFiles(const std::vector<std::string>& filePaths,
+                                                                     unsigned int workerCount = 0);
     bool IsValid() const {
         return HasCpuPixels();
     }
@@ -47,10 +56,80 @@ class Texture {
     bool HasAutoPalette() const {
         return m_HasAutoPalette;
     }
+    // Power-of-two dimensions expose masks so REPEAT addressing is a single AND; -1 otherwise.
+    bool HasWrapMasks() const {
+        return m_WrapMaskX >= 0 && m_WrapMaskY >= 0;
+    }
+    int GetWrapMaskX() const {
+        return m_WrapMaskX;
+    }
+    int GetWrapMaskY() const {
+        return m_WrapMaskY;
+    }
+    bool HasTiledLayout() const {
+        return m_TiledLevel.IsValid();
+    }
+    // The tiled copy of large images is built on first use: textures drawn only by GL never read it. Call this before
+    // drawing with the software rasterizer; FetchTexel never builds anything. Safe to call from several render threads.
+    void EnsureTiledLayout() const;
+    // Texel fetch for the software samplers; reads the tiled copy when one was built for this texture.
+    const Pixel& FetchTexel(int x, int y) const {
+        if (m_TiledLevel.IsValid()) {
+            return m_TiledLevel.Fetch(x, y);
+        }
+        return m_Pixels[static_cast<size_t>(y) * static_cast<size_t>(m_Width) + static_cast<size_t>(x)];
+    }
+    // Box-filtered mip chain down to 1x1, built on first use and only for mipmapped software sampling. Call this before
+    // drawing with mipmapping enabled; the level accessors below never build anything. Safe to call from several
+    // render threads.
+    void EnsureMipChain() const;
+    // Level 0 is the base image; higher levels are the mip chain once EnsureMipChain has built it.
+    int GetMipLevelCount() const {
+        return HasCpuPixels() ? 1 + static_cast<int>(m_MipLevels.size()) : 0;
+    }
+    int GetLevelWidth(int level) const {
+        return level == 0 ? m_Width : m_MipLevels[static_cast<size_t>(level - 1)].width;
+    }
+    int GetLevelHeight(int level) const {
+        return level == 0 ? m_Height : m_MipLevels[static_cast<size_t>(level - 1)].height;
+    }
+    const Pixel& FetchTexel(int level, int x, int y) const {
+        return level == 0 ? FetchTexel(x, y) : m_MipLevels[static_cast<size_t>(level - 1)].Fetch(x, y);
+    }
+    // Picks the level whose texel spacing is closest to one pixel. uvFootprintLog2 is log2 of the UV distance a
+    // screen pixel spans, as estimated by the rasterizer from the triangle's UV derivatives.
+    int SelectMipLevel(float uvFootprintLog2) const {
+        if (m_MipLevels.empty()) {
+            return 0;
+        }
+        return std::clamp(FloorToInt(uvFootprintLog2 + m_MipLodBias + 0.5f), 0, static_cast<int>(m_MipLevels.size()));
+    }
     [[nodiscard]] uint64_t EstimateResidentCpuBytes() const;
     Texture CloneCpuOnly() const;
-    Pixel SampleNearestRepeat(const glm::vec2& uv) const;
+    Pixel SampleNearestRepeat(const glm::vec2& uv, int mipLevel = 0) const;
     Pixel SampleReducedNearestRepeat(const glm::vec2& uv, int maxDimension) const;
+    // Copy of the image shrunk so its larger side is at most maxDimension (retro.textureMaxDimension). Built on first
+    // request and cached until the revision or maxDimension changes; null when no reduction applies. Safe to call
+    // from several render threads.
+    std::shared_ptr<const TextureLevel> GetReducedLevel(int maxDimension) const;
+    // CLUT form of the image: 4-bit indices into the auto palette, built with it for fully opaque textures. Sampling
+    // indices gives the same result as FindNearestAutoPalettePixel on the sampled texel without the per-pixel lookup.
+    bool HasIndexedPixels() const {
+        return m_IndexedLevel.IsValid();
+    }
+    const IndexedTextureLevel& GetIndexedLevel() const {
+        return m_IndexedLevel;
+    }
+    // Base-level palette index under the same addressing as SampleNearestRepeat(uv).
+    uint8_t SampleIndexedNearestRepeat(const glm::vec2& uv) const;
+    // Palette indices of GetReducedLevel(maxDimension); null when either is unavailable.
+    std::shared_ptr<const IndexedTextureLevel> GetReducedIndexedLevel(int maxDimension) const;
+    // The auto palette, its nearest-index table, ramps, dither patterns and the indexed copy are built on first use:
+    // most textures never render in a palette mode. Call this before drawing with a mode that reads them; the
+    // per-pixel accessors below never build anything. Safe to call from several render threads.
+    void EnsureAutoPalette() const;
+    // Wall time the last auto palette build took, 0 until it has been built.
+    [[nodiscard]] uint64_t GetAutoPaletteBuildNs() const;
     uint8_t FindNearestAutoPaletteIndex(const Color& color) const;
     uint8_t FindNearestAutoPaletteIndex(uint8_t r, uint8_t g, uint8_t b) const;
     Pixel FindNearestAutoPalettePixel(const Color& color) const;
@@ -69,18 +148,54 @@ class Texture {
                                std::vector<Pixel>& outPixels,
                                int& outWidth,
                                int& outHeight);
-    void ClearAutoPaletteCaches();
-    void RebuildAutoPaletteCaches();
+    void ClearAutoPaletteCaches() const;
+    void RebuildAutoPaletteCaches() const;
+    void ClearSamplingCaches();
+    void RebuildSamplingCaches();
+    struct ReducedLevelCache;
+    std::shared_ptr<const ReducedLevelCache> GetReducedLevelCache(int maxDimension) const;
+    // Guards the lazily built caches below. Each texture has its own, so a palette or mip build only blocks threads
+    // that need that texture; moving a texture gives the destination a fresh lock.
+    struct CacheMutex {
+        std::mutex mutex;
+        CacheMutex() = default;
+        CacheMutex(CacheMutex&&) noexcept {}
+        CacheMutex& operator=(CacheMutex&&) noexcept {
+            return *this;
+        }
+    };
 
+    mutable CacheMutex m_CacheMutex;
     std::string m_Path;
     int m_Width = 0;
     int m_Height = 0;
     uint64_t m_Revision = 0;
     std::vector<Pixel> m_Pixels;
-    bool m_HasAutoPalette = false;
-    std::array<Pixel, kAutoPaletteSize> m_AutoPalette{};
-    std::array<std::array<Pixel, 4>, kAutoPaletteSize> m_AutoRampPixels{};
-    std::array<std::array<Pixel, 16>, kAutoPaletteSize> m_AutoDitherPatterns{};
-    std::array<uint8_t, kRgb5LutSize> m_AutoPaletteNearestIndexLut{};
+    // Filled lazily by EnsureTiledLayout.
+    mutable bool m_TiledLayoutBuilt = false;
+    mutable TextureLevel m_TiledLevel;
+    int m_WrapMaskX = -1;
+    int m_WrapMaskY = -1;
+    // Filled lazily by EnsureMipChain.
+    mutable bool m_MipChainBuilt = false;
+    mutable std::vector<TextureLevel> m_MipLevels;
+    // log2 of the base level's texel count along one axis (geometric mean of width and height).
+    float m_MipLodBias = 0.0f;
+    struct ReducedLevelCache {
+        uint64_t revision = 0;
+        int maxDimension = 0;
+        TextureLevel level;
+        IndexedTextureLevel indexed;
+    };
+    mutable std::shared_ptr<const ReducedLevelCache> m_ReducedLevel;
+    // Auto palette state, filled lazily by EnsureAutoPalette.
+    mutable bool m_AutoPaletteBuilt = false;
+    mutable uint64_t m_AutoPaletteBuildNs = 0;
+    mutable bool m_HasAutoPalette = false;
+    mutable IndexedTextureLevel m_IndexedLevel;
+    mutable std::array<Pixel, kAutoPaletteSize> m_AutoPalette{};
+    mutable std::array<std::array<Pixel, 4>, kAutoPaletteSize> m_AutoRampPixels{};
+    mutable std::array<std::array<Pixel, 16>, kAutoPaletteSize> m_AutoDitherPatterns{};
+    mutable std::array<uint8_t, kRgb5LutSize> m_AutoPaletteNearestIndexLut{};
 };
 } // namespace RetroRenderer
@@ -0,0 +1,107 @@
+#include "TextureLevel.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace RetroRenderer {
+TextureLevel BuildTiledTextureLevel(const std::vector<Pixel>& linearPixels, int width, int height) {
+    TextureLevel level{};
+    if (width <= 0 || height <= 0 || linearPixels.size() < static_cast<size_t>(width) * static_cast<size_t>(height)) {
+        return level;
+    }
+
+    level.width = width;
+    level.height = height;
+    level.tilesPerRow = (width + TextureLevel::kTileMask) >> TextureLevel::kTileShift;
+    const int tileRows = (height + TextureLevel::kTileMask) >> TextureLevel::kTileShift;
+    level.texels.resize(static_cast<size_t>(level.tilesPerRow) * static_cast<size_t>(tileRows) *
+                        TextureLevel::kTileSize * TextureLevel::kTileSize);
+
+    Pixel* destination = level.texels.data();
+    for (int tileY = 0; tileY < tileRows; tileY++) {
+        for (int tileX = 0; tileX < level.tilesPerRow; tileX++) {
+            for (int localY = 0; localY < TextureLevel::kTileSize; localY++) {
+                const int sourceY = std::min((tileY << TextureLevel::kTileShift) + localY, height - 1);
+                const Pixel* sourceRow = linearPixels.data() + static_cast<size_t>(sourceY) * static_cast<size_t>(width);
+                for (int localX = 0; localX < TextureLevel::kTileSize; localX++) {
+                    *destination++ = sourceRow[std::min((tileX << TextureLevel::kTileShift) + localX, width - 1)];
+                }
+            }
+        }
+    }
+    return level;
+}
+
+IndexedTextureLevel BuildIndexedTextureLevel(const std::vector<Pixel>& linearPixels,
+                                             int width,
+                                             int height,
+                                             const uint8_t* rgb555NearestIndexLut) {
+    IndexedTextureLevel level{};
+    if (width <= 0 || height <= 0 || linearPixels.size() < static_cast<size_t>(width) * static_cast<size_t>(height)) {
+        return level;
+    }
+
+    level.width = width;
+    level.height = height;
+    level.rowStride = (width + 1) >> 1;
+    level.packedIndices.assign(static_cast<size_t>(level.rowStride) * static_cast<size_t>(height), 0);
+    for (int y = 0; y < height; y++) {
+        const Pixel* sourceRow = linearPixels.data() + static_cast<size_t>(y) * static_cast<size_t>(width);
+        uint8_t* destinationRow = level.packedIndices.data() + static_cast<size_t>(y) * static_cast<size_t>(level.rowStride);
+        for (int x = 0; x < width; x++) {
+            const Pixel& pixel = sourceRow[x];
+            const size_t lutIndex = (static_cast<size_t>(pixel.r >> 3) << 10) | (static_cast<size_t>(pixel.g >> 3) << 5) |
+                                    static_cast<size_t>(pixel.b >> 3);
+            destinationRow[x >> 1] |= static_cast<uint8_t>((rgb555NearestIndexLut[lutIndex] & 0x0F) << ((x & 1) << 2));
+        }
+    }
+    return level;
+}
+
+std::vector<TextureLevel> BuildBoxFilteredMipChain(const std::vector<Pixel>& linearPixels, int width, int height) {
+    std::vector<TextureLevel> levels;
+    if (width <= 0 || height <= 0 || linearPixels.size() < static_cast<size_t>(width) * static_cast<size_t>(height)) {
+        return levels;
+    }
+
+    std::vector<Pixel> source(linearPixels.begin(), linearPixels.begin() + static_cast<ptrdiff_t>(width) * height);
+    std::vector<Pixel> reduced;
+    int sourceWidth = width;
+    int sourceHeight = height;
+    while (sourceWidth > 1 || sourceHeight > 1) {
+        const int reducedWidth = std::max(1, sourceWidth / 2);
+        const int reducedHeight = std::max(1, sourceHeight / 2);
+        reduced.assign(static_cast<size_t>(reducedWidth) * static_cast<size_t>(reducedHeight), Pixel{});
+        for (int y = 0; y < reducedHeight; y++) {
+            const int y0 = y * sourceHeight / reducedHeight;
+            const int y1 = (y + 1) * sourceHeight / reducedHeight;
+            for (int x = 0; x < reducedWidth; x++) {
+                const int x0 = x * sourceWidth / reducedWidth;
+                const int x1 = (x + 1) * sourceWidth / reducedWidth;
+                uint32_t sum[4] = {0, 0, 0, 0};
+                for (int sy = y0; sy < y1; sy++) {
+                    const Pixel* row = source.data() + static_cast<size_t>(sy) * static_cast<size_t>(sourceWidth);
+                    for (int sx = x0; sx < x1; sx++) {
+                        sum[0] += row[sx].r;
+                        sum[1] += row[sx].g;
+                        sum[2] += row[sx].b;
+                        sum[3] += row[sx].a;
+                    }
+                }
+                const uint32_t count = static_cast<uint32_t>((y1 - y0) * (x1 - x0));
+                const uint32_t half = count / 2;
+                reduced[static_cast<size_t>(y) * static_cast<size_t>(reducedWidth) + static_cast<size_t>(x)] = Pixel{
+                    static_cast<uint8_t>((sum[0] + half) / count),
+                    static_cast<uint8_t>((sum[1] + half) / count),
+                    static_cast<uint8_t>((sum[2] + half) / count),
+                    static_cast<uint8_t>((sum[3] + half) / count),
+                };
+            }
+        }
+        levels.push_back(BuildTiledTextureLevel(reduced, reducedWidth, reducedHeight));
+        source.swap(reduced);
+        sourceWidth = reducedWidth;
+        sourceHeight = reducedHeight;
+    }
+    return levels;
+}
+} // namespace RetroRenderer
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "../Base/Color.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RETRO_BILINEAR_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RETRO_BILINEAR_NEON 1
+#endif
+
+namespace RetroRenderer {
+// Software-sampling copy of a texture image. Texels are grouped into kTileSize x kTileSize tiles stored one after
+// another, so the 2D neighbourhood touched by rotated or v-major sampling shares cache lines instead of striding
+// across whole rows.
+struct TextureLevel {
+    static constexpr int kTileShift = 3;
+    static constexpr int kTileSize = 1 << kTileShift;
+    static constexpr int kTileMask = kTileSize - 1;
+
+    int width = 0;
+    int height = 0;
+    int tilesPerRow = 0;
+    std::vector<Pixel> texels;
+
+    [[nodiscard]] bool IsValid() const {
+        return !texels.empty();
+    }
+
+    [[nodiscard]] const Pixel& Fetch(int x, int y) const {
+        const size_t tileIndex = static_cast<size_t>(y >> kTileShift) * static_cast<size_t>(tilesPerRow) +
+                                 static_cast<size_t>(x >> kTileShift);
+        return texels[(tileIndex << (2 * kTileShift)) + static_cast<size_t>(((y & kTileMask) << kTileShift) | (x & kTileMask))];
+    }
+
+    [[nodiscard]] uint64_t EstimateResidentBytes() const {
+        return texels.capacity() * sizeof(Pixel);
+    }
+};
+
+// Palette-index copy of a texture image for CLUT sampling: 4-bit indices into a 16-entry palette, two texels per
+// byte with the even column in the low nibble. Row-major; at 1/8 the size of the RGBA image it stays cache resident.
+struct IndexedTextureLevel {
+    int width = 0;
+    int height = 0;
+    int rowStride = 0;
+    std::vector<uint8_t> packedIndices;
+
+    [[nodiscard]] bool IsValid() const {
+        return !packedIndices.empty();
+    }
+
+    [[nodiscard]] uint8_t Fetch(int x, int y) const {
+        const uint8_t pair = packedIndices[static_cast<size_t>(y) * static_cast<size_t>(rowStride) + static_cast<size_t>(x >> 1)];
+        return static_cast<uint8_t>((pair >> ((x & 1) << 2)) & 0x0F);
+    }
+
+    [[nodiscard]] uint64_t EstimateResidentBytes() const {
+        return packedIndices.capacity();
+    }
+};
+
+// UV footprint meaning "no derivative information": mip selection always lands on the base level.
+constexpr float kBaseLevelUvFootprintLog2 = -64.0f;
+
+// Floor without the libm call; texel coordinates stay far inside the int range.
+[[nodiscard]] inline int FloorToInt(float value) {
+    const int truncated = static_cast<int>(value);
+    return truncated - (value < static_cast<float>(truncated) ? 1 : 0);
+}
+
+// Row sampled at v under REPEAT; rows are stored top first, so v is flipped. Shared by every nearest REPEAT path,
+// including the power-of-two ones: a mask form of the flip lands one row off whenever v * height is a whole number.
+[[nodiscard]] inline int RepeatRowFromV(float v, int height) {
+    const float wrappedV = v - std::floor(v);
+    return std::clamp(FloorToInt((1.0f - wrappedV) * static_cast<float>(height)), 0, height - 1);
+}
+
+// Fractional weights of BilinearFilterRgba8 are Q14: 14 bits keep the result within half an LSB of the float lerp,
+// and weight pairs still fit the signed 16-bit lanes of SSE2 madd.
+constexpr int kBilinearWeightBits = 14;
+constexpr int kBilinearWeightOne = 1 << kBilinearWeightBits;
+
+// Bilinear blend of four RGBA8 texels with all channels filtered together. tx and ty are the [0, 1] fractions towards
+// p10/p11 and p01/p11. The SSE2, NEON and scalar paths share the same fixed-point steps and give identical results.
+[[nodiscard]] inline Pixel BilinearFilterRgba8(const Pixel& p00, const Pixel& p10, const Pixel& p01, const Pixel& p11, float tx, float ty) {
+    const int wx1 = static_cast<int>(tx * static_cast<float>(kBilinearWeightOne) + 0.5f);
+    const int wy1 = static_cast<int>(ty * static_cast<float>(kBilinearWeightOne) + 0.5f);
+    const int wx0 = kBilinearWeightOne - wx1;
+    const int wy0 = kBilinearWeightOne - wy1;
+    // Rows are blended to Q14 and rounded to Q6 so the column blend of two rows stays inside 16-bit lanes.
+    constexpr int kRowShift = kBilinearWeightBits - 6;
+    constexpr int kColumnShift = 6 + kBilinearWeightBits;
+
+#if defined(RETRO_BILINEAR_SSE2)
+    uint32_t packed[4];
+    std::memcpy(&packed[0], &p00, sizeof(Pixel));
+    std::memcpy(&packed[1], &p10, sizeof(Pixel));
+    std::memcpy(&packed[2], &p01, sizeof(Pixel));
+    std::memcpy(&packed[3], &p11, sizeof(Pixel));
+    const __m128i zero = _mm_setzero_si128();
+    const auto widen = [&zero](uint32_t texel) {
+        return _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(texel)), zero);
+    };
+    // Interleaved channel pairs (c00, c10, ...) so one madd yields c00 * wx0 + c10 * wx1 per channel.
+    const __m128i rowWeights = _mm_set1_epi32(static_cast<int>((static_cast<uint32_t>(wx1) << 16) | static_cast<uint32_t>(wx0)));
+    const __m128i rowRound = _mm_set1_epi32(1 << (kRowShift - 1));
+    const __m128i top = _mm_srai_epi32(
+        _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(widen(packed[0]), widen(packed[1])), rowWeights), rowRound), kRowShift);
+    const __m128i bottom = _mm_srai_epi32(
+        _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(widen(packed[2]), widen(packed[3])), rowWeights), rowRound), kRowShift);
+    const __m128i columnWeights =
+        _mm_set1_epi32(static_cast<int>((static_cast<uint32_t>(wy1) << 16) | static_cast<uint32_t>(wy0)));
+    const __m128i blended = _mm_srai_epi32(
+        _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(_mm_packs_epi32(top, top), _mm_packs_epi32(bottom, bottom)), columnWeights),
+                      _mm_set1_epi32(1 << (kColumnShift - 1))),
+        kColumnShift);
+    const __m128i narrowed = _mm_packs_epi32(blended, blended);
+    const uint32_t result = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(narrowed, narrowed)));
+    Pixel out;
+    std::memcpy(&out, &result, sizeof(Pixel));
+    return out;
+#elif defined(RETRO_BILINEAR_NEON)
+    const auto widen = [](const Pixel& texel) {
+        uint32_t packed = 0;
+        std::memcpy(&packed, &texel, sizeof(Pixel));
+        return vget_low_u16(vmovl_u8(vcreate_u8(packed)));
+    };
+    const uint32x4_t top = vrshrq_n_u32(
+        vmlal_n_u16(vmull_n_u16(widen(p00), static_cast<uint16_t>(wx0)), widen(p10), static_cast<uint16_t>(wx1)), kRowShift);
+    const uint32x4_t bottom = vrshrq_n_u32(
+        vmlal_n_u16(vmull_n_u16(widen(p01), static_cast<uint16_t>(wx0)), widen(p11), static_cast<uint16_t>(wx1)), kRowShift);
+    const uint32x4_t blended = vrshrq_n_u32(
+        vmlal_n_u16(vmull_n_u16(vmovn_u32(top), static_cast<uint16_t>(wy0)), vmovn_u32(bottom), static_cast<uint16_t>(wy1)),
+        kColumnShift);
+    const uint16x4_t narrowed = vmovn_u32(blended);
+    const uint32_t result = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(narrowed, narrowed))), 0);
+    Pixel out;
+    std::memcpy(&out, &result, sizeof(Pixel));
+    return out;
+#else
+    const auto filter = [&](uint8_t c00, uint8_t c10, uint8_t c01, uint8_t c11) {
+        const int top = (c00 * wx0 + c10 * wx1 + (1 << (kRowShift - 1))) >> kRowShift;
+        const int bottom = (c01 * wx0 + c11 * wx1 + (1 << (kRowShift - 1))) >> kRowShift;
+        return static_cast<uint8_t>((top * wy0 + bottom * wy1 + (1 << (kColumnShift - 1))) >> kColumnShift);
+    };
+    return Pixel{
+        filter(p00.r, p10.r, p01.r, p11.r),
+        filter(p00.g, p10.g, p01.g, p11.g),
+        filter(p00.b, p10.b, p01.b, p11.b),
+        filter(p00.a, p10.a, p01.a, p11.a),
+    };
+#endif
+}
+
+// Re-lays a row-major image into tiles. Partial edge tiles are padded by repeating the last row/column.
+[[nodiscard]] TextureLevel BuildTiledTextureLevel(const std::vector<Pixel>& linearPixels, int width, int height);
+
+// Nearest REPEAT lookup with the clamped texel-center and v-flip conventions of Texture::SampleNearestRepeat. Works
+// on TextureLevel (returns a Pixel) and IndexedTextureLevel (returns a palette index).
+template <typename TLevel>
+[[nodiscard]] auto SampleLevelNearestRepeat(const TLevel& level, const glm::vec2& uv) {
+    const float wrappedU = uv.x - std::floor(uv.x);
+    const int x = std::clamp(FloorToInt(wrappedU * static_cast<float>(level.width)), 0, level.width - 1);
+    return level.Fetch(x, RepeatRowFromV(uv.y, level.height));
+}
+
+// Maps every texel to its palette index through a 32x32x32 RGB555 nearest-index table.
+[[nodiscard]] IndexedTextureLevel BuildIndexedTextureLevel(const std::vector<Pixel>& linearPixels,
+                                                           int width,
+                                                           int height,
+                                                           const uint8_t* rgb555NearestIndexLut);
+
+// Box-filtered mip levels below the base image, each halving both dimensions (minimum 1) down to 1x1. Odd source
+// dimensions fold their last row/column into the final texel of the reduced level.
+[[nodiscard]] std::vector<TextureLevel> BuildBoxFilteredMipChain(const std::vector<Pixel>& linearPixels, int width, int height);
+
+} // namespace RetroRenderer
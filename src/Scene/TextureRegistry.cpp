@@ -0,0 +1,176 @@
+#include "TextureRegistry.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <utility>
+
+namespace RetroRenderer {
+namespace {
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+uint64_t MixWord(uint64_t hash, uint64_t word) {
+    return (hash ^ word) * kFnvPrime;
+}
+
+bool HaveSamePixels(const Texture& a, const Texture& b) {
+    return a.GetWidth() == b.GetWidth() && a.GetHeight() == b.GetHeight() &&
+           std::memcmp(a.GetPixels().data(), b.GetPixels().data(), a.GetPixels().size() * sizeof(Pixel)) == 0;
+}
+} // namespace
+
+TextureRegistry& TextureRegistry::Get() {
+    static TextureRegistry registry;
+    return registry;
+}
+
+std::string TextureRegistry::CanonicalizePath(const std::string& filePath) {
+    std::error_code ec;
+    const std::filesystem::path canonical = std::filesystem::weakly_canonical(filePath, ec);
+    if (ec) {
+        return std::filesystem::path(filePath).lexically_normal().string();
+    }
+    return canonical.string();
+}
+
+uint64_t TextureRegistry::HashContent(const Texture& texture) {
+    // FNV-1a over 64-bit words: two texels per step keeps hashing well below decode cost.
+    uint64_t hash = MixWord(kFnvOffsetBasis, static_cast<uint64_t>(texture.GetWidth()));
+    hash = MixWord(hash, static_cast<uint64_t>(texture.GetHeight()));
+    const auto* bytes = reinterpret_cast<const uint8_t*>(texture.GetPixels().data());
+    const size_t byteCount = texture.GetPixels().size() * sizeof(Pixel);
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= byteCount; offset += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + offset, sizeof(word));
+        hash = MixWord(hash, word);
+    }
+    for (; offset < byteCount; offset++) {
+        hash = MixWord(hash, bytes[offset]);
+    }
+    return hash;
+}
+
+std::vector<std::shared_ptr<const Texture>> TextureRegistry::LoadFromFiles(const std::vector<std::string>& filePaths) {
+    std::vector<std::shared_ptr<const Texture>> textures(filePaths.size());
+    std::vector<std::string> canonicalPaths(filePaths.size());
+    std::vector<FileStamp> stamps(filePaths.size());
+    std::vector<std::string> missPaths;
+    std::vector<size_t> missIndices;
+    for (size_t i = 0; i < filePaths.size(); i++) {
+        canonicalPaths[i] = CanonicalizePath(filePaths[i]);
+        // Stamped before decoding: a file rewritten mid-decode then looks changed on the next lookup, never current.
+        stamps[i] = ReadFileStamp(canonicalPaths[i]);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        PruneExpiredLocked();
+        for (size_t i = 0; i < filePaths.size(); i++) {
+            textures[i] = FindByPathLocked(canonicalPaths[i], stamps[i]);
+            if (!textures[i]) {
+                missPaths.push_back(filePaths[i]);
+                missIndices.push_back(i);
+            }
+        }
+    }
+
+    // Decoding runs unlocked; the same path listed twice in one batch is deduplicated by content below.
+    std::vector<std::shared_ptr<const Texture>> decoded = Texture::LoadFromFiles(missPaths);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (size_t miss = 0; miss < missIndices.size(); miss++) {
+        const size_t index = missIndices[miss];
+        if (decoded[miss]) {
+            textures[index] = RegisterLocked(canonicalPaths[index], stamps[index], std::move(decoded[miss]));
+        }
+    }
+    return textures;
+}
+
+std::shared_ptr<const Texture> TextureRegistry::Register(const std::string& filePath, std::shared_ptr<const Texture> texture) {
+    if (!texture) {
+        return texture;
+    }
+    const std::string canonicalPath = CanonicalizePath(filePath);
+    const FileStamp stamp = ReadFileStamp(canonicalPath);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return RegisterLocked(canonicalPath, stamp, std::move(texture));
+}
+
+TextureRegistryStats TextureRegistry::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    TextureRegistryStats stats = m_Stats;
+    stats.liveTextures = 0;
+    for (const auto& [hash, entries] : m_ByContent) {
+        (void)hash;
+        stats.liveTextures += static_cast<uint64_t>(
+            std::count_if(entries.begin(), entries.end(), [](const std::weak_ptr<const Texture>& entry) { return !entry.expired(); }));
+    }
+    return stats;
+}
+
+TextureRegistry::FileStamp TextureRegistry::ReadFileStamp(const std::string& canonicalPath) {
+    // A missing or unreadable file stamps as zero; the decode then fails and nothing is registered for it.
+    std::error_code ec;
+    FileStamp stamp{};
+    stamp.size = std::filesystem::file_size(canonicalPath, ec);
+    if (ec) {
+        return FileStamp{};
+    }
+    stamp.lastWriteTime = std::filesystem::last_write_time(canonicalPath, ec);
+    return ec ? FileStamp{} : stamp;
+}
+
+std::shared_ptr<const Texture> TextureRegistry::FindByPathLocked(const std::string& canonicalPath, const FileStamp& stamp) {
+    const auto it = m_ByPath.find(canonicalPath);
+    if (it == m_ByPath.end()) {
+        return nullptr;
+    }
+    if (it->second.stamp != stamp) {
+        // The file changed on disk; the old texture stays live for whoever holds it but is no longer this path's.
+        m_ByPath.erase(it);
+        return nullptr;
+    }
+    std::shared_ptr<const Texture> texture = it->second.texture.lock();
+    if (texture) {
+        m_Stats.pathHits++;
+        m_Stats.sharedBytes += texture->EstimateResidentCpuBytes();
+    }
+    return texture;
+}
+
+std::shared_ptr<const Texture> TextureRegistry::RegisterLocked(const std::string& canonicalPath,
+                                                               const FileStamp& stamp,
+                                                               std::shared_ptr<const Texture> texture) {
+    std::vector<std::weak_ptr<const Texture>>& entries = m_ByContent[HashContent(*texture)];
+    for (const std::weak_ptr<const Texture>& entry : entries) {
+        std::shared_ptr<const Texture> existing = entry.lock();
+        if (existing && HaveSamePixels(*existing, *texture)) {
+            m_Stats.contentHits++;
+            m_Stats.sharedBytes += existing->EstimateResidentCpuBytes();
+            m_ByPath[canonicalPath] = PathEntry{existing, stamp};
+            return existing;
+        }
+    }
+    m_Stats.misses++;
+    entries.push_back(texture);
+    m_ByPath[canonicalPath] = PathEntry{texture, stamp};
+    return texture;
+}
+
+void TextureRegistry::PruneExpiredLocked() {
+    for (auto it = m_ByPath.begin(); it != m_ByPath.end();) {
+        it = it->second.texture.expired() ? m_ByPath.erase(it) : std::next(it);
+    }
+    for (auto it = m_ByContent.begin(); it != m_ByContent.end();) {
+        std::vector<std::weak_ptr<const Texture>>& entries = it->second;
+        entries.erase(std::remove_if(entries.begin(),
+                                     entries.end(),
+                                     [](const std::weak_ptr<const Texture>& entry) { return entry.expired(); }),
+                      entries.end());
+        it = entries.empty() ? m_ByContent.erase(it) : std::next(it);
+    }
+}
+
+} // namespace RetroRenderer
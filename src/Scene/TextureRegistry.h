@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Texture.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RetroRenderer {
+
+// Cumulative since process start.
+struct TextureRegistryStats {
+    uint64_t pathHits = 0;
+    uint64_t contentHits = 0;
+    uint64_t misses = 0;
+    // CPU bytes of the shared textures handed out on hits, i.e. what the duplicates would have cost.
+    uint64_t sharedBytes = 0;
+    uint64_t liveTextures = 0;
+};
+
+// Process-wide registry of loaded file textures. Textures are looked up by canonical path first and, after decoding,
+// by a hash of their pixels, so scenes and materials that reference the same image share one immutable Texture (and
+// with it one auto palette and one GL upload). Entries are weak: a texture is freed once no material holds it.
+// A content-shared texture keeps the path it was first decoded from; callers that show or save a file path should use
+// the path they asked for, not Texture::GetPath().
+class TextureRegistry {
+  public:
+    static TextureRegistry& Get();
+
+    // Index aligned with filePaths; nullptr for files that failed to load. Misses are decoded concurrently.
+    std::vector<std::shared_ptr<const Texture>> LoadFromFiles(const std::vector<std::string>& filePaths);
+    // Shares an already decoded texture: returns the live texture with identical pixels if there is one.
+    std::shared_ptr<const Texture> Register(const std::string& filePath, std::shared_ptr<const Texture> texture);
+    [[nodiscard]] TextureRegistryStats GetStats() const;
+
+    static std::string CanonicalizePath(const std::string& filePath);
+    static uint64_t HashContent(const Texture& texture);
+
+  private:
+    // Size and modification time of the file a path entry was decoded from; a mismatch means the file was replaced.
+    struct FileStamp {
+        uintmax_t size = 0;
+        std::filesystem::file_time_type lastWriteTime{};
+
+        bool operator==(const FileStamp&) const = default;
+    };
+    struct PathEntry {
+        std::weak_ptr<const Texture> texture;
+        FileStamp stamp;
+    };
+
+    static FileStamp ReadFileStamp(const std::string& canonicalPath);
+    std::shared_ptr<const Texture> FindByPathLocked(const std::string& canonicalPath, const FileStamp& stamp);
+    std::shared_ptr<const Texture> RegisterLocked(const std::string& canonicalPath,
+                                                  const FileStamp& stamp,
+                                                  std::shared_ptr<const Texture> texture);
+    void PruneExpiredLocked();
+
+    mutable std::mutex m_Mutex;
+    std::unordered_map<std::string, PathEntry> m_ByPath;
+    // Hash collisions are resolved by comparing pixels, so one hash can hold several distinct textures.
+    std::unordered_map<uint64_t, std::vector<std::weak_ptr<const Texture>>> m_ByContent;
+    TextureRegistryStats m_Stats;
+};
+
+} // namespace RetroRenderer
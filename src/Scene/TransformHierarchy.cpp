@@ -0,0 +1,202 @@
+#include "TransformHierarchy.h"
+#include <algorithm>
+#include <cassert>
+
+namespace RetroRenderer {
+namespace {
+void TransformBounds(const glm::mat4& transform, const glm::vec3& localMin, const glm::vec3& localMax, glm::vec3& outMin, glm::vec3& outMax) {
+    // Arvo's method: accumulate the extremes of each rotated axis instead of transforming all eight corners.
+    const glm::vec3 translation(transform[3]);
+    outMin = translation;
+    outMax = translation;
+    for (int column = 0; column < 3; column++) {
+        const glm::vec3 axis(transform[column]);
+        const glm::vec3 a = axis * localMin[column];
+        const glm::vec3 b = axis * localMax[column];
+        outMin += glm::min(a, b);
+        outMax += glm::max(a, b);
+    }
+}
+
+size_t ToSlot(int index, size_t count) {
+    assert(index >= 0 && static_cast<size_t>(index) < count && "Invalid transform index");
+    (void)count;
+    return static_cast<size_t>(index);
+}
+} // namespace
+
+void TransformHierarchy::Clear() {
+    m_Parents.clear();
+    m_LocalMatrices.clear();
+    m_WorldMatrices.clear();
+    m_LocalBoundsMin.clear();
+    m_LocalBoundsMax.clear();
+    m_WorldBoundsMin.clear();
+    m_WorldBoundsMax.clear();
+    m_HasLocalBounds.clear();
+    m_Dirty.clear();
+    m_UpdateOrder.clear();
+    m_HasDirty = false;
+    m_UpdateOrderStale = false;
+}
+
+int TransformHierarchy::Append(const glm::mat4& localMatrix) {
+    m_Parents.push_back(kNoParent);
+    m_LocalMatrices.push_back(localMatrix);
+    m_WorldMatrices.push_back(localMatrix);
+    m_LocalBoundsMin.emplace_back(0.0f);
+    m_LocalBoundsMax.emplace_back(0.0f);
+    m_WorldBoundsMin.emplace_back(0.0f);
+    m_WorldBoundsMax.emplace_back(0.0f);
+    m_HasLocalBounds.push_back(0);
+    m_Dirty.push_back(1);
+    m_HasDirty = true;
+    // A new entry is a root, so it can go last without breaking the parent-before-child order.
+    const int index = static_cast<int>(m_Parents.size() - 1);
+    m_UpdateOrder.push_back(index);
+    return index;
+}
+
+bool TransformHierarchy::SetParent(int index, int parent) {
+    const size_t slot = ToSlot(index, m_Parents.size());
+    if (parent != kNoParent) {
+        if (parent < 0 || static_cast<size_t>(parent) >= m_Parents.size()) {
+            return false;
+        }
+        // Walking up from the new parent must not reach the child, or Update() would never resolve the loop.
+        for (int ancestor = parent; ancestor != kNoParent; ancestor = m_Parents[static_cast<size_t>(ancestor)]) {
+            if (ancestor == index) {
+                return false;
+            }
+        }
+    }
+    if (m_Parents[slot] != parent) {
+        m_Parents[slot] = parent;
+        m_UpdateOrderStale = true;
+    }
+    MarkDirty(index);
+    return true;
+}
+
+void TransformHierarchy::SetLocalMatrix(int index, const glm::mat4& localMatrix) {
+    m_LocalMatrices[ToSlot(index, m_LocalMatrices.size())] = localMatrix;
+    MarkDirty(index);
+}
+
+void TransformHierarchy::SetLocalBounds(int index, bool hasBounds, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    const size_t slot = ToSlot(index, m_HasLocalBounds.size());
+    m_HasLocalBounds[slot] = hasBounds ? 1 : 0;
+    m_LocalBoundsMin[slot] = hasBounds ? boundsMin : glm::vec3(0.0f);
+    m_LocalBoundsMax[slot] = hasBounds ? boundsMax : glm::vec3(0.0f);
+    MarkDirty(index);
+}
+
+void TransformHierarchy::MarkDirty(int index) {
+    m_Dirty[ToSlot(index, m_Dirty.size())] = 1;
+    m_HasDirty = true;
+}
+
+size_t TransformHierarchy::Update() {
+    if (!m_HasDirty) {
+        return 0;
+    }
+    if (m_UpdateOrderStale) {
+        RebuildUpdateOrder();
+    }
+
+    size_t updatedCount = 0;
+    for (const int index : m_UpdateOrder) {
+        const size_t i = static_cast<size_t>(index);
+        const int parent = m_Parents[i];
+        if (parent != kNoParent && m_Dirty[static_cast<size_t>(parent)] != 0) {
+            m_Dirty[i] = 1;
+        }
+        if (m_Dirty[i] == 0) {
+            continue;
+        }
+
+        m_WorldMatrices[i] = parent == kNoParent ? m_LocalMatrices[i]
+                                                 : m_WorldMatrices[static_cast<size_t>(parent)] * m_LocalMatrices[i];
+        if (m_HasLocalBounds[i] != 0) {
+            TransformBounds(m_WorldMatrices[i], m_LocalBoundsMin[i], m_LocalBoundsMax[i], m_WorldBoundsMin[i], m_WorldBoundsMax[i]);
+        }
+        updatedCount++;
+    }
+
+    std::fill(m_Dirty.begin(), m_Dirty.end(), uint8_t{0});
+    m_HasDirty = false;
+    return updatedCount;
+}
+
+void TransformHierarchy::RebuildUpdateOrder() {
+    // Breadth-first from the roots over a flattened child list (counting sort by parent), so parents precede children.
+    const size_t count = m_Parents.size();
+    std::vector<int> childOffsets(count + 1, 0);
+    for (const int parent : m_Parents) {
+        if (parent != kNoParent) {
+            childOffsets[static_cast<size_t>(parent) + 1]++;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        childOffsets[i + 1] += childOffsets[i];
+    }
+    std::vector<int> children(static_cast<size_t>(childOffsets[count]));
+    std::vector<int> childCursor(childOffsets.begin(), childOffsets.end() - 1);
+    for (size_t i = 0; i < count; i++) {
+        const int parent = m_Parents[i];
+        if (parent != kNoParent) {
+            children[static_cast<size_t>(childCursor[static_cast<size_t>(parent)]++)] = static_cast<int>(i);
+        }
+    }
+
+    m_UpdateOrder.clear();
+    m_UpdateOrder.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        if (m_Parents[i] == kNoParent) {
+            m_UpdateOrder.push_back(static_cast<int>(i));
+        }
+    }
+    for (size_t next = 0; next < m_UpdateOrder.size(); next++) {
+        const size_t parent = static_cast<size_t>(m_UpdateOrder[next]);
+        m_UpdateOrder.insert(m_UpdateOrder.end(), children.begin() + childOffsets[parent], children.begin() + childOffsets[parent + 1]);
+    }
+    assert(m_UpdateOrder.size() == count && "Transform hierarchy contains a cycle");
+    m_UpdateOrderStale = false;
+}
+
+size_t TransformHierarchy::GetCount() const {
+    return m_Parents.size();
+}
+
+bool TransformHierarchy::HasPendingUpdates() const {
+    return m_HasDirty;
+}
+
+int TransformHierarchy::GetParent(int index) const {
+    return m_Parents[ToSlot(index, m_Parents.size())];
+}
+
+const glm::mat4& TransformHierarchy::GetLocalMatrix(int index) const {
+    return m_LocalMatrices[ToSlot(index, m_LocalMatrices.size())];
+}
+
+const glm::mat4& TransformHierarchy::GetWorldMatrix(int index) const {
+    return m_WorldMatrices[ToSlot(index, m_WorldMatrices.size())];
+}
+
+bool TransformHierarchy::HasLocalBounds(int index) const {
+    return m_HasLocalBounds[ToSlot(index, m_HasLocalBounds.size())] != 0;
+}
+
+void TransformHierarchy::GetLocalBounds(int index, glm::vec3& outMin, glm::vec3& outMax) const {
+    const size_t slot = ToSlot(index, m_LocalBoundsMin.size());
+    outMin = m_LocalBoundsMin[slot];
+    outMax = m_LocalBoundsMax[slot];
+}
+
+void TransformHierarchy::GetWorldBounds(int index, glm::vec3& outMin, glm::vec3& outMax) const {
+    const size_t slot = ToSlot(index, m_WorldBoundsMin.size());
+    outMin = m_WorldBoundsMin[slot];
+    outMax = m_WorldBoundsMax[slot];
+}
+} // namespace RetroRenderer
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace RetroRenderer {
+// Flat transform storage for scene models, indexed by transform index (Model::GetTransformIndex). Update() sweeps a
+// cached parent-before-child order, rebuilt only after reparenting, so one pass resolves every dirty world matrix and
+// world-space bounds. World getters here and on Model return the result of the last Update().
+class TransformHierarchy {
+  public:
+    static constexpr int kNoParent = -1;
+
+    void Clear();
+    [[nodiscard]] int Append(const glm::mat4& localMatrix);
+    // Accepts any existing entry that would not form a cycle; otherwise returns false and leaves the entry unchanged.
+    bool SetParent(int index, int parent);
+    void SetLocalMatrix(int index, const glm::mat4& localMatrix);
+    void SetLocalBounds(int index, bool hasBounds, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    void MarkDirty(int index);
+    // Recomputes world matrices and bounds of dirty entries and their descendants; returns how many were updated.
+    size_t Update();
+
+    [[nodiscard]] size_t GetCount() const;
+    [[nodiscard]] bool HasPendingUpdates() const;
+    [[nodiscard]] int GetParent(int index) const;
+    [[nodiscard]] const glm::mat4& GetLocalMatrix(int index) const;
+    [[nodiscard]] const glm::mat4& GetWorldMatrix(int index) const;
+    [[nodiscard]] bool HasLocalBounds(int index) const;
+    void GetLocalBounds(int index, glm::vec3& outMin, glm::vec3& outMax) const;
+    void GetWorldBounds(int index, glm::vec3& outMin, glm::vec3& outMax) const;
+
+  private:
+    void RebuildUpdateOrder();
+
+    std::vector<int> m_Parents;
+    std::vector<glm::mat4> m_LocalMatrices;
+    std::vector<glm::mat4> m_WorldMatrices;
+    std::vector<glm::vec3> m_LocalBoundsMin;
+    std::vector<glm::vec3> m_LocalBoundsMax;
+    std::vector<glm::vec3> m_WorldBoundsMin;
+    std::vector<glm::vec3> m_WorldBoundsMax;
+    std::vector<uint8_t> m_HasLocalBounds;
+    std::vector<uint8_t> m_Dirty;
+    std::vector<int> m_UpdateOrder;
+    bool m_HasDirty = false;
+    bool m_UpdateOrderStale = false;
+};
+} // namespace RetroRenderer
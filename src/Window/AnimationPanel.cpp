@@ -1,10 +1,13 @@
 #include "AnimationPanel.h"
 
+#include "../Renderer/AnimationSequenceRenderer.h"
 #include "../Scene/Model.h"
 #include "../Scene/Scene.h"
 #include <imgui.h>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <memory>
 
 namespace RetroRenderer {
 namespace {
@@ -152,12 +155,32 @@ void AnimationPanel::Draw(EditorContext& editorContext) {
         if (ImGui::Button("Reload")) {
             sceneManager.ReloadAnimationSidecar();
         }
+        ImGui::SameLine();
+        const AnimationExportJob* exportJob = editorContext.animationExport;
+        if (exportJob != nullptr && exportJob->IsRunning()) {
+            if (ImGui::Button("Cancel Export")) {
+                editorContext.enqueueEvent(std::make_unique<AnimationExportCancelEvent>());
+            }
+            const size_t framesWritten = exportJob->GetFramesWritten();
+            const size_t frameCount = std::max<size_t>(exportJob->GetFrameCount(), 1);
+            char overlay[48];
+            std::snprintf(overlay, sizeof(overlay), "Exporting %zu/%zu", framesWritten, frameCount);
+            ImGui::ProgressBar(static_cast<float>(framesWritten) / static_cast<float>(frameCount),
+                               ImVec2(-1.0f, 0.0f),
+                               overlay);
+        } else if (ImGui::Button("Export Frames")) {
+            std::filesystem::path outputDirectory = *sceneManager.GetCurrentScenePath();
+            outputDirectory.replace_filename(outputDirectory.stem().string() + "_frames");
+            editorContext.enqueueEvent(std::make_unique<AnimationExportEvent>(outputDirectory));
+        }
         ImGui::TextWrapped("Sidecar: %s", sceneManager.GetAnimationSidecarPath().generic_string().c_str());
     } else {
         ImGui::BeginDisabled();
         ImGui::Button("Save");
         ImGui::SameLine();
         ImGui::Button("Reload");
+        ImGui::SameLine();
+        ImGui::Button("Export Frames");
         ImGui::EndDisabled();
         ImGui::TextDisabled("Sidecar persistence is unavailable for this scene source.");
     }
@@ -26,11 +26,15 @@
 #include "../native/AndroidBridge.h"
 #endif
 
+#include "../Base/AllocationTracker.h"
 #include "../Base/ExampleSceneBaseline.h"
 #include "../Base/Event.h"
+#include "../Base/FrameTrace.h"
 #include "../Base/InputActions.h"
 #include "../native/FileDialog.h"
+#include "../Renderer/RenderPacketCapture.h"
 #include "../Renderer/RetroPalette.h"
+#include "../Renderer/Software/RasterCounters.h"
 #include "../Scene/MaterialManager.h"
 #include "../Scene/Texture.h"
 #include "ConfigPanel.h"
@@ -87,8 +91,34 @@ uint64_t ClockNanoseconds() {
         std::chrono::duration_cast<std::chrono::nanoseconds>(TimingClock::now().time_since_epoch()).count());
 }
 
-double ReadTimingMilliseconds(const std::atomic<uint64_t>& timing) {
-    return static_cast<double>(timing.load(std::memory_order_relaxed)) / 1000000.0;
+double NanosecondsToMilliseconds(uint64_t ns) {
+    return static_cast<double>(ns) / 1000000.0;
+}
+
+bool BeginStageTimingTable(const char* id) {
+    if (!ImGui::BeginTable(id, 6, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+        return false;
+    }
+    ImGui::TableSetupColumn("ms");
+    ImGui::TableSetupColumn("last");
+    ImGui::TableSetupColumn("p50");
+    ImGui::TableSetupColumn("p95");
+    ImGui::TableSetupColumn("p99");
+    ImGui::TableSetupColumn("max");
+    ImGui::TableHeadersRow();
+    return true;
+}
+
+// Percentiles cover the stage's rolling window, so tail spikes stay visible after the last value recovers.
+void StageTimingRow(const char* label, const StageHistogram& timing) {
+    const StageTimingSummary summary = timing.Summarize();
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(label);
+    for (const uint64_t ns : {timing.GetLastNs(), summary.medianNs, summary.p95Ns, summary.p99Ns, summary.maxNs}) {
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", NanosecondsToMilliseconds(ns));
+    }
 }
 
 double BytesToMiB(uint64_t bytes) {
@@ -675,21 +705,7 @@ void ConfigPanel::ApplyManagedSceneBaselineForPath(const std::filesystem::path&
     }
 
     MaterialManager& materialManager = m_editorContext_->GetMaterialManager();
-    if (baseline.showSkybox.has_value()) {
-        p_config_->environment.showSkybox = *baseline.showSkybox;
-    }
-    if (baseline.backfaceCulling.has_value()) {
-        p_config_->cull.backfaceCulling = *baseline.backfaceCulling;
-    }
-    if (baseline.perspectiveCorrect.has_value()) {
-        p_config_->renderer.enablePerspectiveCorrect = *baseline.perspectiveCorrect;
-    }
-    if (baseline.glTextureSampling.has_value()) {
-        p_config_->gl.textureSampling = *baseline.glTextureSampling;
-    }
-    if (baseline.lightPosition.has_value()) {
-        p_config_->environment.lightPosition = *baseline.lightPosition;
-    }
+    ApplyExampleSceneBaselineToConfig(baseline, *p_config_);
 
     if (std::shared_ptr<Scene> scene = GetScene()) {
         const std::filesystem::path baselineMaterialTemplate = ResolveBaselineMaterialTemplate(materialManager, baseline);
@@ -953,7 +969,7 @@ void ConfigPanel::DisplayTexturePreview(const std::shared_ptr<const Texture>& te
 
 void ConfigPanel::DisplayRenderedImage() {
     if (p_stats_) {
-        p_stats_->lastCpuOutputUploadNs.store(0, std::memory_order_relaxed);
+        p_stats_->cpuOutputUploadTiming.Record(0);
     }
     ImGui::Begin("Output");
     ImGui::Text("Please load a scene to start rendering!");
@@ -962,7 +978,7 @@ void ConfigPanel::DisplayRenderedImage() {
 
 void ConfigPanel::DisplayRenderedImage(bool outputAvailable, RenderOutputOrigin origin) {
     if (p_stats_) {
-        p_stats_->lastCpuOutputUploadNs.store(0, std::memory_order_relaxed);
+        p_stats_->cpuOutputUploadTiming.Record(0);
     }
     auto& r = p_config_->renderer;
     ImGui::Begin("Output");
@@ -1306,7 +1322,19 @@ void ConfigPanel::DisplayRasterizerSettings() {
         case Config::RasterizationPolygonMode::FILL:
             ImGui::SeparatorText("Fill");
             manualChange |= ImGui::Combo("Fill mode", reinterpret_cast<int*>(&r.fillMode), fillItems, IM_ARRAYSIZE(fillItems));
+            manualChange |= ImGui::Checkbox("Texture mipmapping", &r.mipmapping);
+        }
+#if RETRO_RASTER_COUNTERS
+        ImGui::SeparatorText("Diagnostics");
+        ImGui::Checkbox("Raster counters", &r.collectCounters);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Count triangles, pixels and material instructions per frame (Metrics > SW Output).");
+        }
+        ImGui::Checkbox("Overdraw heatmap", &r.overdrawHeatmap);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Show framebuffer writes per pixel: black 0, blue 1, through red, white 7+.");
         }
+#endif
     } else if (p_config_->renderer.selectedRenderer == Config::RendererType::GL) {
         auto& r = p_config_->gl.rasterizer;
         const char* polyItems[] = {"Point", "Wireframe (line)", "Fill triangles"};
@@ -1316,6 +1344,12 @@ void ConfigPanel::DisplayRasterizerSettings() {
                                      reinterpret_cast<int*>(&p_config_->gl.textureSampling),
                                      textureSamplingItems,
                                      IM_ARRAYSIZE(textureSamplingItems));
+        ImGui::SeparatorText("GPU residency");
+        ImGui::SliderInt("Cache budget (MiB)", &p_config_->gl.residencyBudgetMiB, 0, 4096);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Textures and meshes idle past the threshold are evicted while over budget. 0 disables eviction.");
+        }
+        ImGui::SliderInt("Evict after idle frames", &p_config_->gl.residencyIdleFrames, 1, 1200);
     }
 
     if (manualChange) {
@@ -1336,6 +1370,7 @@ void ConfigPanel::DisplayCullSettings() {
     manualChange |= ImGui::Checkbox("Raster clip", &c.rasterClip);
     manualChange |= ImGui::Checkbox("Geometric clip", &c.geometricClip);
     manualChange |= ImGui::Checkbox("Frustum cull", &c.frustumCull);
+    manualChange |= ImGui::Checkbox("Occlusion cull (software)", &c.occlusionCull);
 
     if (manualChange) {
         MarkRendererPresetCustom();
@@ -1457,10 +1492,14 @@ void ConfigPanel::DisplayPostFxSettings() {
     if (retro.usePs1TextureClut) {
         const MaterialManager* materialManager = m_editorContext_ ? m_editorContext_->materialManager : nullptr;
         if (materialManager != nullptr) {
-            if (const Texture* previewTexture = materialManager->GetSelectedPreviewTexture();
-                previewTexture != nullptr && previewTexture->HasAutoPalette()) {
+            const Texture* previewTexture = materialManager->GetSelectedPreviewTexture();
+            if (previewTexture != nullptr) {
+                previewTexture->EnsureAutoPalette();
+            }
+            if (previewTexture != nullptr && previewTexture->HasAutoPalette()) {
                 ImGui::Text("Active texture CLUT preview");
                 DrawPixelPalettePreviewGrid(previewTexture->GetAutoPalettePixels());
+                ImGui::TextDisabled("Built in %.2f ms", static_cast<double>(previewTexture->GetAutoPaletteBuildNs()) / 1.0e6);
             } else {
                 ImGui::TextDisabled("Load a texture to preview the derived 16-color CLUT.");
             }
@@ -1590,32 +1629,72 @@ void ConfigPanel::DisplayMetricsOverlay() {
         ImGui::Text("%d verts, %d tris", p_stats_->renderedVerts, p_stats_->renderedTris);
         ImGui::Text("0 draw calls");
         ImGui::SeparatorText("Frame timing");
-        ImGui::Text("Total: %.3f ms", ReadTimingMilliseconds(p_stats_->lastFrameTotalNs));
-        ImGui::Text("Main update: %.3f ms", ReadTimingMilliseconds(p_stats_->lastMainUpdateNs));
-        ImGui::Text("Display before frame: %.3f ms", ReadTimingMilliseconds(p_stats_->lastDisplayBeforeFrameNs));
-        ImGui::Text("Build render packet: %.3f ms", ReadTimingMilliseconds(p_stats_->lastRenderPacketBuildNs));
-        ImGui::Text("Prepare render frame: %.3f ms", ReadTimingMilliseconds(p_stats_->lastRenderSystemNs));
-        ImGui::Text("ImGui build/render: %.3f / %.3f ms",
-                    ReadTimingMilliseconds(p_stats_->lastImGuiBuildNs),
-                    ReadTimingMilliseconds(p_stats_->lastImGuiRenderNs));
-        ImGui::Text("Display draw: %.3f ms", ReadTimingMilliseconds(p_stats_->lastDisplayDrawNs));
-        ImGui::Text("Swap buffers: %.3f ms", ReadTimingMilliseconds(p_stats_->lastSwapBuffersNs));
-        if (p_config_->renderer.selectedRenderer == Config::RendererType::GL) {
-            ImGui::Text("GL render: %.3f ms", ReadTimingMilliseconds(p_stats_->lastGlRenderNs));
+        const uint64_t frameBudgetNs = p_stats_->frameBudgetNs.load(std::memory_order_relaxed);
+        const StageTimingSummary frameSummary = p_stats_->frameTotalTiming.Summarize(frameBudgetNs);
+        ImGui::Text("Over budget (%.2f ms): %zu of last %zu frames",
+                    NanosecondsToMilliseconds(frameBudgetNs),
+                    frameSummary.overBudgetCount,
+                    frameSummary.sampleCount);
+        float frameBudgetMs = static_cast<float>(NanosecondsToMilliseconds(frameBudgetNs));
+        if (ImGui::SliderFloat("Frame budget (ms)", &frameBudgetMs, 1.0f, 100.0f, "%.2f")) {
+            p_stats_->frameBudgetNs.store(static_cast<uint64_t>(frameBudgetMs * 1000000.0f), std::memory_order_relaxed);
+        }
+        if (BeginStageTimingTable("FrameTimingTable")) {
+            StageTimingRow("Total", p_stats_->frameTotalTiming);
+            StageTimingRow("Main update", p_stats_->mainUpdateTiming);
+            StageTimingRow("Display before frame", p_stats_->displayBeforeFrameTiming);
+            StageTimingRow("Build render packet", p_stats_->renderPacketBuildTiming);
+            StageTimingRow("Prepare render frame", p_stats_->renderSystemTiming);
+            StageTimingRow("ImGui build", p_stats_->imGuiBuildTiming);
+            StageTimingRow("ImGui render", p_stats_->imGuiRenderTiming);
+            StageTimingRow("Display draw", p_stats_->displayDrawTiming);
+            StageTimingRow("Swap buffers", p_stats_->swapBuffersTiming);
+            if (p_config_->renderer.selectedRenderer == Config::RendererType::GL) {
+                StageTimingRow("GL render", p_stats_->glRenderTiming);
+            }
+            ImGui::EndTable();
         }
         ImGui::SeparatorText("Memory");
-        if (p_stats_->processMemorySupported) {
-            const double currentMiB = BytesToMiB(p_stats_->processResidentBytes);
-            const double peakMiB = BytesToMiB(p_stats_->processResidentPeakBytes);
+        if (p_stats_->processMemorySupported.load(std::memory_order_relaxed)) {
+            const double currentMiB = BytesToMiB(p_stats_->processResidentBytes.load(std::memory_order_relaxed));
+            const double peakMiB = BytesToMiB(p_stats_->processResidentPeakBytes.load(std::memory_order_relaxed));
             ImGui::Text("RSS: %.2f MiB", currentMiB);
             ImGui::Text("Peak RSS (app): %.2f MiB", peakMiB);
-            if (p_stats_->processResidentPeakOsBytes > 0) {
-                const double peakOsMiB = BytesToMiB(p_stats_->processResidentPeakOsBytes);
+            const uint64_t peakOsBytes = p_stats_->processResidentPeakOsBytes.load(std::memory_order_relaxed);
+            if (peakOsBytes > 0) {
+                const double peakOsMiB = BytesToMiB(peakOsBytes);
                 ImGui::Text("Peak RSS (OS): %.2f MiB", peakOsMiB);
             }
         } else {
             ImGui::Text("Process memory sampling unavailable on this platform");
         }
+        ImGui::SliderFloat("Sample rate (Hz)", &p_config_->diagnostics.memorySampleRateHz, 0.1f, 60.0f, "%.1f",
+                           ImGuiSliderFlags_Logarithmic);
+#if RETRO_ALLOCATION_TRACKING
+        ImGui::Checkbox("Track allocations", &p_config_->diagnostics.trackAllocations);
+        if (p_config_->diagnostics.trackAllocations &&
+            ImGui::BeginTable("AllocationTable", 4, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+            const AllocationFrameReport report = AllocationTracker::GetLastFrame();
+            ImGui::TableSetupColumn("tag");
+            ImGui::TableSetupColumn("allocs");
+            ImGui::TableSetupColumn("frees");
+            ImGui::TableSetupColumn("KiB");
+            ImGui::TableHeadersRow();
+            for (size_t tag = 0; tag < kAllocationTagCount; tag++) {
+                const AllocationCounts& counts = report.tags[tag];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(GetAllocationTagName(static_cast<AllocationTag>(tag)));
+                ImGui::TableNextColumn();
+                ImGui::Text("%" PRIu64, counts.allocations);
+                ImGui::TableNextColumn();
+                ImGui::Text("%" PRIu64, counts.deallocations);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", static_cast<double>(counts.bytes) / 1024.0);
+            }
+            ImGui::EndTable();
+        }
+#endif
         const uint64_t sceneCpuBytes = p_stats_->sceneGeometryCpuBytes + p_stats_->sceneTextureCpuBytes;
         const uint64_t presentationBytes =
             p_stats_->outputPresenterBytes + p_stats_->previewPresenterBytes + p_stats_->fontPresenterBytes;
@@ -1638,6 +1717,10 @@ void ConfigPanel::DisplayMetricsOverlay() {
                     BytesToMiB(sceneCpuBytes),
                     BytesToMiB(p_stats_->sceneGeometryCpuBytes),
                     BytesToMiB(p_stats_->sceneTextureCpuBytes));
+        ImGui::Text("Texture dedup: path hits=%" PRIu64 " content hits=%" PRIu64 " (%.2f MiB shared)",
+                    p_stats_->textureRegistryPathHits,
+                    p_stats_->textureRegistryContentHits,
+                    BytesToMiB(p_stats_->textureRegistrySharedBytes));
         ImGui::Text("Presenters: %.2f MiB (output %.2f, preview %.2f, font %.2f)",
                     BytesToMiB(presentationBytes),
                     BytesToMiB(p_stats_->outputPresenterBytes),
@@ -1649,6 +1732,11 @@ void ConfigPanel::DisplayMetricsOverlay() {
                     BytesToMiB(p_stats_->glRendererMeshCacheBytes),
                     BytesToMiB(p_stats_->glRendererTextureCacheBytes),
                     BytesToMiB(p_stats_->glRendererSkyboxBytes + p_stats_->glRendererFallbackTextureBytes));
+        ImGui::Text("GL evictions: tex=%" PRIu64 " mesh=%" PRIu64 " re-uploads: tex=%" PRIu64 " mesh=%" PRIu64,
+                    p_stats_->glTextureEvictions,
+                    p_stats_->glMeshEvictions,
+                    p_stats_->glTextureReuploads,
+                    p_stats_->glMeshReuploads);
         ImGui::Text("SW renderer: %.2f MiB (fb %.2f, depth %.2f, scratch %.2f, ready %.2f, presented %.2f)",
                     BytesToMiB(swRendererBytes),
                     BytesToMiB(p_stats_->softwareFramebufferColorBytes),
@@ -1684,18 +1772,76 @@ void ConfigPanel::DisplayMetricsOverlay() {
                 lastPresentedNs != 0 ? static_cast<double>(ClockNanoseconds() - lastPresentedNs) / 1000000.0 : 0.0;
             ImGui::SeparatorText("SW Output");
             ImGui::Text("Output: %.1f FPS, age %.3f ms", swOutputFps, outputAgeMs);
-            ImGui::Text("Last present interval: %.3f ms",
-                        ReadTimingMilliseconds(p_stats_->lastSoftwareFramePresentIntervalNs));
-            ImGui::Text("Packet copy: %.3f ms", ReadTimingMilliseconds(p_stats_->lastSoftwarePacketCopyNs));
-            ImGui::Text("Worker render/copy: %.3f / %.3f ms",
-                        ReadTimingMilliseconds(p_stats_->lastSoftwareWorkerRenderNs),
-                        ReadTimingMilliseconds(p_stats_->lastSoftwareWorkerCopyNs));
-            ImGui::Text("CPU upload: %.3f ms", ReadTimingMilliseconds(p_stats_->lastCpuOutputUploadNs));
+            if (BeginStageTimingTable("SoftwareTimingTable")) {
+                StageTimingRow("Present interval", p_stats_->softwareFramePresentIntervalTiming);
+                StageTimingRow("Packet copy", p_stats_->softwarePacketCopyTiming);
+                StageTimingRow("Worker render", p_stats_->softwareWorkerRenderTiming);
+                StageTimingRow("Worker copy", p_stats_->softwareWorkerCopyTiming);
+                StageTimingRow("CPU upload", p_stats_->cpuOutputUploadTiming);
+                ImGui::EndTable();
+            }
             ImGui::Text("Jobs: submitted=%" PRIu64 " completed=%" PRIu64, swJobsSubmitted, swJobsCompleted);
             ImGui::Text("Jobs: cancelled=%" PRIu64 " replaced(pending)=%" PRIu64, swJobsCancelled,
                         swJobsReplacedPending);
             ImGui::Text("Frames: presented=%" PRIu64 " replaced(ready)=%" PRIu64, swFramesPresented,
                         swFramesReplacedReady);
+            ImGui::Text("Clusters: tested=%" PRIu64 " frustum culled=%" PRIu64 " backface culled=%" PRIu64,
+                        p_stats_->lastSoftwareClustersTested.load(std::memory_order_relaxed),
+                        p_stats_->lastSoftwareClustersFrustumCulled.load(std::memory_order_relaxed),
+                        p_stats_->lastSoftwareClustersBackfaceCulled.load(std::memory_order_relaxed));
+            ImGui::Text("Occlusion culled: items=%" PRIu64 "/%" PRIu64 " clusters=%" PRIu64,
+                        p_stats_->lastSoftwareItemsOcclusionCulled.load(std::memory_order_relaxed),
+                        p_stats_->lastSoftwareItemsTested.load(std::memory_order_relaxed),
+                        p_stats_->lastSoftwareClustersOcclusionCulled.load(std::memory_order_relaxed));
+            ImGui::Text("Occlusion pyramid: full builds=%" PRIu64 " tiles rescanned=%" PRIu64,
+                        p_stats_->lastSoftwareOcclusionFullBuilds.load(std::memory_order_relaxed),
+                        p_stats_->lastSoftwareOcclusionTilesRescanned.load(std::memory_order_relaxed));
+#if RETRO_RASTER_COUNTERS
+            if (p_config_->software.rasterizer.collectCounters) {
+                ImGui::Text("Triangles: submitted=%" PRIu64 " culled=%" PRIu64 " clipped=%" PRIu64 " deferred=%" PRIu64,
+                            p_stats_->lastSoftwareRasterTrianglesSubmitted.load(std::memory_order_relaxed),
+                            p_stats_->lastSoftwareRasterTrianglesCulled.load(std::memory_order_relaxed),
+                            p_stats_->lastSoftwareRasterTrianglesClipped.load(std::memory_order_relaxed),
+                            p_stats_->lastSoftwareRasterTrianglesDeferred.load(std::memory_order_relaxed));
+                ImGui::Text("Pixels: covered=%" PRIu64 " shaded=%" PRIu64 " written=%" PRIu64,
+                            p_stats_->lastSoftwareRasterPixelsCovered.load(std::memory_order_relaxed),
+                            p_stats_->lastSoftwareRasterPixelsShaded.load(std::memory_order_relaxed),
+                            p_stats_->lastSoftwareRasterPixelsWritten.load(std::memory_order_relaxed));
+                ImGui::Text("Pixels: depth rejected=%" PRIu64 " alpha discarded=%" PRIu64,
+                            p_stats_->lastSoftwareRasterPixelsDepthRejected.load(std::memory_order_relaxed),
+                            p_stats_->lastSoftwareRasterPixelsAlphaDiscarded.load(std::memory_order_relaxed));
+                ImGui::Text("Material instructions: %" PRIu64,
+                            p_stats_->lastSoftwareRasterMaterialInstructions.load(std::memory_order_relaxed));
+            }
+#endif
+        }
+#if RETRO_TRACE_ZONES
+        ImGui::SeparatorText("Trace");
+        bool traceRecording = FrameTrace::IsEnabled();
+        if (ImGui::Checkbox("Record zones", &traceRecording)) {
+            if (traceRecording) {
+                FrameTrace::Clear();
+            }
+            FrameTrace::SetEnabled(traceRecording);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Save trace")) {
+            // Open in chrome://tracing or ui.perfetto.dev.
+            const std::filesystem::path tracePath = "retrorenderer-trace.json";
+            std::string traceError;
+            if (FrameTrace::WriteChromeTrace(tracePath, traceError)) {
+                LOGI("Wrote frame trace to %s", tracePath.generic_string().c_str());
+            } else {
+                LOGE("%s", traceError.c_str());
+            }
+        }
+#endif
+        ImGui::SeparatorText("Packet capture");
+        // Replay with: retrorenderer_headless --replay <file>
+        ImGui::Checkbox("Capture render packets", &p_config_->diagnostics.capturePackets);
+        if (p_config_->diagnostics.capturePackets) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("-> %s", kDefaultPacketCapturePath);
         }
         if (auto cam = GetCamera()) {
             ImGui::Text("Camera position: (%.3f, %.3f, %.3f)", cam->m_Position.x, cam->m_Position.y, cam->m_Position.z);
@@ -1807,7 +1953,7 @@ void ConfigPanel::BeforeFrame() {
 
     DisplayGUI();
     if (p_stats_) {
-        p_stats_->lastImGuiBuildNs.store(ElapsedNanoseconds(imguiBuildStart), std::memory_order_relaxed);
+        p_stats_->imGuiBuildTiming.Record(ElapsedNanoseconds(imguiBuildStart));
     }
 }
 
@@ -1816,7 +1962,7 @@ void ConfigPanel::OnDraw() {
     ImGui::Render();
     m_uiRenderPacket_ = UiRenderPacket::Capture(ImGui::GetDrawData());
     if (p_stats_) {
-        p_stats_->lastImGuiRenderNs.store(ElapsedNanoseconds(imguiRenderStart), std::memory_order_relaxed);
+        p_stats_->imGuiRenderTiming.Record(ElapsedNanoseconds(imguiRenderStart));
     }
 }
 
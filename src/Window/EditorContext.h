@@ -11,6 +11,7 @@
 
 namespace RetroRenderer {
 
+class AnimationExportJob;
 class Camera;
 class MaterialManager;
 class Scene;
@@ -23,6 +24,8 @@ struct EditorContext {
     std::function<void(const Event&)> dispatchImmediate;
     std::function<void(std::unique_ptr<Event>)> enqueueEvent;
     std::optional<int> selectedModelIndex;
+    // Read-only progress view; cancel through AnimationExportCancelEvent.
+    const AnimationExportJob* animationExport = nullptr;
 
     [[nodiscard]] Camera* GetCamera() const {
         return sceneManager != nullptr ? sceneManager->GetCamera() : nullptr;
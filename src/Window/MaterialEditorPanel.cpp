@@ -235,8 +235,9 @@ void MaterialEditorPanel::Draw(EditorContext& editorContext,
 
     if (const std::shared_ptr<const Texture> previewTexture = materialManager.GetSelectedPreviewTextureShared();
         previewTexture != nullptr && previewTexture->HasCpuPixels()) {
+        const std::string sourcePath = materialManager.GetSelectedTextureSourcePath();
         ImGui::Text("Current Texture: %s (%d x %d)",
-                    previewTexture->GetPath().c_str(),
+                    sourcePath.empty() ? previewTexture->GetPath().c_str() : sourcePath.c_str(),
                     previewTexture->GetWidth(),
                     previewTexture->GetHeight());
         if (texturePreview) {
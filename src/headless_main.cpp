@@ -0,0 +1,64 @@
+#define SDL_MAIN_HANDLED
+
+#include "Headless/HeadlessRenderer.h"
+#include "Headless/PerfRegression.h"
+#include "Base/FrameTrace.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const std::string programName = argc > 0 ? argv[0] : "retrorenderer_headless";
+    std::vector<std::string> arguments;
+    for (int i = 1; i < argc; i++) {
+        arguments.emplace_back(argv[i]);
+    }
+
+    RetroRenderer::HeadlessOptions options;
+    std::string errorMessage;
+    if (!RetroRenderer::ParseHeadlessArguments(arguments, options, errorMessage)) {
+        std::fprintf(stderr, "%s\n\n%s", errorMessage.c_str(), RetroRenderer::GetHeadlessUsage(programName).c_str());
+        return 2;
+    }
+    if (options.showHelp) {
+        std::printf("%s", RetroRenderer::GetHeadlessUsage(programName).c_str());
+        return 0;
+    }
+
+    if (options.tracePath.has_value()) {
+        RetroRenderer::FrameTrace::SetThreadName("headless");
+        RetroRenderer::FrameTrace::SetEnabled(true);
+    }
+
+    int exitCode = 0;
+    if (options.perfBaselinePath.has_value()) {
+        bool regressed = false;
+        if (!RetroRenderer::RunPerfSuite(options, regressed, errorMessage)) {
+            std::fprintf(stderr, "Perf run failed: %s\n", errorMessage.c_str());
+            exitCode = 1;
+        } else if (regressed) {
+            // Distinct from setup failures so CI can tell a slowdown from a broken run.
+            exitCode = 3;
+        }
+    } else {
+        RetroRenderer::HeadlessRunResult result;
+        const bool rendered = options.replayPath.has_value() ? RetroRenderer::RunReplay(options, result)
+                                                              : RetroRenderer::RunHeadless(options, result);
+        if (rendered) {
+            RetroRenderer::PrintHeadlessReport(options, result);
+        } else {
+            std::fprintf(stderr, "Headless render failed: %s\n", result.errorMessage.c_str());
+            exitCode = 1;
+        }
+    }
+
+    // Written after failed runs too; the zones up to the failure are often the interesting part.
+    if (options.tracePath.has_value()) {
+        if (!RetroRenderer::FrameTrace::WriteChromeTrace(*options.tracePath, errorMessage)) {
+            std::fprintf(stderr, "%s\n", errorMessage.c_str());
+            return exitCode != 0 ? exitCode : 1;
+        }
+        std::printf("Trace:      %s\n", options.tracePath->generic_string().c_str());
+    }
+    return exitCode;
+}
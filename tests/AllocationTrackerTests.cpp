@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Base/AllocationTracker.h"
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace RetroRenderer {
+
+#if RETRO_ALLOCATION_TRACKING
+TEST_CASE("Allocation tracker charges allocations to the thread's tag", "[memory]") {
+    AllocationTracker::SetEnabled(true);
+    AllocationTracker::EndFrame();
+    {
+        RETRO_ALLOCATION_TAG(SCENE);
+        auto value = std::make_unique<int>(7);
+        {
+            RETRO_ALLOCATION_TAG(RENDER_PACKET);
+            std::vector<char> bytes(1000);
+        }
+    }
+    std::thread worker([]() {
+        RETRO_ALLOCATION_TAG(SOFTWARE_RENDERER);
+        std::vector<char> bytes(64);
+    });
+    worker.join();
+    AllocationTracker::EndFrame();
+    AllocationTracker::SetEnabled(false);
+
+    const AllocationFrameReport report = AllocationTracker::GetLastFrame();
+    CHECK(report[AllocationTag::SCENE].allocations == 1);
+    CHECK(report[AllocationTag::SCENE].deallocations == 1);
+    CHECK(report[AllocationTag::SCENE].bytes == sizeof(int));
+    CHECK(report[AllocationTag::RENDER_PACKET].allocations == 1);
+    CHECK(report[AllocationTag::RENDER_PACKET].bytes == 1000);
+    CHECK(report[AllocationTag::SOFTWARE_RENDERER].allocations == 1);
+    CHECK(report.Total().allocations >= 3);
+    CHECK(AllocationTracker::GetThreadTag() == AllocationTag::UNTAGGED);
+}
+
+TEST_CASE("Allocation tracker ignores allocations while disabled", "[memory]") {
+    AllocationTracker::SetEnabled(false);
+    AllocationTracker::EndFrame();
+    {
+        RETRO_ALLOCATION_TAG(UI);
+        std::vector<int> values(16);
+    }
+    AllocationTracker::EndFrame();
+    CHECK(AllocationTracker::GetLastFrame()[AllocationTag::UI].allocations == 0);
+}
+
+namespace {
+int g_NewHandlerCalls = 0;
+
+void CountingNewHandler() {
+    g_NewHandlerCalls++;
+    // Nothing to free; uninstall so the retry throws instead of looping forever.
+    std::set_new_handler(nullptr);
+}
+} // namespace
+
+TEST_CASE("Replacement operator new runs the new_handler before throwing", "[memory]") {
+    g_NewHandlerCalls = 0;
+    const std::new_handler previous = std::set_new_handler(CountingNewHandler);
+    CHECK_THROWS_AS(::operator new(SIZE_MAX / 2), std::bad_alloc);
+    std::set_new_handler(previous);
+    CHECK(g_NewHandlerCalls == 1);
+}
+#endif
+
+TEST_CASE("Allocation tags have names", "[memory]") {
+    for (size_t tag = 0; tag < kAllocationTagCount; tag++) {
+        CHECK(std::string_view(GetAllocationTagName(static_cast<AllocationTag>(tag))) != "unknown");
+    }
+    CHECK(std::string_view(GetAllocationTagName(AllocationTag::COUNT)) == "unknown");
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,230 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Base/Event.h"
+#include "Renderer/AnimationSequenceRenderer.h"
+#include "Renderer/RenderSystem.h"
+#include "Scene/MaterialManager.h"
+#include "Scene/SceneManager.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RetroRenderer {
+namespace {
+constexpr const char* kCubeObj =
+    "v -0.5 -0.5 -0.5\n"
+    "v 0.5 -0.5 -0.5\n"
+    "v 0.5 0.5 -0.5\n"
+    "v -0.5 0.5 -0.5\n"
+    "v -0.5 -0.5 0.5\n"
+    "v 0.5 -0.5 0.5\n"
+    "v 0.5 0.5 0.5\n"
+    "v -0.5 0.5 0.5\n"
+    "f 1 4 3 2\n"
+    "f 5 6 7 8\n"
+    "f 1 5 8 4\n"
+    "f 2 3 7 6\n"
+    "f 4 8 7 3\n"
+    "f 1 2 6 5\n";
+
+class ScopedTempDirectory {
+  public:
+    ScopedTempDirectory() {
+        const auto uniqueSuffix = std::chrono::steady_clock::now().time_since_epoch().count();
+        m_path_ = std::filesystem::temp_directory_path() /
+                  ("retrorenderer-animation-export-" + std::to_string(uniqueSuffix));
+        std::filesystem::create_directories(m_path_);
+    }
+
+    ~ScopedTempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path_, ec);
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const {
+        return m_path_;
+    }
+
+  private:
+    std::filesystem::path m_path_;
+};
+
+// Built-in materials resolve relative to the working directory, as in the editor.
+class ScopedWorkingDirectory {
+  public:
+    explicit ScopedWorkingDirectory(const std::filesystem::path& path)
+        : m_previous_(std::filesystem::current_path()) {
+        std::filesystem::current_path(path);
+    }
+
+    ~ScopedWorkingDirectory() {
+        std::error_code ec;
+        std::filesystem::current_path(m_previous_, ec);
+    }
+
+  private:
+    std::filesystem::path m_previous_;
+};
+
+// A spinning cube over a three-frame clip, wired up the same way the editor does it.
+class ExportFixture {
+  public:
+    explicit ExportFixture(const std::filesystem::path& scenePath)
+        : m_Config(std::make_shared<Config>()),
+          m_Stats(std::make_shared<Stats>()),
+          m_RenderSystem(m_Config, m_Stats, m_MaterialManager) {
+        m_Config->renderer.selectedRenderer = Config::RendererType::SOFTWARE;
+        m_Config->renderer.resolution = glm::ivec2(64, 48);
+        REQUIRE(m_RenderSystem.Init());
+        m_SceneManager.BindDependencies(m_Config, m_RenderSystem);
+        m_MaterialManager.BindRenderServices(m_RenderSystem);
+        m_MaterialManager.BindSceneAccessor([this]() { return m_SceneManager.GetScene(); });
+        REQUIRE(m_MaterialManager.Init());
+        REQUIRE(m_SceneManager.LoadScene(scenePath.string()));
+        m_RenderSystem.OnLoadScene(SceneLoadEvent{scenePath.string()});
+
+        m_SceneManager.SetAnimationFrameRange(0, 2);
+        m_SceneManager.SetAnimationPlayheadFrame(0);
+        REQUIRE(m_SceneManager.AddAnimationKeyForCurrentFrame(0, TransformPose{}));
+        m_SceneManager.SetAnimationPlayheadFrame(2);
+        TransformPose turned{};
+        turned.rotationEulerDegrees = glm::vec3(20.0f, 60.0f, 0.0f);
+        REQUIRE(m_SceneManager.AddAnimationKeyForCurrentFrame(0, turned));
+    }
+
+    ~ExportFixture() {
+        m_RenderSystem.Destroy();
+    }
+
+    SceneManager& GetSceneManager() {
+        return m_SceneManager;
+    }
+
+    RenderSystem& GetRenderSystem() {
+        return m_RenderSystem;
+    }
+
+  private:
+    std::shared_ptr<Config> m_Config;
+    std::shared_ptr<Stats> m_Stats;
+    MaterialManager m_MaterialManager;
+    RenderSystem m_RenderSystem;
+    SceneManager m_SceneManager;
+};
+
+std::vector<char> ReadFileBytes(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+size_t CountFiles(const std::filesystem::path& directory) {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        count += entry.is_regular_file() ? 1 : 0;
+    }
+    return count;
+}
+} // namespace
+
+TEST_CASE("Animation export writes every clip frame deterministically", "[animation-export]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path scenePath = tempDirectory.path() / "cube.obj";
+    {
+        std::ofstream file(scenePath, std::ios::binary);
+        file << kCubeObj;
+    }
+    const ScopedWorkingDirectory workingDirectory(RETRO_SOURCE_DIR);
+    ExportFixture fixture(scenePath);
+    SceneManager& sceneManager = fixture.GetSceneManager();
+    sceneManager.SetAnimationPlayheadFrame(1.375);
+
+    AnimationExportSettings settings{};
+    settings.format = ImageSequenceFormat::PPM;
+    settings.workerCount = 2;
+    settings.outputDirectory = tempDirectory.path() / "first";
+    AnimationExportResult first{};
+    REQUIRE(ExportAnimationSequence(sceneManager, fixture.GetRenderSystem(), settings, first));
+    settings.outputDirectory = tempDirectory.path() / "second";
+    AnimationExportResult second{};
+    REQUIRE(ExportAnimationSequence(sceneManager, fixture.GetRenderSystem(), settings, second));
+
+    CHECK(first.framesWritten == 3);
+    CHECK(second.framesWritten == 3);
+    CHECK(CountFiles(tempDirectory.path() / "first") == 3);
+    CHECK(sceneManager.GetAnimationPlayheadFrame() == 1.375);
+
+    std::vector<char> previousFrame;
+    for (const char* name : {"frame_00000.ppm", "frame_00001.ppm", "frame_00002.ppm"}) {
+        const std::vector<char> firstBytes = ReadFileBytes(tempDirectory.path() / "first" / name);
+        REQUIRE_FALSE(firstBytes.empty());
+        CHECK(firstBytes == ReadFileBytes(tempDirectory.path() / "second" / name));
+        CHECK(firstBytes != previousFrame);
+        previousFrame = firstBytes;
+    }
+}
+
+TEST_CASE("Animation export job can be cancelled and keeps the live playhead", "[animation-export]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path scenePath = tempDirectory.path() / "cube.obj";
+    {
+        std::ofstream file(scenePath, std::ios::binary);
+        file << kCubeObj;
+    }
+    const ScopedWorkingDirectory workingDirectory(RETRO_SOURCE_DIR);
+    ExportFixture fixture(scenePath);
+    SceneManager& sceneManager = fixture.GetSceneManager();
+    sceneManager.SetAnimationPlayheadFrame(0.5);
+
+    AnimationExportSettings settings{};
+    settings.format = ImageSequenceFormat::PPM;
+    settings.workerCount = 1;
+    settings.outputDirectory = tempDirectory.path() / "frames";
+    AnimationExportJob job;
+    std::string errorMessage;
+    REQUIRE(job.Start(sceneManager, fixture.GetRenderSystem(), settings, errorMessage));
+    CHECK(job.IsRunning());
+    CHECK(job.GetFrameCount() == 3);
+    CHECK_FALSE(job.Start(sceneManager, fixture.GetRenderSystem(), settings, errorMessage));
+
+    job.Tick();
+    CHECK(sceneManager.GetAnimationPlayheadFrame() == 0.5);
+    job.Cancel();
+    CHECK_FALSE(job.IsRunning());
+    CHECK_FALSE(job.Succeeded());
+    CHECK(job.GetResult().errorMessage == "Export cancelled.");
+    CHECK(job.GetFramesWritten() < 3);
+    CHECK(sceneManager.GetAnimationPlayheadFrame() == 0.5);
+}
+
+TEST_CASE("Animation export keeps an unkeyed preview pose", "[animation-export]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path scenePath = tempDirectory.path() / "cube.obj";
+    {
+        std::ofstream file(scenePath, std::ios::binary);
+        file << kCubeObj;
+    }
+    const ScopedWorkingDirectory workingDirectory(RETRO_SOURCE_DIR);
+    ExportFixture fixture(scenePath);
+    SceneManager& sceneManager = fixture.GetSceneManager();
+    sceneManager.SetAnimationPlayheadFrame(1);
+    TransformPose preview{};
+    preview.translation = glm::vec3(0.0f, 1.5f, 0.0f);
+    sceneManager.SetAnimationPreviewPoseForCurrentFrame(0, preview);
+
+    AnimationExportSettings settings{};
+    settings.format = ImageSequenceFormat::PPM;
+    settings.workerCount = 2;
+    settings.outputDirectory = tempDirectory.path() / "frames";
+    AnimationExportResult result{};
+    REQUIRE(ExportAnimationSequence(sceneManager, fixture.GetRenderSystem(), settings, result));
+
+    CHECK(result.framesWritten == 3);
+    CHECK(sceneManager.GetAnimationPlayheadFrame() == 1.0);
+    CHECK(sceneManager.GetEditableAnimationPoseForModel(0).translation == preview.translation);
+}
+} // namespace RetroRenderer
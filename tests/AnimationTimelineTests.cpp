@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Scene/AnimationTimeline.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+
+namespace RetroRenderer {
+namespace {
+AnimationTrack MakeTrack(int keyCount) {
+    AnimationTrack track{};
+    track.nodePath = "0";
+    for (int i = 0; i < keyCount; i++) {
+        TransformKeyframe key{};
+        key.frame = i * 4;
+        key.pose.translation = glm::vec3(static_cast<float>(i), 0.0f, static_cast<float>(-i));
+        key.pose.rotationEulerDegrees = glm::vec3(0.0f, static_cast<float>((i * 37) % 180), 10.0f);
+        key.pose.scale = glm::vec3(1.0f + 0.25f * static_cast<float>(i % 3));
+        track.keys.push_back(key);
+    }
+    return track;
+}
+
+glm::mat4 PoseToMatrix(const TransformPose& pose) {
+    glm::mat4 matrix = glm::translate(glm::mat4(1.0f), pose.translation);
+    matrix *= glm::mat4_cast(glm::quat(glm::radians(pose.rotationEulerDegrees)));
+    return glm::scale(matrix, pose.scale);
+}
+
+bool MatricesNearlyEqual(const glm::mat4& lhs, const glm::mat4& rhs) {
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            if (std::abs(lhs[column][row] - rhs[column][row]) > 1e-4f) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("Compiled animation tracks match pose sampling", "[scene][animation]") {
+    const AnimationTrack track = MakeTrack(64);
+    CompiledAnimationTrack compiled = CompileAnimationTrack(track);
+    REQUIRE(compiled.frames.size() == track.keys.size());
+
+    // Forward playback exercises the cursor, the reversed pass forces binary-search seeks.
+    for (double frame = -2.0; frame <= 260.0; frame += 0.75) {
+        const glm::mat4 expected = PoseToMatrix(SampleAnimationTrackPose(track, frame, TransformPose{}));
+        CHECK(MatricesNearlyEqual(SampleCompiledAnimationTrack(compiled, frame), expected));
+    }
+    for (double frame = 255.5; frame >= 0.0; frame -= 9.25) {
+        const glm::mat4 expected = PoseToMatrix(SampleAnimationTrackPose(track, frame, TransformPose{}));
+        CHECK(MatricesNearlyEqual(SampleCompiledAnimationTrack(compiled, frame), expected));
+    }
+}
+
+TEST_CASE("Animation key lookup finds exact frames only", "[scene][animation]") {
+    const AnimationTrack track = MakeTrack(16);
+    CHECK(FindAnimationKeyIndex(track, 0) == 0);
+    CHECK(FindAnimationKeyIndex(track, 36) == 9);
+    CHECK(FindAnimationKeyIndex(track, 37) == -1);
+    CHECK(FindAnimationKeyIndex(track, 1000) == -1);
+}
+
+} // namespace RetroRenderer
@@ -3,14 +3,17 @@
 #include "Base/Stats.h"
 #include "Base/Config.h"
 #include "Renderer/Buffer.h"
+#include "Renderer/RetroPalette.h"
 #include "Renderer/Software/Rasterizer.h"
 #include "Scene/ImportedSceneData.h"
 #include "Scene/LightweightObjSceneImporter.h"
+#include "Scene/Texture.h"
 
 #include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
@@ -92,6 +95,17 @@ bool ImportAndRasterize(const std::string& objText, uint64_t& outHash) {
     outHash = hash;
     return true;
 }
+
+std::vector<Pixel> MakeShiftedGradientPixels(int size, int shift) {
+    std::vector<Pixel> pixels(static_cast<size_t>(size) * static_cast<size_t>(size));
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            pixels[static_cast<size_t>(y) * static_cast<size_t>(size) + static_cast<size_t>(x)] =
+                Pixel{static_cast<uint8_t>(x + shift), static_cast<uint8_t>(y * 3), static_cast<uint8_t>((x ^ y) + shift), 255};
+        }
+    }
+    return pixels;
+}
 } // namespace
 
 TEST_CASE("Lightweight OBJ importer can be used concurrently across threads", "[concurrency][importer]") {
@@ -164,6 +178,50 @@ TEST_CASE("Importer+rasterizer pipeline stays deterministic under concurrent exe
     }
 }
 
+TEST_CASE("Custom palette snapshots are shared per revision and safe to resolve concurrently", "[concurrency][palette]") {
+    Config::RetroStyleSettings retro{};
+    retro.palette = Config::PaletteType::CUSTOM;
+    retro.customPaletteRevision = 7;
+    retro.customPalette[3] = Pixel{12, 200, 40, 255};
+
+    const RetroPalette::PaletteSnapshot snapshot = RetroPalette::AcquirePaletteSnapshot(retro);
+    REQUIRE(snapshot != nullptr);
+    CHECK(snapshot->customRevision == 7);
+    CHECK(RetroPalette::AcquirePaletteSnapshot(retro) == snapshot);
+    CHECK(RetroPalette::FindNearestPaletteIndex(12, 200, 40, *snapshot) == 3);
+    CHECK(RetroPalette::FindNearestPaletteIndex(12, 200, 40, retro) == 3);
+
+    constexpr int kThreads = 8;
+    constexpr int kIterations = 200;
+    std::atomic<int> mismatches = 0;
+    std::vector<std::thread> workers;
+    workers.reserve(kThreads);
+    for (int t = 0; t < kThreads; t++) {
+        workers.emplace_back([t, &mismatches]() {
+            // Each thread flips between two revisions so the shared cache is rebuilt while others read it.
+            Config::RetroStyleSettings local{};
+            local.palette = Config::PaletteType::CUSTOM;
+            for (int i = 0; i < kIterations; i++) {
+                const bool useGreen = ((i + t) & 1) == 0;
+                local.customPaletteRevision = useGreen ? 100 : 101;
+                local.customPalette[5] = useGreen ? Pixel{10, 220, 30, 255} : Pixel{220, 10, 200, 255};
+                const RetroPalette::PaletteSnapshot frame = RetroPalette::AcquirePaletteSnapshot(local);
+                const Color& color = RetroPalette::GetPaletteColor(*frame, 5);
+                if (frame->customRevision != local.customPaletteRevision || color.g != (useGreen ? 220 : 10)) {
+                    mismatches.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    CHECK(mismatches.load(std::memory_order_relaxed) == 0);
+    // Earlier snapshots stay valid after the cache moved on to other revisions.
+    CHECK(RetroPalette::GetPaletteColor(*snapshot, 3).g == 200);
+}
+
 TEST_CASE("Software async stats atomics accumulate correctly under contention", "[concurrency][stats]") {
     Stats stats{};
     constexpr int kThreads = 8;
@@ -196,4 +254,91 @@ TEST_CASE("Software async stats atomics accumulate correctly under contention",
     REQUIRE(stats.swFramesReplacedReady.load(std::memory_order_relaxed) == expected);
 }
 
+TEST_CASE("Stage histograms stay consistent when recorded from several threads", "[concurrency][stats]") {
+    StageHistogram histogram(256);
+    constexpr int kThreads = 8;
+    constexpr int kIterations = 10000;
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistentSummaries{0};
+    std::thread reader([&]() {
+        while (!done.load(std::memory_order_acquire)) {
+            const StageTimingSummary summary = histogram.Summarize();
+            if (summary.sampleCount > 256 ||
+                (summary.sampleCount > 0 && (summary.minNs > summary.medianNs || summary.p99Ns > summary.maxNs))) {
+                inconsistentSummaries.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    std::vector<std::thread> workers;
+    workers.reserve(kThreads);
+    for (int t = 0; t < kThreads; t++) {
+        workers.emplace_back([&histogram, t]() {
+            for (int i = 0; i < kIterations; i++) {
+                histogram.Record(static_cast<uint64_t>(1000 + t * 100 + i % 100));
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    CHECK(inconsistentSummaries.load(std::memory_order_relaxed) == 0);
+    const StageTimingSummary summary = histogram.Summarize();
+    CHECK(summary.sampleCount == 256);
+    CHECK(summary.minNs >= 1000);
+    CHECK(summary.maxNs < 1000 + kThreads * 100);
+}
+
+TEST_CASE("Texture sampling caches build once per texture from several threads", "[concurrency][texture]") {
+    // Large enough for the palette histogram to run its own workers while other threads wait on the same texture.
+    constexpr int kSize = 300;
+    constexpr int kTextureCount = 4;
+    std::vector<std::shared_ptr<Texture>> textures;
+    for (int i = 0; i < kTextureCount; i++) {
+        auto texture = std::make_shared<Texture>();
+        REQUIRE(texture->LoadFromPixels(MakeShiftedGradientPixels(kSize, i * 40), kSize, kSize));
+        textures.push_back(std::move(texture));
+    }
+    Texture reference;
+    REQUIRE(reference.LoadFromPixels(MakeShiftedGradientPixels(kSize, 0), kSize, kSize));
+    reference.EnsureAutoPalette();
+
+    constexpr int kThreads = 8;
+    std::vector<std::thread> workers;
+    workers.reserve(kThreads);
+    for (int t = 0; t < kThreads; t++) {
+        workers.emplace_back([t, &textures]() {
+            for (int i = 0; i < kTextureCount; i++) {
+                const Texture& texture = *textures[static_cast<size_t>((i + t) % kTextureCount)];
+                texture.EnsureTiledLayout();
+                texture.EnsureMipChain();
+                texture.EnsureAutoPalette();
+                (void)texture.GetReducedIndexedLevel(32);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (const std::shared_ptr<Texture>& texture : textures) {
+        CHECK(texture->HasTiledLayout());
+        CHECK(texture->GetMipLevelCount() == 9);
+        CHECK(texture->HasIndexedPixels());
+        CHECK(texture->GetReducedIndexedLevel(32) != nullptr);
+    }
+    const auto& palette = textures[0]->GetAutoPalettePixels();
+    const auto& referencePalette = reference.GetAutoPalettePixels();
+    for (size_t i = 0; i < palette.size(); i++) {
+        CHECK(PixelsEqual(palette[i], referencePalette[i]));
+    }
+
+    // A moved texture gets its own cache lock and keeps working.
+    Texture moved = std::move(*textures[1]);
+    CHECK(moved.HasAutoPalette());
+    CHECK(moved.GetAutoPaletteBuildNs() > 0);
+}
+
 } // namespace RetroRenderer
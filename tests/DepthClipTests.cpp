@@ -0,0 +1,62 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Renderer/Software/DepthClip.h"
+
+#include <array>
+#include <cstddef>
+
+namespace RetroRenderer {
+namespace {
+ClipVertex MakeClipVertex(float x, float y, float z, float w) {
+    ClipVertex vertex{};
+    vertex.clipPosition = glm::vec4(x, y, z, w);
+    vertex.texCoords = glm::vec2(z, 0.0f);
+    return vertex;
+}
+} // namespace
+
+TEST_CASE("Depth clipping keeps triangles inside both planes unchanged", "[renderer][clip]") {
+    const std::array<ClipVertex, 3> triangle = {
+        MakeClipVertex(-0.5f, -0.5f, 0.0f, 1.0f),
+        MakeClipVertex(0.5f, -0.5f, 0.5f, 1.0f),
+        MakeClipVertex(0.0f, 0.5f, -0.5f, 1.0f),
+    };
+
+    const ClippedPolygon clipped = ClipPolygonDepthClipSpace(triangle);
+    REQUIRE(clipped.count == 3);
+    for (size_t i = 0; i < 3; i++) {
+        CHECK(clipped.vertices[i].clipPosition == triangle[i].clipPosition);
+    }
+}
+
+TEST_CASE("Depth clipping cuts a triangle crossing the near plane into a quad on the plane", "[renderer][clip]") {
+    const std::array<ClipVertex, 3> triangle = {
+        MakeClipVertex(-0.5f, -0.5f, -2.0f, 1.0f),
+        MakeClipVertex(0.5f, -0.5f, 0.0f, 1.0f),
+        MakeClipVertex(0.0f, 0.5f, 0.0f, 1.0f),
+    };
+
+    const ClippedPolygon clipped = ClipPolygonDepthClipSpace(triangle);
+    REQUIRE(clipped.count == 4);
+    size_t onNearPlane = 0;
+    for (size_t i = 0; i < clipped.count; i++) {
+        const ClipVertex& vertex = clipped.vertices[i];
+        CHECK(vertex.clipPosition.z >= -vertex.clipPosition.w - kClipEpsilon);
+        if (vertex.clipPosition.z == Catch::Approx(-1.0f)) {
+            // Attributes are interpolated along with the position.
+            CHECK(vertex.texCoords.x == Catch::Approx(-1.0f));
+            onNearPlane++;
+        }
+    }
+    CHECK(onNearPlane == 2);
+
+    const std::array<ClipVertex, 3> behind = {
+        MakeClipVertex(-0.5f, -0.5f, -2.0f, 1.0f),
+        MakeClipVertex(0.5f, -0.5f, -3.0f, 1.0f),
+        MakeClipVertex(0.0f, 0.5f, -2.5f, 1.0f),
+    };
+    CHECK(ClipPolygonDepthClipSpace(behind).count == 0);
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Base/FrameTrace.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#if RETRO_TRACE_ZONES
+namespace RetroRenderer {
+namespace {
+
+std::filesystem::path MakeTracePath() {
+    const auto uniqueSuffix = std::chrono::steady_clock::now().time_since_epoch().count();
+    return std::filesystem::temp_directory_path() / ("retrorenderer-trace-" + std::to_string(uniqueSuffix) + ".json");
+}
+
+nlohmann::json WriteAndParseTrace() {
+    const std::filesystem::path path = MakeTracePath();
+    std::string error;
+    REQUIRE(FrameTrace::WriteChromeTrace(path, error));
+    std::ifstream input(path);
+    nlohmann::json trace = nlohmann::json::parse(input);
+    input.close();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return trace;
+}
+
+size_t CountZones(const nlohmann::json& trace, const std::string& name) {
+    size_t count = 0;
+    for (const nlohmann::json& event : trace.at("traceEvents")) {
+        if (event.at("ph") == "X" && event.at("name") == name) {
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("Trace zones are only recorded while tracing is enabled", "[trace]") {
+    FrameTrace::Clear();
+    FrameTrace::SetEnabled(false);
+    {
+        RETRO_TRACE_ZONE("trace-test disabled");
+    }
+
+    FrameTrace::SetEnabled(true);
+    {
+        RETRO_TRACE_ZONE("trace-test outer");
+        {
+            RETRO_TRACE_ZONE("trace-test inner");
+        }
+    }
+    FrameTrace::SetEnabled(false);
+
+    const nlohmann::json trace = WriteAndParseTrace();
+    CHECK(CountZones(trace, "trace-test disabled") == 0);
+    CHECK(CountZones(trace, "trace-test outer") == 1);
+    CHECK(CountZones(trace, "trace-test inner") == 1);
+
+    double outerStart = 0.0;
+    double outerEnd = 0.0;
+    double innerStart = 0.0;
+    double innerEnd = 0.0;
+    for (const nlohmann::json& event : trace.at("traceEvents")) {
+        if (event.at("ph") != "X") {
+            continue;
+        }
+        const double start = event.at("ts").get<double>();
+        const double end = start + event.at("dur").get<double>();
+        if (event.at("name") == "trace-test outer") {
+            outerStart = start;
+            outerEnd = end;
+        } else if (event.at("name") == "trace-test inner") {
+            innerStart = start;
+            innerEnd = end;
+        }
+    }
+    CHECK(innerStart >= outerStart);
+    CHECK(innerEnd <= outerEnd + 0.001);
+
+    FrameTrace::Clear();
+    CHECK(CountZones(WriteAndParseTrace(), "trace-test outer") == 0);
+}
+
+TEST_CASE("Trace zones from other threads land in named lanes and the ring keeps the newest", "[trace]") {
+    FrameTrace::Clear();
+    FrameTrace::SetEnabled(true);
+    constexpr size_t kZoneCount = FrameTrace::kEventsPerThread + 100;
+    std::thread worker([]() {
+        FrameTrace::SetThreadName("trace-test worker");
+        for (size_t i = 0; i < kZoneCount; i++) {
+            RETRO_TRACE_ZONE("trace-test worker zone");
+        }
+    });
+    worker.join();
+    FrameTrace::SetEnabled(false);
+
+    const nlohmann::json trace = WriteAndParseTrace();
+    CHECK(CountZones(trace, "trace-test worker zone") == FrameTrace::kEventsPerThread);
+
+    bool foundLane = false;
+    for (const nlohmann::json& event : trace.at("traceEvents")) {
+        if (event.at("ph") == "M" && event.at("name") == "thread_name" &&
+            event.at("args").at("name") == "trace-test worker") {
+            foundLane = true;
+        }
+    }
+    CHECK(foundLane);
+    FrameTrace::Clear();
+}
+
+} // namespace RetroRenderer
+#endif
@@ -2,12 +2,17 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <limits>
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace RetroRenderer::TestGolden {
 
@@ -90,4 +95,183 @@ inline bool SaveGoldenHashes(const std::string& filePath, const std::map<std::st
     return file.good();
 }
 
+// Tightly packed 8-bit RGBA, row-major from the top row.
+struct GoldenImage {
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<uint8_t> rgba;
+};
+
+// Same FNV-1a over r, g, b, a per pixel as the committed hash baselines.
+inline uint64_t HashGoldenImage(const GoldenImage& image) {
+    uint64_t hash = 1469598103934665603ull;
+    constexpr uint64_t prime = 1099511628211ull;
+    for (const uint8_t channel : image.rgba) {
+        hash ^= static_cast<uint64_t>(channel);
+        hash *= prime;
+    }
+    return hash;
+}
+
+// Reference images are binary PAM (P7, RGB_ALPHA) so the cleared alpha survives the round trip; GIMP, ImageMagick
+// and netpbm open them directly.
+inline bool SaveGoldenImage(const std::filesystem::path& filePath, const GoldenImage& image) {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "P7\nWIDTH " << image.width << "\nHEIGHT " << image.height
+         << "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+    file.write(reinterpret_cast<const char*>(image.rgba.data()), static_cast<std::streamsize>(image.rgba.size()));
+    return file.good();
+}
+
+inline bool LoadGoldenImage(const std::filesystem::path& filePath, GoldenImage& outImage) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string line;
+    if (!std::getline(file, line) || Trim(line) != "P7") {
+        return false;
+    }
+    size_t width = 0;
+    size_t height = 0;
+    int depth = 0;
+    int maxValue = 0;
+    while (std::getline(file, line)) {
+        line = Trim(line);
+        if (line == "ENDHDR") {
+            break;
+        }
+        std::istringstream fields(line);
+        std::string field;
+        fields >> field;
+        if (field == "WIDTH") {
+            fields >> width;
+        } else if (field == "HEIGHT") {
+            fields >> height;
+        } else if (field == "DEPTH") {
+            fields >> depth;
+        } else if (field == "MAXVAL") {
+            fields >> maxValue;
+        }
+    }
+    if (width == 0 || height == 0 || depth != 4 || maxValue != 255) {
+        return false;
+    }
+    outImage.width = width;
+    outImage.height = height;
+    outImage.rgba.resize(width * height * 4);
+    file.read(reinterpret_cast<char*>(outImage.rgba.data()), static_cast<std::streamsize>(outImage.rgba.size()));
+    return static_cast<size_t>(file.gcount()) == outImage.rgba.size();
+}
+
+// How far a rendering may drift from its reference image. The defaults only accept an identical image.
+struct GoldenImageTolerance {
+    // Channel differences up to this much do not make a pixel count as differing.
+    uint8_t channelThreshold = 0;
+    size_t maxDifferingPixels = 0;
+    uint8_t maxChannelError = 255;
+    // 0 disables the PSNR check.
+    double minPsnrDb = 0.0;
+};
+
+struct GoldenImageDiff {
+    bool sizeMatches = false;
+    size_t differingPixels = 0;
+    uint8_t maxChannelError = 0;
+    // Over all four channels; infinite for identical images.
+    double psnrDb = std::numeric_limits<double>::infinity();
+};
+
+inline GoldenImageDiff CompareGoldenImages(const GoldenImage& reference,
+                                           const GoldenImage& actual,
+                                           const GoldenImageTolerance& tolerance = {}) {
+    GoldenImageDiff diff{};
+    diff.sizeMatches = reference.width == actual.width && reference.height == actual.height &&
+                       reference.rgba.size() == actual.rgba.size();
+    if (!diff.sizeMatches) {
+        diff.psnrDb = 0.0;
+        return diff;
+    }
+    double squaredErrorSum = 0.0;
+    for (size_t pixel = 0; pixel + 3 < reference.rgba.size(); pixel += 4) {
+        int pixelError = 0;
+        for (size_t channel = 0; channel < 4; channel++) {
+            const int error = std::abs(static_cast<int>(reference.rgba[pixel + channel]) -
+                                       static_cast<int>(actual.rgba[pixel + channel]));
+            pixelError = std::max(pixelError, error);
+            squaredErrorSum += static_cast<double>(error * error);
+        }
+        if (pixelError > tolerance.channelThreshold) {
+            diff.differingPixels++;
+        }
+        diff.maxChannelError = std::max(diff.maxChannelError, static_cast<uint8_t>(pixelError));
+    }
+    if (squaredErrorSum > 0.0) {
+        const double meanSquaredError = squaredErrorSum / static_cast<double>(reference.rgba.size());
+        diff.psnrDb = 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+    }
+    return diff;
+}
+
+inline bool IsWithinTolerance(const GoldenImageDiff& diff, const GoldenImageTolerance& tolerance) {
+    return diff.sizeMatches && diff.differingPixels <= tolerance.maxDifferingPixels &&
+           diff.maxChannelError <= tolerance.maxChannelError &&
+           (tolerance.minPsnrDb <= 0.0 || diff.psnrDb >= tolerance.minPsnrDb);
+}
+
+inline std::string DescribeGoldenImageDiff(const GoldenImageDiff& diff, size_t pixelCount) {
+    if (!diff.sizeMatches) {
+        return "image size differs from the reference";
+    }
+    std::ostringstream description;
+    description << diff.differingPixels << " of " << pixelCount << " pixels differ, max channel error "
+                << static_cast<int>(diff.maxChannelError) << ", PSNR ";
+    if (std::isinf(diff.psnrDb)) {
+        description << "inf";
+    } else {
+        description << diff.psnrDb << " dB";
+    }
+    return description.str();
+}
+
+// Binary PPM: matching pixels as a dimmed grey copy of the reference, differing ones in red scaled by their error so
+// even single-step drift stands out.
+inline bool SaveGoldenDiffImage(const std::filesystem::path& filePath,
+                                const GoldenImage& reference,
+                                const GoldenImage& actual,
+                                const GoldenImageTolerance& tolerance = {}) {
+    if (reference.width != actual.width || reference.height != actual.height ||
+        reference.rgba.size() != actual.rgba.size()) {
+        return false;
+    }
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "P6\n" << reference.width << " " << reference.height << "\n255\n";
+    std::vector<uint8_t> rgb;
+    rgb.reserve(reference.width * reference.height * 3);
+    for (size_t pixel = 0; pixel + 3 < reference.rgba.size(); pixel += 4) {
+        int pixelError = 0;
+        for (size_t channel = 0; channel < 4; channel++) {
+            pixelError = std::max(pixelError,
+                                  std::abs(static_cast<int>(reference.rgba[pixel + channel]) -
+                                           static_cast<int>(actual.rgba[pixel + channel])));
+        }
+        if (pixelError > tolerance.channelThreshold) {
+            rgb.push_back(static_cast<uint8_t>(std::min(255, 128 + pixelError)));
+            rgb.push_back(0);
+            rgb.push_back(0);
+            continue;
+        }
+        const int grey = (reference.rgba[pixel] + reference.rgba[pixel + 1] + reference.rgba[pixel + 2]) / 9;
+        rgb.insert(rgb.end(), 3, static_cast<uint8_t>(grey));
+    }
+    file.write(reinterpret_cast<const char*>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+    return file.good();
+}
+
 } // namespace RetroRenderer::TestGolden
@@ -8,13 +8,18 @@
 #include "Scene/LightweightObjSceneImporter.h"
 
 #include <array>
+#include <cmath>
 #include <cstdlib>
 #include <cstdint>
+#include <filesystem>
 #include <string>
+#include <system_error>
 
 namespace RetroRenderer {
 namespace {
 constexpr const char* kGoldenHashFile = RETRO_GOLDEN_HASH_FILE;
+constexpr const char* kGoldenImageDirectory = RETRO_GOLDEN_IMAGE_DIR;
+constexpr const char* kGoldenDiffDirectory = RETRO_GOLDEN_DIFF_DIR;
 
 std::string CurrentPlatformTag() {
 #if defined(_WIN32)
@@ -65,30 +70,25 @@ Config MakePipelineConfig(bool depthTest, bool rasterClip, bool backfaceCulling
     return config;
 }
 
-uint64_t HashFramebuffer(const Buffer<Pixel>& framebuffer) {
-    uint64_t hash = 1469598103934665603ull;
-    constexpr uint64_t prime = 1099511628211ull;
+TestGolden::GoldenImage CaptureFramebuffer(const Buffer<Pixel>& framebuffer) {
+    TestGolden::GoldenImage image;
+    image.width = framebuffer.width;
+    image.height = framebuffer.height;
     const size_t pixelCount = framebuffer.width * framebuffer.height;
+    image.rgba.reserve(pixelCount * 4);
     for (size_t i = 0; i < pixelCount; i++) {
         const Pixel& p = framebuffer.data[i];
-        hash ^= static_cast<uint64_t>(p.r);
-        hash *= prime;
-        hash ^= static_cast<uint64_t>(p.g);
-        hash *= prime;
-        hash ^= static_cast<uint64_t>(p.b);
-        hash *= prime;
-        hash ^= static_cast<uint64_t>(p.a);
-        hash *= prime;
+        image.rgba.insert(image.rgba.end(), {p.r, p.g, p.b, p.a});
     }
-    return hash;
+    return image;
 }
 
-bool RenderScenarioToHash(const std::string& objText,
-                          bool depthTest,
-                          bool rasterClip,
-                          const std::array<Pixel, 4>& faceColors,
-                          uint64_t& outHash,
-                          bool backfaceCulling = false) {
+bool RenderScenario(const std::string& objText,
+                    bool depthTest,
+                    bool rasterClip,
+                    const std::array<Pixel, 4>& faceColors,
+                    TestGolden::GoldenImage& outImage,
+                    bool backfaceCulling = false) {
     LightweightObjSceneImporter importer;
     ImportedSceneData sceneData{};
     if (!importer.LoadFromMemory(reinterpret_cast<const uint8_t*>(objText.data()), objText.size(), sceneData)) {
@@ -120,28 +120,76 @@ bool RenderScenarioToHash(const std::string& objText,
         Rasterizer::DrawTriangle(framebuffer, depthBuffer, triangle, config, faceColors[face % faceColors.size()]);
     }
 
-    outHash = HashFramebuffer(framebuffer);
+    outImage = CaptureFramebuffer(framebuffer);
     return true;
 }
 
-void AssertGoldenHash(const std::string& key, uint64_t actualHash) {
+std::filesystem::path GoldenImagePath(const std::string& key) {
+    return std::filesystem::path(kGoldenImageDirectory) / (key + ".pam");
+}
+
+std::filesystem::path SaveActualImage(const std::string& platformKey, const TestGolden::GoldenImage& actualImage) {
+    const std::filesystem::path diffDirectory(kGoldenDiffDirectory);
+    std::error_code errorCode;
+    std::filesystem::create_directories(diffDirectory, errorCode);
+    const std::filesystem::path actualPath = diffDirectory / (platformKey + ".actual.pam");
+    TestGolden::SaveGoldenImage(actualPath, actualImage);
+    return actualPath;
+}
+
+// The rendering passes when it matches the reference image recorded with the same baseline key within the given
+// tolerance; otherwise the actual image and a diff image are written next to the test binary. The hash only guards
+// that the committed image is the one recorded with it, and decides on its own for keys without an image yet.
+void AssertGoldenImage(const std::string& key,
+                       const TestGolden::GoldenImage& actualImage,
+                       const TestGolden::GoldenImageTolerance& tolerance = {}) {
+    const uint64_t actualHash = TestGolden::HashGoldenImage(actualImage);
     auto hashes = TestGolden::LoadGoldenHashes(kGoldenHashFile);
     const std::string platformKey = PlatformKey(key);
     if (TestGolden::ShouldUpdateGoldens()) {
         hashes[platformKey] = actualHash;
         REQUIRE(TestGolden::SaveGoldenHashes(kGoldenHashFile, hashes));
         hashes = TestGolden::LoadGoldenHashes(kGoldenHashFile);
+        std::error_code errorCode;
+        std::filesystem::create_directories(kGoldenImageDirectory, errorCode);
+        REQUIRE(TestGolden::SaveGoldenImage(GoldenImagePath(platformKey), actualImage));
     }
 
     INFO("Golden hash file: " << kGoldenHashFile);
     INFO("Golden key: " << key);
     INFO("Platform key: " << platformKey);
-    auto it = hashes.find(platformKey);
-    if (it == hashes.end()) {
-        it = hashes.find(key); // Backward-compatible fallback to platform-agnostic baseline.
-    }
+    // Backward-compatible fallback to the platform-agnostic baseline; its image is stored under the same key.
+    const std::string baselineKey = hashes.count(platformKey) != 0 ? platformKey : key;
+    const auto it = hashes.find(baselineKey);
     REQUIRE(it != hashes.end());
-    REQUIRE(it->second == actualHash);
+
+    TestGolden::GoldenImage referenceImage;
+    const std::filesystem::path referencePath = GoldenImagePath(baselineKey);
+    INFO("Reference image: " << referencePath.generic_string());
+    if (!TestGolden::LoadGoldenImage(referencePath, referenceImage)) {
+        if (it->second == actualHash) {
+            WARN(key << " has no reference image and passed on its hash alone; record one with RETRO_UPDATE_GOLDENS=1.");
+            return;
+        }
+        INFO("Actual image: " << SaveActualImage(platformKey, actualImage).generic_string());
+        FAIL("Golden hash mismatch and no reference image; record one with RETRO_UPDATE_GOLDENS=1.");
+    }
+    REQUIRE(TestGolden::HashGoldenImage(referenceImage) == it->second);
+
+    const TestGolden::GoldenImageDiff diff = TestGolden::CompareGoldenImages(referenceImage, actualImage, tolerance);
+    const std::string description = TestGolden::DescribeGoldenImageDiff(diff, actualImage.width * actualImage.height);
+    if (TestGolden::IsWithinTolerance(diff, tolerance)) {
+        if (actualHash != it->second) {
+            WARN(key << " changed within tolerance: " << description);
+        }
+        return;
+    }
+
+    INFO("Actual image: " << SaveActualImage(platformKey, actualImage).generic_string());
+    const std::filesystem::path diffPath = std::filesystem::path(kGoldenDiffDirectory) / (platformKey + ".diff.ppm");
+    TestGolden::SaveGoldenDiffImage(diffPath, referenceImage, actualImage, tolerance);
+    INFO("Diff image: " << diffPath.generic_string());
+    FAIL("Golden image outside tolerance: " << description);
 }
 } // namespace
 
@@ -153,13 +201,13 @@ TEST_CASE("Golden software pipeline hash: simple triangle", "[golden][software]"
         "v 0.0 0.7 0.0\n"
         "f 1 2 3\n";
 
-    uint64_t actualHash = 0;
-    REQUIRE(RenderScenarioToHash(objText,
-                                 true,
-                                 true,
-                                 {Pixel{180, 220, 50, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
-                                 actualHash));
-    AssertGoldenHash("integration_triangle", actualHash);
+    TestGolden::GoldenImage actualImage;
+    REQUIRE(RenderScenario(objText,
+                           true,
+                           true,
+                           {Pixel{180, 220, 50, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
+                           actualImage));
+    AssertGoldenImage("integration_triangle", actualImage);
 }
 
 TEST_CASE("Golden software pipeline hash: depth overlap", "[golden][software]") {
@@ -174,13 +222,13 @@ TEST_CASE("Golden software pipeline hash: depth overlap", "[golden][software]")
         "f 1 2 3\n"
         "f 4 5 6\n";
 
-    uint64_t actualHash = 0;
-    REQUIRE(RenderScenarioToHash(objText,
-                                 true,
-                                 true,
-                                 {Pixel{255, 60, 60, 255}, Pixel{60, 60, 255, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
-                                 actualHash));
-    AssertGoldenHash("integration_depth", actualHash);
+    TestGolden::GoldenImage actualImage;
+    REQUIRE(RenderScenario(objText,
+                           true,
+                           true,
+                           {Pixel{255, 60, 60, 255}, Pixel{60, 60, 255, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
+                           actualImage));
+    AssertGoldenImage("integration_depth", actualImage);
 }
 
 TEST_CASE("Golden software pipeline hash: clipping", "[golden][software]") {
@@ -195,13 +243,13 @@ TEST_CASE("Golden software pipeline hash: clipping", "[golden][software]") {
         "f 1 2 3\n"
         "f 4 5 6\n";
 
-    uint64_t actualHash = 0;
-    REQUIRE(RenderScenarioToHash(objText,
-                                 false,
-                                 true,
-                                 {Pixel{255, 120, 0, 255}, Pixel{0, 220, 140, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
-                                 actualHash));
-    AssertGoldenHash("integration_clipping", actualHash);
+    TestGolden::GoldenImage actualImage;
+    REQUIRE(RenderScenario(objText,
+                           false,
+                           true,
+                           {Pixel{255, 120, 0, 255}, Pixel{0, 220, 140, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
+                           actualImage));
+    AssertGoldenImage("integration_clipping", actualImage);
 }
 
 TEST_CASE("Golden software pipeline hash: partial clipping", "[golden][software]") {
@@ -216,13 +264,13 @@ TEST_CASE("Golden software pipeline hash: partial clipping", "[golden][software]
         "f 1 2 3\n"
         "f 4 5 6\n";
 
-    uint64_t actualHash = 0;
-    REQUIRE(RenderScenarioToHash(objText,
-                                 false,
-                                 true,
-                                 {Pixel{255, 180, 40, 255}, Pixel{60, 230, 220, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
-                                 actualHash));
-    AssertGoldenHash("integration_partial_clipping", actualHash);
+    TestGolden::GoldenImage actualImage;
+    REQUIRE(RenderScenario(objText,
+                           false,
+                           true,
+                           {Pixel{255, 180, 40, 255}, Pixel{60, 230, 220, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
+                           actualImage));
+    AssertGoldenImage("integration_partial_clipping", actualImage);
 }
 
 TEST_CASE("Golden software pipeline hash: backface culling", "[golden][software]") {
@@ -234,14 +282,14 @@ TEST_CASE("Golden software pipeline hash: backface culling", "[golden][software]
         "f 1 2 3\n"
         "f 1 3 2\n";
 
-    uint64_t actualHash = 0;
-    REQUIRE(RenderScenarioToHash(objText,
-                                 false,
-                                 true,
-                                 {Pixel{250, 210, 60, 255}, Pixel{80, 90, 255, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
-                                 actualHash,
-                                 true));
-    AssertGoldenHash("integration_backface_culling", actualHash);
+    TestGolden::GoldenImage actualImage;
+    REQUIRE(RenderScenario(objText,
+                           false,
+                           true,
+                           {Pixel{250, 210, 60, 255}, Pixel{80, 90, 255, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
+                           actualImage,
+                           true));
+    AssertGoldenImage("integration_backface_culling", actualImage);
 }
 
 TEST_CASE("Golden software pipeline hash: degenerate face ignored", "[golden][software]") {
@@ -256,13 +304,13 @@ TEST_CASE("Golden software pipeline hash: degenerate face ignored", "[golden][so
         "f 1 2 3\n"
         "f 4 5 6\n";
 
-    uint64_t actualHash = 0;
-    REQUIRE(RenderScenarioToHash(objText,
-                                 false,
-                                 true,
-                                 {Pixel{255, 80, 20, 255}, Pixel{20, 200, 120, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
-                                 actualHash));
-    AssertGoldenHash("integration_degenerate_face", actualHash);
+    TestGolden::GoldenImage actualImage;
+    REQUIRE(RenderScenario(objText,
+                           false,
+                           true,
+                           {Pixel{255, 80, 20, 255}, Pixel{20, 200, 120, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
+                           actualImage));
+    AssertGoldenImage("integration_degenerate_face", actualImage);
 }
 
 TEST_CASE("Golden software pipeline hash: painter order without depth test", "[golden][software]") {
@@ -277,13 +325,13 @@ TEST_CASE("Golden software pipeline hash: painter order without depth test", "[g
         "f 1 2 3\n"
         "f 4 5 6\n";
 
-    uint64_t actualHash = 0;
-    REQUIRE(RenderScenarioToHash(objText,
-                                 false,
-                                 true,
-                                 {Pixel{255, 40, 40, 255}, Pixel{40, 120, 255, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
-                                 actualHash));
-    AssertGoldenHash("integration_painter_no_depth", actualHash);
+    TestGolden::GoldenImage actualImage;
+    REQUIRE(RenderScenario(objText,
+                           false,
+                           true,
+                           {Pixel{255, 40, 40, 255}, Pixel{40, 120, 255, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
+                           actualImage));
+    AssertGoldenImage("integration_painter_no_depth", actualImage);
 }
 
 TEST_CASE("Golden software pipeline hash: fan triangulation", "[golden][software]") {
@@ -295,13 +343,109 @@ TEST_CASE("Golden software pipeline hash: fan triangulation", "[golden][software
         "v -0.7 0.7 0.0\n"
         "f 1 2 3 4\n";
 
-    uint64_t actualHash = 0;
-    REQUIRE(RenderScenarioToHash(objText,
-                                 false,
-                                 true,
-                                 {Pixel{250, 70, 70, 255}, Pixel{70, 250, 120, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
-                                 actualHash));
-    AssertGoldenHash("integration_face_fan", actualHash);
+    TestGolden::GoldenImage actualImage;
+    REQUIRE(RenderScenario(objText,
+                           false,
+                           true,
+                           {Pixel{250, 70, 70, 255}, Pixel{70, 250, 120, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
+                           actualImage));
+    AssertGoldenImage("integration_face_fan", actualImage);
+}
+
+TEST_CASE("Golden tolerance absorbs one-step colour drift in a recorded render", "[golden][diff]") {
+    SkipGoldenOnUnsupportedPlatform();
+    const std::string objText =
+        "v -0.7 -0.7 0.0\n"
+        "v 0.7 -0.7 0.0\n"
+        "v 0.0 0.7 0.0\n"
+        "f 1 2 3\n";
+
+    TestGolden::GoldenImage reference;
+    REQUIRE(TestGolden::LoadGoldenImage(GoldenImagePath("integration_triangle"), reference));
+    TestGolden::GoldenImage drifted;
+    REQUIRE(RenderScenario(objText,
+                           true,
+                           true,
+                           {Pixel{181, 219, 50, 255}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}, Pixel{0, 0, 0, 0}},
+                           drifted));
+
+    const TestGolden::GoldenImageDiff exact = TestGolden::CompareGoldenImages(reference, drifted);
+    CHECK(exact.differingPixels > 0);
+    CHECK(exact.maxChannelError == 1);
+    CHECK_FALSE(TestGolden::IsWithinTolerance(exact, {}));
+
+    TestGolden::GoldenImageTolerance tolerance{};
+    tolerance.channelThreshold = 1;
+    const TestGolden::GoldenImageDiff tolerated = TestGolden::CompareGoldenImages(reference, drifted, tolerance);
+    CHECK(tolerated.differingPixels == 0);
+    CHECK(TestGolden::IsWithinTolerance(tolerated, tolerance));
+}
+
+TEST_CASE("Golden image diff reports differing pixels, max channel error and PSNR", "[golden][diff]") {
+    TestGolden::GoldenImage reference;
+    reference.width = 4;
+    reference.height = 2;
+    reference.rgba.assign(reference.width * reference.height * 4, 100);
+
+    CHECK(std::isinf(TestGolden::CompareGoldenImages(reference, reference).psnrDb));
+    CHECK(TestGolden::IsWithinTolerance(TestGolden::CompareGoldenImages(reference, reference), {}));
+
+    TestGolden::GoldenImage actual = reference;
+    actual.rgba[0] = 102;  // pixel 0, red +2
+    actual.rgba[13] = 90;  // pixel 3, green -10
+    const TestGolden::GoldenImageDiff diff = TestGolden::CompareGoldenImages(reference, actual);
+    CHECK(diff.sizeMatches);
+    CHECK(diff.differingPixels == 2);
+    CHECK(diff.maxChannelError == 10);
+    const double expectedPsnr = 10.0 * std::log10(255.0 * 255.0 / ((4.0 + 100.0) / 32.0));
+    CHECK(std::abs(diff.psnrDb - expectedPsnr) < 1e-9);
+    CHECK_FALSE(TestGolden::IsWithinTolerance(diff, {}));
+
+    TestGolden::GoldenImageTolerance tolerance{};
+    tolerance.channelThreshold = 2;
+    tolerance.maxDifferingPixels = 1;
+    CHECK(TestGolden::CompareGoldenImages(reference, actual, tolerance).differingPixels == 1);
+    CHECK(TestGolden::IsWithinTolerance(TestGolden::CompareGoldenImages(reference, actual, tolerance), tolerance));
+    tolerance.maxChannelError = 8;
+    CHECK_FALSE(TestGolden::IsWithinTolerance(TestGolden::CompareGoldenImages(reference, actual, tolerance), tolerance));
+    tolerance.maxChannelError = 255;
+    tolerance.minPsnrDb = expectedPsnr + 1.0;
+    CHECK_FALSE(TestGolden::IsWithinTolerance(TestGolden::CompareGoldenImages(reference, actual, tolerance), tolerance));
+
+    TestGolden::GoldenImage resized = reference;
+    resized.width = 2;
+    resized.height = 4;
+    CHECK_FALSE(TestGolden::CompareGoldenImages(reference, resized).sizeMatches);
+    CHECK_FALSE(TestGolden::IsWithinTolerance(TestGolden::CompareGoldenImages(reference, resized), {}));
+}
+
+TEST_CASE("Golden images round-trip through PAM and write diff images", "[golden][diff]") {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "retrorenderer_golden_image_tests";
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+
+    TestGolden::GoldenImage image;
+    image.width = 3;
+    image.height = 2;
+    for (size_t i = 0; i < image.width * image.height * 4; i++) {
+        image.rgba.push_back(static_cast<uint8_t>(i * 11));
+    }
+    REQUIRE(TestGolden::SaveGoldenImage(dir / "image.pam", image));
+    TestGolden::GoldenImage loaded;
+    REQUIRE(TestGolden::LoadGoldenImage(dir / "image.pam", loaded));
+    CHECK(loaded.width == image.width);
+    CHECK(loaded.height == image.height);
+    CHECK(loaded.rgba == image.rgba);
+    CHECK(TestGolden::HashGoldenImage(loaded) == TestGolden::HashGoldenImage(image));
+    CHECK_FALSE(TestGolden::LoadGoldenImage(dir / "missing.pam", loaded));
+
+    TestGolden::GoldenImage changed = image;
+    changed.rgba[4] ^= 0x40;
+    REQUIRE(TestGolden::SaveGoldenDiffImage(dir / "diff.ppm", image, changed));
+    CHECK(std::filesystem::file_size(dir / "diff.ppm") == std::string("P6\n3 2\n255\n").size() + 3 * 2 * 3);
+
+    std::filesystem::remove_all(dir, ec);
 }
 
 } // namespace RetroRenderer
@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Headless/HeadlessOptions.h"
+
+#include <string>
+#include <vector>
+
+namespace RetroRenderer {
+
+TEST_CASE("Headless arguments parse scene, output and render settings", "[headless]") {
+    HeadlessOptions options;
+    std::string error;
+    REQUIRE(ParseHeadlessArguments({"scenes/cube.obj",
+                                    "--output", "out",
+                                    "--format", "PPM",
+                                    "--preset", "ps1",
+                                    "--resolution", "320x240",
+                                    "--frames", "12",
+                                    "--warmup", "3",
+                                    "--no-scene-baseline",
+                                    "--frame-timings",
+                                    "--allocations",
+                                    "--trace", "trace.json"},
+                                   options,
+                                   error));
+    CHECK(options.scenePath == "scenes/cube.obj");
+    CHECK(options.outputDirectory == "out");
+    CHECK(options.format == ImageSequenceFormat::PPM);
+    REQUIRE(options.preset.has_value());
+    CHECK(*options.preset == Config::RenderPreset::PS1);
+    REQUIRE(options.resolution.has_value());
+    CHECK(options.resolution->x == 320);
+    CHECK(options.resolution->y == 240);
+    CHECK(options.frameCount == 12);
+    CHECK(options.warmupFrames == 3);
+    CHECK_FALSE(options.useSceneBaseline);
+    CHECK(options.printFrameTimings);
+    CHECK(options.trackAllocations);
+    REQUIRE(options.tracePath.has_value());
+    CHECK(*options.tracePath == "trace.json");
+}
+
+TEST_CASE("Headless arguments parse perf-regression mode", "[headless][perf]") {
+    HeadlessOptions options;
+    std::string error;
+    REQUIRE(ParseHeadlessArguments({"--perf-baseline", "perf.txt", "--perf-update", "--perf-tolerance", "10"},
+                                   options,
+                                   error));
+    REQUIRE(options.perfBaselinePath.has_value());
+    CHECK(*options.perfBaselinePath == "perf.txt");
+    CHECK(options.updatePerfBaseline);
+    CHECK(options.perfTolerance == 0.10);
+    CHECK(options.frameCount == 120);
+    CHECK(options.warmupFrames == 10);
+
+    HeadlessOptions dolly;
+    REQUIRE(ParseHeadlessArguments({"a.obj", "--camera-path", "dolly"}, dolly, error));
+    CHECK(dolly.cameraPath == HeadlessCameraPath::DOLLY);
+
+    CHECK_FALSE(ParseHeadlessArguments({"--perf-update"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"a.obj", "--perf-baseline", "perf.txt"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"a.obj", "--camera-path", "spiral"}, options, error));
+}
+
+TEST_CASE("Headless arguments parse packet capture and replay", "[headless][capture]") {
+    HeadlessOptions options;
+    std::string error;
+    REQUIRE(ParseHeadlessArguments({"a.obj", "--capture", "packets.rrcap"}, options, error));
+    REQUIRE(options.capturePath.has_value());
+    CHECK(*options.capturePath == "packets.rrcap");
+    CHECK_FALSE(options.replayPath.has_value());
+
+    HeadlessOptions replay;
+    REQUIRE(ParseHeadlessArguments({"--replay", "packets.rrcap", "--warmup", "2"}, replay, error));
+    REQUIRE(replay.replayPath.has_value());
+    CHECK(*replay.replayPath == "packets.rrcap");
+    CHECK(replay.frameCount == 0);
+    CHECK(replay.warmupFrames == 2);
+    REQUIRE(ParseHeadlessArguments({"--replay", "packets.rrcap", "--frames", "50", "--resolution", "320x240"},
+                                   replay,
+                                   error));
+    CHECK(replay.frameCount == 50);
+    REQUIRE(replay.resolution.has_value());
+
+    CHECK_FALSE(ParseHeadlessArguments({"a.obj", "--replay", "packets.rrcap"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"--replay", "packets.rrcap", "--preset", "ps1"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"--replay", "a.rrcap", "--capture", "b.rrcap"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"--replay", "packets.rrcap", "--perf-baseline", "perf.txt"}, options, error));
+}
+
+TEST_CASE("Headless arguments reject malformed input", "[headless]") {
+    HeadlessOptions options;
+    std::string error;
+    CHECK_FALSE(ParseHeadlessArguments({}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"a.obj", "b.obj"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"a.obj", "--frames"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"a.obj", "--frames", "0"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"a.obj", "--resolution", "320"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"a.obj", "--preset", "n64"}, options, error));
+    CHECK_FALSE(ParseHeadlessArguments({"a.obj", "--bogus", "1"}, options, error));
+    CHECK_FALSE(error.empty());
+
+    REQUIRE(ParseHeadlessArguments({"--help"}, options, error));
+    CHECK(options.showHelp);
+}
+
+} // namespace RetroRenderer
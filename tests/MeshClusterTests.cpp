@@ -0,0 +1,113 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Scene/MeshClusters.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace RetroRenderer {
+namespace {
+Vertex MakeVertex(float x, float y, float z) {
+    Vertex vertex{};
+    vertex.position = glm::vec4(x, y, z, 1.0f);
+    vertex.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+    vertex.texCoords = glm::vec2(0.0f);
+    vertex.color = glm::vec3(1.0f);
+    return vertex;
+}
+
+// Counter-clockwise quads on the z = 0 plane, so every face normal points along +Z.
+void BuildPlaneGrid(int cellsPerSide, std::vector<Vertex>& outVertices, std::vector<unsigned int>& outIndices) {
+    outVertices.clear();
+    outIndices.clear();
+    for (int y = 0; y <= cellsPerSide; y++) {
+        for (int x = 0; x <= cellsPerSide; x++) {
+            outVertices.push_back(MakeVertex(static_cast<float>(x), static_cast<float>(y), 0.0f));
+        }
+    }
+    const auto vertexIndex = [cellsPerSide](int x, int y) {
+        return static_cast<unsigned int>(y * (cellsPerSide + 1) + x);
+    };
+    for (int y = 0; y < cellsPerSide; y++) {
+        for (int x = 0; x < cellsPerSide; x++) {
+            outIndices.insert(outIndices.end(), {vertexIndex(x, y), vertexIndex(x + 1, y), vertexIndex(x + 1, y + 1)});
+            outIndices.insert(outIndices.end(), {vertexIndex(x, y), vertexIndex(x + 1, y + 1), vertexIndex(x, y + 1)});
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Mesh clusters cover every triangle exactly once", "[scene][clusters]") {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    BuildPlaneGrid(32, vertices, indices);
+    const std::vector<unsigned int> originalIndices = indices;
+
+    std::vector<unsigned int> clusterIndices;
+    const std::vector<MeshCluster> clusters = BuildMeshClusters(vertices, indices, clusterIndices);
+    const size_t triangleCount = originalIndices.size() / 3;
+    REQUIRE(clusters.size() == (triangleCount + kMeshClusterTriangleCount - 1) / kMeshClusterTriangleCount);
+    REQUIRE(clusterIndices.size() == originalIndices.size());
+    // The authored buffer stays untouched for the GL path and order-dependent draws.
+    CHECK(indices == originalIndices);
+    CHECK(clusterIndices != originalIndices);
+
+    uint32_t expectedFirstIndex = 0;
+    for (const MeshCluster& cluster : clusters) {
+        CHECK(cluster.firstIndex == expectedFirstIndex);
+        CHECK(cluster.indexCount % 3 == 0);
+        CHECK(cluster.indexCount <= kMeshClusterTriangleCount * 3);
+        for (uint32_t i = cluster.firstIndex; i < cluster.firstIndex + cluster.indexCount; i++) {
+            const glm::vec3 position(vertices[clusterIndices[i]].position);
+            CHECK(glm::all(glm::greaterThanEqual(position, cluster.boundsMin)));
+            CHECK(glm::all(glm::lessThanEqual(position, cluster.boundsMax)));
+        }
+        expectedFirstIndex += cluster.indexCount;
+    }
+    CHECK(expectedFirstIndex == clusterIndices.size());
+
+    std::vector<unsigned int> sortedOriginal = originalIndices;
+    std::vector<unsigned int> sortedClustered = clusterIndices;
+    std::sort(sortedOriginal.begin(), sortedOriginal.end());
+    std::sort(sortedClustered.begin(), sortedClustered.end());
+    CHECK(sortedOriginal == sortedClustered);
+}
+
+TEST_CASE("Mesh clusters on a plane get a tight normal cone", "[scene][clusters]") {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    BuildPlaneGrid(16, vertices, indices);
+
+    std::vector<unsigned int> clusterIndices;
+    const std::vector<MeshCluster> clusters = BuildMeshClusters(vertices, indices, clusterIndices);
+    REQUIRE_FALSE(clusters.empty());
+    for (const MeshCluster& cluster : clusters) {
+        CHECK(cluster.coneAxis.z == Catch::Approx(1.0f));
+        CHECK(cluster.coneCutoff == Catch::Approx(0.0f).margin(1e-3f));
+    }
+}
+
+TEST_CASE("Small meshes keep their triangle order in a single cluster", "[scene][clusters]") {
+    std::vector<Vertex> vertices = {
+        MakeVertex(0.0f, 0.0f, 0.0f),
+        MakeVertex(1.0f, 0.0f, 0.0f),
+        MakeVertex(0.0f, 1.0f, 0.0f),
+        MakeVertex(0.0f, 0.0f, 1.0f),
+    };
+    // Two opposite-facing triangles: the cone covers more than a hemisphere and must never cull.
+    std::vector<unsigned int> indices = {0, 1, 2, 0, 2, 1};
+    const std::vector<unsigned int> originalIndices = indices;
+
+    std::vector<unsigned int> clusterIndices;
+    const std::vector<MeshCluster> clusters = BuildMeshClusters(vertices, indices, clusterIndices);
+    REQUIRE(clusters.size() == 1);
+    CHECK(indices == originalIndices);
+    CHECK(clusterIndices.empty());
+    CHECK(clusters[0].firstIndex == 0);
+    CHECK(clusters[0].indexCount == 6);
+    CHECK(clusters[0].coneCutoff == Catch::Approx(1.0f));
+}
+
+} // namespace RetroRenderer
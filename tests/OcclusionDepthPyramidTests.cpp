@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Renderer/Software/OcclusionDepthPyramid.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace RetroRenderer {
+namespace {
+constexpr size_t kWidth = 64;
+constexpr size_t kHeight = 48;
+
+glm::mat4 MakeViewProjection() {
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), static_cast<float>(kWidth) / kHeight, 0.1f, 100.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+float ProjectDepth(const glm::mat4& viewProjection, float worldZ) {
+    const glm::vec4 clip = viewProjection * glm::vec4(0.0f, 0.0f, worldZ, 1.0f);
+    return (clip.z / clip.w) * 0.5f + 0.5f;
+}
+} // namespace
+
+TEST_CASE("Occlusion pyramid rejects boxes behind a full-screen occluder", "[renderer][occlusion]") {
+    const glm::mat4 viewProjection = MakeViewProjection();
+    Buffer<float> depthBuffer(kWidth, kHeight);
+    depthBuffer.Clear(ProjectDepth(viewProjection, 0.0f));
+
+    OcclusionDepthPyramid pyramid;
+    CHECK_FALSE(pyramid.IsAabbOccluded(viewProjection, glm::vec3(-0.5f, -0.5f, -3.0f), glm::vec3(0.5f, 0.5f, -2.0f), 0.0f, 0.0f));
+
+    pyramid.Build(depthBuffer);
+    REQUIRE(pyramid.IsValid());
+    CHECK(pyramid.IsAabbOccluded(viewProjection, glm::vec3(-0.5f, -0.5f, -3.0f), glm::vec3(0.5f, 0.5f, -2.0f), 0.0f, 0.0f));
+    CHECK_FALSE(pyramid.IsAabbOccluded(viewProjection, glm::vec3(-0.5f, -0.5f, 1.0f), glm::vec3(0.5f, 0.5f, 2.0f), 0.0f, 0.0f));
+    // Boxes straddling the occluder plane are never rejected.
+    CHECK_FALSE(pyramid.IsAabbOccluded(viewProjection, glm::vec3(-0.5f, -0.5f, -1.0f), glm::vec3(0.5f, 0.5f, 1.0f), 0.0f, 0.0f));
+}
+
+TEST_CASE("Occlusion pyramid keeps boxes visible through uncovered pixels", "[renderer][occlusion]") {
+    const glm::mat4 viewProjection = MakeViewProjection();
+    Buffer<float> depthBuffer(kWidth, kHeight);
+    depthBuffer.Clear(ProjectDepth(viewProjection, 0.0f));
+    // A single pixel of cleared depth near the screen center is enough to keep the box alive.
+    depthBuffer.data[(kHeight / 2) * kWidth + kWidth / 2] = 1.0f;
+
+    OcclusionDepthPyramid pyramid;
+    pyramid.Build(depthBuffer);
+    CHECK_FALSE(pyramid.IsAabbOccluded(viewProjection, glm::vec3(-0.5f, -0.5f, -3.0f), glm::vec3(0.5f, 0.5f, -2.0f), 0.0f, 0.0f));
+    // Boxes projecting away from the hole are still rejected.
+    CHECK(pyramid.IsAabbOccluded(viewProjection, glm::vec3(-4.0f, -2.5f, -3.0f), glm::vec3(-3.5f, -2.0f, -2.0f), 0.0f, 0.0f));
+}
+
+TEST_CASE("Occlusion pyramid updates only the tiles marked dirty", "[renderer][occlusion]") {
+    const glm::mat4 viewProjection = MakeViewProjection();
+    Buffer<float> depthBuffer(kWidth, kHeight);
+    depthBuffer.Clear(1.0f);
+
+    OcclusionDepthPyramid pyramid;
+    pyramid.MarkAabbDirty(viewProjection, glm::vec3(-1.0f), glm::vec3(1.0f), 0.0f);
+    CHECK(pyramid.GetDirtyTileCount() == 0);
+    pyramid.Build(depthBuffer);
+    REQUIRE(pyramid.GetTileCount() == (kWidth / OcclusionDepthPyramid::kTileSize) * (kHeight / OcclusionDepthPyramid::kTileSize));
+    const glm::vec3 hiddenMin(-0.5f, -0.5f, -3.0f);
+    const glm::vec3 hiddenMax(0.5f, 0.5f, -2.0f);
+    CHECK_FALSE(pyramid.IsAabbOccluded(viewProjection, hiddenMin, hiddenMax, 0.0f, 0.0f));
+
+    // An occluder drawn over the middle of the screen; only the tiles under its box are rescanned.
+    const glm::vec3 occluderMin(-1.0f, -1.0f, 0.0f);
+    const glm::vec3 occluderMax(1.0f, 1.0f, 0.0f);
+    depthBuffer.Clear(ProjectDepth(viewProjection, 0.0f));
+    pyramid.MarkAabbDirty(viewProjection, occluderMin, occluderMax, 0.0f);
+    const size_t dirtyTiles = pyramid.GetDirtyTileCount();
+    CHECK(dirtyTiles > 0);
+    CHECK(dirtyTiles < pyramid.GetTileCount());
+    CHECK(pyramid.Update(depthBuffer) == dirtyTiles);
+    CHECK(pyramid.GetDirtyTileCount() == 0);
+    CHECK(pyramid.IsAabbOccluded(viewProjection, hiddenMin, hiddenMax, 0.0f, 0.0f));
+    // Tiles outside the marked box keep their old far depth.
+    CHECK_FALSE(pyramid.IsAabbOccluded(viewProjection, glm::vec3(-4.0f, -2.5f, -3.0f), glm::vec3(-3.5f, -2.0f, -2.0f), 0.0f, 0.0f));
+
+    // A box reaching behind the eye marks the whole screen.
+    pyramid.MarkAabbDirty(viewProjection, glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, 1.0f, 10.0f), 0.0f);
+    CHECK(pyramid.GetDirtyTileCount() == pyramid.GetTileCount());
+    CHECK(pyramid.Update(depthBuffer) == pyramid.GetTileCount());
+    CHECK(pyramid.IsAabbOccluded(viewProjection, glm::vec3(-4.0f, -2.5f, -3.0f), glm::vec3(-3.5f, -2.0f, -2.0f), 0.0f, 0.0f));
+}
+
+} // namespace RetroRenderer
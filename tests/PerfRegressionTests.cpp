@@ -0,0 +1,214 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Headless/PerfRegression.h"
+#include "Renderer/Software/RasterCounters.h"
+#if defined(RETRO_SOURCE_DIR)
+#include "Headless/HeadlessRenderer.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace RetroRenderer {
+namespace {
+
+class ScopedTempDirectory {
+  public:
+    ScopedTempDirectory() {
+        const auto uniqueSuffix = std::chrono::steady_clock::now().time_since_epoch().count();
+        m_path_ = std::filesystem::temp_directory_path() / ("retrorenderer-perf-baseline-" + std::to_string(uniqueSuffix));
+        std::filesystem::create_directories(m_path_);
+    }
+
+    ~ScopedTempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path_, ec);
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const {
+        return m_path_;
+    }
+
+  private:
+    std::filesystem::path m_path_;
+};
+
+PerfMetrics MakeMetrics(double medianMs, double trianglesPerSecond) {
+    PerfMetrics metrics{};
+    metrics.medianFrameMs = medianMs;
+    metrics.p95FrameMs = medianMs * 1.5;
+    metrics.p99FrameMs = medianMs * 2.0;
+    metrics.trianglesPerSecond = trianglesPerSecond;
+    metrics.pixelsPerSecond = 1e7;
+    return metrics;
+}
+
+} // namespace
+
+TEST_CASE("Perf baselines round-trip recorded and unrecorded cases", "[headless][perf]") {
+    ScopedTempDirectory tempDirectory;
+    const std::filesystem::path path = tempDirectory.path() / "baseline.txt";
+
+    std::vector<PerfBaselineEntry> entries(2);
+    entries[0].perfCase.scenePath = "tests-visual/my scene/cube.obj";
+    entries[0].perfCase.preset = Config::RenderPreset::PS1;
+    entries[0].metrics = MakeMetrics(4.25, 2.5e6);
+    entries[1].perfCase.scenePath = "shader-examples/water.obj";
+    entries[1].perfCase.preset = Config::RenderPreset::PICO8;
+    entries[1].perfCase.cameraPath = HeadlessCameraPath::DOLLY;
+
+    std::string error;
+    REQUIRE(SavePerfBaseline(path, entries, error));
+
+    std::vector<PerfBaselineEntry> loaded;
+    REQUIRE(LoadPerfBaseline(path, loaded, error));
+    REQUIRE(loaded.size() == 2);
+    CHECK(loaded[0].perfCase.scenePath == entries[0].perfCase.scenePath);
+    CHECK(loaded[0].perfCase.preset == Config::RenderPreset::PS1);
+    CHECK(loaded[0].perfCase.cameraPath == HeadlessCameraPath::ORBIT);
+    REQUIRE(loaded[0].metrics.has_value());
+    CHECK(loaded[0].metrics->medianFrameMs == Catch::Approx(4.25));
+    CHECK(loaded[0].metrics->p99FrameMs == Catch::Approx(8.5));
+    CHECK(loaded[0].metrics->trianglesPerSecond == Catch::Approx(2.5e6));
+    CHECK(loaded[1].perfCase.scenePath == entries[1].perfCase.scenePath);
+    CHECK(loaded[1].perfCase.cameraPath == HeadlessCameraPath::DOLLY);
+    CHECK_FALSE(loaded[1].metrics.has_value());
+
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << "preset=ps1 camera=orbit median_ms=1.0 scene=a.obj\n";
+    }
+    CHECK_FALSE(LoadPerfBaseline(path, loaded, error));
+    CHECK_FALSE(error.empty());
+}
+
+TEST_CASE("Perf metrics use nearest-rank percentiles and raster counter throughput", "[headless][perf]") {
+    HeadlessRunResult result;
+    result.resolution = {100, 50};
+    for (uint64_t ms = 1; ms <= 100; ms++) {
+        HeadlessFrameTiming frame{};
+        frame.totalNs = ms * 1000000;
+        frame.submittedTriangles = 40;
+        frame.rasterizedTriangles = 10;
+        frame.shadedPixels = 5000;
+        result.frames.push_back(frame);
+    }
+
+    const PerfMetrics metrics = ComputePerfMetrics(result);
+    CHECK(metrics.medianFrameMs == Catch::Approx(50.0));
+    CHECK(metrics.p95FrameMs == Catch::Approx(95.0));
+    CHECK(metrics.p99FrameMs == Catch::Approx(99.0));
+    // 100 frames take 5.05 s in total.
+    CHECK(metrics.trianglesPerSecond == Catch::Approx(1000.0 / 5.05));
+    CHECK(metrics.pixelsPerSecond == Catch::Approx(5000.0 * 100.0 / 5.05));
+}
+
+TEST_CASE("Perf comparison only fails outside the tolerance band", "[headless][perf]") {
+    const PerfMetrics baseline = MakeMetrics(10.0, 1e6);
+
+    CHECK_FALSE(ComparePerfMetrics(baseline, MakeMetrics(11.0, 0.9e6), 0.15).regressed);
+    CHECK_FALSE(ComparePerfMetrics(baseline, MakeMetrics(5.0, 3e6), 0.15).regressed);
+
+    const PerfComparison slower = ComparePerfMetrics(baseline, MakeMetrics(12.0, 1e6), 0.15);
+    CHECK(slower.regressed);
+    CHECK(slower.failures.size() == 3);
+
+    const PerfComparison lowerThroughput = ComparePerfMetrics(baseline, MakeMetrics(10.0, 0.8e6), 0.15);
+#if RETRO_RASTER_COUNTERS
+    CHECK(lowerThroughput.regressed);
+    CHECK(lowerThroughput.failures.size() == 1);
+#else
+    CHECK_FALSE(lowerThroughput.regressed);
+#endif
+}
+
+#if defined(RETRO_SOURCE_DIR)
+TEST_CASE("The committed perf baseline records every bundled case", "[headless][perf]") {
+    const std::filesystem::path baselinePath = std::filesystem::path(RETRO_SOURCE_DIR) / "tests/perf/scene_perf_baseline.txt";
+    std::vector<PerfBaselineEntry> entries;
+    std::string error;
+    REQUIRE(LoadPerfBaseline(baselinePath, entries, error));
+    REQUIRE_FALSE(entries.empty());
+    for (const PerfBaselineEntry& entry : entries) {
+        INFO(entry.perfCase.scenePath.generic_string());
+        CHECK(entry.metrics.has_value());
+        CHECK(std::filesystem::is_regular_file(baselinePath.parent_path() / entry.perfCase.scenePath));
+    }
+
+    // Every bundled scene is recorded for every built-in preset.
+    for (const auto& file : std::filesystem::directory_iterator(baselinePath.parent_path() / "scenes")) {
+        if (file.path().extension() != ".obj") {
+            continue;
+        }
+        const std::filesystem::path scenePath = std::filesystem::path("scenes") / file.path().filename();
+        for (const Config::RenderPreset preset : {Config::RenderPreset::DEFAULT,
+                                                  Config::RenderPreset::PICO8,
+                                                  Config::RenderPreset::PICOCAD,
+                                                  Config::RenderPreset::PS1}) {
+            INFO(scenePath.generic_string() << " " << GetRenderPresetName(preset));
+            CHECK(std::any_of(entries.begin(), entries.end(), [&](const PerfBaselineEntry& entry) {
+                return entry.perfCase.scenePath == scenePath && entry.perfCase.preset == preset;
+            }));
+        }
+    }
+}
+
+TEST_CASE("Perf suite fails on unrecorded cases and bootstraps a missing baseline", "[headless][perf]") {
+    ScopedTempDirectory tempDirectory;
+    const std::filesystem::path emptyPath = tempDirectory.path() / "empty.txt";
+    {
+        std::ofstream file(emptyPath);
+        file << "# nothing recorded yet\n";
+    }
+
+    HeadlessOptions options;
+    options.perfBaselinePath = emptyPath;
+    options.frameCount = 2;
+    bool regressed = true;
+    std::string error;
+    CHECK_FALSE(RunPerfSuite(options, regressed, error));
+    CHECK_FALSE(error.empty());
+
+    // A listed case without metrics fails before anything is rendered.
+    const std::filesystem::path unrecordedPath = tempDirectory.path() / "unrecorded.txt";
+    std::vector<PerfBaselineEntry> unrecorded(1);
+    unrecorded[0].perfCase.scenePath = "scenes/cube-grid.obj";
+    unrecorded[0].perfCase.preset = Config::RenderPreset::PS1;
+    REQUIRE(SavePerfBaseline(unrecordedPath, unrecorded, error));
+    options.perfBaselinePath = unrecordedPath;
+    error.clear();
+    CHECK_FALSE(RunPerfSuite(options, regressed, error));
+    CHECK(error.find("scenes/cube-grid.obj [ps1, orbit]") != std::string::npos);
+    CHECK_FALSE(regressed);
+
+    const std::filesystem::path sceneDirectory = tempDirectory.path() / "fresh" / "scenes";
+    std::filesystem::create_directories(sceneDirectory);
+    std::filesystem::copy_file(std::filesystem::path(RETRO_SOURCE_DIR) / "tests/perf/scenes/cube-grid.obj",
+                               sceneDirectory / "cube-grid.obj");
+    const std::filesystem::path freshPath = tempDirectory.path() / "fresh" / "baseline.txt";
+    options.perfBaselinePath = freshPath;
+    options.updatePerfBaseline = true;
+    options.resolution = glm::ivec2(64, 48);
+    const std::filesystem::path previousDirectory = std::filesystem::current_path();
+    std::filesystem::current_path(RETRO_SOURCE_DIR);
+    const bool recorded = RunPerfSuite(options, regressed, error);
+    std::filesystem::current_path(previousDirectory);
+    REQUIRE(recorded);
+
+    std::vector<PerfBaselineEntry> entries;
+    REQUIRE(LoadPerfBaseline(freshPath, entries, error));
+    size_t bundledCases = 0;
+    for (const PerfBaselineEntry& entry : entries) {
+        CHECK(entry.metrics.has_value());
+        bundledCases += entry.perfCase.scenePath == std::filesystem::path("scenes/cube-grid.obj") ? 1 : 0;
+    }
+    CHECK(bundledCases > 0);
+}
+#endif
+
+} // namespace RetroRenderer
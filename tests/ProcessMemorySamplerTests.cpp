@@ -0,0 +1,48 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Base/MemoryProfiler.h"
+#include "Base/ProcessMemorySampler.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace RetroRenderer {
+
+TEST_CASE("Resident-only sample agrees with the full process sample", "[memory]") {
+    const ProcessMemorySnapshot snapshot = MemoryProfiler::SampleProcessMemory();
+    uint64_t residentBytes = 0;
+    const bool supported = MemoryProfiler::SampleResidentBytes(residentBytes);
+    REQUIRE(supported == snapshot.supported);
+    if (!supported) {
+        SKIP("Process memory sampling unavailable on this platform");
+    }
+    CHECK(residentBytes > 0);
+    CHECK(snapshot.peakResidentBytes >= snapshot.residentBytes);
+}
+
+TEST_CASE("Process memory sampler publishes into stats off the calling thread", "[memory]") {
+    auto stats = std::make_shared<Stats>();
+    ProcessMemorySampler sampler;
+    sampler.Start(stats, ProcessMemorySampler::kMaxRateHz);
+    if (!stats->processMemorySupported.load(std::memory_order_relaxed)) {
+        SKIP("Process memory sampling unavailable on this platform");
+    }
+    CHECK(stats->processResidentBytes.load(std::memory_order_relaxed) > 0);
+    CHECK(sampler.GetSampleCount() >= 1);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sampler.GetSampleCount() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    sampler.Stop();
+    CHECK(sampler.GetSampleCount() >= 3);
+    const uint64_t stoppedCount = sampler.GetSampleCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(sampler.GetSampleCount() == stoppedCount);
+
+    sampler.SetRateHz(1000.0f);
+    CHECK(sampler.GetRateHz() == ProcessMemorySampler::kMaxRateHz);
+}
+
+} // namespace RetroRenderer
@@ -4,6 +4,7 @@
 #include "Base/Config.h"
 #include "Renderer/Buffer.h"
 #include "Renderer/MaterialRuntime.h"
+#include "Renderer/Software/RasterCounters.h"
 #include "Renderer/Software/Rasterizer.h"
 #include "Scene/Texture.h"
 #include "Scene/Vertex.h"
@@ -696,4 +697,77 @@ TEST_CASE("Software material rendering uses the material graph for scanline fill
     }
 }
 
+#if RETRO_RASTER_COUNTERS
+TEST_CASE("Raster counters account for every covered pixel and record overdraw", "[rasterizer][counters]") {
+    Config config = MakeBarycentricFillConfig();
+    const Pixel nearColor{240, 20, 20, 255};
+    const Pixel farColor{20, 20, 240, 255};
+    std::array<Vertex, 3> nearTriangle = {MakeVertex(-0.8f, -0.6f, -0.8f), MakeVertex(0.2f, -0.6f, -0.8f),
+                                           MakeVertex(-0.3f, 0.7f, -0.8f)};
+    std::array<Vertex, 3> farTriangle = {MakeVertex(-0.2f, -0.6f, 0.8f), MakeVertex(0.8f, -0.6f, 0.8f),
+                                          MakeVertex(0.3f, 0.7f, 0.8f)};
+
+    Buffer<Pixel> framebuffer(32, 32);
+    Buffer<float> depthBuffer(32, 32);
+    Buffer<uint16_t> overdraw(32, 32);
+
+    // Back to front: every covered pixel is written and the overlap is written twice.
+    framebuffer.Clear(Pixel{0, 0, 0, 0});
+    depthBuffer.Clear(1.0f);
+    overdraw.Clear();
+    RasterCounters backToFront{};
+    {
+        const RasterCounterScope scope(&backToFront, &overdraw);
+        Rasterizer::DrawTriangle(framebuffer, depthBuffer, farTriangle, config, farColor);
+        Rasterizer::DrawTriangle(framebuffer, depthBuffer, nearTriangle, config, nearColor);
+    }
+    size_t overlapPixels = 0;
+    uint64_t overdrawTotal = 0;
+    for (size_t i = 0; i < overdraw.GetCount(); i++) {
+        REQUIRE(overdraw.data[i] <= 2);
+        overlapPixels += overdraw.data[i] == 2 ? 1 : 0;
+        overdrawTotal += overdraw.data[i];
+    }
+    REQUIRE(overlapPixels > 0);
+    CHECK(backToFront.pixelsCovered > 0);
+    CHECK(backToFront.pixelsShaded == backToFront.pixelsCovered);
+    CHECK(backToFront.pixelsWritten == backToFront.pixelsCovered);
+    CHECK(backToFront.pixelsDepthRejected == 0);
+    CHECK(overdrawTotal == backToFront.pixelsWritten);
+
+    // Front to back: the far triangle loses the overlap to the depth test instead.
+    framebuffer.Clear(Pixel{0, 0, 0, 0});
+    depthBuffer.Clear(1.0f);
+    RasterCounters frontToBack{};
+    {
+        const RasterCounterScope scope(&frontToBack, nullptr);
+        Rasterizer::DrawTriangle(framebuffer, depthBuffer, nearTriangle, config, nearColor);
+        Rasterizer::DrawTriangle(framebuffer, depthBuffer, farTriangle, config, farColor);
+    }
+    CHECK(frontToBack.pixelsCovered == backToFront.pixelsCovered);
+    CHECK(frontToBack.pixelsDepthRejected == overlapPixels);
+    CHECK(frontToBack.pixelsWritten + frontToBack.pixelsDepthRejected == frontToBack.pixelsCovered);
+
+    // Scopes restore the outer binding, so draws after them count nowhere.
+    CHECK(RasterCounterScope::Counters() == nullptr);
+}
+
+TEST_CASE("Raster counters count culled triangles", "[rasterizer][counters]") {
+    Config config = MakeBarycentricFillConfig();
+    config.cull.backfaceCulling = true;
+    Buffer<Pixel> framebuffer(32, 32);
+    Buffer<float> depthBuffer(32, 32);
+    framebuffer.Clear(Pixel{0, 0, 0, 0});
+    depthBuffer.Clear(1.0f);
+    std::array<Vertex, 3> backFacing = {MakeVertex(-0.6f, -0.5f, 0.0f), MakeVertex(0.6f, -0.5f, 0.0f),
+                                         MakeVertex(0.0f, 0.6f, 0.0f)};
+
+    RasterCounters counters{};
+    const RasterCounterScope scope(&counters, nullptr);
+    Rasterizer::DrawTriangle(framebuffer, depthBuffer, backFacing, config, Pixel{255, 255, 255, 255});
+    CHECK(counters.trianglesCulled == 1);
+    CHECK(counters.pixelsCovered == 0);
+}
+#endif
+
 } // namespace RetroRenderer
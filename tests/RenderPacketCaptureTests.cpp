@@ -0,0 +1,374 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Renderer/RenderPacketCapture.h"
+#if defined(RETRO_SOURCE_DIR)
+#include "Headless/HeadlessRenderer.h"
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RetroRenderer {
+namespace {
+class ScopedTempDirectory {
+  public:
+    ScopedTempDirectory() {
+        const auto uniqueSuffix = std::chrono::steady_clock::now().time_since_epoch().count();
+        m_path_ = std::filesystem::temp_directory_path() /
+                  ("retrorenderer-packet-capture-" + std::to_string(uniqueSuffix));
+        std::filesystem::create_directories(m_path_);
+    }
+
+    ~ScopedTempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path_, ec);
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const {
+        return m_path_;
+    }
+
+  private:
+    std::filesystem::path m_path_;
+};
+
+std::shared_ptr<const MeshGeometryData> MakeTriangleGeometry() {
+    auto geometry = std::make_shared<MeshGeometryData>();
+    Vertex vertex{};
+    for (int i = 0; i < 3; i++) {
+        vertex.position = glm::vec4(static_cast<float>(i), static_cast<float>(i * 2), -1.0f, 1.0f);
+        vertex.texCoords = glm::vec2(0.5f * static_cast<float>(i), 1.0f);
+        geometry->vertices.push_back(vertex);
+    }
+    geometry->indices = {0, 1, 2};
+    geometry->boundsMin = glm::vec3(0.0f, 0.0f, -1.0f);
+    geometry->boundsMax = glm::vec3(2.0f, 4.0f, -1.0f);
+    return geometry;
+}
+
+std::shared_ptr<const Texture> MakeCheckerTexture() {
+    auto texture = std::make_shared<Texture>();
+    const Pixel black{0x00, 0x00, 0x00, 0xFF};
+    const Pixel white{0xFF, 0xFF, 0xFF, 0xFF};
+    REQUIRE(texture->LoadFromPixels({black, white, white, black}, 2, 2));
+    return texture;
+}
+
+std::shared_ptr<const CompiledMaterialTemplate> MakeMaterialTemplate() {
+    auto materialTemplate = std::make_shared<CompiledMaterialTemplate>();
+    materialTemplate->name = "capture-test";
+    materialTemplate->assetPath = "materials/capture-test.rrmatdef.json";
+    materialTemplate->parameters.push_back({"tint", MaterialDataType::VEC4, {MaterialDataType::VEC4, glm::vec4(1.0f)}});
+    materialTemplate->samplers.push_back({"albedo", MaterialFilterMode::NEAREST, MaterialWrapMode::REPEAT,
+                                          MaterialWrapMode::CLAMP_TO_EDGE});
+    MaterialInstruction instruction{};
+    instruction.opcode = MaterialOpcode::PARAMETER;
+    instruction.dstRegister = 0;
+    instruction.parameterIndex = 0;
+    materialTemplate->fragmentProgram.instructions.push_back(instruction);
+    materialTemplate->fragmentProgram.registerCount = 1;
+    materialTemplate->fragmentProgram.registerTypes = {MaterialDataType::VEC4};
+    materialTemplate->fragmentOutputs.baseColorRegister = 0;
+    materialTemplate->cacheKey = 0x1234u;
+    materialTemplate->usesTextureSampling = true;
+    return materialTemplate;
+}
+
+std::shared_ptr<RenderPacket> MakePacket(const std::shared_ptr<const MeshGeometryData>& geometry,
+                                         const std::shared_ptr<const Texture>& texture,
+                                         const std::shared_ptr<const CompiledMaterialTemplate>& materialTemplate,
+                                         float time) {
+    auto packet = std::make_shared<RenderPacket>();
+    packet->hasScene = true;
+    packet->camera.m_Position = glm::vec3(1.0f, 2.0f, 3.0f);
+    packet->camera.m_Fov = 60.0f;
+    packet->lights.push_back({LightType::POINT, glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(1.0f, 0.5f, 0.25f), 2.0f});
+    packet->textures.push_back(texture);
+
+    FrameMaterialState material{};
+    material.compiledTemplate = materialTemplate;
+    material.parameterValues = {glm::vec4(0.25f, 0.5f, 0.75f, 1.0f)};
+    material.textureIds = {0};
+    material.pipelineState.cullMode = MaterialCullMode::NONE;
+    packet->materials.push_back(material);
+
+    RenderItem item{};
+    item.geometry = geometry;
+    item.worldTransform = glm::mat4(2.0f);
+    item.materialId = 0;
+    item.viewDepth = 4.5f;
+    packet->items.push_back(item);
+
+    Config::ApplyRenderPreset(packet->configSnapshot, Config::RenderPreset::PS1);
+    packet->configSnapshot.renderer.resolution = glm::ivec2(320, 240);
+    packet->configSnapshot.retro.customPalette[3] = Pixel{1, 2, 3, 4};
+    packet->clearColor = Color(Color::Uint8Tag{}, 0x10, 0x20, 0x30);
+    packet->materialTimeSeconds = time;
+    packet->dataRevision = 7;
+    return packet;
+}
+} // namespace
+
+TEST_CASE("Packet captures round-trip packets and share resources", "[capture]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path path = tempDirectory.path() / "packets.rrcap";
+    const auto geometry = MakeTriangleGeometry();
+    const auto texture = MakeCheckerTexture();
+    const auto materialTemplate = MakeMaterialTemplate();
+
+    std::string error;
+    {
+        RenderPacketCaptureWriter writer;
+        REQUIRE(writer.Open(path, error));
+        REQUIRE(writer.WritePacket(*MakePacket(geometry, texture, materialTemplate, 0.0f), error));
+        REQUIRE(writer.WritePacket(*MakePacket(geometry, texture, materialTemplate, 0.5f), error));
+        CHECK(writer.GetPacketCount() == 2);
+        REQUIRE(writer.Close(error));
+    }
+
+    RenderPacketCapture capture;
+    REQUIRE(LoadRenderPacketCapture(path, capture, error));
+    REQUIRE(capture.packets.size() == 2);
+    CHECK_FALSE(capture.truncated);
+    CHECK(capture.geometryCount == 1);
+    CHECK(capture.textureCount == 1);
+    CHECK(capture.materialTemplateCount == 1);
+
+    const RenderPacket& first = *capture.packets[0];
+    const RenderPacket& second = *capture.packets[1];
+    CHECK(first.hasScene);
+    CHECK(first.camera.m_Position == glm::vec3(1.0f, 2.0f, 3.0f));
+    CHECK(first.camera.m_Fov == 60.0f);
+    REQUIRE(first.lights.size() == 1);
+    CHECK(first.lights[0].intensity == 2.0f);
+    CHECK(first.configSnapshot.retro.preset == Config::RenderPreset::PS1);
+    CHECK(first.configSnapshot.renderer.resolution == glm::ivec2(320, 240));
+    CHECK(first.configSnapshot.retro.customPalette[3].a == 4);
+    CHECK(first.clearColor.g == 0x20);
+    CHECK(first.dataRevision == 7);
+    CHECK(first.materialTimeSeconds == 0.0f);
+    CHECK(second.materialTimeSeconds == 0.5f);
+
+    REQUIRE(first.items.size() == 1);
+    const RenderItem& item = first.items[0];
+    REQUIRE(item.geometry != nullptr);
+    CHECK(item.geometry->vertices.size() == 3);
+    CHECK(item.geometry->vertices[2].position == glm::vec4(2.0f, 4.0f, -1.0f, 1.0f));
+    CHECK(item.geometry->indices == geometry->indices);
+    CHECK(item.geometry->boundsMax == geometry->boundsMax);
+    CHECK(item.worldTransform == glm::mat4(2.0f));
+    CHECK(item.viewDepth == 4.5f);
+    CHECK(second.items[0].geometry == item.geometry);
+
+    REQUIRE(first.textures.size() == 1);
+    REQUIRE(first.textures[0] != nullptr);
+    CHECK(first.textures[0]->GetWidth() == 2);
+    CHECK(first.textures[0]->GetPixels()[1].r == 0xFF);
+    CHECK(second.textures[0] == first.textures[0]);
+
+    REQUIRE(first.materials.size() == 1);
+    const FrameMaterialState& material = first.materials[0];
+    REQUIRE(material.compiledTemplate != nullptr);
+    CHECK(material.compiledTemplate->name == "capture-test");
+    CHECK(material.compiledTemplate->assetPath == materialTemplate->assetPath);
+    REQUIRE(material.compiledTemplate->samplers.size() == 1);
+    CHECK(material.compiledTemplate->samplers[0].wrapV == MaterialWrapMode::CLAMP_TO_EDGE);
+    REQUIRE(material.compiledTemplate->fragmentProgram.instructions.size() == 1);
+    CHECK(material.compiledTemplate->fragmentProgram.instructions[0].opcode == MaterialOpcode::PARAMETER);
+    CHECK(material.compiledTemplate->fragmentOutputs.baseColorRegister == 0);
+    CHECK(material.compiledTemplate->cacheKey == 0x1234u);
+    CHECK(material.compiledTemplate->glShader == nullptr);
+    CHECK(material.parameterValues == std::vector<glm::vec4>{glm::vec4(0.25f, 0.5f, 0.75f, 1.0f)});
+    CHECK(material.textureIds == std::vector<FrameTextureId>{0});
+    CHECK(material.pipelineState.cullMode == MaterialCullMode::NONE);
+    CHECK(second.materials[0].compiledTemplate == material.compiledTemplate);
+}
+
+TEST_CASE("Packet captures keep complete packets of a truncated file", "[capture]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path path = tempDirectory.path() / "packets.rrcap";
+    const auto geometry = MakeTriangleGeometry();
+    const auto texture = MakeCheckerTexture();
+    const auto materialTemplate = MakeMaterialTemplate();
+
+    std::string error;
+    uintmax_t firstPacketEnd = 0;
+    {
+        RenderPacketCaptureWriter writer;
+        REQUIRE(writer.Open(path, error));
+        REQUIRE(writer.WritePacket(*MakePacket(geometry, texture, materialTemplate, 0.0f), error));
+        REQUIRE(writer.Close(error));
+        firstPacketEnd = std::filesystem::file_size(path);
+    }
+    {
+        RenderPacketCaptureWriter writer;
+        REQUIRE(writer.Open(path, error));
+        REQUIRE(writer.WritePacket(*MakePacket(geometry, texture, materialTemplate, 0.0f), error));
+        REQUIRE(writer.WritePacket(*MakePacket(geometry, texture, materialTemplate, 0.5f), error));
+        REQUIRE(writer.Close(error));
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    REQUIRE(std::filesystem::file_size(path) > firstPacketEnd);
+
+    RenderPacketCapture capture;
+    REQUIRE(LoadRenderPacketCapture(path, capture, error));
+    CHECK(capture.truncated);
+    REQUIRE(capture.packets.size() == 1);
+    CHECK(capture.packets[0]->items.size() == 1);
+
+    std::filesystem::resize_file(path, firstPacketEnd - 3);
+    CHECK_FALSE(LoadRenderPacketCapture(path, capture, error));
+    CHECK_FALSE(error.empty());
+}
+
+TEST_CASE("Packet captures reject out-of-range bools and enums", "[capture]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path path = tempDirectory.path() / "packets.rrcap";
+    const auto geometry = MakeTriangleGeometry();
+    const auto texture = MakeCheckerTexture();
+    const auto materialTemplate = MakeMaterialTemplate();
+
+    std::string error;
+    uintmax_t secondPacketStart = 0;
+    {
+        RenderPacketCaptureWriter writer;
+        REQUIRE(writer.Open(path, error));
+        REQUIRE(writer.WritePacket(*MakePacket(geometry, texture, materialTemplate, 0.0f), error));
+        REQUIRE(writer.Close(error));
+        secondPacketStart = std::filesystem::file_size(path);
+    }
+    {
+        RenderPacketCaptureWriter writer;
+        REQUIRE(writer.Open(path, error));
+        REQUIRE(writer.WritePacket(*MakePacket(geometry, texture, materialTemplate, 0.0f), error));
+        REQUIRE(writer.WritePacket(*MakePacket(geometry, texture, materialTemplate, 0.5f), error));
+        REQUIRE(writer.Close(error));
+    }
+    const auto patchByte = [&path](uintmax_t offset, char value) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.put(value);
+    };
+
+    // The second packet reuses every resource, so its record starts with the record type and then hasScene.
+    const uintmax_t hasSceneOffset = secondPacketStart + 1;
+    patchByte(hasSceneOffset, 2);
+    RenderPacketCapture capture;
+    CHECK_FALSE(LoadRenderPacketCapture(path, capture, error));
+    CHECK(error.find("out-of-range") != std::string::npos);
+
+    // Camera type follows hasScene and four vec3s.
+    patchByte(hasSceneOffset, 1);
+    patchByte(hasSceneOffset + 1 + 4 * sizeof(glm::vec3), 9);
+    CHECK_FALSE(LoadRenderPacketCapture(path, capture, error));
+    CHECK(error.find("out-of-range") != std::string::npos);
+
+    patchByte(hasSceneOffset + 1 + 4 * sizeof(glm::vec3), 0);
+    REQUIRE(LoadRenderPacketCapture(path, capture, error));
+    CHECK(capture.packets.size() == 2);
+}
+
+TEST_CASE("Packet captures reject files that are not captures", "[capture]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path path = tempDirectory.path() / "not-a-capture.rrcap";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "P6\n2 2\n255\n";
+    }
+    RenderPacketCapture capture;
+    std::string error;
+    CHECK_FALSE(LoadRenderPacketCapture(path, capture, error));
+    CHECK(error.find("not a packet capture") != std::string::npos);
+    CHECK_FALSE(LoadRenderPacketCapture(tempDirectory.path() / "missing.rrcap", capture, error));
+}
+
+#if defined(RETRO_SOURCE_DIR)
+namespace {
+constexpr const char* kCubeObj =
+    "v -0.5 -0.5 -0.5\n"
+    "v 0.5 -0.5 -0.5\n"
+    "v 0.5 0.5 -0.5\n"
+    "v -0.5 0.5 -0.5\n"
+    "v -0.5 -0.5 0.5\n"
+    "v 0.5 -0.5 0.5\n"
+    "v 0.5 0.5 0.5\n"
+    "v -0.5 0.5 0.5\n"
+    "f 1 4 3 2\n"
+    "f 5 6 7 8\n"
+    "f 1 5 8 4\n"
+    "f 2 3 7 6\n"
+    "f 4 8 7 3\n"
+    "f 1 2 6 5\n";
+
+// Built-in materials resolve relative to the working directory, as in the editor.
+class ScopedWorkingDirectory {
+  public:
+    explicit ScopedWorkingDirectory(const std::filesystem::path& path)
+        : m_previous_(std::filesystem::current_path()) {
+        std::filesystem::current_path(path);
+    }
+
+    ~ScopedWorkingDirectory() {
+        std::error_code ec;
+        std::filesystem::current_path(m_previous_, ec);
+    }
+
+  private:
+    std::filesystem::path m_previous_;
+};
+
+std::string ReadFileBytes(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+} // namespace
+
+TEST_CASE("Replaying a headless capture reproduces its frames", "[capture][headless]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path scenePath = tempDirectory.path() / "cube.obj";
+    {
+        std::ofstream scene(scenePath);
+        scene << kCubeObj;
+    }
+    const std::filesystem::path capturePath = tempDirectory.path() / "cube.rrcap";
+    const ScopedWorkingDirectory workingDirectory(RETRO_SOURCE_DIR);
+
+    HeadlessOptions captureOptions;
+    captureOptions.scenePath = scenePath;
+    captureOptions.useSceneBaseline = false;
+    captureOptions.resolution = glm::ivec2(96, 64);
+    captureOptions.frameCount = 3;
+    captureOptions.cameraPath = HeadlessCameraPath::ORBIT;
+    captureOptions.format = ImageSequenceFormat::PPM;
+    captureOptions.outputDirectory = tempDirectory.path() / "captured";
+    captureOptions.capturePath = capturePath;
+    HeadlessRunResult captured;
+    REQUIRE(RunHeadless(captureOptions, captured));
+    REQUIRE(captured.framesWritten == 3);
+
+    HeadlessOptions replayOptions;
+    replayOptions.replayPath = capturePath;
+    replayOptions.frameCount = 0;
+    replayOptions.format = ImageSequenceFormat::PPM;
+    replayOptions.outputDirectory = tempDirectory.path() / "replayed";
+    HeadlessRunResult replayed;
+    REQUIRE(RunReplay(replayOptions, replayed));
+    REQUIRE(replayed.frames.size() == 3);
+    CHECK(replayed.resolution == glm::ivec2(96, 64));
+
+    for (const char* name : {"frame_00000.ppm", "frame_00001.ppm", "frame_00002.ppm"}) {
+        CAPTURE(name);
+        const std::string capturedImage = ReadFileBytes(captureOptions.outputDirectory / name);
+        REQUIRE_FALSE(capturedImage.empty());
+        CHECK(ReadFileBytes(replayOptions.outputDirectory / name) == capturedImage);
+    }
+}
+#endif
+
+} // namespace RetroRenderer
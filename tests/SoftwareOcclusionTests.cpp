@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Headless/HeadlessRenderer.h"
+#include "Renderer/Software/OcclusionDepthPyramid.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace RetroRenderer {
+namespace {
+constexpr glm::ivec2 kResolution{160, 120};
+constexpr int kGridColumns = 16;
+constexpr int kGridRows = 12;
+
+class ScopedTempDirectory {
+  public:
+    ScopedTempDirectory() {
+        const auto uniqueSuffix = std::chrono::steady_clock::now().time_since_epoch().count();
+        m_path_ = std::filesystem::temp_directory_path() /
+                  ("retrorenderer-software-occlusion-" + std::to_string(uniqueSuffix));
+        std::filesystem::create_directories(m_path_);
+    }
+
+    ~ScopedTempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path_, ec);
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const {
+        return m_path_;
+    }
+
+  private:
+    std::filesystem::path m_path_;
+};
+
+// Built-in materials resolve relative to the working directory, as in the editor.
+class ScopedWorkingDirectory {
+  public:
+    explicit ScopedWorkingDirectory(const std::filesystem::path& path)
+        : m_previous_(std::filesystem::current_path()) {
+        std::filesystem::current_path(path);
+    }
+
+    ~ScopedWorkingDirectory() {
+        std::error_code ec;
+        std::filesystem::current_path(m_previous_, ec);
+    }
+
+  private:
+    std::filesystem::path m_previous_;
+};
+
+// A wall over the left half of the view with a grid of small cubes behind it, one object per cube.
+std::string MakeWallAndCubeGridObj() {
+    std::ostringstream obj;
+    obj << "o wall\n"
+        << "v -20 -20 1\nv 0 -20 1\nv 0 20 1\nv -20 20 1\n"
+        << "f 1 2 3 4\n";
+    int vertexBase = 4;
+    for (int row = 0; row < kGridRows; row++) {
+        for (int column = 0; column < kGridColumns; column++) {
+            const float x = -3.0f + 6.0f * static_cast<float>(column) / (kGridColumns - 1);
+            const float y = -2.0f + 4.0f * static_cast<float>(row) / (kGridRows - 1);
+            obj << "o cube_" << row << "_" << column << "\n";
+            for (int corner = 0; corner < 8; corner++) {
+                obj << "v " << x + ((corner & 1) ? 0.1f : -0.1f) << " " << y + ((corner & 2) ? 0.1f : -0.1f) << " "
+                    << ((corner & 4) ? -3.8f : -4.0f) << "\n";
+            }
+            const int b = vertexBase + 1;
+            obj << "f " << b << " " << b + 2 << " " << b + 3 << " " << b + 1 << "\n"
+                << "f " << b + 4 << " " << b + 5 << " " << b + 7 << " " << b + 6 << "\n"
+                << "f " << b << " " << b + 4 << " " << b + 6 << " " << b + 2 << "\n"
+                << "f " << b + 1 << " " << b + 3 << " " << b + 7 << " " << b + 5 << "\n"
+                << "f " << b + 2 << " " << b + 6 << " " << b + 7 << " " << b + 3 << "\n"
+                << "f " << b << " " << b + 1 << " " << b + 5 << " " << b + 4 << "\n";
+            vertexBase += 8;
+        }
+    }
+    return obj.str();
+}
+} // namespace
+
+TEST_CASE("Software occlusion builds the pyramid once per frame and bounds later rescans", "[headless][occlusion]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path scenePath = tempDirectory.path() / "wall.obj";
+    {
+        std::ofstream scene(scenePath);
+        scene << MakeWallAndCubeGridObj();
+    }
+    const ScopedWorkingDirectory workingDirectory(RETRO_SOURCE_DIR);
+
+    HeadlessOptions options;
+    options.scenePath = scenePath;
+    options.useSceneBaseline = false;
+    options.resolution = kResolution;
+    options.warmupFrames = 1;
+    options.frameCount = 3;
+
+    HeadlessRunResult result;
+    REQUIRE(RunHeadless(options, result));
+    REQUIRE(result.frames.size() == 3);
+
+    const uint64_t tileCount = ((kResolution.x + OcclusionDepthPyramid::kTileSize - 1) / OcclusionDepthPyramid::kTileSize) *
+                               ((kResolution.y + OcclusionDepthPyramid::kTileSize - 1) / OcclusionDepthPyramid::kTileSize);
+    for (const HeadlessFrameTiming& frame : result.frames) {
+        CAPTURE(frame.renderItems, frame.occlusionFullBuilds, frame.occlusionTilesRescanned, frame.occlusionCulledItems);
+        CHECK(frame.renderItems == kGridColumns * kGridRows + 1);
+        CHECK(frame.occlusionFullBuilds == 1);
+        CHECK(frame.occlusionTilesRescanned >= tileCount);
+        // Without incremental updates this scene would rescan the whole screen every few items.
+        CHECK(frame.occlusionTilesRescanned <= 3 * tileCount);
+        CHECK(frame.occlusionCulledItems > 0);
+        CHECK(frame.occlusionCulledItems < frame.renderItems - 1);
+    }
+}
+
+} // namespace RetroRenderer
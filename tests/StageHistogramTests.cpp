@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Base/StageHistogram.h"
+
+#include <cstdint>
+
+namespace RetroRenderer {
+
+TEST_CASE("Stage histogram buckets keep bounded relative error", "[stats]") {
+    for (uint64_t ns = 1; ns < (uint64_t{1} << 24); ns = ns * 3 + 1) {
+        const size_t bucket = StageHistogram::BucketIndex(ns);
+        const uint64_t upper = StageHistogram::BucketUpperBound(bucket);
+        REQUIRE(upper >= ns);
+        REQUIRE(static_cast<double>(upper - ns) <= static_cast<double>(ns) / StageHistogram::kSubBucketCount);
+        if (bucket > 0) {
+            REQUIRE(StageHistogram::BucketUpperBound(bucket - 1) < ns);
+        }
+    }
+    CHECK(StageHistogram::BucketIndex(StageHistogram::kMaxTrackableNs * 4) == StageHistogram::kBucketCount - 1);
+}
+
+TEST_CASE("Stage histogram reports window percentiles", "[stats]") {
+    StageHistogram histogram(100);
+    for (uint64_t ms = 1; ms <= 100; ms++) {
+        histogram.Record(ms * 1'000'000);
+    }
+
+    const StageTimingSummary summary = histogram.Summarize(90'000'000);
+    CHECK(summary.sampleCount == 100);
+    CHECK(summary.minNs == 1'000'000);
+    CHECK(summary.maxNs == 100'000'000);
+    CHECK(summary.overBudgetCount == 10);
+    CHECK(summary.medianNs >= 50'000'000);
+    CHECK(summary.medianNs <= 53'125'000);
+    CHECK(summary.p95Ns >= 95'000'000);
+    CHECK(summary.p95Ns <= 100'000'000);
+    CHECK(summary.p99Ns >= 99'000'000);
+    CHECK(summary.p99Ns <= 100'000'000);
+    CHECK(histogram.GetLastNs() == 100'000'000);
+}
+
+TEST_CASE("Stage histogram forgets samples that left the window", "[stats]") {
+    StageHistogram histogram(8);
+    for (int i = 0; i < 8; i++) {
+        histogram.Record(50'000'000);
+    }
+    for (int i = 0; i < 8; i++) {
+        histogram.Record(1'000'000);
+    }
+
+    const StageTimingSummary summary = histogram.Summarize();
+    CHECK(summary.sampleCount == 8);
+    CHECK(summary.maxNs == 1'000'000);
+    CHECK(summary.p99Ns == 1'000'000);
+    CHECK(summary.overBudgetCount == 0);
+}
+
+TEST_CASE("Stage histogram does not sample stages that did not run", "[stats]") {
+    StageHistogram histogram(4);
+    CHECK(histogram.Summarize().sampleCount == 0);
+
+    histogram.Record(2'000'000);
+    histogram.Record(0);
+    const StageTimingSummary summary = histogram.Summarize();
+    CHECK(histogram.GetLastNs() == 0);
+    CHECK(summary.sampleCount == 1);
+    CHECK(summary.minNs == 2'000'000);
+    CHECK(summary.medianNs == 2'000'000);
+}
+
+} // namespace RetroRenderer
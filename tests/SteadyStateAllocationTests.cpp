@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Base/AllocationTracker.h"
+#include "Headless/HeadlessRenderer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#if RETRO_ALLOCATION_TRACKING
+namespace RetroRenderer {
+namespace {
+// Budgets for one steady-state frame of a single-mesh scene. What is left is the render packet snapshot (the packet
+// itself, its item, light and texture lists and lookup maps) and the frame's shared_ptr control blocks; none of it
+// scales with resolution or triangle count, which is what the byte budget checks.
+constexpr uint64_t kMaxAllocationsPerFrame = 64;
+constexpr int kWarmupFrames = 5;
+constexpr int kMeasuredFrames = 30;
+constexpr glm::ivec2 kResolution{160, 120};
+
+constexpr const char* kCubeObj =
+    "v -0.5 -0.5 -0.5\n"
+    "v 0.5 -0.5 -0.5\n"
+    "v 0.5 0.5 -0.5\n"
+    "v -0.5 0.5 -0.5\n"
+    "v -0.5 -0.5 0.5\n"
+    "v 0.5 -0.5 0.5\n"
+    "v 0.5 0.5 0.5\n"
+    "v -0.5 0.5 0.5\n"
+    "f 1 4 3 2\n"
+    "f 5 6 7 8\n"
+    "f 1 5 8 4\n"
+    "f 2 3 7 6\n"
+    "f 4 8 7 3\n"
+    "f 1 2 6 5\n";
+
+class ScopedTempDirectory {
+  public:
+    ScopedTempDirectory() {
+        const auto uniqueSuffix = std::chrono::steady_clock::now().time_since_epoch().count();
+        m_path_ = std::filesystem::temp_directory_path() /
+                  ("retrorenderer-steady-state-" + std::to_string(uniqueSuffix));
+        std::filesystem::create_directories(m_path_);
+    }
+
+    ~ScopedTempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path_, ec);
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const {
+        return m_path_;
+    }
+
+  private:
+    std::filesystem::path m_path_;
+};
+
+// Built-in materials and the skybox resolve relative to the working directory, as in the editor.
+class ScopedWorkingDirectory {
+  public:
+    explicit ScopedWorkingDirectory(const std::filesystem::path& path)
+        : m_previous_(std::filesystem::current_path()) {
+        std::filesystem::current_path(path);
+    }
+
+    ~ScopedWorkingDirectory() {
+        std::error_code ec;
+        std::filesystem::current_path(m_previous_, ec);
+    }
+
+  private:
+    std::filesystem::path m_previous_;
+};
+
+std::string DescribeAllocations(const AllocationFrameReport& report, int frameCount) {
+    std::string description;
+    for (size_t tag = 0; tag < kAllocationTagCount; tag++) {
+        const AllocationCounts& counts = report.tags[tag];
+        if (counts.allocations == 0) {
+            continue;
+        }
+        description += std::string(GetAllocationTagName(static_cast<AllocationTag>(tag))) + ": " +
+                       std::to_string(counts.allocations / static_cast<uint64_t>(frameCount)) + " allocs, " +
+                       std::to_string(counts.bytes / static_cast<uint64_t>(frameCount)) + " bytes per frame\n";
+    }
+    return description;
+}
+} // namespace
+
+TEST_CASE("Steady-state headless frames stay within the allocation budget", "[headless][allocations]") {
+    const ScopedTempDirectory tempDirectory;
+    const std::filesystem::path scenePath = tempDirectory.path() / "cube.obj";
+    {
+        std::ofstream scene(scenePath);
+        scene << kCubeObj;
+    }
+    const ScopedWorkingDirectory workingDirectory(RETRO_SOURCE_DIR);
+
+    HeadlessOptions options;
+    options.scenePath = scenePath;
+    options.useSceneBaseline = false;
+    options.resolution = kResolution;
+    options.warmupFrames = kWarmupFrames;
+    options.frameCount = kMeasuredFrames;
+    options.trackAllocations = true;
+
+    HeadlessRunResult result;
+    REQUIRE(RunHeadless(options, result));
+    REQUIRE(result.frames.size() == static_cast<size_t>(kMeasuredFrames));
+    CHECK_FALSE(AllocationTracker::IsEnabled());
+
+    const uint64_t framebufferBytes =
+        static_cast<uint64_t>(kResolution.x) * static_cast<uint64_t>(kResolution.y) * sizeof(uint32_t);
+    INFO(DescribeAllocations(result.allocations, kMeasuredFrames));
+    for (size_t i = 0; i < result.frames.size(); i++) {
+        const HeadlessFrameTiming& frame = result.frames[i];
+        CAPTURE(i, frame.allocations, frame.allocatedBytes);
+        CHECK(frame.allocations > 0);
+        CHECK(frame.allocations <= kMaxAllocationsPerFrame);
+        CHECK(frame.allocatedBytes < framebufferBytes);
+    }
+}
+
+} // namespace RetroRenderer
+#endif
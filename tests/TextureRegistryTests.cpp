@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Scene/TextureRegistry.h"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RetroRenderer {
+namespace {
+std::filesystem::path MakeTempDir(const char* name) {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "retrorenderer_texture_registry_tests" / name;
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+    return dir;
+}
+
+void WriteSolidBmp(const std::filesystem::path& path, uint8_t r, uint8_t g, uint8_t b) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 8, 8, 24, SDL_PIXELFORMAT_RGB24);
+    REQUIRE(surface != nullptr);
+    REQUIRE(SDL_FillRect(surface, nullptr, SDL_MapRGB(surface->format, r, g, b)) == 0);
+    REQUIRE(SDL_SaveBMP(surface, path.string().c_str()) == 0);
+    SDL_FreeSurface(surface);
+}
+} // namespace
+
+TEST_CASE("Texture registry shares textures by canonical path and by content", "[texture][registry]") {
+    const std::filesystem::path dir = MakeTempDir("dedup");
+    WriteSolidBmp(dir / "atlas.bmp", 200, 40, 10);
+    WriteSolidBmp(dir / "atlas_copy.bmp", 200, 40, 10);
+    WriteSolidBmp(dir / "other.bmp", 10, 40, 200);
+
+    TextureRegistry& registry = TextureRegistry::Get();
+    const TextureRegistryStats before = registry.GetStats();
+    const std::vector<std::shared_ptr<const Texture>> first = registry.LoadFromFiles({
+        (dir / "atlas.bmp").string(),
+        (dir / "atlas_copy.bmp").string(),
+        (dir / "other.bmp").string(),
+        (dir / "missing.bmp").string(),
+    });
+    REQUIRE(first.size() == 4);
+    REQUIRE(first[0] != nullptr);
+    REQUIRE(first[2] != nullptr);
+    CHECK(first[1] == first[0]);
+    CHECK(first[2] != first[0]);
+    CHECK(first[3] == nullptr);
+
+    // A different spelling of an already loaded path is served without decoding the file again.
+    const std::vector<std::shared_ptr<const Texture>> second =
+        registry.LoadFromFiles({(dir / "." / "other.bmp").string()});
+    REQUIRE(second.size() == 1);
+    CHECK(second[0] == first[2]);
+
+    const TextureRegistryStats after = registry.GetStats();
+    CHECK(after.contentHits - before.contentHits == 1);
+    CHECK(after.pathHits - before.pathHits == 1);
+    CHECK(after.misses - before.misses == 2);
+    CHECK(after.sharedBytes > before.sharedBytes);
+}
+
+TEST_CASE("Texture registry forgets textures once nothing holds them", "[texture][registry]") {
+    const std::filesystem::path dir = MakeTempDir("expiry");
+    const std::string path = (dir / "solo.bmp").string();
+    WriteSolidBmp(path, 1, 2, 3);
+
+    TextureRegistry& registry = TextureRegistry::Get();
+    std::weak_ptr<const Texture> weakTexture;
+    {
+        const std::vector<std::shared_ptr<const Texture>> textures = registry.LoadFromFiles({path});
+        REQUIRE(textures[0] != nullptr);
+        weakTexture = textures[0];
+    }
+    CHECK(weakTexture.expired());
+
+    const uint64_t pathHitsBefore = registry.GetStats().pathHits;
+    const std::vector<std::shared_ptr<const Texture>> reloaded = registry.LoadFromFiles({path});
+    REQUIRE(reloaded[0] != nullptr);
+    CHECK(registry.GetStats().pathHits == pathHitsBefore);
+}
+
+TEST_CASE("Texture registry reloads a path whose file changed on disk", "[texture][registry]") {
+    const std::filesystem::path dir = MakeTempDir("stale");
+    const std::filesystem::path path = dir / "swatch.bmp";
+    WriteSolidBmp(path, 10, 20, 30);
+
+    TextureRegistry& registry = TextureRegistry::Get();
+    const std::vector<std::shared_ptr<const Texture>> before = registry.LoadFromFiles({path.string()});
+    REQUIRE(before[0] != nullptr);
+
+    // Same size on disk, so only the bumped timestamp tells the two files apart.
+    const std::filesystem::file_time_type firstWriteTime = std::filesystem::last_write_time(path);
+    WriteSolidBmp(path, 30, 20, 10);
+    std::filesystem::last_write_time(path, firstWriteTime + std::chrono::seconds(2));
+
+    const std::vector<std::shared_ptr<const Texture>> after = registry.LoadFromFiles({path.string()});
+    REQUIRE(after[0] != nullptr);
+    CHECK(after[0] != before[0]);
+    CHECK(after[0]->GetPixels().front().r != before[0]->GetPixels().front().r);
+}
+
+} // namespace RetroRenderer
@@ -0,0 +1,448 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Scene/Texture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RetroRenderer {
+namespace {
+std::vector<Pixel> MakeGradientPixels(int width, int height) {
+    std::vector<Pixel> pixels(static_cast<size_t>(width) * static_cast<size_t>(height));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            pixels[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)] =
+                Pixel{static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(x ^ y), 255};
+        }
+    }
+    return pixels;
+}
+
+bool PixelsEqual(const Pixel& lhs, const Pixel& rhs) {
+    return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b && lhs.a == rhs.a;
+}
+
+// Row-major nearest REPEAT lookup as the samplers did it before tiling; the benchmark baseline.
+Pixel SampleRowMajorNearestRepeat(const std::vector<Pixel>& pixels, int width, int height, const glm::vec2& uv) {
+    const float wrappedU = uv.x - std::floor(uv.x);
+    const float wrappedV = uv.y - std::floor(uv.y);
+    const int x = std::clamp(static_cast<int>(std::floor(wrappedU * static_cast<float>(width))), 0, width - 1);
+    const int y = std::clamp(static_cast<int>(std::floor((1.0f - wrappedV) * static_cast<float>(height))), 0, height - 1);
+    return pixels[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)];
+}
+
+// Float bilinear blend as MaterialRuntime's SampleLinear did it before the fixed-point kernel; the accuracy reference.
+Pixel FilterBilinearFloat(const Pixel& p00, const Pixel& p10, const Pixel& p01, const Pixel& p11, float tx, float ty) {
+    const auto toUnit = [](const Pixel& pixel) {
+        return glm::vec4(pixel.r / 255.0f, pixel.g / 255.0f, pixel.b / 255.0f, pixel.a / 255.0f);
+    };
+    const glm::vec4 top = glm::mix(toUnit(p00), toUnit(p10), tx);
+    const glm::vec4 bottom = glm::mix(toUnit(p01), toUnit(p11), tx);
+    const glm::vec4 sampled = glm::mix(top, bottom, ty);
+    return Pixel{
+        static_cast<uint8_t>(std::clamp(std::lround(sampled.r * 255.0f), 0L, 255L)),
+        static_cast<uint8_t>(std::clamp(std::lround(sampled.g * 255.0f), 0L, 255L)),
+        static_cast<uint8_t>(std::clamp(std::lround(sampled.b * 255.0f), 0L, 255L)),
+        static_cast<uint8_t>(std::clamp(std::lround(sampled.a * 255.0f), 0L, 255L)),
+    };
+}
+
+int MaxChannelDifference(const Pixel& lhs, const Pixel& rhs) {
+    return std::max({std::abs(lhs.r - rhs.r), std::abs(lhs.g - rhs.g), std::abs(lhs.b - rhs.b), std::abs(lhs.a - rhs.a)});
+}
+
+// Walks a screen-sized grid with UVs rotated 90 degrees, so consecutive samples step along v.
+glm::vec2 RotatedUv(int screenX, int screenY, int screenSize) {
+    const float s = (static_cast<float>(screenX) + 0.5f) / static_cast<float>(screenSize);
+    const float t = (static_cast<float>(screenY) + 0.5f) / static_cast<float>(screenSize);
+    return glm::vec2(t * 1.37f + 0.11f, s * 1.37f - 0.23f);
+}
+} // namespace
+
+TEST_CASE("Tiled texture layout returns the same texels as the row-major copy", "[texture][sampling]") {
+    constexpr int kWidth = 200;
+    constexpr int kHeight = 136;
+    const std::vector<Pixel> pixels = MakeGradientPixels(kWidth, kHeight);
+    Texture texture;
+    REQUIRE(texture.LoadFromPixels(pixels, kWidth, kHeight));
+    CHECK_FALSE(texture.HasTiledLayout());
+    texture.EnsureTiledLayout();
+    REQUIRE(texture.HasTiledLayout());
+    CHECK_FALSE(texture.HasWrapMasks());
+
+    for (int y = 0; y < kHeight; y++) {
+        for (int x = 0; x < kWidth; x++) {
+            REQUIRE(PixelsEqual(texture.FetchTexel(x, y), pixels[static_cast<size_t>(y) * kWidth + static_cast<size_t>(x)]));
+        }
+    }
+}
+
+TEST_CASE("Power-of-two nearest sampling wraps with masks", "[texture][sampling]") {
+    constexpr int kSize = 256;
+    const std::vector<Pixel> pixels = MakeGradientPixels(kSize, kSize);
+    Texture texture;
+    REQUIRE(texture.LoadFromPixels(pixels, kSize, kSize));
+    REQUIRE(texture.HasWrapMasks());
+
+    for (int sy = 0; sy < 64; sy++) {
+        for (int sx = 0; sx < 64; sx++) {
+            const glm::vec2 uv = RotatedUv(sx, sy, 64) * 3.0f - glm::vec2(1.0f);
+            REQUIRE(PixelsEqual(texture.SampleNearestRepeat(uv), SampleRowMajorNearestRepeat(pixels, kSize, kSize, uv)));
+        }
+    }
+}
+
+TEST_CASE("Power-of-two nearest sampling keeps the row-major flip on texel boundaries", "[texture][sampling]") {
+    constexpr int kSize = 8;
+    const std::vector<Pixel> pixels = MakeGradientPixels(kSize, kSize);
+    Texture texture;
+    REQUIRE(texture.LoadFromPixels(pixels, kSize, kSize));
+    REQUIRE(texture.HasWrapMasks());
+    texture.EnsureAutoPalette();
+    REQUIRE(texture.HasIndexedPixels());
+
+    for (int i = -kSize; i <= 2 * kSize; i++) {
+        const float boundary = static_cast<float>(i) / kSize;
+        for (const glm::vec2& uv : {glm::vec2(0.3f, boundary), glm::vec2(boundary, 0.6f), glm::vec2(boundary, boundary)}) {
+            const Pixel sampled = texture.SampleNearestRepeat(uv);
+            CHECK(PixelsEqual(sampled, SampleRowMajorNearestRepeat(pixels, kSize, kSize, uv)));
+            CHECK(texture.SampleIndexedNearestRepeat(uv) == texture.FindNearestAutoPaletteIndex(sampled.r, sampled.g, sampled.b));
+        }
+    }
+    // (1 - 0.25) * 8 is exactly row 6; a masked flip of floor(0.25 * 8) would land on row 5.
+    CHECK(PixelsEqual(texture.SampleNearestRepeat(glm::vec2(0.0f, 0.25f)), pixels[6 * kSize]));
+}
+
+TEST_CASE("Mip chain halves each level and box-filters texels", "[texture][sampling][mips]") {
+    // 4x2 image: left 2x2 block black, right 2x2 block white.
+    std::vector<Pixel> pixels(8, Pixel{0, 0, 0, 255});
+    for (const size_t index : {size_t{2}, size_t{3}, size_t{6}, size_t{7}}) {
+        pixels[index] = Pixel{255, 255, 255, 255};
+    }
+    Texture texture;
+    REQUIRE(texture.LoadFromPixels(pixels, 4, 2));
+    CHECK(texture.GetMipLevelCount() == 1);
+    CHECK(texture.SelectMipLevel(10.0f) == 0);
+    texture.EnsureMipChain();
+    const uint64_t baseOnlyBytes = sizeof(Texture) + texture.GetPath().capacity() + pixels.size() * sizeof(Pixel);
+    CHECK(texture.EstimateResidentCpuBytes() > baseOnlyBytes);
+
+    REQUIRE(texture.GetMipLevelCount() == 3);
+    CHECK(texture.GetLevelWidth(1) == 2);
+    CHECK(texture.GetLevelHeight(1) == 1);
+    CHECK(texture.GetLevelWidth(2) == 1);
+    CHECK(texture.GetLevelHeight(2) == 1);
+    CHECK(PixelsEqual(texture.FetchTexel(1, 0, 0), Pixel{0, 0, 0, 255}));
+    CHECK(PixelsEqual(texture.FetchTexel(1, 1, 0), Pixel{255, 255, 255, 255}));
+    CHECK(PixelsEqual(texture.FetchTexel(2, 0, 0), Pixel{128, 128, 128, 255}));
+}
+
+TEST_CASE("Mip selection follows the pixel footprint in texels", "[texture][sampling][mips]") {
+    constexpr int kSize = 256;
+    Texture texture;
+    REQUIRE(texture.LoadFromPixels(MakeGradientPixels(kSize, kSize), kSize, kSize));
+    texture.EnsureMipChain();
+    REQUIRE(texture.GetMipLevelCount() == 9);
+
+    CHECK(texture.SelectMipLevel(kBaseLevelUvFootprintLog2) == 0);
+    // One texel per pixel stays on the base level; four texels per pixel drops two levels.
+    CHECK(texture.SelectMipLevel(std::log2(1.0f / kSize)) == 0);
+    CHECK(texture.SelectMipLevel(std::log2(4.0f / kSize)) == 2);
+    CHECK(texture.SelectMipLevel(10.0f) == 8);
+
+    const glm::vec2 uv(0.3f, 0.7f);
+    const Pixel sampled = texture.SampleNearestRepeat(uv, 2);
+    const int x = static_cast<int>(std::floor(uv.x * 64.0f));
+    const int y = 63 - static_cast<int>(std::floor(uv.y * 64.0f));
+    CHECK(PixelsEqual(sampled, texture.FetchTexel(2, x, y)));
+}
+
+TEST_CASE("Reduced texture level matches per-sample reduction and is cached per revision", "[texture][sampling]") {
+    constexpr int kWidth = 200;
+    constexpr int kHeight = 136;
+    constexpr int kMaxDimension = 16;
+    const std::vector<Pixel> pixels = MakeGradientPixels(kWidth, kHeight);
+    Texture texture;
+    REQUIRE(texture.LoadFromPixels(pixels, kWidth, kHeight));
+    CHECK(texture.GetReducedLevel(0) == nullptr);
+    CHECK(texture.GetReducedLevel(kWidth) == nullptr);
+
+    const std::shared_ptr<const TextureLevel> reduced = texture.GetReducedLevel(kMaxDimension);
+    REQUIRE(reduced != nullptr);
+    CHECK(reduced->width == kMaxDimension);
+    CHECK(reduced->height == 11);
+    CHECK(texture.GetReducedLevel(kMaxDimension) == reduced);
+
+    for (int sy = 0; sy < 64; sy++) {
+        for (int sx = 0; sx < 64; sx++) {
+            const glm::vec2 uv = RotatedUv(sx, sy, 64) * 2.0f - glm::vec2(0.5f);
+            // Per-sample reduction as it was done before the reduced copy was cached.
+            const float wrappedU = uv.x - std::floor(uv.x);
+            const float wrappedV = uv.y - std::floor(uv.y);
+            const int reducedX = std::clamp(static_cast<int>(std::floor(wrappedU * reduced->width)), 0, reduced->width - 1);
+            const int reducedY = std::clamp(static_cast<int>(std::floor((1.0f - wrappedV) * reduced->height)), 0, reduced->height - 1);
+            const int x = ((reducedX * 2 + 1) * kWidth) / (reduced->width * 2);
+            const int y = ((reducedY * 2 + 1) * kHeight) / (reduced->height * 2);
+            REQUIRE(PixelsEqual(texture.SampleReducedNearestRepeat(uv, kMaxDimension),
+                                pixels[static_cast<size_t>(y) * kWidth + static_cast<size_t>(x)]));
+        }
+    }
+
+    REQUIRE(texture.LoadFromPixels(pixels, kWidth, kHeight));
+    CHECK(texture.GetReducedLevel(kMaxDimension) != reduced);
+}
+
+TEST_CASE("Indexed CLUT sampling matches nearest-palette lookup of RGBA samples", "[texture][sampling][palette]") {
+    for (const auto [width, height] : {std::pair{64, 64}, std::pair{45, 30}}) {
+        const std::vector<Pixel> pixels = MakeGradientPixels(width, height);
+        Texture texture;
+        REQUIRE(texture.LoadFromPixels(pixels, width, height));
+        texture.EnsureAutoPalette();
+        REQUIRE(texture.HasIndexedPixels());
+        const std::shared_ptr<const IndexedTextureLevel> reducedIndices = texture.GetReducedIndexedLevel(16);
+        const std::shared_ptr<const TextureLevel> reduced = texture.GetReducedLevel(16);
+        REQUIRE(reducedIndices != nullptr);
+        REQUIRE(reduced != nullptr);
+
+        for (int sy = 0; sy < 48; sy++) {
+            for (int sx = 0; sx < 48; sx++) {
+                const glm::vec2 uv = RotatedUv(sx, sy, 48) * 2.0f - glm::vec2(0.5f);
+                const Pixel sampled = texture.SampleNearestRepeat(uv);
+                CHECK(texture.SampleIndexedNearestRepeat(uv) == texture.FindNearestAutoPaletteIndex(sampled.r, sampled.g, sampled.b));
+
+                const Pixel sampledReduced = SampleLevelNearestRepeat(*reduced, uv);
+                CHECK(SampleLevelNearestRepeat(*reducedIndices, uv) ==
+                      texture.FindNearestAutoPaletteIndex(sampledReduced.r, sampledReduced.g, sampledReduced.b));
+            }
+        }
+    }
+}
+
+TEST_CASE("Textures with transparent texels keep sampling RGBA", "[texture][sampling][palette]") {
+    std::vector<Pixel> pixels = MakeGradientPixels(8, 8);
+    pixels[5].a = 0;
+    Texture texture;
+    REQUIRE(texture.LoadFromPixels(pixels, 8, 8));
+    texture.EnsureAutoPalette();
+    CHECK(texture.HasAutoPalette());
+    CHECK_FALSE(texture.HasIndexedPixels());
+}
+
+TEST_CASE("Auto palette is built on demand and its lookup table picks the nearest entry", "[texture][palette]") {
+    // Large enough for the histogram to be split across workers on multi-core machines.
+    constexpr int kSize = 600;
+    Texture texture;
+    REQUIRE(texture.LoadFromPixels(MakeGradientPixels(kSize, kSize), kSize, kSize));
+    CHECK_FALSE(texture.HasAutoPalette());
+    CHECK(texture.GetAutoPaletteBuildNs() == 0);
+
+    texture.EnsureAutoPalette();
+    REQUIRE(texture.HasAutoPalette());
+    CHECK(texture.GetAutoPaletteBuildNs() > 0);
+
+    const auto& palette = texture.GetAutoPalettePixels();
+    for (int r = 0; r < 256; r += 7) {
+        for (int g = 0; g < 256; g += 11) {
+            for (int b = 0; b < 256; b += 5) {
+                // The table is indexed at RGB555 precision, so compare against the bucket's representative color.
+                const int qr = ((r >> 3) << 3) | (r >> 5);
+                const int qg = ((g >> 3) << 3) | (g >> 5);
+                const int qb = ((b >> 3) << 3) | (b >> 5);
+                int bestDistance = std::numeric_limits<int>::max();
+                size_t bestIndex = 0;
+                for (size_t i = 0; i < palette.size(); i++) {
+                    const int dr = qr - palette[i].r;
+                    const int dg = qg - palette[i].g;
+                    const int db = qb - palette[i].b;
+                    const int distance = dr * dr * 3 + dg * dg * 4 + db * db * 2;
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        bestIndex = i;
+                    }
+                }
+                REQUIRE(texture.FindNearestAutoPaletteIndex(static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b)) ==
+                        bestIndex);
+            }
+        }
+    }
+}
+
+TEST_CASE("Batch file loading decodes RGB and RGBA images straight into texture pixels", "[texture][loading]") {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "retrorenderer_texture_loading_tests";
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+
+    constexpr int kWidth = 13;
+    constexpr int kHeight = 7;
+    std::vector<Pixel> expected = MakeGradientPixels(kWidth, kHeight);
+    for (size_t i = 0; i < expected.size(); i++) {
+        expected[i].a = static_cast<uint8_t>(i * 5);
+    }
+
+    // The BMP decodes to a 24-bit BGR surface and the PNG to RGBA32, covering both the converting and copying paths.
+    SDL_Surface* rgbSurface = SDL_CreateRGBSurfaceWithFormat(0, kWidth, kHeight, 24, SDL_PIXELFORMAT_RGB24);
+    SDL_Surface* rgbaSurface = SDL_CreateRGBSurfaceWithFormat(0, kWidth, kHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(rgbSurface != nullptr);
+    REQUIRE(rgbaSurface != nullptr);
+    for (int y = 0; y < kHeight; y++) {
+        auto* rgbRow = static_cast<uint8_t*>(rgbSurface->pixels) + static_cast<size_t>(y) * static_cast<size_t>(rgbSurface->pitch);
+        auto* rgbaRow = static_cast<uint8_t*>(rgbaSurface->pixels) + static_cast<size_t>(y) * static_cast<size_t>(rgbaSurface->pitch);
+        for (int x = 0; x < kWidth; x++) {
+            const Pixel& pixel = expected[static_cast<size_t>(y) * kWidth + static_cast<size_t>(x)];
+            rgbRow[x * 3 + 0] = pixel.r;
+            rgbRow[x * 3 + 1] = pixel.g;
+            rgbRow[x * 3 + 2] = pixel.b;
+            rgbaRow[x * 4 + 0] = pixel.r;
+            rgbaRow[x * 4 + 1] = pixel.g;
+            rgbaRow[x * 4 + 2] = pixel.b;
+            rgbaRow[x * 4 + 3] = pixel.a;
+        }
+    }
+    const std::string bmpPath = (dir / "gradient.bmp").string();
+    const std::string pngPath = (dir / "gradient.png").string();
+    REQUIRE(SDL_SaveBMP(rgbSurface, bmpPath.c_str()) == 0);
+    REQUIRE(IMG_SavePNG(rgbaSurface, pngPath.c_str()) == 0);
+    SDL_FreeSurface(rgbSurface);
+    SDL_FreeSurface(rgbaSurface);
+
+    const std::vector<std::string> paths = {bmpPath, (dir / "missing.png").string(), pngPath};
+    const std::vector<std::shared_ptr<const Texture>> textures = Texture::LoadFromFiles(paths, 2);
+    REQUIRE(textures.size() == paths.size());
+    CHECK(textures[1] == nullptr);
+    REQUIRE(textures[0] != nullptr);
+    REQUIRE(textures[2] != nullptr);
+    for (const size_t index : {size_t{0}, size_t{2}}) {
+        const Texture& texture = *textures[index];
+        REQUIRE(texture.GetWidth() == kWidth);
+        REQUIRE(texture.GetHeight() == kHeight);
+        CHECK(texture.GetPath() == paths[index]);
+        for (size_t i = 0; i < expected.size(); i++) {
+            const Pixel& actual = texture.GetPixels()[i];
+            CHECK(actual.r == expected[i].r);
+            CHECK(actual.g == expected[i].g);
+            CHECK(actual.b == expected[i].b);
+            CHECK(actual.a == (index == 0 ? 255 : expected[i].a));
+        }
+    }
+    std::filesystem::remove_all(dir, ec);
+}
+
+TEST_CASE("Fixed-point bilinear kernel matches float filtering within one LSB", "[texture][sampling]") {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> channel(0, 255);
+    std::uniform_real_distribution<float> fraction(0.0f, 1.0f);
+    const auto randomPixel = [&]() {
+        return Pixel{static_cast<uint8_t>(channel(rng)),
+                     static_cast<uint8_t>(channel(rng)),
+                     static_cast<uint8_t>(channel(rng)),
+                     static_cast<uint8_t>(channel(rng))};
+    };
+
+    int maxDifference = 0;
+    for (int i = 0; i < 200000; i++) {
+        const Pixel p00 = randomPixel();
+        const Pixel p10 = randomPixel();
+        const Pixel p01 = randomPixel();
+        const Pixel p11 = randomPixel();
+        const float tx = fraction(rng);
+        const float ty = fraction(rng);
+        maxDifference = std::max(
+            maxDifference,
+            MaxChannelDifference(BilinearFilterRgba8(p00, p10, p01, p11, tx, ty), FilterBilinearFloat(p00, p10, p01, p11, tx, ty)));
+    }
+    CHECK(maxDifference <= 1);
+
+    // Texel centers and extreme channel values come back exactly.
+    const Pixel black{0, 0, 0, 0};
+    const Pixel white{255, 255, 255, 255};
+    const Pixel mixed{12, 200, 77, 255};
+    CHECK(PixelsEqual(BilinearFilterRgba8(mixed, black, black, black, 0.0f, 0.0f), mixed));
+    CHECK(PixelsEqual(BilinearFilterRgba8(black, mixed, black, black, 1.0f, 0.0f), mixed));
+    CHECK(PixelsEqual(BilinearFilterRgba8(black, black, black, mixed, 1.0f, 1.0f), mixed));
+    CHECK(PixelsEqual(BilinearFilterRgba8(white, white, white, white, 0.37f, 0.81f), white));
+}
+
+TEST_CASE("Bilinear filtering throughput", "[.][benchmark][texture]") {
+    constexpr int kSize = 1024;
+    constexpr int kScreenSize = 512;
+    const std::vector<Pixel> pixels = MakeGradientPixels(kSize, kSize);
+    // Same texel addressing as SampleLinear, so the two benchmarks differ only in the blend.
+    const auto sampleLinear = [&pixels](const glm::vec2& uv, auto&& filter) {
+        const float sampleX = (uv.x - std::floor(uv.x)) * static_cast<float>(kSize - 1);
+        const float sampleY = (uv.y - std::floor(uv.y)) * static_cast<float>(kSize - 1);
+        const int x0 = static_cast<int>(sampleX);
+        const int y0 = static_cast<int>(sampleY);
+        const int x1 = std::min(x0 + 1, kSize - 1);
+        const int y1 = std::min(y0 + 1, kSize - 1);
+        const auto fetch = [&pixels](int x, int y) -> const Pixel& {
+            return pixels[static_cast<size_t>(y) * kSize + static_cast<size_t>(x)];
+        };
+        return filter(fetch(x0, y0),
+                      fetch(x1, y0),
+                      fetch(x0, y1),
+                      fetch(x1, y1),
+                      sampleX - static_cast<float>(x0),
+                      sampleY - static_cast<float>(y0));
+    };
+
+    BENCHMARK("float bilinear") {
+        uint32_t checksum = 0;
+        for (int sy = 0; sy < kScreenSize; sy++) {
+            for (int sx = 0; sx < kScreenSize; sx++) {
+                checksum += sampleLinear(RotatedUv(sx, sy, kScreenSize), FilterBilinearFloat).g;
+            }
+        }
+        return checksum;
+    };
+    BENCHMARK("fixed-point bilinear") {
+        uint32_t checksum = 0;
+        for (int sy = 0; sy < kScreenSize; sy++) {
+            for (int sx = 0; sx < kScreenSize; sx++) {
+                checksum += sampleLinear(RotatedUv(sx, sy, kScreenSize), BilinearFilterRgba8).g;
+            }
+        }
+        return checksum;
+    };
+}
+
+TEST_CASE("Texture sampling throughput on large textures", "[.][benchmark][texture]") {
+    constexpr int kScreenSize = 512;
+    for (const int size : {2048, 4096}) {
+        const std::vector<Pixel> pixels = MakeGradientPixels(size, size);
+        Texture texture;
+        REQUIRE(texture.LoadFromPixels(pixels, size, size));
+        texture.EnsureTiledLayout();
+
+        BENCHMARK("row-major nearest, v-major walk, " + std::to_string(size)) {
+            uint32_t checksum = 0;
+            for (int sy = 0; sy < kScreenSize; sy++) {
+                for (int sx = 0; sx < kScreenSize; sx++) {
+                    checksum += SampleRowMajorNearestRepeat(pixels, size, size, RotatedUv(sx, sy, kScreenSize)).b;
+                }
+            }
+            return checksum;
+        };
+        BENCHMARK("tiled nearest, v-major walk, " + std::to_string(size)) {
+            uint32_t checksum = 0;
+            for (int sy = 0; sy < kScreenSize; sy++) {
+                for (int sx = 0; sx < kScreenSize; sx++) {
+                    checksum += texture.SampleNearestRepeat(RotatedUv(sx, sy, kScreenSize)).b;
+                }
+            }
+            return checksum;
+        };
+    }
+}
+
+} // namespace RetroRenderer
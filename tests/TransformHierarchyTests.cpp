@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Scene/TransformHierarchy.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace RetroRenderer {
+namespace {
+glm::mat4 Translation(float x, float y, float z) {
+    return glm::translate(glm::mat4(1.0f), glm::vec3(x, y, z));
+}
+} // namespace
+
+TEST_CASE("Transform hierarchy defers world updates until the batched sweep", "[scene][transform]") {
+    TransformHierarchy hierarchy;
+    const int root = hierarchy.Append(Translation(1.0f, 0.0f, 0.0f));
+    const int child = hierarchy.Append(Translation(0.0f, 2.0f, 0.0f));
+    const int grandchild = hierarchy.Append(Translation(0.0f, 0.0f, 3.0f));
+    hierarchy.SetParent(child, root);
+    hierarchy.SetParent(grandchild, child);
+
+    REQUIRE(hierarchy.HasPendingUpdates());
+    CHECK(hierarchy.Update() == 3);
+    CHECK_FALSE(hierarchy.HasPendingUpdates());
+    CHECK(glm::vec3(hierarchy.GetWorldMatrix(grandchild)[3]) == glm::vec3(1.0f, 2.0f, 3.0f));
+
+    // Moving the root only touches the stored local matrix until the next sweep.
+    hierarchy.SetLocalMatrix(root, Translation(5.0f, 0.0f, 0.0f));
+    CHECK(glm::vec3(hierarchy.GetWorldMatrix(grandchild)[3]) == glm::vec3(1.0f, 2.0f, 3.0f));
+    CHECK(hierarchy.Update() == 3);
+    CHECK(glm::vec3(hierarchy.GetWorldMatrix(grandchild)[3]) == glm::vec3(5.0f, 2.0f, 3.0f));
+
+    // Clean subtrees are skipped.
+    hierarchy.MarkDirty(grandchild);
+    CHECK(hierarchy.Update() == 1);
+    CHECK(hierarchy.Update() == 0);
+}
+
+TEST_CASE("Transform hierarchy keeps world bounds in sync with world matrices", "[scene][transform]") {
+    TransformHierarchy hierarchy;
+    const int root = hierarchy.Append(glm::scale(glm::mat4(1.0f), glm::vec3(2.0f)));
+    const int child = hierarchy.Append(glm::rotate(Translation(1.0f, 0.0f, 0.0f), glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+    hierarchy.SetParent(child, root);
+    hierarchy.SetLocalBounds(child, true, glm::vec3(0.0f, -1.0f, -1.0f), glm::vec3(2.0f, 1.0f, 1.0f));
+    hierarchy.Update();
+
+    glm::vec3 worldMin{};
+    glm::vec3 worldMax{};
+    hierarchy.GetWorldBounds(child, worldMin, worldMax);
+    constexpr float kEpsilon = 1e-4f;
+    CHECK(glm::all(glm::lessThan(glm::abs(worldMin - glm::vec3(0.0f, 0.0f, -2.0f)), glm::vec3(kEpsilon))));
+    CHECK(glm::all(glm::lessThan(glm::abs(worldMax - glm::vec3(4.0f, 4.0f, 2.0f)), glm::vec3(kEpsilon))));
+    CHECK_FALSE(hierarchy.HasLocalBounds(root));
+}
+
+TEST_CASE("Transform hierarchy accepts later parents and rejects cycles", "[scene][transform]") {
+    TransformHierarchy hierarchy;
+    const int first = hierarchy.Append(Translation(1.0f, 0.0f, 0.0f));
+    const int second = hierarchy.Append(Translation(0.0f, 1.0f, 0.0f));
+    const int third = hierarchy.Append(Translation(0.0f, 0.0f, 1.0f));
+
+    CHECK_FALSE(hierarchy.SetParent(second, second));
+    CHECK_FALSE(hierarchy.SetParent(second, -2));
+    CHECK_FALSE(hierarchy.SetParent(second, 3));
+
+    // Entries may be parented to ones created after them; the sweep still resolves parents first.
+    REQUIRE(hierarchy.SetParent(first, second));
+    REQUIRE(hierarchy.SetParent(second, third));
+    CHECK(hierarchy.Update() == 3);
+    CHECK(glm::vec3(hierarchy.GetWorldMatrix(first)[3]) == glm::vec3(1.0f, 1.0f, 1.0f));
+
+    CHECK_FALSE(hierarchy.SetParent(third, first));
+    CHECK(hierarchy.GetParent(third) == TransformHierarchy::kNoParent);
+
+    // Detaching the middle entry re-roots its subtree.
+    REQUIRE(hierarchy.SetParent(second, TransformHierarchy::kNoParent));
+    CHECK(hierarchy.SetParent(third, first));
+    CHECK(hierarchy.Update() == 3);
+    CHECK(glm::vec3(hierarchy.GetWorldMatrix(third)[3]) == glm::vec3(1.0f, 1.0f, 1.0f));
+}
+
+} // namespace RetroRenderer